@@ -4,7 +4,9 @@
 #include "Core/Areas.hpp"
 #include "Core/Signal.hpp"
 #include "Core/Buffer.hpp"
+#include "Core/Metrics.hpp"
 #include "Core/ThreadPool.hpp"
+#include "Library/Chrono.hpp"
 #include "Library/IO/Buffer.hpp"
 
 // ------------------------------------------------------------------------------------------------
@@ -29,6 +31,7 @@
 #include <cstdarg>
 #include <exception>
 #include <stdexcept>
+#include <iterator>
 #include <algorithm>
 
 // ------------------------------------------------------------------------------------------------
@@ -45,9 +48,13 @@ extern void InitializeRoutines();
 extern void TerminateAreas();
 extern void TerminateTasks();
 extern void TerminatePrivileges();
+extern void TerminateLoot();
 extern void TerminateRoutines();
 extern void TerminateCommands();
 extern void TerminateSignals();
+extern void TerminatePromises();
+extern void TerminateCURL();
+extern void TerminateMetrics();
 extern void TerminateNet();
 #ifdef SQMOD_DISCORD
     extern void TerminateDiscord();
@@ -165,6 +172,7 @@ Core::Core() noexcept
     , m_PendingScripts()
     , m_Options()
     , m_ExtCommands{nullptr, nullptr, nullptr, nullptr}
+    , m_EntityTags()
     , m_Blips()
     , m_Checkpoints()
     , m_KeyBinds()
@@ -179,6 +187,7 @@ Core::Core() noexcept
     , m_IncomingNameBuffer(nullptr)
     , m_IncomingNameCapacity(0)
     , m_AreasEnabled(false)
+    , m_AreasBatched(false)
     , m_Debugging(false)
     , m_Executed(false)
     , m_Shutdown(false)
@@ -186,7 +195,15 @@ Core::Core() noexcept
     , m_LockPostLoadSignal(false)
     , m_LockUnloadSignal(false)
     , m_EmptyInit(false)
+    , m_ClientDataView(false)
     , m_Verbosity(1)
+    , m_StateWindow(0)
+    , m_ScriptCache()
+    , m_DirtyPlayers()
+    , m_DirtyVehicles()
+    , m_AreasFound()
+    , m_AreasLeft()
+    , m_AreasEntered()
     , m_ClientData()
     , m_NullBlip()
     , m_NullCheckpoint()
@@ -258,6 +275,13 @@ bool Core::Initialize()
     m_Debugging = conf.GetBoolValue("Squirrel", "Debugging", m_Debugging);
     // Configure the empty initialization
     m_EmptyInit = conf.GetBoolValue("Squirrel", "EmptyInit", false);
+    // Configure the compiled script cache
+    m_ScriptCache = conf.GetValue("Squirrel", "BytecodeCache", "");
+    // Configure how client data is delivered to scripts
+    m_ClientDataView = conf.GetBoolValue("Squirrel", "ClientDataView", false);
+    // Configure the signal profiler
+    Signal::SetProfiling(conf.GetBoolValue("Squirrel", "SignalProfiling", false));
+    Signal::SetSlowSlot(static_cast< SQInteger >(conf.GetLongValue("Squirrel", "SlowSlotThreshold", 0)));
     // Configure the verbosity level
     m_Verbosity = conf.GetLongValue("Log", "VerbosityLevel", 1);
     // Initialize the log filename
@@ -280,6 +304,22 @@ bool Core::Initialize()
     Logger::Get().ToggleLogFileLevel(LOGL_WRN, conf.GetBoolValue("Log", "LogFileWarning", true));
     Logger::Get().ToggleLogFileLevel(LOGL_ERR, conf.GetBoolValue("Log", "LogFileError", true));
     Logger::Get().ToggleLogFileLevel(LOGL_FTL, conf.GetBoolValue("Log", "LogFileFatal", true));
+    // Configure what happens to messages when the asynchronous buffer is full
+    Logger::Get().SetOverflow(ConvTo< uint8_t >::From(conf.GetLongValue("Log", "AsyncOverflow", LOGO_COUNT)));
+    // Move console and file output to a dedicated thread, if requested
+    if (conf.GetBoolValue("Log", "Async", false))
+    {
+        Logger::Get().EnableAsync(ConvTo< size_t >::From(conf.GetLongValue("Log", "AsyncSlots", 4096)));
+    }
+    // Start the metrics server, if requested. It survives script reloads
+    if (conf.GetBoolValue("Metrics", "Enabled", false) &&
+        Metrics::Get().Initialize(conf.GetValue("Metrics", "Listen", "127.0.0.1:8090"),
+                                  conf.GetValue("Metrics", "AccessControl", "-0.0.0.0/0,+127.0.0.1"),
+                                  conf.GetLongValue("Metrics", "Interval", 1000),
+                                  conf.GetLongValue("Metrics", "LogTail", 50)))
+    {
+        cLogDbg(m_Verbosity >= 1, "Metrics available on %s", conf.GetValue("Metrics", "Listen", "127.0.0.1:8090"));
+    }
 
     cLogDbg(m_Verbosity >= 1, "Resizing the entity containers");
     // Make sure the entity containers have the proper size
@@ -530,6 +570,15 @@ void Core::Terminate(bool shutdown)
     const ContainerCleaner cc_blips(m_Blips, ENT_BLIP, !shutdown);
     const ContainerCleaner cc_keybinds(m_KeyBinds, ENT_KEYBIND, !shutdown);
 
+    // Stop the metrics server only when the server shuts down
+    if (shutdown)
+    {
+        TerminateMetrics();
+        cLogDbg(m_Verbosity >= 1, "Metrics server terminated");
+    }
+    // Abort the HTTP transfers in progress
+    TerminateCURL();
+    cLogDbg(m_Verbosity >= 1, "HTTP transfers terminated");
     // Terminate the thread pool
     ThreadPool::Get().Terminate();
     cLogDbg(m_Verbosity >= 1, "Thread pool terminated");
@@ -544,12 +593,24 @@ void Core::Terminate(bool shutdown)
     // Release all resources from signals
     TerminateSignals();
     cLogDbg(m_Verbosity >= 2, "Signals terminated");
+    // Release all resources from promises and coroutines
+    TerminatePromises();
+    cLogDbg(m_Verbosity >= 2, "Promises terminated");
+    // Forget about pending area changes
+    m_DirtyPlayers.clear();
+    m_DirtyVehicles.clear();
+    m_AreasFound.clear();
+    m_AreasLeft.clear();
+    m_AreasEntered.clear();
     // Release all managed areas
     TerminateAreas();
     cLogDbg(m_Verbosity >= 2, "Areas terminated");
     // Release privilege managers
     TerminatePrivileges();
     cLogDbg(m_Verbosity >= 2, "Privileges terminated");
+    // Release loot managers
+    TerminateLoot();
+    cLogDbg(m_Verbosity >= 2, "Loot terminated");
     // Release announcers
     AnnounceTerminate();
     cLogDbg(m_Verbosity >= 1, "Announcer terminated");
@@ -800,7 +861,7 @@ bool Core::LoadScript(const SQChar * filepath, Function & cb, LightObj & ctx, bo
         // Attempt to load and compile the script file
         try
         {
-            m_Scripts.back().mExec.CompileFile(path);
+            m_Scripts.back().Compile(m_ScriptCache);
         }
         catch (const std::exception & e)
         {
@@ -1006,7 +1067,7 @@ bool Core::DoScripts(Scripts::iterator itr, Scripts::iterator end)
         // Attempt to load and compile the script file
         try
         {
-            (*itr).mExec.CompileFile((*itr).mPath);
+            (*itr).Compile(Get().m_ScriptCache);
         }
         catch (const std::exception & e)
         {
@@ -1352,6 +1413,8 @@ BlipInst & Core::AllocBlip(int32_t id, bool owned, int32_t header, LightObj & pa
     }
     // Assign the specified entity identifier
     inst.mID = id;
+    // Make the entity discoverable by tag
+    m_EntityTags[ENT_BLIP].Insert(inst.mInst->m_Tag, static_cast< TagIndex::Slot >(id));
     // Specify whether the entity is owned by this plug-in
     if (owned)
     {
@@ -1447,6 +1510,8 @@ CheckpointInst & Core::AllocCheckpoint(int32_t id, bool owned, int32_t header, L
     }
     // Assign the specified entity identifier
     inst.mID = id;
+    // Make the entity discoverable by tag
+    m_EntityTags[ENT_CHECKPOINT].Insert(inst.mInst->m_Tag, static_cast< TagIndex::Slot >(id));
     // Specify whether the entity is owned by this plug-in
     if (owned)
     {
@@ -1506,6 +1571,8 @@ KeyBindInst & Core::AllocKeyBind(int32_t id, bool owned, int32_t header, LightOb
     }
     // Assign the specified entity identifier
     inst.mID = id;
+    // Make the entity discoverable by tag
+    m_EntityTags[ENT_KEYBIND].Insert(inst.mInst->m_Tag, static_cast< TagIndex::Slot >(id));
     // Specify whether the entity is owned by this plug-in
     if (owned)
     {
@@ -1601,6 +1668,8 @@ ObjectInst & Core::AllocObject(int32_t id, bool owned, int32_t header, LightObj
     }
     // Assign the specified entity identifier
     inst.mID = id;
+    // Make the entity discoverable by tag
+    m_EntityTags[ENT_OBJECT].Insert(inst.mInst->m_Tag, static_cast< TagIndex::Slot >(id));
     // Specify whether the entity is owned by this plug-in
     if (owned)
     {
@@ -1696,6 +1765,8 @@ PickupInst & Core::AllocPickup(int32_t id, bool owned, int32_t header, LightObj
     }
     // Assign the specified entity identifier
     inst.mID = id;
+    // Make the entity discoverable by tag
+    m_EntityTags[ENT_PICKUP].Insert(inst.mInst->m_Tag, static_cast< TagIndex::Slot >(id));
     // Specify whether the entity is owned by this plug-in
     if (owned)
     {
@@ -1791,6 +1862,8 @@ VehicleInst & Core::AllocVehicle(int32_t id, bool owned, int32_t header, LightOb
     }
     // Assign the specified entity identifier
     inst.mID = id;
+    // Make the entity discoverable by tag
+    m_EntityTags[ENT_VEHICLE].Insert(inst.mInst->m_Tag, static_cast< TagIndex::Slot >(id));
     // Specify whether the entity is owned by this plug-in
     if (owned)
     {
@@ -2227,6 +2300,8 @@ void Core::ConnectPlayer(int32_t id, int32_t header, LightObj & payload)
     }
     // Assign the specified entity identifier
     inst.mID = id;
+    // Make the entity discoverable by tag
+    m_EntityTags[ENT_PLAYER].Insert(inst.mInst->m_Tag, static_cast< TagIndex::Slot >(id));
     // Should we enable area tracking?
     if (m_AreasEnabled)
     {
@@ -2262,6 +2337,171 @@ void Core::DisconnectPlayer(int32_t id, int32_t header, LightObj & payload)
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+static bool AreaPairLess(AreaList::const_reference a, AreaList::const_reference b)
+{
+    return (a.first < b.first);
+}
+
+// ------------------------------------------------------------------------------------------------
+template < typename T > static void DiffAreas(T & inst, AreaList & found, AreaList & left, AreaList & entered)
+{
+    found.clear();
+    left.clear();
+    entered.clear();
+    // Collect the areas at the last known position of the entity
+    AreaManager::Get().TestPoint([&found](AreaList::reference ap) -> void {
+        found.emplace_back(ap);
+    }, inst.mLastPosition.x, inst.mLastPosition.y);
+    // Both lists must be sorted (current areas might have been collected while not batched)
+    std::sort(found.begin(), found.end(), AreaPairLess);
+    std::sort(inst.mAreas.begin(), inst.mAreas.end(), AreaPairLess);
+    // Areas that are no longer found were left and areas that were not there before were entered
+    std::set_difference(inst.mAreas.begin(), inst.mAreas.end(), found.begin(), found.end(),
+                        std::back_inserter(left), AreaPairLess);
+    std::set_difference(found.begin(), found.end(), inst.mAreas.begin(), inst.mAreas.end(),
+                        std::back_inserter(entered), AreaPairLess);
+    // The found areas are now the current areas
+    inst.mAreas.swap(found);
+}
+
+// ------------------------------------------------------------------------------------------------
+int64_t Core::StateTime() const
+{
+    // Don't bother with the clock if the state is never reused
+    return m_StateWindow > 0 ? Chrono::GetCurrentSysTime() : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Core::IsStateFresh(int64_t time) const
+{
+    // Was the state captured while reuse was enabled and is it recent enough?
+    return time > 0 && m_StateWindow > 0 && (Chrono::GetCurrentSysTime() - time) <= m_StateWindow;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Core::ProcessAreas()
+{
+    // Any players moved since the last frame?
+    if (!m_DirtyPlayers.empty())
+    {
+        // Take the list so that entities can be marked again from within the events
+        std::vector< int32_t > dirty;
+        dirty.swap(m_DirtyPlayers);
+        // Process them in the order of their identifiers
+        std::sort(dirty.begin(), dirty.end());
+        // Recompute the areas of each player
+        for (const int32_t id : dirty)
+        {
+            // Has the container been cleared in the meantime?
+            if (static_cast< size_t >(id) >= m_Players.size())
+            {
+                continue;
+            }
+            PlayerInst & inst = m_Players[id];
+            // Was the player destroyed in the meantime?
+            if (!(inst.mFlags & ENF_AREA_DIRTY))
+            {
+                continue;
+            }
+            // The player can be marked again
+            inst.mFlags ^= ENF_AREA_DIRTY;
+            // Was area tracking disabled in the meantime?
+            if (!(inst.mFlags & ENF_AREA_TRACK))
+            {
+                continue;
+            }
+            // Find the differences
+            DiffAreas(inst, m_AreasFound, m_AreasLeft, m_AreasEntered);
+            // Emit the areas that were left first (stop if the player is destroyed by the script)
+            for (auto & ap : m_AreasLeft)
+            {
+                if (inst.mID != id)
+                {
+                    break;
+                }
+                EmitPlayerLeaveArea(id, ap.second);
+            }
+            // Emit the areas that were entered
+            for (auto & ap : m_AreasEntered)
+            {
+                if (inst.mID != id)
+                {
+                    break;
+                }
+                EmitPlayerEnterArea(id, ap.second);
+            }
+        }
+        // Keep the allocated memory if nothing was marked in the meantime
+        if (m_DirtyPlayers.empty())
+        {
+            dirty.clear();
+            m_DirtyPlayers.swap(dirty);
+        }
+    }
+    // Any vehicles moved since the last frame?
+    if (!m_DirtyVehicles.empty())
+    {
+        // Take the list so that entities can be marked again from within the events
+        std::vector< int32_t > dirty;
+        dirty.swap(m_DirtyVehicles);
+        // Process them in the order of their identifiers
+        std::sort(dirty.begin(), dirty.end());
+        // Recompute the areas of each vehicle
+        for (const int32_t id : dirty)
+        {
+            // Has the container been cleared in the meantime?
+            if (static_cast< size_t >(id) >= m_Vehicles.size())
+            {
+                continue;
+            }
+            VehicleInst & inst = m_Vehicles[id];
+            // Was the vehicle destroyed in the meantime?
+            if (!(inst.mFlags & ENF_AREA_DIRTY))
+            {
+                continue;
+            }
+            // The vehicle can be marked again
+            inst.mFlags ^= ENF_AREA_DIRTY;
+            // Was area tracking disabled in the meantime?
+            if (!(inst.mFlags & ENF_AREA_TRACK))
+            {
+                continue;
+            }
+            // Find the differences
+            DiffAreas(inst, m_AreasFound, m_AreasLeft, m_AreasEntered);
+            // Emit the areas that were left first (stop if the vehicle is destroyed by the script)
+            for (auto & ap : m_AreasLeft)
+            {
+                if (inst.mID != id)
+                {
+                    break;
+                }
+                EmitVehicleLeaveArea(id, ap.second);
+            }
+            // Emit the areas that were entered
+            for (auto & ap : m_AreasEntered)
+            {
+                if (inst.mID != id)
+                {
+                    break;
+                }
+                EmitVehicleEnterArea(id, ap.second);
+            }
+        }
+        // Keep the allocated memory if nothing was marked in the meantime
+        if (m_DirtyVehicles.empty())
+        {
+            dirty.clear();
+            m_DirtyVehicles.swap(dirty);
+        }
+    }
+    // Release script references held by the helper lists
+    m_AreasFound.clear();
+    m_AreasLeft.clear();
+    m_AreasEntered.clear();
+}
+
 // ------------------------------------------------------------------------------------------------
 void Core::ClearContainer(EntityType type)
 {
@@ -2767,6 +3007,105 @@ static void SqSetAreasEnabled(bool toggle)
     Core::Get().AreasEnabled(toggle);
 }
 
+// ------------------------------------------------------------------------------------------------
+static bool SqGetAreasBatched()
+{
+    return Core::Get().AreasBatched();
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqSetAreasBatched(bool toggle)
+{
+    Core::Get().AreasBatched(toggle);
+}
+
+// ------------------------------------------------------------------------------------------------
+static bool SqGetClientDataView()
+{
+    return Core::Get().IsClientDataView();
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqSetClientDataView(bool toggle)
+{
+    Core::Get().SetClientDataView(toggle);
+}
+
+// ------------------------------------------------------------------------------------------------
+static Table SqGetVMMemory()
+{
+    SQMemStats st;
+    // Retrieve the allocator statistics
+    sq_getmemstats(&st);
+    // Create the table that will hold them
+    Table tbl(SqVM(), 8);
+    tbl.SetValue(_SC("Backend"), st.backend);
+    tbl.SetValue(_SC("LiveBytes"), static_cast< SQInteger >(st.live_bytes));
+    tbl.SetValue(_SC("PeakBytes"), static_cast< SQInteger >(st.peak_bytes));
+    tbl.SetValue(_SC("LiveBlocks"), static_cast< SQInteger >(st.live_blocks));
+    tbl.SetValue(_SC("Allocations"), static_cast< SQInteger >(st.allocations));
+    tbl.SetValue(_SC("ReservedBytes"), static_cast< SQInteger >(st.reserved_bytes));
+    // Create an array with the statistics of each size class
+    Array classes(SqVM(), SQ_MEM_SIZE_CLASSES + 1);
+    for (SQInteger i = 0; i <= SQ_MEM_SIZE_CLASSES; ++i)
+    {
+        Table cls(SqVM(), 4);
+        // The last class has no upper bound
+        cls.SetValue(_SC("Size"), i < SQ_MEM_SIZE_CLASSES ? (i + 1) * SQ_MEM_CLASS_GRANULARITY : SQInteger(-1));
+        cls.SetValue(_SC("Live"), static_cast< SQInteger >(st.class_live[i]));
+        cls.SetValue(_SC("Allocations"), static_cast< SQInteger >(st.class_allocs[i]));
+        cls.SetValue(_SC("Free"), static_cast< SQInteger >(st.class_free[i]));
+        classes.SetValue(i, cls);
+    }
+    tbl.SetValue(_SC("Classes"), classes);
+    // Return the resulted table
+    return tbl;
+}
+
+// ------------------------------------------------------------------------------------------------
+static Array SqGetWorkerLanes()
+{
+    static const SQChar * names[TPLANE_COUNT] = {_SC("High"), _SC("Normal"), _SC("Low")};
+    // Create the array that will hold the lanes
+    Array arr(SqVM(), TPLANE_COUNT);
+    for (SQInteger i = 0; i < TPLANE_COUNT; ++i)
+    {
+        const ThreadPool::LaneInfo info = ThreadPool::Get().GetLaneInfo(static_cast< ThreadPoolLane >(i));
+        // Create the table that will hold the lane statistics
+        Table tbl(SqVM(), 9);
+        tbl.SetValue(_SC("Name"), names[i]);
+        tbl.SetValue(_SC("Depth"), static_cast< SQInteger >(info.mDepth));
+        tbl.SetValue(_SC("Queued"), static_cast< SQInteger >(info.mQueued));
+        tbl.SetValue(_SC("Processed"), static_cast< SQInteger >(info.mProcessed));
+        tbl.SetValue(_SC("Retried"), static_cast< SQInteger >(info.mRetried));
+        tbl.SetValue(_SC("Stolen"), static_cast< SQInteger >(info.mStolen));
+        tbl.SetValue(_SC("WaitTotal"), static_cast< SQInteger >(info.mWaitTotal));
+        tbl.SetValue(_SC("WaitMax"), static_cast< SQInteger >(info.mWaitMax));
+        tbl.SetValue(_SC("WaitAverage"), info.mProcessed ? static_cast< SQInteger >(info.mWaitTotal / info.mProcessed) : SQInteger(0));
+        arr.SetValue(i, tbl);
+    }
+    // Return the resulted array
+    return arr;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqResetWorkerLanes()
+{
+    ThreadPool::Get().ResetLaneInfo();
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqGetStateWindow()
+{
+    return Core::Get().StateWindow();
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqSetStateWindow(SQInteger ms)
+{
+    Core::Get().StateWindow(ms);
+}
+
 // ------------------------------------------------------------------------------------------------
 static const String & SqGetOption(StackStrF & name)
 {
@@ -3006,6 +3345,15 @@ void Register_Core(HSQUIRRELVM vm)
         .Func(_SC("SetState"), &SqSetState)
         .Func(_SC("AreasEnabled"), &SqGetAreasEnabled)
         .Func(_SC("SetAreasEnabled"), &SqSetAreasEnabled)
+        .Func(_SC("AreasBatched"), &SqGetAreasBatched)
+        .Func(_SC("SetAreasBatched"), &SqSetAreasBatched)
+        .Func(_SC("ClientDataView"), &SqGetClientDataView)
+        .Func(_SC("SetClientDataView"), &SqSetClientDataView)
+        .Func(_SC("VMMemory"), &SqGetVMMemory)
+        .Func(_SC("WorkerLanes"), &SqGetWorkerLanes)
+        .Func(_SC("ResetWorkerLanes"), &SqResetWorkerLanes)
+        .Func(_SC("StateWindow"), &SqGetStateWindow)
+        .Func(_SC("SetStateWindow"), &SqSetStateWindow)
         .Func(_SC("GetOption"), &SqGetOption)
         .Func(_SC("GetOptionOr"), &SqGetOptionOr)
         .Func(_SC("SetOption"), &SqSetOption)
@@ -5,6 +5,7 @@
 #include "Core/Common.hpp"
 #include "Core/Entity.hpp"
 #include "Core/Script.hpp"
+#include "Core/TagIndex.hpp"
 
 // ------------------------------------------------------------------------------------------------
 #include <unordered_map>
@@ -61,6 +62,8 @@ public:
     typedef std::unordered_map< String, String >    Options; // List of custom options.
     // --------------------------------------------------------------------------------------------
     typedef std::array< ExtPluginCommand_t, 4 > ExtCommands; // 4 external command parsers should be enough.
+    // --------------------------------------------------------------------------------------------
+    typedef std::array< TagIndex, ENT_VEHICLE + 1 > EntityTags; // Active entities by tag, for each type.
 
 private:
 
@@ -75,6 +78,9 @@ private:
     Options                         m_Options; // Custom configuration options.
     ExtCommands                     m_ExtCommands; // External command parsers pointers.
 
+    // --------------------------------------------------------------------------------------------
+    EntityTags                      m_EntityTags; // Active entities by tag, for each type.
+
     // --------------------------------------------------------------------------------------------
     Blips                           m_Blips; // Blips pool.
     Checkpoints                     m_Checkpoints; // Checkpoints pool.
@@ -100,6 +106,7 @@ private:
 
     // --------------------------------------------------------------------------------------------
     bool                            m_AreasEnabled; // Whether area tracking is enabled.
+    bool                            m_AreasBatched; // Whether area tracking is deferred to the next frame.
     bool                            m_Debugging; // Enable debugging features, if any.
     bool                            m_Executed; // Whether the scripts were executed.
     bool                            m_Shutdown; // Whether the server currently shutting down.
@@ -107,8 +114,18 @@ private:
     bool                            m_LockPostLoadSignal; // Lock post load signal container.
     bool                            m_LockUnloadSignal; // Lock unload signal container.
     bool                            m_EmptyInit; // Whether to initialize without any scripts.
+    bool                            m_ClientDataView; // Whether client data is delivered as a read-only view.
     // --------------------------------------------------------------------------------------------
     int32_t                         m_Verbosity; // Restrict the amount of outputted information.
+    int64_t                         m_StateWindow; // How long captured entity state can be reused (microseconds).
+    String                          m_ScriptCache; // Directory where compiled scripts are cached.
+
+    // --------------------------------------------------------------------------------------------
+    std::vector< int32_t >          m_DirtyPlayers; // Players that moved since the last frame.
+    std::vector< int32_t >          m_DirtyVehicles; // Vehicles that moved since the last frame.
+    AreaList                        m_AreasFound; // Areas found at the position of an entity.
+    AreaList                        m_AreasLeft; // Areas that an entity just left.
+    AreaList                        m_AreasEntered; // Areas that an entity just entered.
 
     // --------------------------------------------------------------------------------------------
     LightObj                        m_ClientData; // Currently processed client data buffer.
@@ -211,6 +228,30 @@ public:
         return m_Debugging;
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the directory where compiled scripts are cached. Empty if caching is disabled.
+    */
+    SQMOD_NODISCARD const String & GetScriptCache() const
+    {
+        return m_ScriptCache;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * See whether client data is delivered as a read-only view over the received bytes.
+    */
+    SQMOD_NODISCARD bool IsClientDataView() const
+    {
+        return m_ClientDataView;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Toggle whether client data is delivered as a read-only view over the received bytes.
+    */
+    void SetClientDataView(bool toggle)
+    {
+        m_ClientDataView = toggle;
+    }
+
     /* --------------------------------------------------------------------------------------------
      * See whether all queued scripts were executed and the plug-in fully started.
     */
@@ -243,6 +284,54 @@ public:
         m_AreasEnabled = toggle;
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * See whether area tracking is deferred until the next server frame.
+    */
+    SQMOD_NODISCARD bool AreasBatched() const
+    {
+        return m_AreasBatched;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Toggle whether area tracking is deferred until the next server frame.
+    */
+    void AreasBatched(bool toggle)
+    {
+        m_AreasBatched = toggle;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve how long the entity state captured during updates can be reused (milliseconds).
+    */
+    SQMOD_NODISCARD SQInteger StateWindow() const
+    {
+        return static_cast< SQInteger >(m_StateWindow / 1000);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify how long the entity state captured during updates can be reused (milliseconds).
+     * Zero disables reuse and entity getters always query the server.
+    */
+    void StateWindow(SQInteger ms)
+    {
+        m_StateWindow = ms > 0 ? static_cast< int64_t >(ms) * 1000 : 0;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Obtain a time stamp for entity state captured now. Zero if reuse is disabled.
+    */
+    SQMOD_NODISCARD int64_t StateTime() const;
+
+    /* --------------------------------------------------------------------------------------------
+     * See whether entity state captured at the specified time can still be reused.
+    */
+    SQMOD_NODISCARD bool IsStateFresh(int64_t time) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Recompute the areas of entities that moved since the last frame and emit the changes.
+    */
+    void ProcessAreas();
+
     /* --------------------------------------------------------------------------------------------
      * Retrieve the value of the specified option.
     */
@@ -535,6 +624,11 @@ public:
     SQMOD_NODISCARD const Players & GetPlayers() const { return m_Players; }
     SQMOD_NODISCARD const Vehicles & GetVehicles() const { return m_Vehicles; }
 
+    /* --------------------------------------------------------------------------------------------
+     * Tag index retriever.
+    */
+    SQMOD_NODISCARD TagIndex & GetEntityTags(int32_t type) { return m_EntityTags[static_cast< size_t >(type)]; }
+
     /* --------------------------------------------------------------------------------------------
      * Null instance retrievers.
     */
@@ -598,7 +692,7 @@ public:
     void EmitVehicleCustom(int32_t vehicle, int32_t header, LightObj & payload);
     void EmitServerStartup() const;
     void EmitServerShutdown() const;
-    void EmitServerFrame(float elapsed_time) const;
+    void EmitServerFrame(float elapsed_time);
     void EmitPluginCommand(uint32_t command_identifier, const char * message);
     void EmitIncomingConnection(char * player_name, size_t name_buffer_size, const char * user_password, const char * ip_address);
     void EmitPlayerRequestClass(int32_t player_id, int32_t offset);
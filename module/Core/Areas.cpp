@@ -160,61 +160,14 @@ bool Area::IsInside(float x, float y) const
 }
 
 // ------------------------------------------------------------------------------------------------
-AreaManager::AreaManager(size_t sz) noexcept
-    : m_Queue(), m_ProcList(), m_Grid{}, m_Cells{}
+AreaManager::AreaManager() noexcept
+    : m_Queue(), m_ProcList(), m_Root(), m_Depth(DEF_DEPTH), m_Locks(0), m_Managed(0), m_Cells(1)
 {
-    // Negative half grid size (left)
-    int l = (-GRIDH * CELLD);
-    // Positive half grid size minus one cell (bottom)
-    int b = (abs(l) - CELLD);
-    // Negative half grid size minus one cell (right)
-    int r = (l + CELLD);
-    // Positive half grid size (top)
-    int t = abs(l);
-    // Row/Column of the grid
-    int row = 0, col = 0;
-    // Initialize the grid cells
-    for (auto & a : m_Grid)
-    {
-        // Reset the column
-        col = 0;
-        // Process row
-        for (auto & c : a)
-        {
-            auto & cx = m_Cells[row][col];
-            // Grab a reference to the cell
-            // Configure the range of the cell
-            c.mL = cx.mL = static_cast< float >(l);
-            c.mB = cx.mB = static_cast< float >(b);
-            c.mR = cx.mR = static_cast< float >(r);
-            c.mT = cx.mT = static_cast< float >(t);
-            // Reserve area memory if requested
-            c.mAreas.reserve(sz);
-            // Reset the locks on this area
-            c.mLocks = 0;
-            // Set the row and column
-            c.mRow = row;
-            c.mCol = col++;
-            // Advance the left side
-            l = r;
-            // Advance the right side
-            r += CELLD;
-            // Should we advance to the next row?
-            if (r > (GRIDH * CELLD))
-            {
-                // Reset the left side
-                l = (-GRIDH * CELLD);
-                // Reset the right side
-                r = (l + CELLD);
-                // Advance the bottom
-                b -= CELLD;
-                // Advance the top
-                t -= CELLD;
-            }
-        }
-        // Advance row
-        ++row;
-    }
+    // Configure the range of the root cell
+    m_Root.mL = -DEF_WORLD;
+    m_Root.mB = -DEF_WORLD;
+    m_Root.mR = DEF_WORLD;
+    m_Root.mT = DEF_WORLD;
     // Reserve some space in the queue
     m_Queue.reserve(128);
     m_ProcList.reserve(128);
@@ -234,6 +187,8 @@ void AreaManager::Insert(AreaCell & c, Area & a, LightObj & obj)
     }
     // Associate the area with this cell so it can't be managed again (even while in the queue)
     a.mCells.push_back(&c);
+    // Keep track of managed associations
+    ++m_Managed;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -263,6 +218,113 @@ void AreaManager::Remove(AreaCell & c, Area & a)
     if (itr != a.mCells.end())
     {
         a.mCells.erase(itr); // Dissociate them
+        // Keep track of managed associations
+        --m_Managed;
+    }
+    // Can we discard cells that no longer hold anything? (nothing may refer to them)
+    if (m_Locks <= 0 && m_Queue.empty() && c.IsVacant())
+    {
+        Prune(c);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AreaManager::Distribute(AreaCell & c, Area & a, LightObj & obj)
+{
+    // Does the area cover the whole cell or is this the smallest cell we can have?
+    if (c.mDepth >= m_Depth || (a.mL <= c.mL && a.mR >= c.mR && a.mB <= c.mB && a.mT >= c.mT))
+    {
+        Insert(c, a, obj); // Attempt to insert the area into this cell
+        return;
+    }
+    // Make sure the cell is subdivided
+    if (!c.HasChildren())
+    {
+        Subdivide(c);
+    }
+    // Go through each sub-cell and check if the area touches it
+    for (int i = 0; i < 4; ++i)
+    {
+        AreaCell & s = c.mChildren[i];
+        // Does the bounding box of this cell intersect with the one of the area?
+        if (a.mL <= s.mR && s.mL <= a.mR && a.mB <= s.mT && s.mB <= a.mT)
+        {
+            Distribute(s, a, obj);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AreaManager::Subdivide(AreaCell & c)
+{
+    // Find the center of the cell
+    const float x = (c.mL * 0.5f) + (c.mR * 0.5f);
+    const float y = (c.mB * 0.5f) + (c.mT * 0.5f);
+    // Allocate the sub-cells
+    c.mChildren = std::make_unique< AreaCell[] >(4);
+    // Configure the sub-cells
+    for (int i = 0; i < 4; ++i)
+    {
+        AreaCell & s = c.mChildren[i];
+        // Top row first, left column first
+        const bool bottom = (i & 2) != 0, right = (i & 1) != 0;
+        // Configure the range of the cell
+        s.mL = right ? x : c.mL;
+        s.mB = bottom ? c.mB : y;
+        s.mR = right ? c.mR : x;
+        s.mT = bottom ? y : c.mT;
+        // Set the location in the tree
+        s.mRow = (c.mRow * 2) + (bottom ? 1 : 0);
+        s.mCol = (c.mCol * 2) + (right ? 1 : 0);
+        s.mDepth = c.mDepth + 1;
+        s.mParent = &c;
+    }
+    // Keep track of allocated cells
+    m_Cells += 4;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AreaManager::Prune(AreaCell & c)
+{
+    // Walk upwards for as long as all sub-cells of a cell are vacant
+    for (AreaCell * p = c.mParent; p != nullptr; p = p->mParent)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            if (!p->mChildren[i].IsVacant())
+            {
+                return; // Sub-cells are still needed
+            }
+        }
+        // Discard the sub-cells
+        p->mChildren.reset();
+        // Keep track of allocated cells
+        m_Cells -= 4;
+        // Can the parent be discarded as well?
+        if (!p->mAreas.empty())
+        {
+            break;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AreaManager::Release(AreaCell & c)
+{
+    // Dissociate the areas from this cell
+    for (auto & p : c.mAreas)
+    {
+        p.first->mCells.clear();
+    }
+    // Release script references
+    c.mAreas.clear();
+    // Do the same for the sub-cells
+    if (c.HasChildren())
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            Release(c.mChildren[i]);
+        }
     }
 }
 
@@ -278,24 +340,34 @@ void AreaManager::ProcQueue()
             m_ProcList.push_back(itr);
         }
     }
-    // Process the actions that are ready
+    // Process the actions that are ready (areas were already associated/dissociated with the cells)
     for (auto & itr : m_ProcList)
     {
+        AreaCell & c = *(itr->mCell);
         // Was this a remove request?
         if (itr->mObj.IsNull())
         {
-            Remove(*(itr->mCell), *(itr->mArea));
+            // Attempt to locate this area in the cell
+            auto ap = std::find_if(c.mAreas.begin(), c.mAreas.end(),
+                [a = itr->mArea](AreaCell::Areas::reference p) -> bool {
+                    return (p.first == a);
+            });
+            // Have we found it?
+            if (ap != c.mAreas.end())
+            {
+                c.mAreas.erase(ap); // Erase it
+            }
         }
         else
         {
-            Insert(*(itr->mCell), *(itr->mArea), itr->mObj);
+            c.mAreas.emplace_back(itr->mArea, std::move(itr->mObj));
         }
     }
-    // Remove processed requests
-    for (auto & itr : m_ProcList)
-    {
-        m_Queue.erase(itr);
-    }
+    // Remove processed requests (erasing them one by one would invalidate the stored iterators)
+    m_Queue.erase(std::remove_if(m_Queue.begin(), m_Queue.end(),
+        [](Queue::reference e) -> bool {
+            return (e.mCell->mLocks <= 0);
+    }), m_Queue.end());
     // Actions were processed
     m_ProcList.clear();
 }
@@ -303,17 +375,27 @@ void AreaManager::ProcQueue()
 // ------------------------------------------------------------------------------------------------
 void AreaManager::Clear()
 {
-    // Clear the cells
-    for (AreaCell (&row)[GRIDN] : m_Grid)
+    // Dissociate the areas from the cells
+    Release(m_Root);
+    // Dissociate the queued areas as well
+    for (auto & e : m_Queue)
     {
-        for (AreaCell & c : row)
+        if (e.mArea != nullptr)
         {
-            c.mAreas.clear();
+            e.mArea->mCells.clear();
         }
     }
     // Clear the queue as well
     m_Queue.clear();
     m_ProcList.clear();
+    // Nothing is managed anymore
+    m_Managed = 0;
+    // Discard the sub-cells if nothing is currently iterating over them
+    if (m_Locks <= 0)
+    {
+        m_Root.mChildren.reset();
+        m_Cells = 1;
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -324,73 +406,69 @@ void AreaManager::InsertArea(Area & a, LightObj & obj)
     {
         return; // Already managed or nothing to manage
     }
-    // Go through each cell and check if the area touches it
-    for (auto & y : m_Grid)
+    // Does the area touch the managed world at all?
+    if (a.mL <= m_Root.mR && m_Root.mL <= a.mR && a.mB <= m_Root.mT && m_Root.mB <= a.mT)
     {
-        for (auto & c : y)
-        {
-            // Does the bounding box of this cell intersect with the one of the area?
-            if (a.mL <= c.mR && c.mL <= a.mR && a.mB <= c.mT && c.mB <= a.mT)
-            {
-                Insert(c, a, obj); // Attempt to insert the area into this cell
-            }
-        }
+        Distribute(m_Root, a, obj); // Insert the area into the cells it touches
     }
 }
 
 // ------------------------------------------------------------------------------------------------
 void AreaManager::RemoveArea(Area & a)
 {
-    // Just remove the associated cells
-    for (auto c : a.mCells)
+    // Just remove the associated cells (work on a copy since removal alters the list)
+    const Area::Cells cells(a.mCells);
+    // Remove the area from each cell
+    for (auto c : cells)
     {
         Remove(*c, a);
     }
 }
 
 // ------------------------------------------------------------------------------------------------
-Vector2i AreaManager::LocateCell(float x, float y)
+Vector2i AreaManager::LocateCell(float x, float y) const
 {
-    for (int r = 0; r < GRIDN; ++r)
+    // Check whether point is inside the managed world
+    if (m_Root.mL > x || m_Root.mR < x || m_Root.mB > y || m_Root.mT < y)
     {
-        for (int c = 0; c < GRIDN; ++c)
-        {
-            auto & bb = m_Cells[r][c];
-            // Check whether point is inside cell
-            if (bb.mL <= x && bb.mR >= x && bb.mB <= y && bb.mT >= y)
-            {
-                return {r, c}; // Is inside
-            }
-        }
+        return {NOCELL, NOCELL}; // Point is out of bounds
     }
-    // Point is out of bounds
-    return {NOCELL, NOCELL};
-/*
-    // Transform the world coordinates into a cell coordinates
-    // and cast to integral after rounding the value
-    int xc = static_cast< int >(std::round(x / CELLD));
-    int yc = static_cast< int >(std::round(y / CELLD));
-    // Grab the absolute cell coordinates for range checking
-    const int xca = std::abs(xc);
-    const int yca = std::abs(yc);
-    // Make sure the cell coordinates are within range
-    if (xca > (GRIDH+1) || yca > (GRIDH+1))
+    // Number of cells on each side of the grid at the maximum depth
+    const int n = 1 << m_Depth;
+    // Transform the world coordinates into cell coordinates
+    const auto r = static_cast< int >(((m_Root.mT - y) / (m_Root.mT - m_Root.mB)) * static_cast< float >(n));
+    const auto c = static_cast< int >(((x - m_Root.mL) / (m_Root.mR - m_Root.mL)) * static_cast< float >(n));
+    // Points on the right and bottom edges belong to the last cell
+    return {std::min(r, n - 1), std::min(c, n - 1)};
+}
+
+// ------------------------------------------------------------------------------------------------
+void AreaManager::Configure(float l, float b, float r, float t, int depth)
+{
+    // Are there any areas still managed?
+    if (m_Managed > 0 || !m_Queue.empty() || m_Locks > 0)
     {
-        return {NOCELL, NOCELL}; // Out of our scanning area
+        STHROWF("Cannot configure the area manager while areas are being managed");
     }
-    // Clamp the x coordinate if necessary
-    if (xca >= (GRIDH))
+    // Validate the world bounds
+    else if (!(l < r) || !(b < t))
     {
-        xc = xc < 0 ? -(GRIDH-1) : (GRIDH-1);
+        STHROWF("Invalid world bounds ({} : {} | {} : {})", l, b, r, t);
     }
-    // Clamp the y coordinate if necessary
-    if (yca >= (GRIDH))
+    // Validate the depth of the tree
+    else if (depth < 0 || depth > MAX_DEPTH)
     {
-        yc = xc < 0 ? -(GRIDH-1) : (GRIDH-1);
+        STHROWF("Tree depth ({}) is out of range [0, {}]", depth, MAX_DEPTH);
     }
-    // Return the identified cell row and column
-    return {GRIDH+xc, GRIDH-yc};
-*/
+    // Discard the current sub-cells
+    m_Root.mChildren.reset();
+    m_Cells = 1;
+    // Apply the new configuration
+    m_Root.mL = l;
+    m_Root.mB = b;
+    m_Root.mR = r;
+    m_Root.mT = t;
+    m_Depth = depth;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -440,6 +518,30 @@ static Vector2i Areas_LocatePointCellEx(float x, float y)
     return AreaManager::Get().LocateCell(x, y);
 }
 
+// ------------------------------------------------------------------------------------------------
+static void Areas_Configure(float l, float b, float r, float t, SQInteger depth)
+{
+    AreaManager::Get().Configure(l, b, r, t, ConvTo< int >::From(depth));
+}
+
+// ------------------------------------------------------------------------------------------------
+static Vector4 Areas_GetBounds()
+{
+    return AreaManager::Get().GetBounds();
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger Areas_GetDepth()
+{
+    return AreaManager::Get().GetDepth();
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger Areas_GetCellCount()
+{
+    return ConvTo< SQInteger >::From(AreaManager::Get().GetCellCount());
+}
+
 // ------------------------------------------------------------------------------------------------
 void TerminateAreas()
 {
@@ -505,6 +607,10 @@ void Register_Areas(HSQUIRRELVM vm)
         .StaticFunc(_SC("LocatePointCell"), &Areas_LocatePointCell)
         .StaticFunc(_SC("LocatePointCellEx"), &Areas_LocatePointCellEx)
         .StaticFunc(_SC("UnmanageAll"), &TerminateAreas)
+        .StaticFunc(_SC("Configure"), &Areas_Configure)
+        .StaticFunc(_SC("GetBounds"), &Areas_GetBounds)
+        .StaticFunc(_SC("GetDepth"), &Areas_GetDepth)
+        .StaticFunc(_SC("GetCellCount"), &Areas_GetCellCount)
     );
 }
 
@@ -8,6 +8,7 @@
 #include "Base/Vector2i.hpp"
 
 // ------------------------------------------------------------------------------------------------
+#include <memory>
 #include <vector>
 #include <utility>
 
@@ -15,7 +16,8 @@
 namespace SqMod {
 
 /* ------------------------------------------------------------------------------------------------
- * Various information associated with an area cell.
+ * Various information associated with an area cell. Cells form a quad-tree where each cell is
+ * subdivided on demand into four equal sub-cells until the configured depth is reached.
 */
 struct AreaCell
 {
@@ -29,24 +31,53 @@ struct AreaCell
     Areas   mAreas; // Areas that intersect with the cell.
     // --------------------------------------------------------------------------------------------
     int     mLocks; // The amount of locks on the cell.
-    int     mRow; // Row location in the grid.
-    int     mCol; // Column location in the grid.
+    int     mRow; // Row location in the grid at this depth.
+    int     mCol; // Column location in the grid at this depth.
+    int     mDepth; // Depth of the cell in the tree. Zero for the root cell.
+    // --------------------------------------------------------------------------------------------
+    AreaCell *                      mParent; // The cell that was subdivided to create this cell.
+    std::unique_ptr< AreaCell[] >   mChildren; // Sub-cells (top-left, top-right, bottom-left, bottom-right).
 
     /* --------------------------------------------------------------------------------------------
      * Default constructor.
     */
     AreaCell()
-        : mL(0), mB(0), mR(0), mT(0), mAreas(0), mLocks(0), mRow(0), mCol(0)
+        : mL(0), mB(0), mR(0), mT(0), mAreas(0), mLocks(0), mRow(0), mCol(0), mDepth(0)
+        , mParent(nullptr), mChildren()
     {
         //...
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Check whether the cell was subdivided.
+    */
+    SQMOD_NODISCARD bool HasChildren() const
+    {
+        return static_cast< bool >(mChildren);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Check whether the cell can be discarded. (no areas, no sub-cells and no locks)
+    */
+    SQMOD_NODISCARD bool IsVacant() const
+    {
+        return mAreas.empty() && !mChildren && mLocks <= 0;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the sub-cell that contains the specified point. Cell must have children!
+    */
+    SQMOD_NODISCARD AreaCell & ChildAt(float x, float y) const
+    {
+        return mChildren[(y < (mB * 0.5f) + (mT * 0.5f) ? 2 : 0) + (x < (mL * 0.5f) + (mR * 0.5f) ? 0 : 1)];
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Show information (mainly for debug purposes).
     */
     String Dump()
     {
-        return fmt::format("({} : {} | {} : {}) {} : {}", mL, mB, mR, mT, mRow, mCol);
+        return fmt::format("({} : {} | {} : {}) {} : {} @ {}", mL, mB, mR, mT, mRow, mCol, mDepth);
     }
 };
 
@@ -503,9 +534,9 @@ class AreaManager
     static AreaManager s_Inst; // Manager instance.
 
     /* --------------------------------------------------------------------------------------------
-     * Base constructor.
+     * Default constructor.
     */
-    explicit AreaManager(size_t sz = 16) noexcept;
+    AreaManager() noexcept;
 
 protected:
 
@@ -522,6 +553,7 @@ protected:
             : mCell(cell)
         {
             ++(cell.mLocks); // Place a lock on the cell to prevent iterator invalidation
+            ++(AreaManager::Get().m_Locks); // Prevent the tree from being restructured
         }
         /* ----------------------------------------------------------------------------------------
          * Destructor.
@@ -530,17 +562,16 @@ protected:
         {
             // Remove the lock from the cell so it can be processed
             --(mCell.mLocks);
+            --(AreaManager::Get().m_Locks);
             // Process requested actions during the lock
             AreaManager::Get().ProcQueue();
         }
     };
 
     // --------------------------------------------------------------------------------------------
-    static constexpr int GRIDN = 16; // Number of horizontal and vertical number of cells.
-    static constexpr int GRIDH = GRIDN/2; // Half of the grid horizontal and vertical size.
-    static constexpr int CELLS = GRIDN*GRIDN; // Total number of cells in the grid.
-    static constexpr int CELLH = CELLS/2; // Half total number of cells in the grid.
-    static constexpr int CELLD = 256; // Area covered by a cell in the world.
+    static constexpr float DEF_WORLD = 2048.0f; // Default half size of the managed world.
+    static constexpr int DEF_DEPTH = 6; // Default maximum depth of the tree.
+    static constexpr int MAX_DEPTH = 16; // Maximum depth that can be configured.
     static constexpr int NOCELL = std::numeric_limits< int >::max(); // Inexistent cell index.
 
     /* --------------------------------------------------------------------------------------------
@@ -624,17 +655,39 @@ protected:
     */
     void Remove(AreaCell & c, Area & a);
 
+    /* --------------------------------------------------------------------------------------------
+     * Descend the tree and insert the area into the smallest cells that it intersects.
+    */
+    void Distribute(AreaCell & c, Area & a, LightObj & obj);
+
+    /* --------------------------------------------------------------------------------------------
+     * Create the sub-cells of the specified cell.
+    */
+    void Subdivide(AreaCell & c);
+
+    /* --------------------------------------------------------------------------------------------
+     * Discard the sub-cells that no longer hold anything, starting from the parent of a cell.
+    */
+    void Prune(AreaCell & c);
+
+    /* --------------------------------------------------------------------------------------------
+     * Dissociate all areas from the specified cell and its sub-cells.
+    */
+    static void Release(AreaCell & c);
+
 private:
 
     // --------------------------------------------------------------------------------------------
     Queue       m_Queue; // Actions currently queued.
     ProcList    m_ProcList; // Actions ready to be completed.
     // --------------------------------------------------------------------------------------------
-    AreaCell    m_Grid[GRIDN][GRIDN]; // A grid of area lists.
+    AreaCell    m_Root; // The cell that covers the whole managed world.
     // --------------------------------------------------------------------------------------------
-    struct {
-        float   mL, mB, mR, mT;
-    } m_Cells[GRIDN][GRIDN];
+    int         m_Depth; // Maximum depth at which cells are subdivided.
+    int         m_Locks; // Number of cells currently locked.
+    size_t      m_Managed; // Number of area to cell associations.
+    size_t      m_Cells; // Number of allocated cells.
+
 public:
 
     /* --------------------------------------------------------------------------------------------
@@ -686,37 +739,66 @@ public:
     void RemoveArea(Area & a);
 
     /* --------------------------------------------------------------------------------------------
-     * Clear all cell lists and release any script references.
+     * Locate the cell at the maximum depth of the tree which contains the given point.
+    */
+    SQMOD_NODISCARD Vector2i LocateCell(float x, float y) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Change the world bounds and the maximum depth of the tree. Only while no areas are managed.
     */
-    Vector2i LocateCell(float x, float y);
+    void Configure(float l, float b, float r, float t, int depth);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the world bounds covered by the tree.
+    */
+    SQMOD_NODISCARD Vector4 GetBounds() const
+    {
+        return {m_Root.mL, m_Root.mB, m_Root.mR, m_Root.mT};
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the maximum depth of the tree.
+    */
+    SQMOD_NODISCARD int GetDepth() const
+    {
+        return m_Depth;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of allocated cells.
+    */
+    SQMOD_NODISCARD size_t GetCellCount() const
+    {
+        return m_Cells;
+    }
 
     /* --------------------------------------------------------------------------------------------
      * Test a point to see whether it intersects with any areas
     */
     template < typename F > void TestPoint(F && f, float x, float y)
     {
-        // Transform the world coordinates into a cell coordinates
-        const Vector2i cc(LocateCell(x, y));
-        // Were these coordinates valid?
-        if (cc.x == NOCELL)
+        // Is this point within the managed world?
+        if (m_Root.mL > x || m_Root.mR < x || m_Root.mB > y || m_Root.mT < y)
         {
             return; // Not our problem
         }
-        // Retrieve a reference to the identified cell
-        AreaCell & c = m_Grid[cc.x][cc.y];
-        // Is this cell empty?
-        if (c.mAreas.empty())
-        {
-            return; // Nothing to test
-        }
-        // Guard the cell while processing
-        const CellGuard cg(c);
-        // Finally, begin processing the areas in this cell
-        for (auto & a : c.mAreas)
+        // Walk the cells that contain this point, from the root down to the smallest one
+        for (AreaCell * c = &m_Root; c != nullptr; c = c->HasChildren() ? &(c->ChildAt(x, y)) : nullptr)
         {
-            if (a.first->TestEx(x, y))
+            // Is this cell empty?
+            if (c->mAreas.empty())
+            {
+                continue; // Nothing to test
+            }
+            // Guard the cell while processing
+            const CellGuard cg(*c);
+            // Finally, begin processing the areas in this cell
+            for (auto & a : c->mAreas)
             {
-                f(a);
+                if (a.first->TestEx(x, y))
+                {
+                    f(a);
+                }
             }
         }
     }
@@ -21,6 +21,53 @@ SQMOD_NODISCARD inline unsigned int NextPow2(unsigned int num)
     return ++num;
 }
 
+/* ------------------------------------------------------------------------------------------------
+ * Compute the base two logarithm of the specified number, rounded down.
+*/
+SQMOD_NODISCARD inline unsigned int FloorLog2(unsigned int num)
+{
+    unsigned int r = 0;
+    while (num >>= 1u) ++r;
+    return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+static constexpr unsigned int POOL_MIN_CLASS = 3; // Smallest pooled block. (8 bytes)
+static constexpr unsigned int POOL_MAX_CLASS = 20; // Largest pooled block. (1 MiB)
+static constexpr unsigned int POOL_CLASS_LIMIT = 64; // Maximum number of blocks kept per size class.
+static constexpr size_t POOL_BYTES_LIMIT = 8 * 1024 * 1024; // Maximum number of bytes kept per thread.
+
+/* ------------------------------------------------------------------------------------------------
+ * Per-thread free lists of buffer memory, indexed by the base two logarithm of the block size.
+ * Free blocks are linked through their first bytes so the state itself is trivially destructible.
+*/
+struct BufferPool
+{
+    Buffer::Pointer     mHead[POOL_MAX_CLASS + 1]; // First free block of each size class.
+    unsigned int        mCount[POOL_MAX_CLASS + 1]; // Number of free blocks in each size class.
+    size_t              mBytes; // Total number of bytes kept by this pool.
+    bool                mClosed; // Whether the owning thread is exiting.
+};
+
+// ------------------------------------------------------------------------------------------------
+static thread_local BufferPool s_BufferPool{};
+
+/* ------------------------------------------------------------------------------------------------
+ * Releases the pooled memory when the owning thread exits and stops further pooling after that.
+*/
+struct BufferPoolGuard
+{
+    ~BufferPoolGuard()
+    {
+        Buffer::TrimPool();
+        // Anything released from now on goes straight back to the system
+        s_BufferPool.mClosed = true;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+static thread_local BufferPoolGuard s_BufferPoolGuard{};
+
 // ------------------------------------------------------------------------------------------------
 Buffer::Buffer(const Buffer & o)
     : m_Ptr(nullptr), m_Cap(o.m_Cap), m_Cur(o.m_Cur)
@@ -84,14 +131,20 @@ Buffer & Buffer::operator = (const Buffer & o) // NOLINT(cert-oop54-cpp)
 // ------------------------------------------------------------------------------------------------
 void Buffer::Grow(SzType n)
 {
-    // Backup the current memory
-    Buffer bkp(m_Ptr, m_Cap, m_Cur);
+    // Grow geometrically so that repeated appends are amortized
+    SzType cap = (m_Cap < 0x80000000u && m_Cap * 2 > m_Cap + n) ? m_Cap * 2 : m_Cap + n;
     // Acquire a bigger buffer
-    Request(bkp.m_Cap + n);
+    Pointer ptr = Acquire(cap);
     // Copy the data from the old buffer
-    std::memcpy(m_Ptr, bkp.m_Ptr, bkp.m_Cap);
-    // Copy the previous edit cursor
-    m_Cur = bkp.m_Cur;
+    if (m_Ptr)
+    {
+        std::memcpy(ptr, m_Ptr, m_Cap);
+        // Give the old buffer back to the pool
+        Recycle(m_Ptr, m_Cap);
+    }
+    // Use the new buffer and keep the previous edit cursor
+    m_Ptr = ptr;
+    m_Cap = cap;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -99,12 +152,16 @@ void Buffer::Request(SzType n)
 {
     // NOTE: Function assumes (n > 0)
     assert(n > 0);
-    // Round up the size to a power of two number
-    n = (n & (n - 1)) ? NextPow2(n) : n;
     // Release previous memory if any
-    delete[] m_Ptr; // Implicitly handles null!
+    if (m_Ptr)
+    {
+        Recycle(m_Ptr, m_Cap);
+        // In case the allocation fails
+        m_Ptr = nullptr;
+        m_Cap = 0;
+    }
     // Attempt to allocate memory
-    m_Ptr = new Value[n];
+    m_Ptr = Acquire(n);
     // If no errors occurred then we can set the size
     m_Cap = n;
 }
@@ -112,14 +169,96 @@ void Buffer::Request(SzType n)
 // ------------------------------------------------------------------------------------------------
 void Buffer::Release()
 {
-    // Deallocate the memory
-    delete[] m_Ptr; // Implicitly handles null!
+    // Give the memory back to the pool
+    if (m_Ptr)
+    {
+        Recycle(m_Ptr, m_Cap);
+    }
     // Explicitly reset the buffer
     m_Ptr = nullptr;
     m_Cap = 0;
     m_Cur = 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+Buffer::Pointer Buffer::Acquire(SzType & n)
+{
+    // Round up the size to a power of two number
+    n = (n & (n - 1)) ? NextPow2(n) : n;
+    // Don't bother with very small blocks
+    if (n < (1u << POOL_MIN_CLASS))
+    {
+        n = (1u << POOL_MIN_CLASS);
+    }
+    // Identify the size class
+    const unsigned int c = FloorLog2(n);
+    // Make sure the pool is released when this thread exits
+    static_cast< void >(s_BufferPoolGuard);
+    // Is there a free block of this size?
+    if (c <= POOL_MAX_CLASS && s_BufferPool.mHead[c] != nullptr)
+    {
+        Pointer ptr = s_BufferPool.mHead[c];
+        // Unlink the block from the free list
+        std::memcpy(&s_BufferPool.mHead[c], ptr, sizeof(Pointer));
+        // Update the pool statistics
+        --s_BufferPool.mCount[c];
+        s_BufferPool.mBytes -= n;
+        // Reuse this block
+        return ptr;
+    }
+    // Allocate a new block
+    return new Value[n];
+}
+
+// ------------------------------------------------------------------------------------------------
+void Buffer::Recycle(Pointer ptr, SzType n) noexcept
+{
+    // Blocks may be larger than the specified capacity but never smaller
+    const unsigned int c = n ? FloorLog2(n) : 0;
+    // Can this block be kept?
+    if (c < POOL_MIN_CLASS || c > POOL_MAX_CLASS || s_BufferPool.mClosed ||
+        s_BufferPool.mCount[c] >= POOL_CLASS_LIMIT || s_BufferPool.mBytes + (1u << c) > POOL_BYTES_LIMIT)
+    {
+        delete[] ptr;
+        // Nothing else to do
+        return;
+    }
+    // Make sure the pool is released when this thread exits (may never have acquired anything)
+    static_cast< void >(s_BufferPoolGuard);
+    // Link the block into the free list
+    std::memcpy(ptr, &s_BufferPool.mHead[c], sizeof(Pointer));
+    s_BufferPool.mHead[c] = ptr;
+    // Update the pool statistics
+    ++s_BufferPool.mCount[c];
+    s_BufferPool.mBytes += (1u << c);
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t Buffer::PoolBytes() noexcept
+{
+    return s_BufferPool.mBytes;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Buffer::TrimPool() noexcept
+{
+    for (unsigned int c = POOL_MIN_CLASS; c <= POOL_MAX_CLASS; ++c)
+    {
+        // Release every block of this size class
+        while (s_BufferPool.mHead[c] != nullptr)
+        {
+            Pointer ptr = s_BufferPool.mHead[c];
+            // Unlink the block from the free list
+            std::memcpy(&s_BufferPool.mHead[c], ptr, sizeof(Pointer));
+            // Release the memory
+            delete[] ptr;
+        }
+        s_BufferPool.mCount[c] = 0;
+    }
+    // The pool is now empty
+    s_BufferPool.mBytes = 0;
+}
+
 // ------------------------------------------------------------------------------------------------
 Buffer::SzType Buffer::Write(SzType pos, ConstPtr data, SzType size)
 {
@@ -129,10 +268,10 @@ Buffer::SzType Buffer::Write(SzType pos, ConstPtr data, SzType size)
         return 0;
     }
     // See if the buffer size must be adjusted
-    else if ((pos + size) >= m_Cap)
+    else if ((pos + size) > m_Cap)
     {
         // Acquire a larger buffer
-        Grow((pos + size) - m_Cap + 32);
+        Grow((pos + size) - m_Cap);
     }
     // Copy the data into the internal buffer
     std::memcpy(m_Ptr + pos, data, size);
@@ -168,15 +307,17 @@ Buffer::SzType Buffer::WriteF(SzType pos, const char * fmt, va_list args)
     va_copy(args_cpy, args);
     // Attempt to write to the current buffer
     // (if empty, it should tell us the necessary size)
-    int ret =  std::vsnprintf(m_Ptr + pos, m_Cap, fmt, args);
+    int ret =  std::vsnprintf(m_Ptr + pos, m_Cap - pos, fmt, args);
     // Do we need a bigger buffer?
-    if ((pos + ret) >= m_Cap)
+    if (ret >= 0 && (pos + ret) >= m_Cap)
     {
-        // Acquire a larger buffer
-        Grow((pos + ret) - m_Cap + 32);
+        // Acquire a larger buffer (including the null terminator)
+        Grow((pos + ret) - m_Cap + 1);
         // Retry writing the requested information
-        ret =  std::vsnprintf(m_Ptr + pos, m_Cap, fmt, args_cpy);
+        ret =  std::vsnprintf(m_Ptr + pos, m_Cap - pos, fmt, args_cpy);
     }
+    // Finalize the backup of the variable argument list
+    va_end(args_cpy);
     // Return the value 0 if data could not be written
     if (ret < 0)
     {
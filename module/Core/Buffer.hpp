@@ -479,7 +479,7 @@ public:
         // Do we need to scale the buffer?
         if ((m_Cur + (n * sizeof(T))) > m_Cap)
         {
-            Grow(m_Cur + (n * sizeof(T)));
+            Grow((m_Cur + (n * sizeof(T))) - m_Cap);
         }
         // Advance to the specified position
         m_Cur += (n * sizeof(T));
@@ -510,7 +510,7 @@ public:
         // Do we need to scale the buffer?
         if ((n * sizeof(T)) > m_Cap)
         {
-            Grow(n * sizeof(T));
+            Grow((n * sizeof(T)) - m_Cap);
         }
         // Move to the specified position
         m_Cur = (n * sizeof(T));
@@ -524,7 +524,7 @@ public:
         // Do we need to scale the buffer?
         if ((m_Cur + sizeof(T)) > m_Cap)
         {
-            Grow(m_Cap + sizeof(T));
+            Grow((m_Cur + sizeof(T)) - m_Cap);
         }
         // Assign the specified value
         *reinterpret_cast< T * >(m_Ptr + m_Cur) = v;
@@ -691,7 +691,8 @@ public:
     }
 
     /* --------------------------------------------------------------------------------------------
-     * Grow the size of the internal buffer by the specified amount of bytes.
+     * Grow the size of the internal buffer by at least the specified amount of bytes.
+     * The capacity is at least doubled so that repeated appends are amortized.
     */
     void Grow(SzType n);
 
@@ -869,6 +870,28 @@ public:
         return ptr;
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Obtain a block of at least the specified size from the pool of the calling thread.
+     * The size is rounded up to the actual size of the block. Can be released with delete [].
+    */
+    SQMOD_NODISCARD static Pointer Acquire(SzType & n);
+
+    /* --------------------------------------------------------------------------------------------
+     * Give a block of at least the specified size back to the pool of the calling thread.
+     * The block must have been allocated with new [] but not necessarily obtained from the pool.
+    */
+    static void Recycle(Pointer ptr, SzType n) noexcept;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of bytes kept by the pool of the calling thread.
+    */
+    SQMOD_NODISCARD static size_t PoolBytes() noexcept;
+
+    /* --------------------------------------------------------------------------------------------
+     * Release all the memory kept by the pool of the calling thread.
+    */
+    static void TrimPool() noexcept;
+
 protected:
 
     /* --------------------------------------------------------------------------------------------
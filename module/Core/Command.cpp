@@ -22,7 +22,7 @@ SQMOD_DECL_TYPENAME(ListenerTypename, _SC("SqCmdListener"))
 Guard::Guard(CtrRef ctr, Object & invoker)
     : mController(std::move(ctr))
     , mPrevious(mController->m_Context)
-    , mCurrent(new Context(invoker))
+    , mCurrent(mController->AcquireCtx(invoker))
 {
     mController->m_Context = mCurrent;
 }
@@ -31,6 +31,7 @@ Guard::Guard(CtrRef ctr, Object & invoker)
 Guard::~Guard()
 {
     mController->m_Context = mPrevious;
+    mController->ReleaseCtx(mCurrent);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -154,18 +155,18 @@ Object & Controller::Attach(Object && obj, Listener * ptr)
     // Obtain the unique identifier of the specified name
     const std::size_t hash = std::hash< String >()(name);
     // Make sure the command doesn't already exist
-    for (const auto & cmd : m_Commands)
+    auto itr = m_Index.find(hash);
+    if (itr != m_Index.end())
     {
-        // Are the hashes identical?
-        if (cmd.mHash == hash)
-        {
-            // Include information necessary to help identify hash collisions!
-            STHROWF("Command '{}' already exists as '{}' for hash ({})",
-                        name.c_str(), cmd.mName.c_str(), hash);
-        }
+        // Include information necessary to help identify hash collisions!
+        STHROWF("Command '{}' already exists as '{}' for hash ({})",
+                    name.c_str(), m_Commands[itr->second].mName.c_str(), hash);
     }
     // Attempt to insert the command
     m_Commands.emplace_back(hash, name, ptr, std::move(obj), m_Manager->GetCtr());
+    // Remember where it was inserted
+    m_Index.emplace(hash, m_Commands.size() - 1);
+    m_Unsorted = true;
     // Return the script object of the listener
     return m_Commands.back().mObj;
 }
@@ -211,18 +212,18 @@ Object & Controller::Attach(Object && obj, Listener * ptr, String name)
     // Obtain the unique identifier of the specified name
     const std::size_t hash = std::hash< String >()(name);
     // Make sure the command doesn't already exist
-    for (const auto & cmd : m_Commands)
+    auto itr = m_Index.find(hash);
+    if (itr != m_Index.end())
     {
-        // Are the hashes identical?
-        if (cmd.mHash == hash)
-        {
-            // Include information necessary to help identify hash collisions!
-            STHROWF("Command '{}' already exists as '{}' for hash ({})",
-                        name.c_str(), cmd.mName.c_str(), hash);
-        }
+        // Include information necessary to help identify hash collisions!
+        STHROWF("Command '{}' already exists as '{}' for hash ({})",
+                    name.c_str(), m_Commands[itr->second].mName.c_str(), hash);
     }
     // Attempt to insert the command
     m_Commands.emplace_back(hash, std::move(name), ptr, std::move(obj), m_Manager->GetCtr());
+    // Remember where it was inserted
+    m_Index.emplace(hash, m_Commands.size() - 1);
+    m_Unsorted = true;
     // Return the script object of the listener
     return m_Commands.back().mObj;
 }
@@ -258,6 +259,135 @@ Object Manager::Create(StackStrF & name, StackStrF & spec, Array & tags, uint8_t
     return o;
 }
 
+// ------------------------------------------------------------------------------------------------
+CtxRef Controller::AcquireCtx(Object & invoker)
+{
+    // Is there a context that we can reuse?
+    if (m_Spare)
+    {
+        CtxRef ctx(std::move(m_Spare));
+        // Prepare it for the new invoker
+        ctx->Reset(invoker);
+        // Hand it over
+        return ctx;
+    }
+    // Allocate a new one (only happens on first use or nested executions)
+    return CtxRef(new Context(invoker));
+}
+
+// ------------------------------------------------------------------------------------------------
+void Controller::ReleaseCtx(CtxRef & ctx)
+{
+    // Don't keep script objects alive longer than needed
+    ctx->Release();
+    // Keep it for the next execution
+    m_Spare = ctx;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Controller::SortNames()
+{
+    // Is there anything to sort?
+    if (!m_Unsorted)
+    {
+        return;
+    }
+    m_Names.clear();
+    m_Names.reserve(m_Commands.size());
+    // Collect the names of the commands
+    for (const auto & cmd : m_Commands)
+    {
+        m_Names.push_back(cmd.mName);
+    }
+    // Sort them so that names with the same prefix are next to each other
+    std::sort(m_Names.begin(), m_Names.end());
+    // Names are now sorted
+    m_Unsorted = false;
+}
+
+// ------------------------------------------------------------------------------------------------
+Array Controller::Complete(const SQChar * prefix, size_t len, SQInteger limit)
+{
+    // Make sure the names are sorted
+    SortNames();
+    // Allocate an empty array
+    Array arr(SqVM());
+    // Use an empty prefix if none was specified
+    const std::string_view pfx(prefix ? prefix : _SC(""), prefix ? len : 0);
+    // Names that begin with the prefix are all stored after it
+    auto itr = std::lower_bound(m_Names.cbegin(), m_Names.cend(), pfx,
+                                [](const String & a, std::string_view b) { return a < b; });
+    // Collect the names that begin with the prefix
+    for (; itr != m_Names.cend() && limit != 0; ++itr, --limit)
+    {
+        // Did we move past the names that begin with the prefix?
+        if (itr->compare(0, pfx.size(), pfx) != 0)
+        {
+            break;
+        }
+        arr.Append(*itr);
+    }
+    // Return the resulted array
+    return arr;
+}
+
+// ------------------------------------------------------------------------------------------------
+LightObj Controller::Suggest(const SQChar * name, size_t len)
+{
+    // Is there anything to compare?
+    if (!name || len == 0)
+    {
+        return LightObj{};
+    }
+    // Allow roughly one mistake for every three characters
+    const size_t limit = std::max< size_t >(1, len / 3);
+    // Rows of the edit distance matrix
+    std::vector< size_t > prev(len + 1), curr(len + 1);
+    // The closest name so far
+    const String * best = nullptr;
+    size_t best_dist = limit + 1;
+    // Look at every command name
+    for (const auto & cmd : m_Commands)
+    {
+        const String & str = cmd.mName;
+        // Names with too many extra or missing characters can't be close enough
+        if ((str.size() > len ? str.size() - len : len - str.size()) >= best_dist)
+        {
+            continue;
+        }
+        // Compute the edit distance one row at a time
+        for (size_t j = 0; j <= len; ++j)
+        {
+            prev[j] = j;
+        }
+        size_t row_min = 0;
+        for (size_t i = 1; i <= str.size(); ++i)
+        {
+            curr[0] = row_min = i;
+            for (size_t j = 1; j <= len; ++j)
+            {
+                const size_t cost = (str[i - 1] == name[j - 1]) ? 0 : 1;
+                curr[j] = std::min({prev[j] + 1, curr[j - 1] + 1, prev[j - 1] + cost});
+                row_min = std::min(row_min, curr[j]);
+            }
+            // Stop early if this name can't beat the closest one
+            if (row_min >= best_dist)
+            {
+                break;
+            }
+            std::swap(prev, curr);
+        }
+        // Is this closer than anything found so far?
+        if (row_min < best_dist && prev[len] < best_dist)
+        {
+            best = &str;
+            best_dist = prev[len];
+        }
+    }
+    // Return the closest name, if any
+    return best ? LightObj(SqInPlace{}, SqVM(), *best) : LightObj{};
+}
+
 // ------------------------------------------------------------------------------------------------
 int32_t Controller::Run(const Guard & guard, const char * command)
 {
@@ -272,7 +402,7 @@ int32_t Controller::Run(const Guard & guard, const char * command)
     // Grab a direct reference to the context instance
     Context & ctx = *(guard.mCurrent);
     // Skip white-space until the command name
-    while (std::isspace(*command))
+    while (IsCmdSpace(*command))
     {
         ++command;
     }
@@ -287,7 +417,7 @@ int32_t Controller::Run(const Guard & guard, const char * command)
     // Where the name ends and argument begins
     const char * split = command;
     // Find where the command name ends
-    while (*split != '\0' && !std::isspace(*split))
+    while (*split != '\0' && !IsCmdSpace(*split))
     {
         ++split;
     }
@@ -297,7 +427,7 @@ int32_t Controller::Run(const Guard & guard, const char * command)
         // Save the command name
         ctx.mCommand.assign(command, (split - command));
         // Skip white space after command name
-        while (std::isspace(*split))
+        while (IsCmdSpace(*split))
         {
             ++split;
         }
@@ -625,7 +755,7 @@ bool Controller::Parse(Context & ctx)
             // Remember the current stack size
             const StackGuard sg;
             // Skip white-space characters
-            itr = std::find_if(itr, ctx.mArgument.cend(), IsNotCType(std::isspace));
+            itr = std::find_if_not(itr, ctx.mArgument.cend(), IsCmdSpace);
             // Anything left to copy to the argument?
             if (itr != ctx.mArgument.end())
             {
@@ -746,10 +876,10 @@ bool Controller::Parse(Context & ctx)
             arg_flags = ctx.mInstance->m_ArgSpec[++ctx.mArgc];
         }
         // Ignore white-space characters until another valid character is found
-        else if (!std::isspace(elem) && (std::isspace(prev) || prev == '\0'))
+        else if (!IsCmdSpace(elem) && (IsCmdSpace(prev) || prev == '\0'))
         {
             // Find the first space character that marks the end of the argument
-            String::const_iterator pos = std::find_if(itr, ctx.mArgument.cend(), IsCType(std::isspace));
+            String::const_iterator pos = std::find_if(itr, ctx.mArgument.cend(), IsCmdSpace);
             // Obtain both ends of the argument string
             const char * str = &(*itr), * end = &(*pos);
             // Compute the argument string size
@@ -1178,6 +1308,9 @@ void Register(HSQUIRRELVM vm)
         .Func(_SC("Clear"), &Manager::Clear)
         .Func(_SC("Attach"), &Manager::Attach)
         .FmtFunc(_SC("FindByName"), &Manager::FindByName)
+        .FmtFunc(_SC("Complete"), &Manager::Complete)
+        .FmtFunc(_SC("CompleteLimit"), &Manager::CompleteLimit)
+        .FmtFunc(_SC("Suggest"), &Manager::Suggest)
         .CbFunc(_SC("BindFail"), &Manager::SetOnFail)
         .CbFunc(_SC("BindAuth"), &Manager::SetOnAuth)
         .Func(_SC("GetArray"), &Manager::GetCommandsArray)
@@ -11,6 +11,7 @@
 #include <cstring>
 #include <map>
 #include <vector>
+#include <unordered_map>
 #include <iterator>
 #include <algorithm>
 
@@ -48,6 +49,10 @@ typedef std::vector< Argument >     Arguments; // A list of extracted arguments.
 typedef std::vector< Command >      Commands; // List of attached command instances.
 typedef std::vector< Controller * > Controllers; // List of active controllers.
 
+// ------------------------------------------------------------------------------------------------
+typedef std::unordered_map< std::size_t, size_t >   CommandIndex; // Position of commands by name hash.
+typedef std::vector< String >                       CommandNames; // Command names in ascending order.
+
 /* ------------------------------------------------------------------------------------------------
  * Types of arguments supported by the command system.
 */
@@ -104,6 +109,13 @@ enum CmdError
     CMDERR_MAX
 };
 
+// ------------------------------------------------------------------------------------------------
+inline bool IsCmdSpace(SQChar c)
+{
+    // Same set of characters as `std::isspace` in the "C" locale, without the locale lookup
+    return (c == ' ') || (c >= '\t' && c <= '\r');
+}
+
 // ------------------------------------------------------------------------------------------------
 inline const SQChar * ValidateName(const SQChar * name)
 {
@@ -118,7 +130,7 @@ inline const SQChar * ValidateName(const SQChar * name)
     while ('\0' != *str)
     {
         // Does it contain spaces?
-        if (std::isspace(*str) != 0)
+        if (IsCmdSpace(*str))
         {
             STHROWF("Command names cannot contain spaces");
         }
@@ -157,7 +169,7 @@ public:
     Buffer          mBuffer; // Shared buffer used to extract arguments and process data.
 
     // --------------------------------------------------------------------------------------------
-    const Object    mInvoker; // Reference to the entity that invoked the command.
+    Object          mInvoker; // Reference to the entity that invoked the command.
     String          mCommand; // Command name extracted from the command string.
     String          mArgument; // Command argument extracted from the command string.
     Listener*       mInstance; // Pointer to the currently executed command listener.
@@ -183,6 +195,31 @@ public:
         // Reserve enough space upfront
         mCommand.reserve(64);
         mArgument.reserve(512);
+        mArgv.reserve(SQMOD_MAX_CMD_ARGS);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Prepare the context to be used again by a different invoker. Memory is kept for reuse.
+    */
+    void Reset(const Object & invoker)
+    {
+        mInvoker = invoker;
+        mCommand.clear();
+        mArgument.clear();
+        mInstance = nullptr;
+        mObject.Release();
+        mArgv.clear();
+        mArgc = 0;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Release script objects referenced by the context. Memory is kept for reuse.
+    */
+    void Release()
+    {
+        mInvoker.Release();
+        mObject.Release();
+        mArgv.clear();
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -346,7 +383,11 @@ private:
 
     // --------------------------------------------------------------------------------------------
     Commands        m_Commands; // List of available command instances.
+    CommandIndex    m_Index; // Position of each command by name hash.
+    CommandNames    m_Names; // Command names in ascending order. (built on demand)
+    bool            m_Unsorted; // Whether the command names must be rebuilt.
     CtxRef          m_Context; // Context of the currently executed command.
+    CtxRef          m_Spare; // Previously used context kept for reuse.
 
     // --------------------------------------------------------------------------------------------
     Function        m_OnFail; // Callback when something failed while running a command.
@@ -365,7 +406,11 @@ protected:
     */
     explicit Controller(Manager * mgr)
         : m_Commands()
+        , m_Index()
+        , m_Names()
+        , m_Unsorted(false)
         , m_Context()
+        , m_Spare()
         , m_OnFail()
         , m_OnAuth()
         , m_Manager(mgr)
@@ -402,6 +447,36 @@ protected:
         }
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Obtain an execution context for the specified invoker. Reuses the spare context, if any.
+    */
+    CtxRef AcquireCtx(Object & invoker);
+
+    /* --------------------------------------------------------------------------------------------
+     * Give back an execution context that is no longer used.
+    */
+    void ReleaseCtx(CtxRef & ctx);
+
+    /* --------------------------------------------------------------------------------------------
+     * Rebuild the positions of the commands after they were moved around.
+    */
+    void Reindex()
+    {
+        m_Index.clear();
+        // Remember where each command is
+        for (size_t i = 0; i < m_Commands.size(); ++i)
+        {
+            m_Index.emplace(m_Commands[i].mHash, i);
+        }
+        // Names must be sorted again
+        m_Unsorted = true;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Make sure the command names are sorted.
+    */
+    void SortNames();
+
     /* --------------------------------------------------------------------------------------------
      * Execute one of the managed commands.
     */
@@ -464,16 +539,14 @@ protected:
     */
     void Detach(const String & name)
     {
-        // Obtain the unique identifier of the specified name
-        const std::size_t hash = std::hash< String >()(name);
         // Attempt to find the specified command
-        auto itr = std::find_if(m_Commands.cbegin(), m_Commands.cend(), [=](Commands::const_reference c) {
-            return (c.mHash == hash);
-        });
+        auto itr = m_Index.find(std::hash< String >()(name));
         // Make sure the command exist before attempting to remove it
-        if (itr != m_Commands.end())
+        if (itr != m_Index.end())
         {
-            m_Commands.erase(itr);
+            m_Commands.erase(m_Commands.begin() + static_cast< Commands::difference_type >(itr->second));
+            // Commands after it were moved
+            Reindex();
         }
     }
 
@@ -490,6 +563,8 @@ protected:
         if (itr != m_Commands.end())
         {
             m_Commands.erase(itr);
+            // Commands after it were moved
+            Reindex();
         }
     }
 
@@ -552,19 +627,7 @@ public:
     */
     SQMOD_NODISCARD bool Attached(const String & name) const
     {
-        // Obtain the unique identifier of the specified name
-        const std::size_t hash = std::hash< String >()(name);
-        // Attempt to find the specified command
-        for (const auto & cmd : m_Commands) // NOLINT(readability-use-anyofallof)
-        {
-            // Are the hashes identical?
-            if (cmd.mHash == hash)
-            {
-                return true; // We found our command!
-            }
-        }
-        // No such command exists
-        return false;
+        return m_Index.find(std::hash< String >()(name)) != m_Index.end();
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -594,6 +657,8 @@ public:
             [](Commands::const_reference a, Commands::const_reference b) -> bool {
                 return (a.mName < b.mName); // NOLINT(modernize-use-nullptr)
             });
+        // Commands were moved
+        Reindex();
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -602,6 +667,9 @@ public:
     void Clear()
     {
         m_Commands.clear();
+        m_Index.clear();
+        m_Names.clear();
+        m_Unsorted = false;
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -609,21 +677,22 @@ public:
     */
     const Object & FindByName(const String & name)
     {
-        // Obtain the unique identifier of the specified name
-        const std::size_t hash = std::hash< String >()(name);
         // Attempt to find the specified command
-        for (const auto & cmd : m_Commands)
-        {
-            // Are the hashes identical?
-            if (cmd.mHash == hash)
-            {
-                return cmd.mObj; // We found our command!
-            }
-        }
-        // No such command exist
-        return NullObject();
+        auto itr = m_Index.find(std::hash< String >()(name));
+        // Return the command, if found
+        return (itr == m_Index.end()) ? NullObject() : m_Commands[itr->second].mObj;
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the names of the commands that begin with the specified prefix.
+    */
+    Array Complete(const SQChar * prefix, size_t len, SQInteger limit);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the name of the command closest to the specified name. Null if none is close enough.
+    */
+    LightObj Suggest(const SQChar * name, size_t len);
+
     /* --------------------------------------------------------------------------------------------
      * Retrieve the error callback.
     */
@@ -927,6 +996,30 @@ public:
         return GetValid()->FindByName(String(name.mPtr, static_cast< size_t >(name.mLen)));
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the names of the commands that begin with the specified prefix.
+    */
+    Array Complete(StackStrF & prefix)
+    {
+        return GetValid()->Complete(prefix.mPtr, static_cast< size_t >(ClampMin(prefix.mLen, 0)), -1);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve at most a certain number of commands names that begin with the specified prefix.
+    */
+    Array CompleteLimit(SQInteger limit, StackStrF & prefix)
+    {
+        return GetValid()->Complete(prefix.mPtr, static_cast< size_t >(ClampMin(prefix.mLen, 0)), limit);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the name of the command closest to the specified name. Null if none is close enough.
+    */
+    LightObj Suggest(StackStrF & name)
+    {
+        return GetValid()->Suggest(name.mPtr, static_cast< size_t >(ClampMin(name.mLen, 0)));
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Retrieve the number of managed command listeners.
     */
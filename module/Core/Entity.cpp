@@ -120,6 +120,8 @@ void BlipInst::Destroy(bool destroy, int32_t header, LightObj & payload)
     // Is there a manager instance associated with this entity?
     if (mInst)
     {
+        // No longer discoverable by tag
+        Core::Get().GetEntityTags(ENT_BLIP).Remove(mInst->m_Tag, static_cast< TagIndex::Slot >(mInst->m_ID));
         // Prevent further use of this entity
         mInst->m_ID = -1;
         // Release user data to avoid dangling or circular references
@@ -161,6 +163,8 @@ void CheckpointInst::Destroy(bool destroy, int32_t header, LightObj & payload)
     // Is there a manager instance associated with this entity?
     if (mInst)
     {
+        // No longer discoverable by tag
+        Core::Get().GetEntityTags(ENT_CHECKPOINT).Remove(mInst->m_Tag, static_cast< TagIndex::Slot >(mInst->m_ID));
         // Prevent further use of this entity
         mInst->m_ID = -1;
         // Release user data to avoid dangling or circular references
@@ -214,6 +218,8 @@ void KeyBindInst::Destroy(bool destroy, int32_t header, LightObj & payload)
     // Is there a manager instance associated with this entity?
     if (mInst)
     {
+        // No longer discoverable by tag
+        Core::Get().GetEntityTags(ENT_KEYBIND).Remove(mInst->m_Tag, static_cast< TagIndex::Slot >(mInst->m_ID));
         // Prevent further use of this entity
         mInst->m_ID = -1;
         // Release user data to avoid dangling or circular references
@@ -255,6 +261,8 @@ void ObjectInst::Destroy(bool destroy, int32_t header, LightObj & payload)
     // Is there a manager instance associated with this entity?
     if (mInst)
     {
+        // No longer discoverable by tag
+        Core::Get().GetEntityTags(ENT_OBJECT).Remove(mInst->m_Tag, static_cast< TagIndex::Slot >(mInst->m_ID));
         // Prevent further use of this entity
         mInst->m_ID = -1;
         // Release user data to avoid dangling or circular references
@@ -308,6 +316,8 @@ void PickupInst::Destroy(bool destroy, int32_t header, LightObj & payload)
     // Is there a manager instance associated with this entity?
     if (mInst)
     {
+        // No longer discoverable by tag
+        Core::Get().GetEntityTags(ENT_PICKUP).Remove(mInst->m_Tag, static_cast< TagIndex::Slot >(mInst->m_ID));
         // Prevent further use of this entity
         mInst->m_ID = -1;
         // Release user data to avoid dangling or circular references
@@ -361,6 +371,8 @@ void PlayerInst::Destroy(bool /*destroy*/, int32_t header, LightObj & payload)
     // Is there a manager instance associated with this entity?
     if (mInst)
     {
+        // No longer discoverable by tag
+        Core::Get().GetEntityTags(ENT_PLAYER).Remove(mInst->m_Tag, static_cast< TagIndex::Slot >(mInst->m_ID));
         // Prevent further use of this entity
         mInst->m_ID = -1;
         // Release user data to avoid dangling or circular references
@@ -408,6 +420,8 @@ void VehicleInst::Destroy(bool destroy, int32_t header, LightObj & payload)
     // Is there a manager instance associated with this entity?
     if (mInst)
     {
+        // No longer discoverable by tag
+        Core::Get().GetEntityTags(ENT_VEHICLE).Remove(mInst->m_Tag, static_cast< TagIndex::Slot >(mInst->m_ID));
         // Prevent further use of this entity
         mInst->m_ID = -1;
         // Release user data to avoid dangling or circular references
@@ -507,6 +521,13 @@ void PlayerInst::ResetInstance()
     mLastArmour = 0.0;
     mLastHeading = 0.0;
     mLastPosition.Clear();
+    mStateWeapon = -1;
+    mStateHealth = 0.0;
+    mStateArmour = 0.0;
+    mStateHeading = 0.0;
+    mStatePosition.Clear();
+    mStateTime = 0;
+    mChanged = ESC_NONE;
     mAuthority = 0;
 }
 
@@ -524,6 +545,14 @@ void VehicleInst::ResetInstance()
     mLastHealth = 0.0;
     mLastPosition.Clear();
     mLastRotation.Clear();
+    mStateHealth = 0.0;
+    mStatePosition.Clear();
+    mStateRotation.Clear();
+    mHealthTime = 0;
+    mPositionTime = 0;
+    mRotationTime = 0;
+    mChanged = ESC_NONE;
+    mChanging = ESC_NONE;
 }
 
 // ------------------------------------------------------------------------------------------------
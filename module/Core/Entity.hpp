@@ -521,6 +521,15 @@ struct PlayerInst
     float           mLastHeading{0}; // Last known heading of the player entity.
     Vector3         mLastPosition{}; // Last known position of the player entity.
 
+    // ----------------------------------------------------------------------------------------
+    int32_t         mStateWeapon{-1}; // Weapon captured during the last update.
+    float           mStateHealth{0}; // Health captured during the last update.
+    float           mStateArmour{0}; // Armor captured during the last update.
+    float           mStateHeading{0}; // Heading captured during the last update.
+    Vector3         mStatePosition{}; // Position captured during the last update.
+    int64_t         mStateTime{0}; // When the captured values were obtained (microseconds).
+    uint32_t        mChanged{ESC_NONE}; // Last known values that changed during the last update.
+
     // ----------------------------------------------------------------------------------------
     int32_t         mAuthority{0}; // The authority level of the managed player.
 
@@ -694,6 +703,16 @@ struct VehicleInst
     Vector3         mLastPosition{}; // Last known position of the vehicle entity.
     Quaternion      mLastRotation{}; // Last known rotation of the vehicle entity.
 
+    // ----------------------------------------------------------------------------------------
+    float           mStateHealth{0}; // Health captured during the last update.
+    Vector3         mStatePosition{}; // Position captured during the last update.
+    Quaternion      mStateRotation{}; // Rotation captured during the last update.
+    int64_t         mHealthTime{0}; // When the captured health was obtained (microseconds).
+    int64_t         mPositionTime{0}; // When the captured position was obtained (microseconds).
+    int64_t         mRotationTime{0}; // When the captured rotation was obtained (microseconds).
+    uint32_t        mChanged{ESC_NONE}; // Last known values that changed until the last update.
+    uint32_t        mChanging{ESC_NONE}; // Last known values that changed since the last update.
+
     // ----------------------------------------------------------------------------------------
     LightObj        mEvents{}; // Table containing the emitted entity events.
 
@@ -1,19 +1,748 @@
 // ------------------------------------------------------------------------------------------------
 #include "Core/Inventory.hpp"
+#include "Library/IO/Buffer.hpp"
 
 // ------------------------------------------------------------------------------------------------
+#include <cmath>
 #include <cstring>
+#include <algorithm>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
 // ------------------------------------------------------------------------------------------------
+SQMOD_DECL_TYPENAME(ManagerTn, _SC("SqInventoryManager"))
 
+// ------------------------------------------------------------------------------------------------
+static constexpr uint32_t INVENTORY_FORMAT = 1; // Version of the serialized inventory format.
+static constexpr uint32_t INVENTORY_MAX_SLOTS = 65536; // Hard coded limit of slots per inventory.
+static constexpr size_t INVENTORY_RECORD_SIZE = sizeof(uint32_t) + sizeof(int64_t) + sizeof(uint32_t) + sizeof(int64_t); // Serialized stack.
+
+/* ------------------------------------------------------------------------------------------------
+ * Read a value at the cursor position of a buffer and advance the cursor.
+*/
+template < typename T > static T ReadValue(Buffer & b)
+{
+    const T v = b.Cursor< T >();
+    // Move past the value
+    b.Advance< T >(1);
+    // Return the value
+    return v;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Clamp a script count to the range used by item records.
+*/
+static uint32_t ClampCount(SQInteger count)
+{
+    if (count <= 0)
+    {
+        return 0;
+    }
+    return static_cast< uint32_t >(std::min< SQInteger >(count, std::numeric_limits< uint32_t >::max()));
+}
+
+// ------------------------------------------------------------------------------------------------
+uint32_t InventoryManager::ValidType(SQInteger id) const
+{
+    auto itr = m_TypeIndex.find(id);
+    // Does this type exist?
+    if (itr == m_TypeIndex.end())
+    {
+        STHROWF("Item type ({}) does not exist", id);
+    }
+    return itr->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+InventoryStore & InventoryManager::ValidStore(SQInteger owner)
+{
+    auto itr = m_Stores.find(owner);
+    // Does this inventory exist?
+    if (itr == m_Stores.end())
+    {
+        STHROWF("Inventory ({}) does not exist", owner);
+    }
+    return itr->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+const InventoryStore & InventoryManager::ValidStore(SQInteger owner) const
+{
+    auto itr = m_Stores.find(owner);
+    // Does this inventory exist?
+    if (itr == m_Stores.end())
+    {
+        STHROWF("Inventory ({}) does not exist", owner);
+    }
+    return itr->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::ValidateSlot(const InventoryStore & s, SQInteger slot)
+{
+    if (slot < 0 || static_cast< size_t >(slot) >= s.mSlots.size())
+    {
+        STHROWF("Slot ({}) is out of range ({})", slot, s.mSlots.size());
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+uint32_t InventoryManager::AcquireItem(uint32_t type, uint32_t count, int64_t meta)
+{
+    uint32_t idx;
+    // Can we reuse a released record?
+    if (!m_FreeItems.empty())
+    {
+        idx = m_FreeItems.back();
+        m_FreeItems.pop_back();
+    }
+    else
+    {
+        idx = static_cast< uint32_t >(m_Items.size());
+        m_Items.emplace_back();
+    }
+    // Initialize the record
+    InventoryItem & item = m_Items[idx];
+    item.mType = type;
+    item.mCount = count;
+    item.mMeta = meta;
+    // Keep track of how many records use this type
+    ++m_Types[type].mRecords;
+    // Return the record
+    return idx;
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::ReleaseItem(uint32_t idx)
+{
+    InventoryItem & item = m_Items[idx];
+    // Keep track of how many records use this type
+    --m_Types[item.mType].mRecords;
+    // Reset the record
+    item.mCount = 0;
+    item.mMeta = 0;
+    // Make it available again
+    m_FreeItems.push_back(idx);
+}
+
+// ------------------------------------------------------------------------------------------------
+uint32_t InventoryManager::Fits(const InventoryStore & s, uint32_t type, uint32_t count) const
+{
+    const SQFloat weight = m_Types[type].mWeight;
+    // Is there a weight limit that applies to these items?
+    if (s.mCapacity <= 0 || weight <= 0)
+    {
+        return count;
+    }
+    const SQFloat free = s.mCapacity - s.mWeight;
+    // Is there any room left?
+    if (free <= 0)
+    {
+        return 0;
+    }
+    // Allow a little slack for accumulated rounding errors
+    const SQFloat n = std::floor((free / weight) + static_cast< SQFloat >(1e-6));
+    // Return how many would fit
+    return n < static_cast< SQFloat >(count) ? static_cast< uint32_t >(n) : count;
+}
+
+// ------------------------------------------------------------------------------------------------
+uint32_t InventoryManager::Store(InventoryStore & s, uint32_t type, uint32_t count, int64_t meta)
+{
+    const uint32_t stack = m_Types[type].mStack;
+    uint32_t left = count;
+    // Fill existing stacks first
+    for (uint32_t idx : s.mSlots)
+    {
+        if (left == 0)
+        {
+            break;
+        }
+        else if (idx == NIL)
+        {
+            continue;
+        }
+        InventoryItem & item = m_Items[idx];
+        // Can these items be stacked here?
+        if (item.mType != type || item.mMeta != meta || item.mCount >= stack)
+        {
+            continue;
+        }
+        const uint32_t n = std::min(left, stack - item.mCount);
+        item.mCount += n;
+        left -= n;
+    }
+    // Use free slots for the remaining items
+    for (uint32_t & idx : s.mSlots)
+    {
+        if (left == 0)
+        {
+            break;
+        }
+        else if (idx != NIL)
+        {
+            continue;
+        }
+        const uint32_t n = std::min(left, stack);
+        idx = AcquireItem(type, n, meta);
+        ++s.mUsed;
+        left -= n;
+    }
+    // Account for the weight of the stored items
+    s.mWeight += static_cast< SQFloat >(count - left) * m_Types[type].mWeight;
+    // Return how many were stored
+    return count - left;
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Drain(InventoryStore & s, uint32_t slot, uint32_t count)
+{
+    const uint32_t idx = s.mSlots[slot];
+    InventoryItem & item = m_Items[idx];
+    // Remove the items and their weight
+    item.mCount -= count;
+    s.mWeight -= static_cast< SQFloat >(count) * m_Types[item.mType].mWeight;
+    // Did the slot become empty?
+    if (item.mCount == 0)
+    {
+        ReleaseItem(idx);
+        s.mSlots[slot] = NIL;
+        --s.mUsed;
+    }
+    // Don't let rounding errors accumulate
+    if (s.mUsed == 0 || s.mWeight < 0)
+    {
+        s.mWeight = 0;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::DefineType(SQInteger id, SQFloat weight, SQInteger stack)
+{
+    if (weight < 0)
+    {
+        STHROWF("Item weight cannot be negative ({})", weight);
+    }
+    else if (stack < 1 || stack > std::numeric_limits< uint32_t >::max())
+    {
+        STHROWF("Item stack size is out of range ({})", stack);
+    }
+    auto itr = m_TypeIndex.find(id);
+    // Is this an existing type?
+    if (itr != m_TypeIndex.end())
+    {
+        InventoryItemType & t = m_Types[itr->second];
+        // Stored items rely on the current definition
+        if (t.mRecords != 0)
+        {
+            STHROWF("Item type ({}) is in use", id);
+        }
+        t.mWeight = weight;
+        t.mStack = static_cast< uint32_t >(stack);
+        return;
+    }
+    uint32_t idx;
+    // Can we reuse a removed type?
+    if (!m_FreeTypes.empty())
+    {
+        idx = m_FreeTypes.back();
+        m_FreeTypes.pop_back();
+    }
+    else
+    {
+        idx = static_cast< uint32_t >(m_Types.size());
+        m_Types.emplace_back();
+    }
+    // Initialize the type
+    InventoryItemType & t = m_Types[idx];
+    t.mID = id;
+    t.mWeight = weight;
+    t.mStack = static_cast< uint32_t >(stack);
+    t.mRecords = 0;
+    t.mTag.clear();
+    // Index it
+    m_TypeIndex.emplace(id, idx);
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::RemoveType(SQInteger id)
+{
+    const uint32_t idx = ValidType(id);
+    // Stored items rely on this type
+    if (m_Types[idx].mRecords != 0)
+    {
+        STHROWF("Item type ({}) is in use", id);
+    }
+    m_Types[idx].mID = -1;
+    m_Types[idx].mTag.clear();
+    m_FreeTypes.push_back(idx);
+    m_TypeIndex.erase(id);
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Create(SQInteger owner, SQInteger slots, SQFloat capacity)
+{
+    if (slots < 0 || slots > static_cast< SQInteger >(INVENTORY_MAX_SLOTS))
+    {
+        STHROWF("Slot count is out of range ({})", slots);
+    }
+    else if (m_Stores.find(owner) != m_Stores.end())
+    {
+        STHROWF("Inventory ({}) already exists", owner);
+    }
+    InventoryStore & s = m_Stores[owner];
+    // Initialize the inventory
+    s.mSlots.assign(static_cast< size_t >(slots), NIL);
+    s.mCapacity = capacity > 0 ? capacity : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Destroy(SQInteger owner)
+{
+    Clear(owner);
+    // Forget about it
+    m_Stores.erase(owner);
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Clear(SQInteger owner)
+{
+    InventoryStore & s = ValidStore(owner);
+    // Release the stored items
+    for (uint32_t & idx : s.mSlots)
+    {
+        if (idx != NIL)
+        {
+            ReleaseItem(idx);
+            idx = NIL;
+        }
+    }
+    s.mUsed = 0;
+    s.mWeight = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Resize(SQInteger owner, SQInteger slots)
+{
+    InventoryStore & s = ValidStore(owner);
+    // Validate the slot count
+    if (slots < 0 || slots > static_cast< SQInteger >(INVENTORY_MAX_SLOTS))
+    {
+        STHROWF("Slot count is out of range ({})", slots);
+    }
+    // Make sure no items would be lost
+    for (size_t i = static_cast< size_t >(slots); i < s.mSlots.size(); ++i)
+    {
+        if (s.mSlots[i] != NIL)
+        {
+            STHROWF("Slot ({}) is not empty", i);
+        }
+    }
+    s.mSlots.resize(static_cast< size_t >(slots), NIL);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::Add(SQInteger owner, SQInteger type, SQInteger count)
+{
+    const uint32_t t = ValidType(type);
+    InventoryStore & s = ValidStore(owner);
+    // Store as many as the weight allows
+    return static_cast< SQInteger >(Store(s, t, Fits(s, t, ClampCount(count)), 0));
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::Remove(SQInteger owner, SQInteger type, SQInteger count)
+{
+    const uint32_t t = ValidType(type);
+    InventoryStore & s = ValidStore(owner);
+    uint32_t left = ClampCount(count);
+    // Take from every stack of this type until satisfied
+    for (uint32_t i = 0; i < s.mSlots.size() && left != 0; ++i)
+    {
+        const uint32_t idx = s.mSlots[i];
+        // Does this slot hold items of this type?
+        if (idx == NIL || m_Items[idx].mType != t)
+        {
+            continue;
+        }
+        const uint32_t n = std::min(left, m_Items[idx].mCount);
+        Drain(s, i, n);
+        left -= n;
+    }
+    // Return how many were removed
+    return static_cast< SQInteger >(ClampCount(count) - left);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::Count(SQInteger owner, SQInteger type) const
+{
+    const uint32_t t = ValidType(type);
+    const InventoryStore & s = ValidStore(owner);
+    SQInteger n = 0;
+    // Add up every stack of this type
+    for (uint32_t idx : s.mSlots)
+    {
+        if (idx != NIL && m_Items[idx].mType == t)
+        {
+            n += m_Items[idx].mCount;
+        }
+    }
+    return n;
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::Take(SQInteger owner, SQInteger slot, SQInteger count)
+{
+    InventoryStore & s = ValidStore(owner);
+    ValidateSlot(s, slot);
+    const uint32_t idx = s.mSlots[static_cast< size_t >(slot)];
+    // Is there anything to take?
+    if (idx == NIL)
+    {
+        return 0;
+    }
+    const uint32_t n = std::min(ClampCount(count), m_Items[idx].mCount);
+    Drain(s, static_cast< uint32_t >(slot), n);
+    // Return how many were removed
+    return static_cast< SQInteger >(n);
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Move(SQInteger owner, SQInteger from, SQInteger to)
+{
+    InventoryStore & s = ValidStore(owner);
+    ValidateSlot(s, from);
+    ValidateSlot(s, to);
+    // Is there anything to move?
+    uint32_t & a = s.mSlots[static_cast< size_t >(from)];
+    uint32_t & b = s.mSlots[static_cast< size_t >(to)];
+    if (from == to || a == NIL)
+    {
+        return;
+    }
+    // Is the destination occupied by a compatible stack?
+    else if (b != NIL && m_Items[a].mType == m_Items[b].mType && m_Items[a].mMeta == m_Items[b].mMeta)
+    {
+        InventoryItem & src = m_Items[a];
+        InventoryItem & dst = m_Items[b];
+        const uint32_t stack = m_Types[dst.mType].mStack;
+        // Is there any room left in the destination stack?
+        if (dst.mCount < stack)
+        {
+            const uint32_t n = std::min(src.mCount, stack - dst.mCount);
+            dst.mCount += n;
+            src.mCount -= n;
+            // Did the source slot become empty?
+            if (src.mCount == 0)
+            {
+                ReleaseItem(a);
+                a = NIL;
+                --s.mUsed;
+            }
+            return;
+        }
+    }
+    // Swap the slots otherwise
+    std::swap(a, b);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::Split(SQInteger owner, SQInteger slot, SQInteger count)
+{
+    InventoryStore & s = ValidStore(owner);
+    ValidateSlot(s, slot);
+    const uint32_t idx = s.mSlots[static_cast< size_t >(slot)];
+    // Is there anything to split?
+    if (idx == NIL)
+    {
+        STHROWF("Slot ({}) is empty", slot);
+    }
+    else if (count <= 0 || count >= static_cast< SQInteger >(m_Items[idx].mCount))
+    {
+        STHROWF("Cannot split ({}) items from a stack of ({})", count, m_Items[idx].mCount);
+    }
+    // Find a free slot
+    auto itr = std::find(s.mSlots.begin(), s.mSlots.end(), NIL);
+    if (itr == s.mSlots.end())
+    {
+        return -1;
+    }
+    // The record pool can grow so don't hold references to records across this call
+    *itr = AcquireItem(m_Items[idx].mType, static_cast< uint32_t >(count), m_Items[idx].mMeta);
+    m_Items[idx].mCount -= static_cast< uint32_t >(count);
+    ++s.mUsed;
+    // Return the slot where the items were moved
+    return static_cast< SQInteger >(itr - s.mSlots.begin());
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::Transfer(SQInteger owner, SQInteger slot, SQInteger target, SQInteger count)
+{
+    if (owner == target)
+    {
+        STHROWF("Cannot transfer items to the same inventory ({})", owner);
+    }
+    InventoryStore & s = ValidStore(owner);
+    InventoryStore & d = ValidStore(target);
+    ValidateSlot(s, slot);
+    const uint32_t idx = s.mSlots[static_cast< size_t >(slot)];
+    // Is there anything to transfer?
+    if (idx == NIL)
+    {
+        return 0;
+    }
+    // Copy the record because the pool can grow
+    const InventoryItem item = m_Items[idx];
+    // Store as many as the destination allows
+    const uint32_t n = Store(d, item.mType, Fits(d, item.mType, std::min(ClampCount(count), item.mCount)), item.mMeta);
+    // Remove them from the source
+    if (n != 0)
+    {
+        Drain(s, static_cast< uint32_t >(slot), n);
+    }
+    // Return how many were moved
+    return static_cast< SQInteger >(n);
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Compact(SQInteger owner)
+{
+    InventoryStore & s = ValidStore(owner);
+    std::vector< InventoryItem > items;
+    items.reserve(s.mUsed);
+    // Take out every stack in slot order
+    for (uint32_t & idx : s.mSlots)
+    {
+        if (idx != NIL)
+        {
+            items.push_back(m_Items[idx]);
+            ReleaseItem(idx);
+            idx = NIL;
+        }
+    }
+    s.mUsed = 0;
+    s.mWeight = 0;
+    // Put them back, merging compatible stacks (never needs more slots than before)
+    for (const InventoryItem & item : items)
+    {
+        Store(s, item.mType, item.mCount, item.mMeta);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::GetSlotType(SQInteger owner, SQInteger slot) const
+{
+    const InventoryStore & s = ValidStore(owner);
+    ValidateSlot(s, slot);
+    const uint32_t idx = s.mSlots[static_cast< size_t >(slot)];
+    // Return the type identifier, if any
+    return idx == NIL ? -1 : m_Types[m_Items[idx].mType].mID;
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::GetSlotCount(SQInteger owner, SQInteger slot) const
+{
+    const InventoryStore & s = ValidStore(owner);
+    ValidateSlot(s, slot);
+    const uint32_t idx = s.mSlots[static_cast< size_t >(slot)];
+    // Return the item count, if any
+    return idx == NIL ? 0 : static_cast< SQInteger >(m_Items[idx].mCount);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::GetSlotMeta(SQInteger owner, SQInteger slot) const
+{
+    const InventoryStore & s = ValidStore(owner);
+    ValidateSlot(s, slot);
+    const uint32_t idx = s.mSlots[static_cast< size_t >(slot)];
+    // Return the user value, if any
+    return idx == NIL ? 0 : static_cast< SQInteger >(m_Items[idx].mMeta);
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::SetSlotMeta(SQInteger owner, SQInteger slot, SQInteger meta)
+{
+    InventoryStore & s = ValidStore(owner);
+    ValidateSlot(s, slot);
+    const uint32_t idx = s.mSlots[static_cast< size_t >(slot)];
+    // Is there a stack in this slot?
+    if (idx == NIL)
+    {
+        STHROWF("Slot ({}) is empty", slot);
+    }
+    m_Items[idx].mMeta = static_cast< int64_t >(meta);
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Each(SQInteger owner, Function & func) const
+{
+    const InventoryStore & s = ValidStore(owner);
+    // In order to be safe from modifications while iterating, create a copy
+    std::vector< std::pair< SQInteger, InventoryItem > > items;
+    items.reserve(s.mUsed);
+    for (size_t i = 0; i < s.mSlots.size(); ++i)
+    {
+        if (s.mSlots[i] != NIL)
+        {
+            items.emplace_back(static_cast< SQInteger >(i), m_Items[s.mSlots[i]]);
+        }
+    }
+    // Forward the slots to the callback
+    for (const auto & e : items)
+    {
+        func.Execute(e.first, m_Types[e.second.mType].mID, static_cast< SQInteger >(e.second.mCount),
+                     static_cast< SQInteger >(e.second.mMeta));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Serialize(SQInteger owner, SqBuffer & buffer) const
+{
+    const InventoryStore & s = ValidStore(owner);
+    Buffer & b = buffer.Writable();
+    // Header
+    b.Push< uint32_t >(INVENTORY_FORMAT);
+    b.Push< double >(static_cast< double >(s.mCapacity));
+    b.Push< uint32_t >(static_cast< uint32_t >(s.mSlots.size()));
+    b.Push< uint32_t >(s.mUsed);
+    // Occupied slots
+    for (size_t i = 0; i < s.mSlots.size(); ++i)
+    {
+        const uint32_t idx = s.mSlots[i];
+        // Empty slots are implied
+        if (idx == NIL)
+        {
+            continue;
+        }
+        const InventoryItem & item = m_Items[idx];
+        b.Push< uint32_t >(static_cast< uint32_t >(i));
+        b.Push< int64_t >(static_cast< int64_t >(m_Types[item.mType].mID));
+        b.Push< uint32_t >(item.mCount);
+        b.Push< int64_t >(item.mMeta);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Deserialize(SQInteger owner, SqBuffer & buffer)
+{
+    Buffer & b = buffer.Valid();
+    // Validate the header
+    const auto format = ReadValue< uint32_t >(b);
+    if (format != INVENTORY_FORMAT)
+    {
+        STHROWF("Unknown inventory format ({})", format);
+    }
+    const auto capacity = ReadValue< double >(b);
+    const auto slots = ReadValue< uint32_t >(b);
+    const auto used = ReadValue< uint32_t >(b);
+    if (slots > INVENTORY_MAX_SLOTS || used > slots)
+    {
+        STHROWF("Invalid inventory slots ({}) or used slots ({})", slots, used);
+    }
+    // Make sure the stacks are actually there before allocating anything for them
+    else if (static_cast< size_t >(used) * INVENTORY_RECORD_SIZE > static_cast< size_t >(b.Remaining()))
+    {
+        STHROWF("Inventory data is truncated ({} stacks in {} bytes)", used, b.Remaining());
+    }
+    // Read and validate everything before touching the inventory
+    std::vector< std::pair< uint32_t, InventoryItem > > items;
+    std::vector< bool > seen(slots, false);
+    items.reserve(used);
+    for (uint32_t n = 0; n < used; ++n)
+    {
+        const auto slot = ReadValue< uint32_t >(b);
+        const auto type = ValidType(static_cast< SQInteger >(ReadValue< int64_t >(b)));
+        const auto count = ReadValue< uint32_t >(b);
+        const auto meta = ReadValue< int64_t >(b);
+        // Validate the stack
+        if (slot >= slots || seen[slot])
+        {
+            STHROWF("Invalid or duplicate slot ({})", slot);
+        }
+        else if (count == 0 || count > m_Types[type].mStack)
+        {
+            STHROWF("Invalid stack of ({}) items in slot ({})", count, slot);
+        }
+        seen[slot] = true;
+        items.emplace_back(slot, InventoryItem{type, count, meta});
+    }
+    // Create the inventory or discard its current contents
+    auto itr = m_Stores.find(owner);
+    if (itr == m_Stores.end())
+    {
+        itr = m_Stores.emplace(owner, InventoryStore{}).first;
+    }
+    else
+    {
+        Clear(owner);
+    }
+    InventoryStore & s = itr->second;
+    s.mSlots.assign(slots, NIL);
+    s.mCapacity = capacity > 0 ? static_cast< SQFloat >(capacity) : 0;
+    // Place the stacks where they were
+    for (const auto & e : items)
+    {
+        s.mSlots[e.first] = AcquireItem(e.second.mType, e.second.mCount, e.second.mMeta);
+        s.mWeight += static_cast< SQFloat >(e.second.mCount) * m_Types[e.second.mType].mWeight;
+        ++s.mUsed;
+    }
+}
 
 // ================================================================================================
 void Register_Inventory(HSQUIRRELVM vm)
 {
+    Table ns(vm);
+
+    // --------------------------------------------------------------------------------------------
+    ns.Bind(_SC("Manager"),
+        Class< InventoryManager, NoCopy< InventoryManager > >(vm, ManagerTn::Str)
+        // Constructors
+        .Ctor()
+        // Meta-methods
+        .SquirrelFunc(_SC("_typename"), &ManagerTn::Fn)
+        // Properties
+        .Prop(_SC("Types"), &InventoryManager::GetTypes)
+        .Prop(_SC("Records"), &InventoryManager::GetRecords)
+        .Prop(_SC("Inventories"), &InventoryManager::GetInventories)
+        // Type Methods
+        .Func(_SC("DefineType"), &InventoryManager::DefineType)
+        .Func(_SC("HaveType"), &InventoryManager::HaveType)
+        .Func(_SC("RemoveType"), &InventoryManager::RemoveType)
+        .Func(_SC("TypeWeight"), &InventoryManager::GetTypeWeight)
+        .Func(_SC("TypeStack"), &InventoryManager::GetTypeStack)
+        .Func(_SC("TypeTag"), &InventoryManager::GetTypeTag)
+        .FmtFunc(_SC("SetTypeTag"), &InventoryManager::SetTypeTag)
+        // Inventory Methods
+        .Func(_SC("Create"), &InventoryManager::Create)
+        .Func(_SC("Destroy"), &InventoryManager::Destroy)
+        .Func(_SC("Have"), &InventoryManager::Have)
+        .Func(_SC("Clear"), &InventoryManager::Clear)
+        .Func(_SC("Resize"), &InventoryManager::Resize)
+        .Func(_SC("Slots"), &InventoryManager::GetSlots)
+        .Func(_SC("Used"), &InventoryManager::GetUsed)
+        .Func(_SC("Weight"), &InventoryManager::GetWeight)
+        .Func(_SC("Capacity"), &InventoryManager::GetCapacity)
+        .Func(_SC("SetCapacity"), &InventoryManager::SetCapacity)
+        // Item Methods
+        .Func(_SC("Add"), &InventoryManager::Add)
+        .Func(_SC("Remove"), &InventoryManager::Remove)
+        .Func(_SC("Count"), &InventoryManager::Count)
+        .Func(_SC("Take"), &InventoryManager::Take)
+        .Func(_SC("Move"), &InventoryManager::Move)
+        .Func(_SC("Split"), &InventoryManager::Split)
+        .Func(_SC("Transfer"), &InventoryManager::Transfer)
+        .Func(_SC("Compact"), &InventoryManager::Compact)
+        .Func(_SC("SlotType"), &InventoryManager::GetSlotType)
+        .Func(_SC("SlotCount"), &InventoryManager::GetSlotCount)
+        .Func(_SC("SlotMeta"), &InventoryManager::GetSlotMeta)
+        .Func(_SC("SetSlotMeta"), &InventoryManager::SetSlotMeta)
+        .CbFunc(_SC("Each"), &InventoryManager::Each)
+        .Func(_SC("Serialize"), &InventoryManager::Serialize)
+        .Func(_SC("Deserialize"), &InventoryManager::Deserialize)
+    );
 
+    RootTable(vm).Bind(_SC("SqInventory"), ns);
 }
 
 } // Namespace:: SqMod
@@ -2,25 +2,65 @@
 
 // ------------------------------------------------------------------------------------------------
 #include "Core/Utility.hpp"
-#include "Base/Vector3.hpp"
-#include "Base/Quaternion.hpp"
 
 // ------------------------------------------------------------------------------------------------
-#include <array>
 #include <vector>
-#include <random>
-#include <chrono>
+#include <limits>
+#include <unordered_map>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
+// ------------------------------------------------------------------------------------------------
+class SqBuffer;
+
+/* ------------------------------------------------------------------------------------------------
+ * Definition of a type of item that can be stored in an inventory.
+*/
+struct InventoryItemType
+{
+    // --------------------------------------------------------------------------------------------
+    SQInteger   mID{-1}; // User defined type identifier.
+    SQFloat     mWeight{0}; // Weight of a single item of this type.
+    uint32_t    mStack{1}; // Maximum number of items of this type that can share a slot.
+    uint32_t    mRecords{0}; // Number of item records that currently use this type.
+    String      mTag{}; // User tag associated with this type.
+};
+
 /* ------------------------------------------------------------------------------------------------
- * Built-in inventory.
+ * Packed item record. Identifies a stack of items of the same type that occupies a slot.
+*/
+struct InventoryItem
+{
+    // --------------------------------------------------------------------------------------------
+    uint32_t    mType{0}; // Index of the item type.
+    uint32_t    mCount{0}; // Number of items in this stack.
+    int64_t     mMeta{0}; // User defined value associated with the stack (durability, flags etc.).
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Slots of an inventory owned by a certain entity, as well as the limits imposed on them.
+*/
+struct InventoryStore
+{
+    // --------------------------------------------------------------------------------------------
+    std::vector< uint32_t > mSlots{}; // Index of the item record in each slot.
+    SQFloat                 mCapacity{0}; // Maximum weight that can be carried. Zero if unlimited.
+    SQFloat                 mWeight{0}; // Weight of the items currently stored.
+    uint32_t                mUsed{0}; // Number of slots currently occupied.
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Built-in inventory. Item records are kept in a shared pool and inventories only store indexes
+ * into that pool. Scripts address items through the owner and slot instead of individual objects.
 */
 class InventoryManager
 {
 public:
 
+    // --------------------------------------------------------------------------------------------
+    static constexpr uint32_t NIL = std::numeric_limits< uint32_t >::max(); // Unused slot/record.
+
     /* --------------------------------------------------------------------------------------------
      * Default constructor.
     */
@@ -51,8 +91,281 @@ public:
     */
     InventoryManager & operator = (InventoryManager && o) = delete;
 
+    /* --------------------------------------------------------------------------------------------
+     * Define a new item type or update the weight and stack size of an existing one.
+    */
+    void DefineType(SQInteger id, SQFloat weight, SQInteger stack);
+
+    /* --------------------------------------------------------------------------------------------
+     * See whether an item type was defined.
+    */
+    SQMOD_NODISCARD bool HaveType(SQInteger id) const
+    {
+        return m_TypeIndex.find(id) != m_TypeIndex.end();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Remove an item type. Fails if there are still items of this type in any inventory.
+    */
+    void RemoveType(SQInteger id);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the weight of a single item of the specified type.
+    */
+    SQMOD_NODISCARD SQFloat GetTypeWeight(SQInteger id) const
+    {
+        return m_Types[ValidType(id)].mWeight;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the maximum number of items of the specified type that can share a slot.
+    */
+    SQMOD_NODISCARD SQInteger GetTypeStack(SQInteger id) const
+    {
+        return static_cast< SQInteger >(m_Types[ValidType(id)].mStack);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the tag associated with the specified type.
+    */
+    SQMOD_NODISCARD const String & GetTypeTag(SQInteger id) const
+    {
+        return m_Types[ValidType(id)].mTag;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the tag associated with the specified type.
+    */
+    void SetTypeTag(SQInteger id, StackStrF & tag)
+    {
+        m_Types[ValidType(id)].mTag.assign(tag.mPtr, static_cast< size_t >(tag.mLen));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of defined item types.
+    */
+    SQMOD_NODISCARD SQInteger GetTypes() const
+    {
+        return static_cast< SQInteger >(m_TypeIndex.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of item records currently in use.
+    */
+    SQMOD_NODISCARD SQInteger GetRecords() const
+    {
+        return static_cast< SQInteger >(m_Items.size() - m_FreeItems.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of inventories.
+    */
+    SQMOD_NODISCARD SQInteger GetInventories() const
+    {
+        return static_cast< SQInteger >(m_Stores.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Create an inventory for the specified owner.
+    */
+    void Create(SQInteger owner, SQInteger slots, SQFloat capacity);
+
+    /* --------------------------------------------------------------------------------------------
+     * Destroy the inventory of the specified owner and release its items.
+    */
+    void Destroy(SQInteger owner);
+
+    /* --------------------------------------------------------------------------------------------
+     * See whether the specified owner has an inventory.
+    */
+    SQMOD_NODISCARD bool Have(SQInteger owner) const
+    {
+        return m_Stores.find(owner) != m_Stores.end();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Release all items stored in the inventory of the specified owner.
+    */
+    void Clear(SQInteger owner);
+
+    /* --------------------------------------------------------------------------------------------
+     * Change the number of slots in the inventory. Fails if occupied slots would be dropped.
+    */
+    void Resize(SQInteger owner, SQInteger slots);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of slots in the inventory.
+    */
+    SQMOD_NODISCARD SQInteger GetSlots(SQInteger owner) const
+    {
+        return static_cast< SQInteger >(ValidStore(owner).mSlots.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of occupied slots in the inventory.
+    */
+    SQMOD_NODISCARD SQInteger GetUsed(SQInteger owner) const
+    {
+        return static_cast< SQInteger >(ValidStore(owner).mUsed);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the weight of the items in the inventory.
+    */
+    SQMOD_NODISCARD SQFloat GetWeight(SQInteger owner) const
+    {
+        return ValidStore(owner).mWeight;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the maximum weight the inventory can carry. Zero if unlimited.
+    */
+    SQMOD_NODISCARD SQFloat GetCapacity(SQInteger owner) const
+    {
+        return ValidStore(owner).mCapacity;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the maximum weight the inventory can carry. Items already stored are not affected.
+    */
+    void SetCapacity(SQInteger owner, SQFloat capacity)
+    {
+        ValidStore(owner).mCapacity = capacity > 0 ? capacity : 0;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Add items of the specified type. Existing stacks are filled first. Returns how many were added.
+    */
+    SQInteger Add(SQInteger owner, SQInteger type, SQInteger count);
+
+    /* --------------------------------------------------------------------------------------------
+     * Remove items of the specified type from any slot. Returns how many were removed.
+    */
+    SQInteger Remove(SQInteger owner, SQInteger type, SQInteger count);
+
+    /* --------------------------------------------------------------------------------------------
+     * Count the items of the specified type.
+    */
+    SQMOD_NODISCARD SQInteger Count(SQInteger owner, SQInteger type) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Remove items from the specified slot. Returns how many were removed.
+    */
+    SQInteger Take(SQInteger owner, SQInteger slot, SQInteger count);
+
+    /* --------------------------------------------------------------------------------------------
+     * Move the stack in a slot to another slot. Merges compatible stacks and swaps otherwise.
+    */
+    void Move(SQInteger owner, SQInteger from, SQInteger to);
+
+    /* --------------------------------------------------------------------------------------------
+     * Split items from a stack into the first free slot. Returns the slot or -1 if none is free.
+    */
+    SQInteger Split(SQInteger owner, SQInteger slot, SQInteger count);
+
+    /* --------------------------------------------------------------------------------------------
+     * Move items from a slot into another inventory. Returns how many were moved.
+    */
+    SQInteger Transfer(SQInteger owner, SQInteger slot, SQInteger target, SQInteger count);
+
+    /* --------------------------------------------------------------------------------------------
+     * Merge compatible stacks and move all stacks to the beginning of the inventory.
+    */
+    void Compact(SQInteger owner);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the item type in the specified slot. -1 if the slot is empty.
+    */
+    SQMOD_NODISCARD SQInteger GetSlotType(SQInteger owner, SQInteger slot) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of items in the specified slot.
+    */
+    SQMOD_NODISCARD SQInteger GetSlotCount(SQInteger owner, SQInteger slot) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the user value associated with the stack in the specified slot.
+    */
+    SQMOD_NODISCARD SQInteger GetSlotMeta(SQInteger owner, SQInteger slot) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the user value associated with the stack in the specified slot.
+    */
+    void SetSlotMeta(SQInteger owner, SQInteger slot, SQInteger meta);
+
+    /* --------------------------------------------------------------------------------------------
+     * Invoke a callback with the slot, type, count and meta of every occupied slot.
+    */
+    void Each(SQInteger owner, Function & func) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Write the contents of the inventory to a buffer.
+    */
+    void Serialize(SQInteger owner, SqBuffer & buffer) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Replace the contents of the inventory with the contents read from a buffer.
+    */
+    void Deserialize(SQInteger owner, SqBuffer & buffer);
+
 private:
 
+    // --------------------------------------------------------------------------------------------
+    typedef std::unordered_map< SQInteger, uint32_t >       TypeIndex; // Type identifier to type index.
+    typedef std::unordered_map< SQInteger, InventoryStore > Stores; // Owner identifier to inventory.
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the index of a type and throw an exception if it doesn't exist.
+    */
+    SQMOD_NODISCARD uint32_t ValidType(SQInteger id) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the inventory of an owner and throw an exception if it doesn't exist.
+    */
+    SQMOD_NODISCARD InventoryStore & ValidStore(SQInteger owner);
+    SQMOD_NODISCARD const InventoryStore & ValidStore(SQInteger owner) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Make sure the specified slot exists in the inventory.
+    */
+    static void ValidateSlot(const InventoryStore & s, SQInteger slot);
+
+    /* --------------------------------------------------------------------------------------------
+     * Obtain an unused item record.
+    */
+    uint32_t AcquireItem(uint32_t type, uint32_t count, int64_t meta);
+
+    /* --------------------------------------------------------------------------------------------
+     * Return an item record to the pool.
+    */
+    void ReleaseItem(uint32_t idx);
+
+    /* --------------------------------------------------------------------------------------------
+     * Find out how many items of a type still fit in the inventory, by weight.
+    */
+    SQMOD_NODISCARD uint32_t Fits(const InventoryStore & s, uint32_t type, uint32_t count) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Store items into the inventory. Assumes the weight was checked. Returns how many were stored.
+    */
+    uint32_t Store(InventoryStore & s, uint32_t type, uint32_t count, int64_t meta);
+
+    /* --------------------------------------------------------------------------------------------
+     * Remove items from a slot and release the item record if the slot becomes empty.
+    */
+    void Drain(InventoryStore & s, uint32_t slot, uint32_t count);
+
+    // --------------------------------------------------------------------------------------------
+    std::vector< InventoryItemType >    m_Types{}; // Defined item types.
+    std::vector< uint32_t >             m_FreeTypes{}; // Indexes of removed item types.
+    TypeIndex                           m_TypeIndex{}; // Type identifier to type index.
+
+    // --------------------------------------------------------------------------------------------
+    std::vector< InventoryItem >        m_Items{}; // Pool of item records.
+    std::vector< uint32_t >             m_FreeItems{}; // Indexes of unused item records.
+
+    // --------------------------------------------------------------------------------------------
+    Stores                              m_Stores{}; // Inventories of each owner.
 };
 
 } // Namespace:: SqMod
@@ -1,19 +1,672 @@
 // ------------------------------------------------------------------------------------------------
 #include "Core/Loot.hpp"
+#include "Core.hpp"
+#include "Library/Chrono.hpp"
+#include "Library/Numeric/Random.hpp"
 
 // ------------------------------------------------------------------------------------------------
+#include <cmath>
 #include <cstring>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
 // ------------------------------------------------------------------------------------------------
+SQMOD_DECL_TYPENAME(ManagerTn, _SC("SqLootManager"))
 
+// ------------------------------------------------------------------------------------------------
+void ProcessLoot()
+{
+    const int64_t now = Chrono::GetEpochTimeMilli();
+    // Go over all managers and allow them to process pending work
+    for (LootManager * inst = LootManager::sHead; inst && inst->mNext != LootManager::sHead; inst = inst->mNext)
+    {
+        try
+        {
+            inst->Process(now);
+        }
+        catch (const std::exception & e)
+        {
+            LogErr("Exception occured while processing loot [%s]", e.what());
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void TerminateLoot()
+{
+    // Go over all managers and release script resources
+    for (LootManager * inst = LootManager::sHead; inst && inst->mNext != LootManager::sHead; inst = inst->mNext)
+    {
+        inst->Terminate();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootCluster::Rebuild()
+{
+    const size_t n = mWeights.size();
+    // Start with a clean table
+    mProb.assign(n, 1.0);
+    mAlias.assign(n, 0);
+    mDirty = false;
+    // Anything to build?
+    if (n == 0)
+    {
+        return;
+    }
+    double sum = 0.0;
+    // Compute the total weight
+    for (const double w : mWeights)
+    {
+        sum += w;
+    }
+    std::vector< double > p(n);
+    std::vector< uint32_t > small, large;
+    // Scale the weights so that their average is one and split them by that average
+    for (size_t i = 0; i < n; ++i)
+    {
+        p[i] = (mWeights[i] * static_cast< double >(n)) / sum;
+        // Which side of the average is it?
+        if (p[i] < 1.0)
+        {
+            small.push_back(static_cast< uint32_t >(i));
+        }
+        else
+        {
+            large.push_back(static_cast< uint32_t >(i));
+        }
+    }
+    // Fill each small column with the excess of a large one
+    while (!small.empty() && !large.empty())
+    {
+        const uint32_t l = small.back();
+        small.pop_back();
+        const uint32_t g = large.back();
+        large.pop_back();
+        // The small column keeps its own probability and borrows the rest from the large one
+        mProb[l] = p[l];
+        mAlias[l] = g;
+        // Whatever the large column has left decides where it goes next
+        p[g] = (p[g] + p[l]) - 1.0;
+        // Which side of the average is it now?
+        if (p[g] < 1.0)
+        {
+            small.push_back(g);
+        }
+        else
+        {
+            large.push_back(g);
+        }
+    }
+    // Whatever remains is full (rounding errors end up here as well)
+    for (const uint32_t i : small)
+    {
+        mProb[i] = 1.0;
+    }
+    for (const uint32_t i : large)
+    {
+        mProb[i] = 1.0;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+uint32_t LootCluster::Sample()
+{
+    // Are there any factories to choose from?
+    if (mFactories.empty())
+    {
+        return LootSpawn::NIL;
+    }
+    // Was the table invalidated?
+    if (mDirty)
+    {
+        Rebuild();
+    }
+    // Pick a column and then decide between it and its alias
+    const uint32_t i = GetRandomUint32(static_cast< uint32_t >(mFactories.size() - 1));
+    // Return the chosen factory
+    return mFactories[GetRandomFloat64() < mProb[i] ? i : mAlias[i]];
+}
+
+// ------------------------------------------------------------------------------------------------
+LootSpawn & LootManager::ValidSpawn(SQInteger spawn)
+{
+    // Is the index within range?
+    if (spawn < 0 || static_cast< size_t >(spawn) >= m_Spawns.size())
+    {
+        STHROWF("Loot spawn ({}) does not exist", spawn);
+    }
+    return m_Spawns[static_cast< size_t >(spawn)];
+}
+
+// ------------------------------------------------------------------------------------------------
+uint64_t LootManager::CellKey(float x, float y) const
+{
+    const auto cx = static_cast< int32_t >(std::floor(x / m_Radius));
+    const auto cy = static_cast< int32_t >(std::floor(y / m_Radius));
+    // Pack both cell coordinates into a single key
+    return (static_cast< uint64_t >(static_cast< uint32_t >(cx)) << 32u) | static_cast< uint32_t >(cy);
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Reindex()
+{
+    // Forget the previous cells
+    for (auto & r : m_Regions)
+    {
+        r.mGrid.clear();
+    }
+    // Insert every spawn in the grid of its region
+    for (size_t i = 0; i < m_Spawns.size(); ++i)
+    {
+        const LootSpawn & s = m_Spawns[i];
+        // Find the region of this spawn
+        LootRegion & r = m_Regions[m_Clusters[s.mCluster].mRegion];
+        // Insert it in the associated cell
+        r.mGrid[CellKey(s.mPos.x, s.mPos.y)].push_back(static_cast< uint32_t >(i));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::SetRadius(SQFloat radius)
+{
+    // Must be a positive distance
+    if (!(radius > 0))
+    {
+        STHROWF("Invalid loot radius ({})", radius);
+    }
+    m_Radius = static_cast< float >(radius);
+    // The grid cells match the radius so they must be rebuilt
+    Reindex();
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::DefineFactory(SQInteger id, SQInteger type, SQInteger cls, Function & create, Function & del)
+{
+    auto itr = m_FactoryIndex.find(id);
+    // Is this a new factory?
+    if (itr == m_FactoryIndex.end())
+    {
+        itr = m_FactoryIndex.emplace(id, static_cast< uint32_t >(m_Factories.size())).first;
+        m_Factories.emplace_back();
+    }
+    LootFactory & f = m_Factories[itr->second];
+    // Assign the factory information
+    f.mID = id;
+    f.mType = type;
+    f.mClass = cls;
+    f.mCreate = create;
+    f.mDelete = del;
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger LootManager::AddRegion(SQInteger interval)
+{
+    m_Regions.emplace_back();
+    // Assign the restock interval
+    m_Regions.back().mInterval = std::max< SQInteger >(interval, 0);
+    // Return the index of the new region
+    return static_cast< SQInteger >(m_Regions.size() - 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::SetRegionEnabled(SQInteger region, bool toggle)
+{
+    // Is the index within range?
+    if (region < 0 || static_cast< size_t >(region) >= m_Regions.size())
+    {
+        STHROWF("Loot region ({}) does not exist", region);
+    }
+    // Materialized spawns from disabled regions are released on the next scan
+    m_Regions[static_cast< size_t >(region)].mEnabled = toggle;
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::SetRegionInterval(SQInteger region, SQInteger interval)
+{
+    // Is the index within range?
+    if (region < 0 || static_cast< size_t >(region) >= m_Regions.size())
+    {
+        STHROWF("Loot region ({}) does not exist", region);
+    }
+    // Only affects spawns collected from now on
+    m_Regions[static_cast< size_t >(region)].mInterval = std::max< SQInteger >(interval, 0);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger LootManager::AddCluster(SQInteger region)
+{
+    // Is the index within range?
+    if (region < 0 || static_cast< size_t >(region) >= m_Regions.size())
+    {
+        STHROWF("Loot region ({}) does not exist", region);
+    }
+    m_Clusters.emplace_back();
+    // Associate with the region
+    m_Clusters.back().mRegion = static_cast< uint32_t >(region);
+    // Return the index of the new cluster
+    return static_cast< SQInteger >(m_Clusters.size() - 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::AddClusterFactory(SQInteger cluster, SQInteger factory, SQFloat weight)
+{
+    // Is the index within range?
+    if (cluster < 0 || static_cast< size_t >(cluster) >= m_Clusters.size())
+    {
+        STHROWF("Loot cluster ({}) does not exist", cluster);
+    }
+    auto itr = m_FactoryIndex.find(factory);
+    // Does the factory exist?
+    if (itr == m_FactoryIndex.end())
+    {
+        STHROWF("Loot factory ({}) does not exist", factory);
+    }
+    // Must have a chance of being picked
+    else if (!(weight > 0))
+    {
+        STHROWF("Invalid loot factory weight ({})", weight);
+    }
+    LootCluster & c = m_Clusters[static_cast< size_t >(cluster)];
+    // Add the factory to the cluster
+    c.mFactories.push_back(itr->second);
+    c.mWeights.push_back(static_cast< double >(weight));
+    // The alias table must be rebuilt before sampling again
+    c.mDirty = true;
+    // Spawns that could not be stocked before can be stocked now
+    for (const uint32_t i : c.mSpawns)
+    {
+        if (m_Spawns[i].mFactory == NIL && !m_Timers.IsArmed(i))
+        {
+            m_Restock.push_back(i);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger LootManager::AddSpawn(SQInteger cluster, SQFloat x, SQFloat y, SQFloat z)
+{
+    // Is the index within range?
+    if (cluster < 0 || static_cast< size_t >(cluster) >= m_Clusters.size())
+    {
+        STHROWF("Loot cluster ({}) does not exist", cluster);
+    }
+    const auto i = static_cast< uint32_t >(m_Spawns.size());
+    LootCluster & c = m_Clusters[static_cast< size_t >(cluster)];
+    LootRegion & r = m_Regions[c.mRegion];
+    // Create the spawn
+    m_Spawns.emplace_back();
+    LootSpawn & s = m_Spawns.back();
+    s.mPos.SetVector3Ex(static_cast< float >(x), static_cast< float >(y), static_cast< float >(z));
+    s.mCluster = static_cast< uint32_t >(cluster);
+    // Associate with the cluster
+    c.mSpawns.push_back(i);
+    // Insert it in the spatial index of the region
+    r.Extend(s.mPos);
+    r.mGrid[CellKey(s.mPos.x, s.mPos.y)].push_back(i);
+    // Stock it right away
+    Stock(i);
+    // Return the index of the new spawn
+    return static_cast< SQInteger >(i);
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Collect(SQInteger spawn)
+{
+    LootSpawn & s = ValidSpawn(spawn);
+    // Is it materialized?
+    if (s.mLive != NIL)
+    {
+        Unlink(s);
+    }
+    // The item now belongs to whoever collected it
+    s.mItem.Release();
+    s.mFactory = NIL;
+    // Schedule the spawn to be stocked again
+    const int64_t interval = m_Regions[m_Clusters[s.mCluster].mRegion].mInterval;
+    // Should it be stocked on the next frame?
+    if (interval <= 0)
+    {
+        m_Restock.push_back(static_cast< uint32_t >(spawn));
+    }
+    else
+    {
+        m_Timers.Arm(static_cast< uint32_t >(spawn), interval);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Respawn(SQInteger spawn)
+{
+    // Get rid of the current item, if any
+    if (ValidSpawn(spawn).mLive != NIL)
+    {
+        Dematerialize(static_cast< uint32_t >(spawn));
+    }
+    // The script may have cleared everything while deleting the item
+    ValidSpawn(spawn).mFactory = NIL;
+    // Cancel any pending timer and stock it on the next frame
+    m_Timers.Disarm(static_cast< uint32_t >(spawn));
+    m_Restock.push_back(static_cast< uint32_t >(spawn));
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger LootManager::GetSpawnFactory(SQInteger spawn)
+{
+    const LootSpawn & s = ValidSpawn(spawn);
+    // Is the spawn stocked?
+    return s.mFactory == NIL ? -1 : m_Factories[s.mFactory].mID;
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Stock(uint32_t spawn)
+{
+    LootSpawn & s = m_Spawns[spawn];
+    // Is it already stocked? (duplicate requests are possible)
+    if (s.mFactory != NIL)
+    {
+        return;
+    }
+    // Pick a factory from the cluster
+    s.mFactory = m_Clusters[s.mCluster].Sample();
+    // Was a player near this spawn during the last scan?
+    if (s.mFactory != NIL && m_Scan != 0 && s.mSeen == m_Scan)
+    {
+        m_Create.push_back(spawn);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Materialize(uint32_t spawn)
+{
+    // The callback may add or remove spawns and factories so, don't keep references across it
+    const Vector3 pos = m_Spawns[spawn].mPos;
+    const uint32_t factory = m_Spawns[spawn].mFactory;
+    const SQInteger id = m_Factories[factory].mID;
+    Function create = m_Factories[factory].mCreate;
+    LightObj item;
+    // Let the script create the item
+    if (!create.IsNull())
+    {
+        item = create.Eval(static_cast< SQInteger >(spawn), id, pos.x, pos.y, pos.z);
+    }
+    // Was the spawn removed, emptied or materialized by the callback?
+    if (spawn >= m_Spawns.size() || m_Spawns[spawn].mFactory != factory || m_Spawns[spawn].mLive != NIL)
+    {
+        return;
+    }
+    LootSpawn & s = m_Spawns[spawn];
+    s.mItem = std::move(item);
+    // Remember that it was materialized
+    s.mLive = static_cast< uint32_t >(m_Live.size());
+    m_Live.push_back(spawn);
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Dematerialize(uint32_t spawn)
+{
+    LootSpawn & s = m_Spawns[spawn];
+    // No longer materialized
+    Unlink(s);
+    // Take ownership of the item
+    LightObj item(s.mItem);
+    s.mItem.Release();
+    // The callback may add or remove factories so, don't keep references across it
+    Function del = m_Factories[s.mFactory].mDelete;
+    // Let the script delete the item
+    if (!del.IsNull())
+    {
+        del.Execute(static_cast< SQInteger >(spawn), item);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Unlink(LootSpawn & s)
+{
+    const uint32_t last = m_Live.back();
+    // Move the last materialized spawn in place of this one
+    m_Live[s.mLive] = last;
+    m_Spawns[last].mLive = s.mLive;
+    m_Live.pop_back();
+    // No longer materialized
+    s.mLive = NIL;
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Scan()
+{
+    // Zero is reserved for spawns that were never seen
+    if (++m_Scan == 0)
+    {
+        m_Scan = 1;
+    }
+    // Previous results are no longer relevant
+    m_Create.clear();
+    m_Release.clear();
+    // Anything to look for?
+    if (m_Spawns.empty())
+    {
+        return;
+    }
+    const float r2 = m_Radius * m_Radius;
+    // Look for spawns near each active player
+    ForeachActivePlayer([&](const PlayerInst & inst) {
+        const Vector3 & pos = inst.mLastPosition;
+        // Go over regions that could contain nearby spawns
+        for (auto & r : m_Regions)
+        {
+            if (!r.mEnabled || !r.Near(pos, m_Radius))
+            {
+                continue;
+            }
+            const auto cx = static_cast< int32_t >(std::floor(pos.x / m_Radius));
+            const auto cy = static_cast< int32_t >(std::floor(pos.y / m_Radius));
+            // Since cells are as large as the radius, only the neighbouring cells must be checked
+            for (int32_t x = cx - 1; x <= cx + 1; ++x)
+            {
+                for (int32_t y = cy - 1; y <= cy + 1; ++y)
+                {
+                    auto itr = r.mGrid.find((static_cast< uint64_t >(static_cast< uint32_t >(x)) << 32u) | static_cast< uint32_t >(y));
+                    // Any spawns in this cell?
+                    if (itr == r.mGrid.end())
+                    {
+                        continue;
+                    }
+                    for (const uint32_t i : itr->second)
+                    {
+                        LootSpawn & s = m_Spawns[i];
+                        // Already found near another player?
+                        if (s.mSeen == m_Scan)
+                        {
+                            continue;
+                        }
+                        const float dx = s.mPos.x - pos.x, dy = s.mPos.y - pos.y, dz = s.mPos.z - pos.z;
+                        // Is it close enough?
+                        if ((dx * dx + dy * dy + dz * dz) > r2)
+                        {
+                            continue;
+                        }
+                        s.mSeen = m_Scan;
+                        // Should it be materialized?
+                        if (s.mFactory != NIL && s.mLive == NIL)
+                        {
+                            m_Create.push_back(i);
+                        }
+                    }
+                }
+            }
+        }
+    });
+    // Materialized spawns that were not found have no players near them
+    for (const uint32_t i : m_Live)
+    {
+        if (m_Spawns[i].mSeen != m_Scan)
+        {
+            m_Release.push_back(i);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Process(int64_t now)
+{
+    // Is this the first time?
+    if (m_Time == 0)
+    {
+        m_Time = now;
+    }
+    const int64_t delta = now - m_Time;
+    m_Time = now;
+    // Collect the spawns whose timer expired
+    m_Timers.Advance(delta, [this](TimerQueue::Slot slot) -> TimerQueue::Time {
+        m_Restock.push_back(slot);
+        // Timers do not repeat
+        return 0;
+    });
+    // Stock a batch of empty spawns
+    if (!m_Restock.empty())
+    {
+        const size_t n = std::min(m_Restock.size(), static_cast< size_t >(m_Budget));
+        // Process them in the order they expired
+        for (size_t i = 0; i < n; ++i)
+        {
+            Stock(m_Restock[i]);
+        }
+        m_Restock.erase(m_Restock.begin(), m_Restock.begin() + static_cast< ptrdiff_t >(n));
+    }
+    // Is it time to look for players?
+    if (now >= m_NextScan)
+    {
+        Scan();
+        // Schedule the next scan
+        m_NextScan = now + m_ScanInterval;
+    }
+    // Materialize a batch of stocked spawns near players
+    for (uint32_t n = 0; n < m_Budget && !m_Create.empty();)
+    {
+        const uint32_t i = m_Create.back();
+        m_Create.pop_back();
+        const LootSpawn & s = m_Spawns[i];
+        // Did anything change since it was queued?
+        if (s.mFactory != NIL && s.mLive == NIL && s.mSeen == m_Scan)
+        {
+            Materialize(i);
+            ++n;
+        }
+    }
+    // Dematerialize a batch of spawns with no players near them
+    for (uint32_t n = 0; n < m_Budget && !m_Release.empty();)
+    {
+        const uint32_t i = m_Release.back();
+        m_Release.pop_back();
+        const LootSpawn & s = m_Spawns[i];
+        // Did anything change since it was queued?
+        if (s.mLive != NIL && s.mSeen != m_Scan)
+        {
+            Dematerialize(i);
+            ++n;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Clear()
+{
+    // Let the script delete every materialized item
+    while (!m_Live.empty())
+    {
+        Dematerialize(m_Live.back());
+    }
+    // Forget about everything
+    m_Factories.clear();
+    m_FactoryIndex.clear();
+    m_Regions.clear();
+    m_Clusters.clear();
+    m_Spawns.clear();
+    m_Timers.Clear();
+    m_Restock.clear();
+    m_Create.clear();
+    m_Release.clear();
+    m_NextScan = 0;
+    m_Scan = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Terminate()
+{
+    // Release script objects held by spawns
+    for (auto & s : m_Spawns)
+    {
+        s.mItem.Release();
+        s.mLive = NIL;
+    }
+    // Release script objects held by factories
+    for (auto & f : m_Factories)
+    {
+        f.mData.Release();
+        f.mCreate.Release();
+        f.mDelete.Release();
+    }
+    // Release script objects held by clusters and regions
+    for (auto & c : m_Clusters)
+    {
+        c.mData.Release();
+    }
+    for (auto & r : m_Regions)
+    {
+        r.mData.Release();
+    }
+    m_Live.clear();
+    // Release script objects held by the manager
+    m_Data.Release();
+    // Clear the containers as well
+    Clear();
+}
 
 // ================================================================================================
 void Register_Loot(HSQUIRRELVM vm)
 {
+    Table ns(vm);
+
+    // --------------------------------------------------------------------------------------------
+    ns.Bind(_SC("Manager"),
+        Class< LootManager, NoCopy< LootManager > >(vm, ManagerTn::Str)
+        // Constructors
+        .Ctor()
+        // Meta-methods
+        .SquirrelFunc(_SC("_typename"), &ManagerTn::Fn)
+        // Properties
+        .Prop(_SC("Tag"), &LootManager::GetTag, &LootManager::SetTag)
+        .Prop(_SC("Data"), &LootManager::GetData, &LootManager::SetData)
+        .Prop(_SC("Radius"), &LootManager::GetRadius, &LootManager::SetRadius)
+        .Prop(_SC("Budget"), &LootManager::GetBudget, &LootManager::SetBudget)
+        .Prop(_SC("ScanInterval"), &LootManager::GetScanInterval, &LootManager::SetScanInterval)
+        .Prop(_SC("Factories"), &LootManager::GetFactories)
+        .Prop(_SC("Regions"), &LootManager::GetRegions)
+        .Prop(_SC("Clusters"), &LootManager::GetClusters)
+        .Prop(_SC("Spawns"), &LootManager::GetSpawns)
+        .Prop(_SC("Materialized"), &LootManager::GetMaterialized)
+        .Prop(_SC("Waiting"), &LootManager::GetWaiting)
+        // Definition Methods
+        .Func(_SC("DefineFactory"), &LootManager::DefineFactory)
+        .Func(_SC("HaveFactory"), &LootManager::HaveFactory)
+        .Func(_SC("AddRegion"), &LootManager::AddRegion)
+        .Func(_SC("SetRegionEnabled"), &LootManager::SetRegionEnabled)
+        .Func(_SC("SetRegionInterval"), &LootManager::SetRegionInterval)
+        .Func(_SC("AddCluster"), &LootManager::AddCluster)
+        .Func(_SC("AddClusterFactory"), &LootManager::AddClusterFactory)
+        .Func(_SC("AddSpawn"), &LootManager::AddSpawn)
+        // Spawn Methods
+        .Func(_SC("Collect"), &LootManager::Collect)
+        .Func(_SC("Respawn"), &LootManager::Respawn)
+        .Func(_SC("SpawnItem"), &LootManager::GetSpawnItem)
+        .Func(_SC("SpawnFactory"), &LootManager::GetSpawnFactory)
+        .Func(_SC("SpawnMaterialized"), &LootManager::IsSpawnMaterialized)
+        .Func(_SC("Clear"), &LootManager::Clear)
+    );
 
+    RootTable(vm).Bind(_SC("SqLoot"), ns);
 }
 
 } // Namespace:: SqMod
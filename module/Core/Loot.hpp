@@ -2,6 +2,7 @@
 
 // ------------------------------------------------------------------------------------------------
 #include "Core/Utility.hpp"
+#include "Core/TimerQueue.hpp"
 #include "Base/Vector3.hpp"
 #include "Base/Quaternion.hpp"
 
@@ -10,6 +11,9 @@
 #include <vector>
 #include <random>
 #include <chrono>
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
@@ -68,8 +72,21 @@ struct LootFactory
 */
 struct LootSpawn
 {
+    // --------------------------------------------------------------------------------------------
+    static constexpr uint32_t NIL = std::numeric_limits< uint32_t >::max(); // Invalid index.
+
+    // --------------------------------------------------------------------------------------------
     Vector3     mPos; // Spawn position
 
+    // --------------------------------------------------------------------------------------------
+    uint32_t    mCluster{NIL}; // Index of the cluster that owns this spawn.
+    uint32_t    mFactory{NIL}; // Index of the factory of the stocked item. NIL if empty.
+    uint32_t    mLive{NIL}; // Position inside the list of materialized spawns. NIL if not materialized.
+    uint32_t    mSeen{0}; // Last proximity scan that found a player near this spawn.
+
+    // --------------------------------------------------------------------------------------------
+    LightObj    mItem{}; // Item created by the factory while materialized.
+
     /* --------------------------------------------------------------------------------------------
      * Default constructor.
     */
@@ -104,11 +121,22 @@ struct LootSpawn
 /* ------------------------------------------------------------------------------------------------
  * Defines a cluster of loot spawns with little space in between where associated items can be spawned.
 */
-class LootCluster
+struct LootCluster
 {
     // --------------------------------------------------------------------------------------------
+    uint32_t    mRegion{LootSpawn::NIL}; // Index of the region that owns this cluster.
     LightObj    mData; // User data associated with this instance.
 
+    // --------------------------------------------------------------------------------------------
+    std::vector< uint32_t >     mSpawns{}; // Indexes of the spawns from this cluster.
+    std::vector< uint32_t >     mFactories{}; // Indexes of the factories that can stock this cluster.
+    std::vector< double >       mWeights{}; // Weight of each factory.
+
+    // --------------------------------------------------------------------------------------------
+    std::vector< double >       mProb{}; // Alias table probabilities.
+    std::vector< uint32_t >     mAlias{}; // Alias table aliases.
+    bool                        mDirty{false}; // Whether the alias table must be rebuilt.
+
     /* --------------------------------------------------------------------------------------------
      * Default constructor.
     */
@@ -138,17 +166,42 @@ class LootCluster
      * Copy assignment operator. (disabled)
     */
     LootCluster & operator = (LootCluster && o) noexcept = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Rebuild the alias table from the factory weights.
+    */
+    void Rebuild();
+
+    /* --------------------------------------------------------------------------------------------
+     * Pick a factory index according to the weights in constant time. NIL if there are none.
+    */
+    SQMOD_NODISCARD uint32_t Sample();
 };
 
 /* ------------------------------------------------------------------------------------------------
  * Defines a region of loot clusters where various attributes can be influenced globally.
 */
-class LootRegion
+struct LootRegion
 {
+    // --------------------------------------------------------------------------------------------
+    typedef std::unordered_map< uint64_t, std::vector< uint32_t > > Grid; // Spawns in each grid cell.
+
     // --------------------------------------------------------------------------------------------
     String      mTag; // User tag associated with this instance.
     LightObj    mData; // User data associated with this instance.
 
+    // --------------------------------------------------------------------------------------------
+    int64_t     mInterval{0}; // Milliseconds until an empty spawn is stocked again.
+    bool        mEnabled{true}; // Whether spawns from this region are materialized.
+
+    // --------------------------------------------------------------------------------------------
+    Vector3     mMin{}; // Lower corner of the box that contains all spawns.
+    Vector3     mMax{}; // Upper corner of the box that contains all spawns.
+    bool        mEmpty{true}; // Whether the region has no spawns yet.
+
+    // --------------------------------------------------------------------------------------------
+    Grid        mGrid{}; // Spatial index of the spawns from this region.
+
     /* --------------------------------------------------------------------------------------------
      * Default constructor.
     */
@@ -178,19 +231,59 @@ class LootRegion
      * Copy assignment operator. (disabled)
     */
     LootRegion & operator = (LootRegion && o) noexcept = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Check whether a point could be within a certain distance of a spawn from this region.
+    */
+    SQMOD_NODISCARD bool Near(const Vector3 & pos, float distance) const
+    {
+        return !mEmpty &&
+                pos.x >= (mMin.x - distance) && pos.x <= (mMax.x + distance) &&
+                pos.y >= (mMin.y - distance) && pos.y <= (mMax.y + distance);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Grow the bounding box to contain the specified point.
+    */
+    void Extend(const Vector3 & pos)
+    {
+        if (mEmpty)
+        {
+            mMin = mMax = pos;
+            mEmpty = false;
+        }
+        else
+        {
+            mMin.x = std::min(mMin.x, pos.x), mMin.y = std::min(mMin.y, pos.y), mMin.z = std::min(mMin.z, pos.z);
+            mMax.x = std::max(mMax.x, pos.x), mMax.y = std::max(mMax.y, pos.y), mMax.z = std::max(mMax.z, pos.z);
+        }
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
  * Loot distribution utility.
+ * Spawns are indexed in a uniform grid per region and only the ones near a player are materialized.
+ * Empty spawns are stocked again through a timer queue and expired timers are processed in batches.
 */
-class LootManager
+class LootManager : public SqChainedInstances< LootManager >
 {
 public:
 
+    // --------------------------------------------------------------------------------------------
+    static constexpr uint32_t NIL = LootSpawn::NIL; // Invalid index.
+
     /* --------------------------------------------------------------------------------------------
      * Default constructor.
     */
-    LootManager() = default;
+    LootManager()
+        : m_Factories(), m_FactoryIndex(), m_Regions(), m_Clusters(), m_Spawns()
+        , m_Timers(), m_Restock(), m_Create(), m_Release(), m_Live()
+        , m_Radius(100.0f), m_Budget(32), m_ScanInterval(500), m_NextScan(0), m_Time(0), m_Scan(0)
+        , m_Tag(), m_Data()
+    {
+        // Remember this instance
+        ChainInstance();
+    }
 
     /* --------------------------------------------------------------------------------------------
      * Copy constructor. (disabled)
@@ -205,7 +298,11 @@ public:
     /* --------------------------------------------------------------------------------------------
      * Destructor.
     */
-    ~LootManager() = default;
+    ~LootManager()
+    {
+        // Forget about this instance
+        UnchainInstance();
+    }
 
     /* --------------------------------------------------------------------------------------------
      * Copy assignment operator. (disabled)
@@ -217,8 +314,234 @@ public:
     */
     LootManager & operator = (LootManager && o) = delete;
 
+    /* --------------------------------------------------------------------------------------------
+     * Release all script resources without invoking any callbacks.
+    */
+    void Terminate();
+
+    /* --------------------------------------------------------------------------------------------
+     * Advance the timers and perform the pending work allowed by the budget.
+    */
+    void Process(int64_t now);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the associated user tag.
+    */
+    SQMOD_NODISCARD const String & GetTag() const { return m_Tag; }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the associated user tag.
+    */
+    void SetTag(StackStrF & tag) { m_Tag.assign(tag.mPtr, static_cast< size_t >(tag.mLen)); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the associated user data.
+    */
+    SQMOD_NODISCARD LightObj & GetData() { return m_Data; }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the associated user data.
+    */
+    void SetData(LightObj & data) { m_Data = data; }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the distance from a player within which spawns are materialized.
+    */
+    SQMOD_NODISCARD SQFloat GetRadius() const { return static_cast< SQFloat >(m_Radius); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the distance from a player within which spawns are materialized.
+    */
+    void SetRadius(SQFloat radius);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the maximum number of spawns stocked, materialized or released in a single frame.
+    */
+    SQMOD_NODISCARD SQInteger GetBudget() const { return static_cast< SQInteger >(m_Budget); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the maximum number of spawns stocked, materialized or released in a single frame.
+    */
+    void SetBudget(SQInteger budget) { m_Budget = static_cast< uint32_t >(std::max< SQInteger >(budget, 1)); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the milliseconds between proximity scans.
+    */
+    SQMOD_NODISCARD SQInteger GetScanInterval() const { return static_cast< SQInteger >(m_ScanInterval); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the milliseconds between proximity scans.
+    */
+    void SetScanInterval(SQInteger interval) { m_ScanInterval = std::max< SQInteger >(interval, 0); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of defined factories.
+    */
+    SQMOD_NODISCARD SQInteger GetFactories() const { return static_cast< SQInteger >(m_Factories.size()); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of regions.
+    */
+    SQMOD_NODISCARD SQInteger GetRegions() const { return static_cast< SQInteger >(m_Regions.size()); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of clusters.
+    */
+    SQMOD_NODISCARD SQInteger GetClusters() const { return static_cast< SQInteger >(m_Clusters.size()); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of spawns.
+    */
+    SQMOD_NODISCARD SQInteger GetSpawns() const { return static_cast< SQInteger >(m_Spawns.size()); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of currently materialized spawns.
+    */
+    SQMOD_NODISCARD SQInteger GetMaterialized() const { return static_cast< SQInteger >(m_Live.size()); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of empty spawns waiting to be stocked.
+    */
+    SQMOD_NODISCARD SQInteger GetWaiting() const { return static_cast< SQInteger >(m_Timers.Armed() + m_Restock.size()); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Define a factory or replace the callbacks of an existing one.
+    */
+    void DefineFactory(SQInteger id, SQInteger type, SQInteger cls, Function & create, Function & del);
+
+    /* --------------------------------------------------------------------------------------------
+     * Check whether a factory with the specified identifier was defined.
+    */
+    SQMOD_NODISCARD bool HaveFactory(SQInteger id) const { return m_FactoryIndex.find(id) != m_FactoryIndex.end(); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Create a region with the specified restock interval (milliseconds) and return its index.
+    */
+    SQInteger AddRegion(SQInteger interval);
+
+    /* --------------------------------------------------------------------------------------------
+     * Enable or disable materialization of the spawns from a region.
+    */
+    void SetRegionEnabled(SQInteger region, bool toggle);
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the restock interval (milliseconds) of a region.
+    */
+    void SetRegionInterval(SQInteger region, SQInteger interval);
+
+    /* --------------------------------------------------------------------------------------------
+     * Create a cluster inside the specified region and return its index.
+    */
+    SQInteger AddCluster(SQInteger region);
+
+    /* --------------------------------------------------------------------------------------------
+     * Allow a factory to stock the spawns from a cluster with the specified weight.
+    */
+    void AddClusterFactory(SQInteger cluster, SQInteger factory, SQFloat weight);
+
+    /* --------------------------------------------------------------------------------------------
+     * Create a spawn inside the specified cluster and return its index. The spawn is stocked right away.
+    */
+    SQInteger AddSpawn(SQInteger cluster, SQFloat x, SQFloat y, SQFloat z);
+
+    /* --------------------------------------------------------------------------------------------
+     * Mark a spawn as looted. The item is forgotten (without deleting it) and the spawn is stocked
+     * again once the interval of its region elapses.
+    */
+    void Collect(SQInteger spawn);
+
+    /* --------------------------------------------------------------------------------------------
+     * Stock a spawn again as soon as possible, discarding the current item.
+    */
+    void Respawn(SQInteger spawn);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the item of a materialized spawn. Null otherwise.
+    */
+    SQMOD_NODISCARD LightObj & GetSpawnItem(SQInteger spawn) { return ValidSpawn(spawn).mItem; }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the identifier of the factory that stocked a spawn. -1 if empty.
+    */
+    SQMOD_NODISCARD SQInteger GetSpawnFactory(SQInteger spawn);
+
+    /* --------------------------------------------------------------------------------------------
+     * Check whether a spawn is currently materialized.
+    */
+    SQMOD_NODISCARD bool IsSpawnMaterialized(SQInteger spawn) { return ValidSpawn(spawn).mLive != NIL; }
+
+    /* --------------------------------------------------------------------------------------------
+     * Delete all materialized items and forget about everything.
+    */
+    void Clear();
+
 private:
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the spawn with the specified index or throw an error.
+    */
+    LootSpawn & ValidSpawn(SQInteger spawn);
+
+    /* --------------------------------------------------------------------------------------------
+     * Compute the grid cell key of the specified coordinates.
+    */
+    SQMOD_NODISCARD uint64_t CellKey(float x, float y) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Rebuild the spatial index of every region.
+    */
+    void Reindex();
+
+    /* --------------------------------------------------------------------------------------------
+     * Pick a factory for an empty spawn.
+    */
+    void Stock(uint32_t spawn);
+
+    /* --------------------------------------------------------------------------------------------
+     * Invoke the create callback of the stocked factory.
+    */
+    void Materialize(uint32_t spawn);
+
+    /* --------------------------------------------------------------------------------------------
+     * Invoke the delete callback of the stocked factory and forget about the item.
+    */
+    void Dematerialize(uint32_t spawn);
+
+    /* --------------------------------------------------------------------------------------------
+     * Remove a spawn from the list of materialized spawns.
+    */
+    void Unlink(LootSpawn & s);
+
+    /* --------------------------------------------------------------------------------------------
+     * Find the stocked spawns near players and the materialized spawns that no longer are.
+    */
+    void Scan();
+
+    // --------------------------------------------------------------------------------------------
+    std::vector< LootFactory >                  m_Factories; // Defined factories.
+    std::unordered_map< SQInteger, uint32_t >   m_FactoryIndex; // Factory identifier to index.
+    std::vector< LootRegion >                   m_Regions; // Created regions.
+    std::vector< LootCluster >                  m_Clusters; // Created clusters.
+    std::vector< LootSpawn >                    m_Spawns; // Created spawns.
+
+    // --------------------------------------------------------------------------------------------
+    TimerQueue                                  m_Timers; // Restock timers of empty spawns.
+    std::vector< uint32_t >                     m_Restock; // Spawns whose timer expired.
+    std::vector< uint32_t >                     m_Create; // Spawns that must be materialized.
+    std::vector< uint32_t >                     m_Release; // Spawns that must be dematerialized.
+    std::vector< uint32_t >                     m_Live; // Spawns that are currently materialized.
+
+    // --------------------------------------------------------------------------------------------
+    float                                       m_Radius; // Materialization distance and grid cell size.
+    uint32_t                                    m_Budget; // Maximum work items per frame for each queue.
+    int64_t                                     m_ScanInterval; // Milliseconds between proximity scans.
+    int64_t                                     m_NextScan; // Time of the next proximity scan.
+    int64_t                                     m_Time; // Time of the last processing.
+    uint32_t                                    m_Scan; // Stamp of the last proximity scan.
+
+    // --------------------------------------------------------------------------------------------
+    String                                      m_Tag; // User tag associated with this instance.
+    LightObj                                    m_Data; // User data associated with this instance.
 };
 
 } // Namespace:: SqMod
@@ -0,0 +1,475 @@
+// ------------------------------------------------------------------------------------------------
+#include "Core/Metrics.hpp"
+#include "Core/Signal.hpp"
+#include "Core/ThreadPool.hpp"
+#include "Core.hpp"
+#include "Logger.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <squirrelex.h>
+#include <civetweb.h>
+
+// ------------------------------------------------------------------------------------------------
+#include <cstring>
+#include <iterator>
+
+// ------------------------------------------------------------------------------------------------
+namespace SqMod {
+
+// ------------------------------------------------------------------------------------------------
+Metrics Metrics::s_Inst;
+
+// ------------------------------------------------------------------------------------------------
+static const char * g_LaneNames[TPLANE_COUNT] = {"high", "normal", "low"};
+static const char * g_EntityNames[7] = {"blip", "checkpoint", "keybind", "object", "pickup", "player", "vehicle"};
+
+// ------------------------------------------------------------------------------------------------
+void ProcessMetrics()
+{
+    Metrics::Get().Process();
+}
+
+// ------------------------------------------------------------------------------------------------
+void TerminateMetrics()
+{
+    Metrics::Get().Terminate();
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Append a string to a JSON document, with quotes and the necessary escapes.
+*/
+static void JSONString(String & out, const char * str, size_t len)
+{
+    out.push_back('"');
+    for (size_t i = 0; i < len; ++i)
+    {
+        const auto c = static_cast< unsigned char >(str[i]);
+        switch (c)
+        {
+            case '"': out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            default:
+            {
+                // Remaining control characters must be escaped as well
+                if (c < 0x20)
+                {
+                    fmt::format_to(std::back_inserter(out), "\\u{:04x}", c);
+                }
+                else
+                {
+                    out.push_back(static_cast< char >(c));
+                }
+            }
+        }
+    }
+    out.push_back('"');
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Append a label value to a Prometheus document, with quotes and the necessary escapes.
+*/
+static void PromLabel(String & out, const char * str, size_t len)
+{
+    out.push_back('"');
+    for (size_t i = 0; i < len; ++i)
+    {
+        switch (str[i])
+        {
+            case '"': out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\n': out.append("\\n"); break;
+            default: out.push_back(str[i]);
+        }
+    }
+    out.push_back('"');
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Append the series of a histogram to a Prometheus document. Labels must end with a comma, if any.
+*/
+static void PromHistogram(String & out, const char * name, const String & labels, const MetricTimes & t)
+{
+    uint64_t count = 0;
+    // Buckets are cumulative
+    for (size_t b = 0; b < METRICS_BUCKETS - 1; ++b)
+    {
+        count += t.mHistogram[b].load(std::memory_order_relaxed);
+        fmt::format_to(std::back_inserter(out), "{}_bucket{{{}le=\"{}\"}} {}\n", name, labels,
+                       static_cast< double >(UINT64_C(1) << b) / 1000000.0, count);
+    }
+    // The count is taken from the buckets so that the series stay consistent with each other
+    count += t.mHistogram[METRICS_BUCKETS - 1].load(std::memory_order_relaxed);
+    fmt::format_to(std::back_inserter(out), "{}_bucket{{{}le=\"+Inf\"}} {}\n", name, labels, count);
+    // Labels without the trailing comma
+    const size_t len = labels.empty() ? 0 : labels.size() - 1;
+    fmt::format_to(std::back_inserter(out), "{}_sum{{{}}} {}\n", name, labels.substr(0, len),
+                   static_cast< double >(t.mTotal.load(std::memory_order_relaxed)) / 1000000.0);
+    fmt::format_to(std::back_inserter(out), "{}_count{{{}}} {}\n", name, labels.substr(0, len), count);
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Append the header of a metric family to a Prometheus document.
+*/
+static void PromFamily(String & out, const char * name, const char * type, const char * help)
+{
+    fmt::format_to(std::back_inserter(out), "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Append timing statistics to a JSON document.
+*/
+static void JSONTimes(String & out, const MetricTimes & t)
+{
+    fmt::format_to(std::back_inserter(out), "{{\"calls\":{},\"total_us\":{},\"max_us\":{},\"histogram\":[",
+                   t.mCalls.load(std::memory_order_relaxed), t.mTotal.load(std::memory_order_relaxed),
+                   t.mMax.load(std::memory_order_relaxed));
+    for (size_t b = 0; b < METRICS_BUCKETS; ++b)
+    {
+        fmt::format_to(std::back_inserter(out), b ? ",{}" : "{}", t.mHistogram[b].load(std::memory_order_relaxed));
+    }
+    out.append("]}");
+}
+
+// ------------------------------------------------------------------------------------------------
+Metrics::Metrics() noexcept
+    : m_Server(nullptr)
+    , m_Enabled(false)
+    , m_Frame()
+    , m_Tick()
+    , m_Events()
+    , m_EventCount(0)
+    , m_Snapshot()
+    , m_Interval(1000)
+    , m_Next()
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+Metrics::~Metrics()
+{
+    Terminate();
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Metrics::Initialize(const char * listen, const char * acl, long interval, long tail)
+{
+    // Already started?
+    if (m_Server != nullptr)
+    {
+        return true;
+    }
+    // Server options
+    const char * options[] = {
+        "listening_ports", listen,
+        "num_threads", "2",
+        "request_timeout_ms", "10000",
+        // Only include the access control list if there is one
+        (acl && *acl) ? "access_control_list" : nullptr, acl,
+        nullptr
+    };
+    mg_callbacks callbacks;
+    std::memset(&callbacks, 0, sizeof(callbacks));
+    // Attempt to start the server
+    m_Server = mg_start(&callbacks, nullptr, options);
+    // Was the server started?
+    if (m_Server == nullptr)
+    {
+        LogErr("Unable to start the metrics server on (%s)", listen);
+        // Can't serve anything
+        return false;
+    }
+    // Every request goes through the same handler
+    mg_set_request_handler(m_Server, "/", &Metrics::OnRequest, this);
+    // Configure how often snapshots are published
+    m_Interval = std::chrono::milliseconds(std::max(interval, 100L));
+    m_Next = std::chrono::steady_clock::now();
+    // Configure how many log messages are included
+    Logger::Get().SetTailSize(static_cast< size_t >(std::max(tail, 0L)));
+    // Start recording timings
+    m_Enabled = true;
+    // Server started
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Metrics::Terminate()
+{
+    // Stop recording timings
+    m_Enabled = false;
+    // Is there a server to stop?
+    if (m_Server != nullptr)
+    {
+        // Will block until the pending requests are answered
+        mg_stop(m_Server);
+        m_Server = nullptr;
+        // No need to remember log messages anymore
+        Logger::Get().SetTailSize(0);
+    }
+    // Release the last snapshot
+    std::atomic_store(&m_Snapshot, Snapshot{});
+}
+
+// ------------------------------------------------------------------------------------------------
+MetricTimes & Metrics::Event(const char * name)
+{
+    // Where events go once the limit was reached
+    static MetricTimes s_Discarded;
+    // Only the server thread adds events so, no one else can take this slot
+    const size_t n = m_EventCount.load(std::memory_order_relaxed);
+    // Is there room for another event?
+    if (n >= MAX_METRIC_EVENTS)
+    {
+        return s_Discarded;
+    }
+    m_Events[n].mName = name;
+    // Make the event visible to the request handlers
+    m_EventCount.store(n + 1, std::memory_order_release);
+    // Return the statistics of this event
+    return m_Events[n].mTimes;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Metrics::Process()
+{
+    // Is there anyone to publish for?
+    if (m_Server == nullptr)
+    {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    // Is it time for a new snapshot?
+    if (now < m_Next)
+    {
+        return;
+    }
+    m_Next = now + m_Interval;
+    // Create the snapshot
+    auto snap = std::make_shared< MetricsSnapshot >();
+    snap->mTime = std::chrono::duration_cast< std::chrono::milliseconds >(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+    // Collect the allocator statistics of the virtual machine
+    SQMemStats st;
+    sq_getmemstats(&st);
+    snap->mVMBackend.assign(st.backend);
+    snap->mVMLiveBytes = st.live_bytes;
+    snap->mVMPeakBytes = st.peak_bytes;
+    snap->mVMLiveBlocks = st.live_blocks;
+    snap->mVMAllocations = st.allocations;
+    snap->mVMReservedBytes = st.reserved_bytes;
+    // Count the active entities
+    const auto count = [](size_t & n) { return [&n](const auto &) { ++n; }; };
+    ForeachActiveEntity(Core::Get().GetBlips(), count(snap->mEntities[0]));
+    ForeachActiveEntity(Core::Get().GetCheckpoints(), count(snap->mEntities[1]));
+    ForeachActiveEntity(Core::Get().GetKeyBinds(), count(snap->mEntities[2]));
+    ForeachActiveEntity(Core::Get().GetObjs(), count(snap->mEntities[3]));
+    ForeachActiveEntity(Core::Get().GetPickups(), count(snap->mEntities[4]));
+    ForeachActiveEntity(Core::Get().GetPlayers(), count(snap->mEntities[5]));
+    ForeachActiveEntity(Core::Get().GetVehicles(), count(snap->mEntities[6]));
+    // Collect the emission costs of the signals
+    std::vector< Signal::ProfileSample > samples;
+    Signal::SampleProfiles(samples);
+    snap->mSignals.reserve(samples.size());
+    for (auto & s : samples)
+    {
+        snap->mSignals.push_back(MetricsSnapshot::SignalCost{std::move(s.mName), s.mCalls, s.mTotal, s.mMax});
+    }
+    // Collect the recent log messages
+    Logger::Get().GetTail(snap->mLog);
+    // Publish the snapshot
+    std::atomic_store(&m_Snapshot, Snapshot(std::move(snap)));
+}
+
+// ------------------------------------------------------------------------------------------------
+void Metrics::ToPrometheus(String & out, const MetricsSnapshot & snap) const
+{
+    // Server frames
+    PromFamily(out, "sqmod_frame_seconds", "histogram", "Time spent by the plug-in in each server frame.");
+    PromHistogram(out, "sqmod_frame_seconds", String(), m_Frame);
+    PromFamily(out, "sqmod_tick_seconds", "histogram", "Time between server frames, as reported by the server.");
+    PromHistogram(out, "sqmod_tick_seconds", String(), m_Tick);
+    // Server events
+    PromFamily(out, "sqmod_event_seconds", "histogram", "Time spent by the plug-in in each server event.");
+    const size_t events = m_EventCount.load(std::memory_order_acquire);
+    String labels;
+    for (size_t i = 0; i < events; ++i)
+    {
+        labels.assign("event=");
+        PromLabel(labels, m_Events[i].mName, std::strlen(m_Events[i].mName));
+        labels.push_back(',');
+        PromHistogram(out, "sqmod_event_seconds", labels, m_Events[i].mTimes);
+    }
+    // Signals
+    PromFamily(out, "sqmod_signal_seconds_total", "counter", "Time spent in signal emissions, while profiling.");
+    for (const auto & s : snap.mSignals)
+    {
+        labels.assign("signal=");
+        PromLabel(labels, s.mName.data(), s.mName.size());
+        fmt::format_to(std::back_inserter(out), "sqmod_signal_seconds_total{{{}}} {}\n", labels, static_cast< double >(s.mTotal) / 1000000.0);
+    }
+    PromFamily(out, "sqmod_signal_emissions_total", "counter", "Signal emissions, while profiling.");
+    for (const auto & s : snap.mSignals)
+    {
+        labels.assign("signal=");
+        PromLabel(labels, s.mName.data(), s.mName.size());
+        fmt::format_to(std::back_inserter(out), "sqmod_signal_emissions_total{{{}}} {}\n", labels, s.mCalls);
+    }
+    PromFamily(out, "sqmod_signal_max_seconds", "gauge", "Longest signal emission, while profiling.");
+    for (const auto & s : snap.mSignals)
+    {
+        labels.assign("signal=");
+        PromLabel(labels, s.mName.data(), s.mName.size());
+        fmt::format_to(std::back_inserter(out), "sqmod_signal_max_seconds{{{}}} {}\n", labels, static_cast< double >(s.mMax) / 1000000.0);
+    }
+    // Thread pool
+    ThreadPool::LaneInfo lanes[TPLANE_COUNT];
+    for (size_t i = 0; i < TPLANE_COUNT; ++i)
+    {
+        lanes[i] = ThreadPool::Get().GetLaneInfo(static_cast< ThreadPoolLane >(i));
+    }
+    PromFamily(out, "sqmod_pool_depth", "gauge", "Tasks waiting in each thread pool lane.");
+    for (size_t i = 0; i < TPLANE_COUNT; ++i)
+    {
+        fmt::format_to(std::back_inserter(out), "sqmod_pool_depth{{lane=\"{}\"}} {}\n", g_LaneNames[i], lanes[i].mDepth);
+    }
+    PromFamily(out, "sqmod_pool_processed_total", "counter", "Tasks taken out of each thread pool lane.");
+    for (size_t i = 0; i < TPLANE_COUNT; ++i)
+    {
+        fmt::format_to(std::back_inserter(out), "sqmod_pool_processed_total{{lane=\"{}\"}} {}\n", g_LaneNames[i], lanes[i].mProcessed);
+    }
+    PromFamily(out, "sqmod_pool_wait_seconds_total", "counter", "Time tasks spent waiting in each thread pool lane.");
+    for (size_t i = 0; i < TPLANE_COUNT; ++i)
+    {
+        fmt::format_to(std::back_inserter(out), "sqmod_pool_wait_seconds_total{{lane=\"{}\"}} {}\n", g_LaneNames[i], static_cast< double >(lanes[i].mWaitTotal) / 1000000.0);
+    }
+    PromFamily(out, "sqmod_pool_wait_max_seconds", "gauge", "Longest time a task spent waiting in each thread pool lane.");
+    for (size_t i = 0; i < TPLANE_COUNT; ++i)
+    {
+        fmt::format_to(std::back_inserter(out), "sqmod_pool_wait_max_seconds{{lane=\"{}\"}} {}\n", g_LaneNames[i], static_cast< double >(lanes[i].mWaitMax) / 1000000.0);
+    }
+    // Virtual machine memory
+    PromFamily(out, "sqmod_vm_live_bytes", "gauge", "Bytes currently allocated by the virtual machine.");
+    fmt::format_to(std::back_inserter(out), "sqmod_vm_live_bytes {}\n", snap.mVMLiveBytes);
+    PromFamily(out, "sqmod_vm_peak_bytes", "gauge", "Most bytes allocated by the virtual machine at once.");
+    fmt::format_to(std::back_inserter(out), "sqmod_vm_peak_bytes {}\n", snap.mVMPeakBytes);
+    PromFamily(out, "sqmod_vm_live_blocks", "gauge", "Blocks currently allocated by the virtual machine.");
+    fmt::format_to(std::back_inserter(out), "sqmod_vm_live_blocks {}\n", snap.mVMLiveBlocks);
+    PromFamily(out, "sqmod_vm_allocations_total", "counter", "Allocations made by the virtual machine.");
+    fmt::format_to(std::back_inserter(out), "sqmod_vm_allocations_total {}\n", snap.mVMAllocations);
+    PromFamily(out, "sqmod_vm_reserved_bytes", "gauge", "Bytes reserved by the virtual machine allocator.");
+    fmt::format_to(std::back_inserter(out), "sqmod_vm_reserved_bytes {}\n", snap.mVMReservedBytes);
+    // Entities
+    PromFamily(out, "sqmod_entities", "gauge", "Active entities of each type.");
+    for (size_t i = 0; i < 7; ++i)
+    {
+        fmt::format_to(std::back_inserter(out), "sqmod_entities{{type=\"{}\"}} {}\n", g_EntityNames[i], snap.mEntities[i]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Metrics::ToJSON(String & out, const MetricsSnapshot & snap) const
+{
+    fmt::format_to(std::back_inserter(out), "{{\"time\":{},\"frame\":", snap.mTime);
+    JSONTimes(out, m_Frame);
+    out.append(",\"tick\":");
+    JSONTimes(out, m_Tick);
+    // Server events
+    out.append(",\"events\":{");
+    const size_t events = m_EventCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < events; ++i)
+    {
+        if (i) out.push_back(',');
+        JSONString(out, m_Events[i].mName, std::strlen(m_Events[i].mName));
+        out.push_back(':');
+        JSONTimes(out, m_Events[i].mTimes);
+    }
+    // Signals
+    out.append("},\"signals\":[");
+    for (size_t i = 0; i < snap.mSignals.size(); ++i)
+    {
+        const auto & s = snap.mSignals[i];
+        out.append(i ? ",{\"name\":" : "{\"name\":");
+        JSONString(out, s.mName.data(), s.mName.size());
+        fmt::format_to(std::back_inserter(out), ",\"calls\":{},\"total_us\":{},\"max_us\":{}}}", s.mCalls, s.mTotal, s.mMax);
+    }
+    // Thread pool
+    out.append("],\"lanes\":{");
+    for (size_t i = 0; i < TPLANE_COUNT; ++i)
+    {
+        const ThreadPool::LaneInfo l = ThreadPool::Get().GetLaneInfo(static_cast< ThreadPoolLane >(i));
+        fmt::format_to(std::back_inserter(out), "{}\"{}\":{{\"depth\":{},\"queued\":{},\"processed\":{},\"retried\":{},"
+                       "\"stolen\":{},\"wait_total_us\":{},\"wait_max_us\":{}}}", i ? "," : "", g_LaneNames[i],
+                       l.mDepth, l.mQueued, l.mProcessed, l.mRetried, l.mStolen, l.mWaitTotal, l.mWaitMax);
+    }
+    // Virtual machine memory
+    out.append("},\"vm\":{\"backend\":");
+    JSONString(out, snap.mVMBackend.data(), snap.mVMBackend.size());
+    fmt::format_to(std::back_inserter(out), ",\"live_bytes\":{},\"peak_bytes\":{},\"live_blocks\":{},\"allocations\":{},\"reserved_bytes\":{}}}",
+                   snap.mVMLiveBytes, snap.mVMPeakBytes, snap.mVMLiveBlocks, snap.mVMAllocations, snap.mVMReservedBytes);
+    // Entities
+    out.append(",\"entities\":{");
+    for (size_t i = 0; i < 7; ++i)
+    {
+        fmt::format_to(std::back_inserter(out), "{}\"{}\":{}", i ? "," : "", g_EntityNames[i], snap.mEntities[i]);
+    }
+    // Recent log messages
+    out.append("},\"log\":[");
+    for (size_t i = 0; i < snap.mLog.size(); ++i)
+    {
+        if (i) out.push_back(',');
+        JSONString(out, snap.mLog[i].data(), snap.mLog[i].size());
+    }
+    out.append("]}");
+}
+
+// ------------------------------------------------------------------------------------------------
+int Metrics::OnRequest(mg_connection * conn, void * cbdata)
+{
+    auto * self = static_cast< Metrics * >(cbdata);
+    const mg_request_info * info = mg_get_request_info(conn);
+    // Only reading is supported
+    if (std::strcmp(info->request_method, "GET") != 0)
+    {
+        mg_send_http_error(conn, 405, "%s", "Method not allowed");
+        return 405;
+    }
+    // Take the last published snapshot. The server thread never waits for us
+    const Snapshot snap = std::atomic_load(&self->m_Snapshot);
+    const MetricsSnapshot empty{};
+    String out;
+    const char * type;
+    // Generate the requested document
+    if (std::strcmp(info->local_uri, "/metrics") == 0)
+    {
+        self->ToPrometheus(out, snap ? *snap : empty);
+        type = "text/plain; version=0.0.4; charset=utf-8";
+    }
+    else if (std::strcmp(info->local_uri, "/metrics.json") == 0)
+    {
+        self->ToJSON(out, snap ? *snap : empty);
+        type = "application/json";
+    }
+    else if (std::strcmp(info->local_uri, "/log") == 0)
+    {
+        // One message per line
+        for (const auto & line : (snap ? *snap : empty).mLog)
+        {
+            out.append(line).push_back('\n');
+        }
+        type = "text/plain; charset=utf-8";
+    }
+    else
+    {
+        mg_send_http_error(conn, 404, "%s", "Not found");
+        return 404;
+    }
+    // Send the document
+    mg_send_http_ok(conn, type, static_cast< long long >(out.size()));
+    mg_write(conn, out.data(), out.size());
+    // Request handled
+    return 200;
+}
+
+} // Namespace:: SqMod
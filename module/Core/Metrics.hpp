@@ -0,0 +1,269 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------------------
+#include "Core/Common.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// ------------------------------------------------------------------------------------------------
+struct mg_context;
+struct mg_connection;
+
+// ------------------------------------------------------------------------------------------------
+namespace SqMod {
+
+// ------------------------------------------------------------------------------------------------
+static constexpr size_t METRICS_BUCKETS = 20; // Bucket N holds durations below 2^N microseconds.
+static constexpr size_t MAX_METRIC_EVENTS = 64; // Hard coded limit of timed events.
+
+/* ------------------------------------------------------------------------------------------------
+ * Timing statistics that are only ever updated by the server thread but can be read by any thread.
+*/
+struct MetricTimes
+{
+    // --------------------------------------------------------------------------------------------
+    std::atomic< uint64_t > mCalls{0}; // Number of recorded calls.
+    std::atomic< uint64_t > mTotal{0}; // Total time spent in calls (microseconds).
+    std::atomic< uint64_t > mMax{0}; // Longest call (microseconds).
+    std::atomic< uint64_t > mHistogram[METRICS_BUCKETS]{}; // Distribution of call times.
+
+    /* --------------------------------------------------------------------------------------------
+     * Record the time spent in a call. There is a single writer so, no atomic read-modify-write.
+    */
+    void Record(uint64_t us)
+    {
+        mCalls.store(mCalls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        mTotal.store(mTotal.load(std::memory_order_relaxed) + us, std::memory_order_relaxed);
+        // Is this the longest call so far?
+        if (us > mMax.load(std::memory_order_relaxed))
+        {
+            mMax.store(us, std::memory_order_relaxed);
+        }
+        // Find the bucket of this call
+        size_t b = 0;
+        while (b < METRICS_BUCKETS - 1 && (us >> b) != 0) ++b;
+        mHistogram[b].store(mHistogram[b].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Timing statistics of a server event.
+*/
+struct MetricEvent
+{
+    const char *    mName{nullptr}; // Name of the event.
+    MetricTimes     mTimes{}; // Time spent in the event.
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Data that can only be collected from the server thread. Published as an immutable snapshot.
+*/
+struct MetricsSnapshot
+{
+    /* --------------------------------------------------------------------------------------------
+     * Emission costs of a signal.
+    */
+    struct SignalCost
+    {
+        String                  mName{}; // Name of the signal.
+        uint64_t                mCalls{0}; // Number of recorded emissions.
+        uint64_t                mTotal{0}; // Total time spent in emissions (microseconds).
+        uint64_t                mMax{0}; // Longest emission (microseconds).
+    };
+
+    // --------------------------------------------------------------------------------------------
+    int64_t                     mTime{0}; // When was the snapshot taken. (milliseconds since epoch)
+    // --------------------------------------------------------------------------------------------
+    String                      mVMBackend{}; // Allocator used by the virtual machine.
+    uint64_t                    mVMLiveBytes{0}; // Bytes currently allocated by the virtual machine.
+    uint64_t                    mVMPeakBytes{0}; // Most bytes allocated at once.
+    uint64_t                    mVMLiveBlocks{0}; // Blocks currently allocated.
+    uint64_t                    mVMAllocations{0}; // Allocations made since startup.
+    uint64_t                    mVMReservedBytes{0}; // Bytes reserved by the allocator.
+    // --------------------------------------------------------------------------------------------
+    size_t                      mEntities[7]{}; // Active entities of each type.
+    // --------------------------------------------------------------------------------------------
+    std::vector< SignalCost >   mSignals{}; // Signals with recorded emission costs.
+    std::vector< String >       mLog{}; // Most recent log messages.
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Embedded HTTP server that exposes the behavior of the running server. Timings are recorded by
+ * the server thread in atomic counters. Everything else is collected by the server thread at a
+ * fixed interval and published as an immutable snapshot. Requests are answered from CivetWeb
+ * threads without ever waiting on the server thread.
+*/
+class Metrics
+{
+private:
+
+    // --------------------------------------------------------------------------------------------
+    using Snapshot = std::shared_ptr< const MetricsSnapshot >; // Shared snapshot reference.
+
+    // --------------------------------------------------------------------------------------------
+    static Metrics s_Inst; // Metrics instance.
+
+    // --------------------------------------------------------------------------------------------
+    mg_context *                m_Server; // The HTTP server, if started.
+    std::atomic_bool            m_Enabled; // Whether timings are recorded.
+    // --------------------------------------------------------------------------------------------
+    MetricTimes                 m_Frame; // Time spent by the plug-in in each server frame.
+    MetricTimes                 m_Tick; // Time between server frames, as reported by the server.
+    // --------------------------------------------------------------------------------------------
+    MetricEvent                 m_Events[MAX_METRIC_EVENTS]; // Timed server events.
+    std::atomic_size_t          m_EventCount; // Number of timed server events.
+    // --------------------------------------------------------------------------------------------
+    Snapshot                    m_Snapshot; // Last published snapshot. Only accessed atomically.
+    std::chrono::milliseconds   m_Interval; // How often to publish a snapshot.
+    std::chrono::steady_clock::time_point m_Next; // When to publish the next snapshot.
+
+    /* --------------------------------------------------------------------------------------------
+     * Default constructor.
+    */
+    Metrics() noexcept;
+
+    /* --------------------------------------------------------------------------------------------
+     * Destructor.
+    */
+    ~Metrics();
+
+    /* --------------------------------------------------------------------------------------------
+     * Generate the metrics in Prometheus text format.
+    */
+    void ToPrometheus(String & out, const MetricsSnapshot & snap) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Generate the metrics in JSON format.
+    */
+    void ToJSON(String & out, const MetricsSnapshot & snap) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * CivetWeb request handler.
+    */
+    static int OnRequest(mg_connection * conn, void * cbdata);
+
+public:
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy constructor. (disabled)
+    */
+    Metrics(const Metrics & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move constructor. (disabled)
+    */
+    Metrics(Metrics && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy assignment operator. (disabled)
+    */
+    Metrics & operator = (const Metrics & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move assignment operator. (disabled)
+    */
+    Metrics & operator = (Metrics && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the metrics instance.
+    */
+    static Metrics & Get()
+    {
+        return s_Inst;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Start the HTTP server. Does nothing if already started.
+    */
+    bool Initialize(const char * listen, const char * acl, long interval, long tail);
+
+    /* --------------------------------------------------------------------------------------------
+     * Stop the HTTP server.
+    */
+    void Terminate();
+
+    /* --------------------------------------------------------------------------------------------
+     * Publish a new snapshot if the interval elapsed. Server thread only.
+    */
+    void Process();
+
+    /* --------------------------------------------------------------------------------------------
+     * See whether timings are recorded.
+    */
+    SQMOD_NODISCARD bool IsEnabled() const
+    {
+        return m_Enabled.load(std::memory_order_relaxed);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the statistics of the time spent by the plug-in in each server frame.
+    */
+    SQMOD_NODISCARD MetricTimes & FrameTimes()
+    {
+        return m_Frame;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Record the time between server frames, as reported by the server.
+    */
+    void RecordTick(float elapsed)
+    {
+        if (IsEnabled())
+        {
+            m_Tick.Record(static_cast< uint64_t >(elapsed * 1000000.0f));
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the statistics of a server event. Server thread only.
+    */
+    SQMOD_NODISCARD MetricTimes & Event(const char * name);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the clock used for timings (microseconds).
+    */
+    SQMOD_NODISCARD static uint64_t Clock()
+    {
+        return static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::microseconds >(
+                                        std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Records the time spent in a scope, when timings are recorded.
+*/
+struct MetricScope
+{
+    MetricTimes *   mTimes; // Where to record the time, if at all.
+    uint64_t        mStart; // When did the scope begin.
+
+    /* --------------------------------------------------------------------------------------------
+     * Base constructor.
+    */
+    explicit MetricScope(MetricTimes & times)
+        : mTimes(Metrics::Get().IsEnabled() ? &times : nullptr), mStart(mTimes ? Metrics::Clock() : 0)
+    {
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Destructor.
+    */
+    ~MetricScope()
+    {
+        if (mTimes)
+        {
+            mTimes->Record(Metrics::Clock() - mStart);
+        }
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+#define SQMOD_EVENT_METRIC(ev) /*
+*/ static MetricTimes & ev##_mt = Metrics::Get().Event(#ev); /*
+*/ const MetricScope ev##_ms(ev##_mt);
+
+} // Namespace:: SqMod
@@ -70,6 +70,8 @@ LightObj PvManager::CreateEntry(SQInteger id, StackStrF & name)
     const auto h = name.CacheHash().GetHash();
     // Create it now
     auto & e = m_Entries.emplace_back(PvIdentity(id, h), std::make_shared< PvEntry >(id, std::move(name), this));
+    // Units may have resolved this entry through the manager defaults
+    PvCache::Invalidate();
     // Create a wrapper instance and return it
     return LightObj(SqTypeIdentity< SqPvEntry >{}, SqVM(), e);
 }
@@ -356,6 +358,8 @@ void PvManager::RemoveEntryWithID(SQInteger id)
     }
     // Finally remove it from the list
     m_Entries.erase(PvIdentity(id));
+    // Units must not use this entry anymore
+    PvCache::Invalidate();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -382,6 +386,8 @@ void PvManager::RemoveEntryWithTag(StackStrF & tag)
     {
         m_Entries.erase(itr);
     }
+    // Units must not use this entry anymore
+    PvCache::Invalidate();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -410,6 +416,8 @@ void PvManager::RemoveClassWithID(SqPvClass & sub, SQInteger id)
     }
     // Finally remove it from the list
     m_Classes.erase(PvIdentity(id));
+    // Units must not inherit from this class anymore
+    PvCache::Invalidate();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -444,6 +452,8 @@ void PvManager::RemoveClassWithTag(SqPvClass & sub, StackStrF & tag)
     {
         m_Classes.erase(itr);
     }
+    // Units must not inherit from this class anymore
+    PvCache::Invalidate();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -230,6 +230,8 @@ public:
     void SetOnQuery(Function & func)
     {
         m_OnQuery = std::move(func);
+        // Units must find out again who arbitrates their requests
+        PvCache::Invalidate();
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -5,5 +5,6 @@
 namespace SqMod {
 
 // ------------------------------------------------------------------------------------------------
+uint32_t PvCache::sVersion = 1;
 
 } // Namespace:: SqMod
@@ -8,6 +8,7 @@
 #include <memory>
 #include <utility>
 #include <algorithm>
+#include <unordered_map>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
@@ -102,4 +103,82 @@ struct PvIdPred
     }
 };
 
+/* ------------------------------------------------------------------------------------------------
+ * Outcome of resolving an entry for a particular unit, cached until something changes.
+*/
+struct PvResolved
+{
+    /* --------------------------------------------------------------------------------------------
+     * Value of the entry after walking the unit, class, parent classes and manager.
+    */
+    SQInteger mValue{0};
+
+    /* --------------------------------------------------------------------------------------------
+     * Whether the value satisfies the entry default. Only meaningful without a query callback.
+    */
+    bool mAllowed{false};
+
+    /* --------------------------------------------------------------------------------------------
+     * Whether a query callback must arbitrate requests for this entry.
+    */
+    bool mQuery{false};
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Lazily populated cache of resolved entries. Changes local to the owner simply reset it while
+ * changes that can affect any number of owners (classes, entries, managers) bump a global version
+ * which makes every cache discard its contents the next time it is used.
+*/
+struct PvCache
+{
+    /* --------------------------------------------------------------------------------------------
+     * Global version. Incremented whenever a change can affect more than a single unit.
+    */
+    static uint32_t sVersion;
+
+    /* --------------------------------------------------------------------------------------------
+     * Entries resolved so far, identified by their unique identifier.
+    */
+    std::unordered_map< SQInteger, PvResolved > mEntries{};
+
+    /* --------------------------------------------------------------------------------------------
+     * Entry identifiers resolved so far, identified by the hash of their tag.
+    */
+    std::unordered_map< size_t, SQInteger > mTags{};
+
+    /* --------------------------------------------------------------------------------------------
+     * Global version when this cache was populated.
+    */
+    uint32_t mVersion{0};
+
+    /* --------------------------------------------------------------------------------------------
+     * Make every cache discard their contents.
+    */
+    static void Invalidate() noexcept
+    {
+        ++sVersion;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Discard the resolved entries of this cache only.
+    */
+    void Reset()
+    {
+        mEntries.clear();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Discard the contents of this cache if something changed since it was populated.
+    */
+    void Sync()
+    {
+        if (mVersion != sVersion)
+        {
+            mEntries.clear();
+            mTags.clear();
+            mVersion = sVersion;
+        }
+    }
+};
+
 } // Namespace:: SqMod
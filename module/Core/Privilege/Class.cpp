@@ -164,6 +164,8 @@ void PvClass::AssignPrivilege(SQInteger id, SQInteger value)
     }
     // Either way, we are setting this value
     mPrivileges[id] = value;
+    // Units that inherit this value must resolve it again
+    PvCache::Invalidate();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -182,6 +184,8 @@ void PvClass::RemovePrivilege(SQInteger id)
     SQInteger current = itr->second;
     // Erase this status value
     mPrivileges.erase(itr);
+    // Units that inherit this value must resolve it again
+    PvCache::Invalidate();
     // Retrieve the associated entry
     PvEntry & entry = ValidManager().ValidEntry(id);
     // Is there someone that can identify this change?
@@ -218,6 +222,8 @@ void PvClass::ModifyPrivilege(SQInteger id, SQInteger value)
             DoChanged(id, r.Cast< bool >(), value);
             // Use this value now as well
             mPrivileges[id] = value;
+            // Units that inherit this value must resolve it again
+            PvCache::Invalidate();
         }
     }
     else
@@ -226,6 +232,8 @@ void PvClass::ModifyPrivilege(SQInteger id, SQInteger value)
         DoChanged(id, value > current, value);
         // Use this value now
         mPrivileges[id] = value;
+        // Units that inherit this value must resolve it again
+        PvCache::Invalidate();
     }
 }
 
@@ -252,6 +260,8 @@ void PvClass::RemoveAllPrivileges()
 {
     // Discard all privileges but not before gaining ownership of them
     PvStatusList list = std::move(mPrivileges);
+    // Units that inherit these values must resolve them again
+    PvCache::Invalidate();
     // Go over all entries and see if this unit will gain or loose any privileges from this change
     for (const auto & e : list)
     {
@@ -290,6 +300,8 @@ void PvClass::AssignParent(const Ref & parent)
     {
         // Assign the specified class
         mParent = parent;
+        // Units that inherit from this class must resolve their values again
+        PvCache::Invalidate();
         // Propagate changes
         ValidManager().PropagateParentAssign(*this, parent);
     }
@@ -298,6 +310,8 @@ void PvClass::AssignParent(const Ref & parent)
     {
         // Assign the specified class
         mParent = parent;
+        // Units that inherit from this class must resolve their values again
+        PvCache::Invalidate();
         // Propagate changes
         ValidManager().PropagateParentChange(*this, parent);
     }
@@ -337,7 +337,7 @@ struct SqPvClass
     SQMOD_NODISCARD LightObj & GetData() const { return Valid().mData; }
     void SetData(LightObj & data) const { Valid().mData = data; }
     // --------------------------------------------------------------------------------------------
-    void SetOnQuery(Function & func) const { Valid().mOnQuery = std::move(func); }
+    void SetOnQuery(Function & func) const { Valid().mOnQuery = std::move(func); PvCache::Invalidate(); }
     void SetOnLost(Function & func) const { Valid().mOnLost = std::move(func); }
     void SetOnGained(Function & func) const { Valid().mOnGained = std::move(func); }
     // --------------------------------------------------------------------------------------------
@@ -19,6 +19,8 @@ void PvEntry::SetTag(StackStrF & tag)
     {
         mManager->UpdateEntryHash(mID, static_cast< size_t >(mTag.mRes));
     }
+    // Tags resolved so far may point to the wrong entry now
+    PvCache::Invalidate();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -122,6 +122,51 @@ SQInteger PvUnit::GetInheritedEntryValue(SQInteger id) const
     return ValidClass().GetEntryValue(id);
 }
 
+// ------------------------------------------------------------------------------------------------
+const PvResolved & PvUnit::Resolve(SQInteger id) const
+{
+    // Discard stale results
+    mCache.Sync();
+    // Was this entry resolved already?
+    auto itr = mCache.mEntries.find(id);
+    if (itr != mCache.mEntries.end())
+    {
+        return itr->second;
+    }
+    PvResolved r;
+    // Walk the hierarchy to find the current status of the specified entry
+    r.mValue = GetEntryValue(id);
+    // Find out if there's someone that can arbitrate requests
+    r.mQuery = !GetOnQuery(id).IsNull();
+    // Settle the arbitration now otherwise
+    if (!r.mQuery)
+    {
+        r.mAllowed = (r.mValue >= ValidManager().ValidEntry(id).mDefault);
+    }
+    // Remember the result
+    return mCache.mEntries.emplace(id, r).first->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger PvUnit::ResolveTag(StackStrF & tag) const
+{
+    // Discard stale results
+    mCache.Sync();
+    // Generate and cache the hash
+    const size_t h = tag.CacheHash().GetHash();
+    // Was this tag resolved already?
+    auto itr = mCache.mTags.find(h);
+    if (itr != mCache.mTags.end())
+    {
+        return itr->second;
+    }
+    // Look for the entry with this tag and remember it
+    const SQInteger id = ValidManager().GetValidEntryWithTag(tag)->mID;
+    mCache.mTags.emplace(h, id);
+    // Return the identifier
+    return id;
+}
+
 // ------------------------------------------------------------------------------------------------
 void PvUnit::DoGained(SQInteger id, SQInteger value) const
 {
@@ -179,6 +224,8 @@ void PvUnit::AssignPrivilege(SQInteger id, SQInteger value)
     }
     // Either way, we are setting this value
     mPrivileges[id] = value;
+    // Forget the previous resolution
+    mCache.Reset();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -197,6 +244,8 @@ void PvUnit::RemovePrivilege(SQInteger id)
     SQInteger current = itr->second;
     // Erase this status value
     mPrivileges.erase(itr);
+    // Forget the previous resolution
+    mCache.Reset();
     // Retrieve the associated entry
     PvEntry & entry = ValidManager().ValidEntry(id);
     // Is there someone that can identify this change?
@@ -233,6 +282,8 @@ void PvUnit::ModifyPrivilege(SQInteger id, SQInteger value)
             DoChanged(id, r.Cast< bool >(), value);
             // Use this value now as well
             mPrivileges[id] = value;
+            // Forget the previous resolution
+            mCache.Reset();
         }
     }
     else
@@ -241,6 +292,8 @@ void PvUnit::ModifyPrivilege(SQInteger id, SQInteger value)
         DoChanged(id, value > current, value);
         // Use this value now
         mPrivileges[id] = value;
+        // Forget the previous resolution
+        mCache.Reset();
     }
 }
 
@@ -267,6 +320,8 @@ void PvUnit::RemoveAllPrivileges()
 {
     // Discard all privileges but not before gaining ownership of them
     PvStatusList list = std::move(mPrivileges);
+    // Forget the previous resolutions
+    mCache.Reset();
     // Go over all entries and see if this unit will gain or loose any privileges from this change
     for (const auto & e : list)
     {
@@ -311,6 +366,8 @@ void PvUnit::AssignClass(const std::shared_ptr< PvClass > & cls)
     }
     // Assign this class
     mClass = cls;
+    // Forget the previous resolutions
+    mCache.Reset();
     // Propagate changes
     ValidManager().PropagateClassChange(*this, cls);
 }
@@ -318,28 +375,18 @@ void PvUnit::AssignClass(const std::shared_ptr< PvClass > & cls)
 // ------------------------------------------------------------------------------------------------
 bool PvUnit::Can(SQInteger id, SQInteger req) const
 {
-    // Get the current status of the specified entry
-    SQInteger current = GetEntryValue(id);
-    // Retrieve the function responsible for the query event
-    const Function & query = GetOnQuery(id);
+    // Get the resolved status of the specified entry (copy because the callback can invalidate it)
+    const PvResolved r = Resolve(id);
     // Is there someone that can arbitrate this request?
-    if (!query.IsNull())
+    if (r.mQuery)
     {
         // Attempt arbitration
-        LightObj r = query.Eval(current, req);
+        LightObj o = GetOnQuery(id).Eval(r.mValue, req);
         // If NULL or false the request was denied
-        if (!r.IsNull() && r.Cast< bool >())
-        {
-            return true; // Request allowed
-        }
-    }
-    // We use the >= comparison to settle arbitration
-    else if (current >= ValidManager().ValidEntry(id).mDefault)
-    {
-        return true;
+        return !o.IsNull() && o.Cast< bool >();
     }
-    // Request failed, no arbitration
-    return false;
+    // The >= comparison against the default was settled when resolved
+    return r.mAllowed;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -397,10 +444,8 @@ bool SqPvUnit::Can(LightObj & obj, SQInteger req) const
         sq_poptop(SqVM());
         // Reference the instance
         PvUnit & u = Valid();
-        // Generate and cache the hash
-        tag.CacheHash();
         // Forward request
-        return u.Can(u.ValidManager().GetValidEntryWithTag(tag)->mID, req);
+        return u.Can(u.ResolveTag(tag), req);
     }
     // Entry instance?
     else if (obj.GetType() == OT_INSTANCE && obj.GetTypeTag() == StaticClassTypeTag< SqPvEntry >::Get())
@@ -71,6 +71,11 @@ struct PvUnit
     */
     std::weak_ptr< PvClass > mClass;
 
+    /* --------------------------------------------------------------------------------------------
+     * Entries resolved for this unit so far.
+    */
+    mutable PvCache     mCache;
+
     /* -------------------------------------------------------------------------------------------
      * Default constructor.
     */
@@ -81,6 +86,7 @@ struct PvUnit
         , mOnQuery(), mOnGained(), mOnLost()
         , mTag(), mData()
         , mClass(std::move(cls))
+        , mCache()
     {
     }
 
@@ -94,6 +100,7 @@ struct PvUnit
         , mOnQuery(), mOnGained(), mOnLost()
         , mTag(std::move(tag)), mData()
         , mClass(std::move(cls))
+        , mCache()
     {
     }
 
@@ -188,6 +195,16 @@ struct PvUnit
     */
     SQMOD_NODISCARD SQInteger GetInheritedEntryValue(SQInteger id) const;
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the resolved state of an entry for this particular unit. Cached until invalidated.
+    */
+    SQMOD_NODISCARD const PvResolved & Resolve(SQInteger id) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the identifier of the entry with the specified tag. Cached until invalidated.
+    */
+    SQMOD_NODISCARD SQInteger ResolveTag(StackStrF & tag) const;
+
     /* --------------------------------------------------------------------------------------------
      * Perform the actions necessary to handle a privilege gain event.
     */
@@ -288,7 +305,7 @@ struct SqPvUnit
     SQMOD_NODISCARD LightObj & GetData() const { return Valid().mData; }
     void SetData(LightObj & data) const { Valid().mData = data; }
     // --------------------------------------------------------------------------------------------
-    void SetOnQuery(Function & func) const { Valid().mOnQuery = std::move(func); }
+    void SetOnQuery(Function & func) const { PvUnit & u = Valid(); u.mOnQuery = std::move(func); u.mCache.Reset(); }
     void SetOnLost(Function & func) const { Valid().mOnLost = std::move(func); }
     void SetOnGained(Function & func) const { Valid().mOnGained = std::move(func); }
     // --------------------------------------------------------------------------------------------
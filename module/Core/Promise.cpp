@@ -0,0 +1,385 @@
+// ------------------------------------------------------------------------------------------------
+#include "Core/Promise.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <sqratConst.h>
+
+// ------------------------------------------------------------------------------------------------
+#include <unordered_map>
+#include <unordered_set>
+
+// ------------------------------------------------------------------------------------------------
+namespace SqMod {
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_DECL_TYPENAME(Typename, _SC("SqPromise"))
+
+/* ------------------------------------------------------------------------------------------------
+ * Coroutine started with SqAsync() and the promise that receives its result.
+*/
+struct Coroutine
+{
+    LightObj    mThread{}; // Strong reference to the thread running the coroutine.
+    PromiseRef  mResult{}; // Promise settled when the coroutine returns or throws.
+};
+
+// ------------------------------------------------------------------------------------------------
+static std::vector< PromiseRef > g_ReadyPromises{}; // Settled promises waiting to be dispatched.
+static std::unordered_set< PromiseHnd * > g_Promises{}; // All promise handles that exist.
+static std::unordered_map< HSQUIRRELVM, Coroutine > g_Coroutines{}; // Coroutines started by SqAsync().
+
+// ------------------------------------------------------------------------------------------------
+static void CoroutineStep(HSQUIRRELVM thread, SQRESULT res)
+{
+    // Look for the promise that receives the result of this coroutine, if any
+    auto itr = g_Coroutines.find(thread);
+    // Did the coroutine fail?
+    if (SQ_FAILED(res))
+    {
+        // Clean up the stack of the thread
+        sq_settop(thread, 0);
+        // Forward the error to the promise
+        if (itr != g_Coroutines.end())
+        {
+            sq_getlasterror(thread);
+            itr->second.mResult->Reject(LightObj(-1, thread));
+            g_Coroutines.erase(itr);
+        }
+        // Nothing else to do
+        return;
+    }
+    // Grab the returned value and pop it
+    LightObj ret(-1, thread);
+    sq_pop(thread, 1);
+    // Did the coroutine return?
+    if (sq_getvmstate(thread) == SQ_VMSTATE_IDLE)
+    {
+        // Clean up the stack of the thread
+        sq_settop(thread, 0);
+        // Forward the value to the promise
+        if (itr != g_Coroutines.end())
+        {
+            itr->second.mResult->Resolve(std::move(ret));
+            g_Coroutines.erase(itr);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ProcessPromises()
+{
+    // Promises settled by the dispatched ones go in the next batch
+    std::vector< PromiseRef > ready;
+    // Take the current batch
+    ready.swap(g_ReadyPromises);
+    // Dispatch every promise in the batch
+    for (auto & p : ready)
+    {
+        p->Dispatch();
+    }
+    // Keep the memory for the next batch
+    if (g_ReadyPromises.empty())
+    {
+        ready.clear();
+        g_ReadyPromises.swap(ready);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void TerminatePromises()
+{
+    // Forget about settled promises
+    g_ReadyPromises.clear();
+    // Release the coroutines
+    g_Coroutines.clear();
+    // Releasing script resources may destroy other promises so, keep them alive until done
+    std::vector< PromiseRef > promises;
+    promises.reserve(g_Promises.size());
+    for (auto * p : g_Promises)
+    {
+        promises.push_back(p->mSelf.Lock());
+    }
+    // Release script resources held by the remaining promises
+    for (auto & p : promises)
+    {
+        p->Release();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+PromiseHnd::PromiseHnd()
+{
+    g_Promises.insert(this);
+}
+
+// ------------------------------------------------------------------------------------------------
+PromiseHnd::~PromiseHnd()
+{
+    g_Promises.erase(this);
+}
+
+// ------------------------------------------------------------------------------------------------
+PromiseRef PromiseHnd::Make()
+{
+    PromiseRef p(new PromiseHnd());
+    // Allow the handle to reference itself
+    p->mSelf = p;
+    // Return the handle
+    return p;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PromiseHnd::Settle(PromiseState state, LightObj && value)
+{
+    // Promises can only be settled once
+    if (mState != PROMISE_PENDING)
+    {
+        return false;
+    }
+    // Save the outcome
+    mState = state;
+    mValue = std::move(value);
+    // Let the waiting parties know at the end of the frame
+    Queue();
+    // Promise settled
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void PromiseHnd::Queue()
+{
+    // Is there a reason to queue the promise?
+    if (mQueued || mState == PROMISE_PENDING || (mWaiters.empty() && mHandlers.empty()))
+    {
+        return;
+    }
+    // Remember that it was queued
+    mQueued = true;
+    // A strong reference keeps the promise alive until dispatched
+    g_ReadyPromises.emplace_back(mSelf.Lock());
+}
+
+// ------------------------------------------------------------------------------------------------
+void PromiseHnd::Dispatch()
+{
+    // No longer in the queue
+    mQueued = false;
+    // Take the parties that are currently waiting
+    std::vector< Handler > handlers;
+    std::vector< Waiter > waiters;
+    handlers.swap(mHandlers);
+    waiters.swap(mWaiters);
+    // Invoke the callbacks first
+    for (auto & h : handlers)
+    {
+        Function & cb = (mState == PROMISE_RESOLVED) ? h.mResolved : h.mRejected;
+        // Is there a callback for this outcome?
+        if (cb.IsNull())
+        {
+            continue;
+        }
+        // Callbacks are not allowed to interrupt the batch
+        try
+        {
+            cb(mValue);
+        }
+        catch (const std::exception & e)
+        {
+            LogErr("Promise handler failed: %s", e.what());
+        }
+    }
+    // Resume the suspended coroutines in the order they started waiting
+    for (auto & w : waiters)
+    {
+        // Was the thread resumed by something else?
+        if (sq_getvmstate(w.mThread) != SQ_VMSTATE_SUSPENDED)
+        {
+            continue;
+        }
+        // The value is what the await call returns
+        sq_pushobject(w.mThread, mValue.GetObj());
+        // Was the promise resolved?
+        if (mState == PROMISE_RESOLVED)
+        {
+            CoroutineStep(w.mThread, sq_wakeupvm(w.mThread, SQTrue, SQTrue, SQTrue, SQFalse));
+        }
+        else
+        {
+            // The error is thrown from the await call
+            sq_throwobject(w.mThread);
+            CoroutineStep(w.mThread, sq_wakeupvm(w.mThread, SQFalse, SQTrue, SQTrue, SQTrue));
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void PromiseHnd::Release()
+{
+    mValue.Release();
+    mWaiters.clear();
+    mHandlers.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+Promise::Promise()
+    : m_Handle(PromiseHnd::Make())
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+Promise::Promise(PromiseRef handle)
+    : m_Handle(std::move(handle))
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+LightObj Promise::Create(PromiseRef & handle)
+{
+    handle = PromiseHnd::Make();
+    // Create the script object around the handle
+    return LightObj(SqTypeIdentity< Promise >{}, SqVM(), handle);
+}
+
+// ------------------------------------------------------------------------------------------------
+Promise & Promise::Handle(Function & resolved, Function & rejected)
+{
+    m_Handle->mHandlers.push_back(PromiseHnd::Handler{resolved, rejected});
+    // Already settled promises are dispatched with the next batch
+    m_Handle->Queue();
+    // Allow chaining
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqAwait(HSQUIRRELVM vm)
+{
+    // Was the promise specified?
+    if (sq_gettop(vm) < 2)
+    {
+        return sq_throwerror(vm, _SC("Please specify the promise to await"));
+    }
+    // Values that are not promises are returned as they are
+    if (sq_gettype(vm, 2) != OT_INSTANCE)
+    {
+        sq_push(vm, 2);
+        return 1;
+    }
+    Promise * promise;
+    // Attempt to extract the promise
+    try
+    {
+        promise = Var< Promise * >(vm, 2).value;
+    }
+    catch (const std::exception & e)
+    {
+        return sq_throwerror(vm, e.what());
+    }
+    // Was it a promise?
+    if (promise == nullptr)
+    {
+        sq_push(vm, 2);
+        return 1;
+    }
+    const PromiseRef & p = promise->GetHandle();
+    // Is the promise settled already?
+    if (p->mState != PROMISE_PENDING)
+    {
+        sq_pushobject(vm, p->mValue.GetObj());
+        // Throw the error or return the value
+        return p->mState == PROMISE_REJECTED ? sq_throwobject(vm) : 1;
+    }
+    // The main thread cannot be suspended
+    else if (vm == SqVM())
+    {
+        return sq_throwerror(vm, _SC("Cannot await a pending promise outside of a coroutine"));
+    }
+    // Obtain a strong reference to this thread
+    sq_pushthread(vm, vm);
+    LightObj thread(-1, vm);
+    sq_pop(vm, 1);
+    // Wait for the promise to be settled
+    p->mWaiters.push_back(PromiseHnd::Waiter{vm, std::move(thread)});
+    // Attempt to suspend the thread
+    const SQRESULT res = sq_suspendvm(vm);
+    // Was the thread suspended? (a successful suspension also returns a negative value)
+    if (res == SQ_ERROR)
+    {
+        p->mWaiters.pop_back();
+    }
+    // Return the result
+    return res;
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqAsync(HSQUIRRELVM vm)
+{
+    const SQInteger top = sq_gettop(vm);
+    // Was the function specified?
+    if (top < 2)
+    {
+        return sq_throwerror(vm, _SC("Please specify the function to run"));
+    }
+    // Make sure it can be called
+    const SQObjectType type = sq_gettype(vm, 2);
+    if (type != OT_CLOSURE && type != OT_NATIVECLOSURE)
+    {
+        return sq_throwerror(vm, _SC("The specified value cannot be called"));
+    }
+    // Create the thread that will run the coroutine
+    HSQUIRRELVM thread = sq_newthread(vm, 1024);
+    // Keep a reference to the thread object
+    Coroutine co{LightObj(-1, vm), PromiseRef{}};
+    sq_pop(vm, 1);
+    // Create the promise that receives the result
+    LightObj promise = Promise::Create(co.mResult);
+    // Push the function, the environment and the arguments on the stack of the thread
+    sq_move(thread, vm, 2);
+    sq_pushroottable(thread);
+    for (SQInteger i = 3; i <= top; ++i)
+    {
+        sq_move(thread, vm, i);
+    }
+    // Remember the coroutine, it may be suspended
+    g_Coroutines[thread] = std::move(co);
+    // Run the coroutine until it returns or awaits something
+    CoroutineStep(thread, sq_call(thread, top - 1, SQTrue, SQTrue));
+    // Return the promise
+    sq_pushobject(vm, promise.GetObj());
+    return 1;
+}
+
+// ================================================================================================
+void Register_Promise(HSQUIRRELVM vm)
+{
+    RootTable(vm).Bind(Typename::Str,
+        Class< Promise, NoCopy< Promise > >(vm, Typename::Str)
+        // Constructors
+        .Ctor()
+        // Meta-methods
+        .SquirrelFunc(_SC("_typename"), &Typename::Fn)
+        // Properties
+        .Prop(_SC("State"), &Promise::GetState)
+        .Prop(_SC("Pending"), &Promise::IsPending)
+        .Prop(_SC("Resolved"), &Promise::IsResolved)
+        .Prop(_SC("Rejected"), &Promise::IsRejected)
+        .Prop(_SC("Value"), &Promise::GetValue)
+        // Member Methods
+        .Func(_SC("Resolve"), &Promise::Resolve)
+        .Func(_SC("Reject"), &Promise::Reject)
+        .Func(_SC("Then"), &Promise::Then)
+        .Func(_SC("Catch"), &Promise::Catch)
+        .Func(_SC("Handle"), &Promise::Handle)
+    );
+
+    RootTable(vm)
+        .SquirrelFunc(_SC("SqAwait"), &SqAwait)
+        .SquirrelFunc(_SC("SqAsync"), &SqAsync);
+
+    ConstTable(vm).Enum(_SC("SqPromiseState"), Enumeration(vm)
+        .Const(_SC("Pending"), static_cast< SQInteger >(PROMISE_PENDING))
+        .Const(_SC("Resolved"), static_cast< SQInteger >(PROMISE_RESOLVED))
+        .Const(_SC("Rejected"), static_cast< SQInteger >(PROMISE_REJECTED))
+    );
+}
+
+} // Namespace:: SqMod
@@ -0,0 +1,277 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------------------
+#include "Core/Utility.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <vector>
+
+// ------------------------------------------------------------------------------------------------
+namespace SqMod {
+
+// ------------------------------------------------------------------------------------------------
+struct PromiseHnd;
+
+// ------------------------------------------------------------------------------------------------
+typedef SharedPtr< PromiseHnd > PromiseRef; // Shared reference to a promise handle.
+
+/* ------------------------------------------------------------------------------------------------
+ * States in which a promise can be.
+*/
+enum PromiseState
+{
+    // The promise was not settled yet
+    PROMISE_PENDING = 0,
+    // The promise was settled with a value
+    PROMISE_RESOLVED,
+    // The promise was settled with an error
+    PROMISE_REJECTED
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Shared state of a promise. Can be settled from native code, such as the completion stage of a
+ * thread pool item, without having access to the script object. Handlers and suspended coroutines
+ * are not invoked immediately when the promise is settled. Instead, all promises that were settled
+ * are dispatched together, once per server frame.
+*/
+struct PromiseHnd
+{
+    /* --------------------------------------------------------------------------------------------
+     * Coroutine that is suspended until the promise is settled.
+    */
+    struct Waiter
+    {
+        HSQUIRRELVM mThread{nullptr}; // The suspended thread.
+        LightObj    mObject{}; // Strong reference to the suspended thread.
+    };
+
+    /* --------------------------------------------------------------------------------------------
+     * Pair of callbacks to invoke when the promise is settled.
+    */
+    struct Handler
+    {
+        Function    mResolved{}; // Callback to invoke when the promise was resolved.
+        Function    mRejected{}; // Callback to invoke when the promise was rejected.
+    };
+
+    // --------------------------------------------------------------------------------------------
+    PromiseState            mState{PROMISE_PENDING}; // Current state of the promise.
+    LightObj                mValue{}; // Value or error with which the promise was settled.
+    // --------------------------------------------------------------------------------------------
+    std::vector< Waiter >   mWaiters{}; // Coroutines waiting for the promise to be settled.
+    std::vector< Handler >  mHandlers{}; // Callbacks waiting for the promise to be settled.
+    // --------------------------------------------------------------------------------------------
+    WeakPtr< PromiseHnd >   mSelf{}; // Weak reference to this handle, used to queue it.
+    bool                    mQueued{false}; // Whether the promise is waiting to be dispatched.
+
+    /* --------------------------------------------------------------------------------------------
+     * Default constructor. Handles must be created with Make().
+    */
+    PromiseHnd();
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy constructor. (disabled)
+    */
+    PromiseHnd(const PromiseHnd & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move constructor. (disabled)
+    */
+    PromiseHnd(PromiseHnd && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Destructor.
+    */
+    ~PromiseHnd();
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy assignment operator. (disabled)
+    */
+    PromiseHnd & operator = (const PromiseHnd & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move assignment operator. (disabled)
+    */
+    PromiseHnd & operator = (PromiseHnd && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Create a pending promise handle.
+    */
+    SQMOD_NODISCARD static PromiseRef Make();
+
+    /* --------------------------------------------------------------------------------------------
+     * Settle the promise with a value. Returns false if the promise was already settled.
+    */
+    bool Resolve(LightObj && value)
+    {
+        return Settle(PROMISE_RESOLVED, std::move(value));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Settle the promise with an error. Returns false if the promise was already settled.
+    */
+    bool Reject(LightObj && error)
+    {
+        return Settle(PROMISE_REJECTED, std::move(error));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Settle the promise and queue it to be dispatched. Returns false if already settled.
+    */
+    bool Settle(PromiseState state, LightObj && value);
+
+    /* --------------------------------------------------------------------------------------------
+     * Queue the promise to be dispatched, if settled and not already queued.
+    */
+    void Queue();
+
+    /* --------------------------------------------------------------------------------------------
+     * Invoke the handlers and resume the coroutines that wait for this promise.
+    */
+    void Dispatch();
+
+    /* --------------------------------------------------------------------------------------------
+     * Release all script resources.
+    */
+    void Release();
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Script wrapper around a promise handle.
+*/
+class Promise
+{
+private:
+
+    // --------------------------------------------------------------------------------------------
+    PromiseRef  m_Handle; // The shared promise handle.
+
+public:
+
+    /* --------------------------------------------------------------------------------------------
+     * Default constructor. Creates a pending promise.
+    */
+    Promise();
+
+    /* --------------------------------------------------------------------------------------------
+     * Construct a wrapper around an existing promise handle.
+    */
+    explicit Promise(PromiseRef handle);
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy constructor. (disabled)
+    */
+    Promise(const Promise & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move constructor. (disabled)
+    */
+    Promise(Promise && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Destructor.
+    */
+    ~Promise() = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy assignment operator. (disabled)
+    */
+    Promise & operator = (const Promise & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move assignment operator. (disabled)
+    */
+    Promise & operator = (Promise && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Create a pending promise and the script object that wraps it.
+    */
+    SQMOD_NODISCARD static LightObj Create(PromiseRef & handle);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the promise handle.
+    */
+    SQMOD_NODISCARD const PromiseRef & GetHandle() const
+    {
+        return m_Handle;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the state of the promise.
+    */
+    SQMOD_NODISCARD SQInteger GetState() const
+    {
+        return static_cast< SQInteger >(m_Handle->mState);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * See whether the promise was not settled yet.
+    */
+    SQMOD_NODISCARD bool IsPending() const
+    {
+        return m_Handle->mState == PROMISE_PENDING;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * See whether the promise was settled with a value.
+    */
+    SQMOD_NODISCARD bool IsResolved() const
+    {
+        return m_Handle->mState == PROMISE_RESOLVED;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * See whether the promise was settled with an error.
+    */
+    SQMOD_NODISCARD bool IsRejected() const
+    {
+        return m_Handle->mState == PROMISE_REJECTED;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the value or error with which the promise was settled.
+    */
+    SQMOD_NODISCARD const LightObj & GetValue() const
+    {
+        return m_Handle->mValue;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Settle the promise with a value.
+    */
+    bool Resolve(LightObj & value)
+    {
+        return m_Handle->Resolve(std::move(value));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Settle the promise with an error.
+    */
+    bool Reject(LightObj & error)
+    {
+        return m_Handle->Reject(std::move(error));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Register a callback to be invoked when the promise is resolved.
+    */
+    Promise & Then(Function & resolved)
+    {
+        return Handle(resolved, NullFunction());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Register callbacks to be invoked when the promise is resolved or rejected.
+    */
+    Promise & Handle(Function & resolved, Function & rejected);
+
+    /* --------------------------------------------------------------------------------------------
+     * Register a callback to be invoked when the promise is rejected.
+    */
+    Promise & Catch(Function & rejected)
+    {
+        return Handle(NullFunction(), rejected);
+    }
+};
+
+} // Namespace:: SqMod
@@ -16,9 +16,10 @@ SQMOD_DECL_TYPENAME(Typename, _SC("SqRoutineInstance"))
 // ------------------------------------------------------------------------------------------------
 Routine::Time       Routine::s_Last = 0;
 Routine::Time       Routine::s_Prev = 0;
-Routine::Interval   Routine::s_Intervals[SQMOD_MAX_ROUTINES];
-Routine::Instance   Routine::s_Instances[SQMOD_MAX_ROUTINES];
-SQInteger           Routine::s_Current = SQMOD_MAX_ROUTINES;
+TagIndex            Routine::s_Tags{};
+TimerQueue          Routine::s_Timers{};
+Routine::Instances  Routine::s_Instances{};
+SQInteger           Routine::s_Current = Routine::NOSLOT;
 bool                Routine::s_Silenced = false;
 bool                Routine::s_Persistent = false;
 
@@ -38,31 +39,21 @@ void Routine::Process()
     s_Last = Chrono::GetCurrentSysTime();
     // Calculate the elapsed time
     const auto delta = int32_t((s_Last - s_Prev) / 1000L);
-    // Process all active routines
-    for (Interval * itr = s_Intervals; itr != (s_Intervals + SQMOD_MAX_ROUTINES); ++itr)
-    {
-        // Is this routine valid?
-        if (*itr)
-        {
-            // Decrease the elapsed time
-            (*itr) -= delta;
-            // Have we completed the routine interval?
-            if ((*itr) <= 0)
-            {
-                s_Current = static_cast< SQInteger >(itr - s_Intervals);
-                // Execute and reset the elapsed time
-                (*itr) = s_Instances[s_Current].Execute();
-            }
-        }
-    }
+    // Process the routines that completed their interval
+    s_Timers.Advance(delta, [](TimerQueue::Slot slot) -> TimerQueue::Time {
+        s_Current = static_cast< SQInteger >(slot);
+        // Execute and reset the elapsed time
+        return s_Instances[slot].Execute();
+    });
     // Clear currently executed routine
-    s_Current = SQMOD_MAX_ROUTINES;
+    s_Current = NOSLOT;
 }
 
 // ------------------------------------------------------------------------------------------------
 void Routine::Initialize()
 {
-    std::memset(s_Intervals, 0, sizeof(s_Intervals));
+    s_Timers.Clear();
+    s_Timers.Reserve(SQMOD_MAX_ROUTINES);
     SetSilenced(!ErrorHandling::IsEnabled());
 }
 
@@ -74,6 +65,8 @@ void Routine::Deinitialize()
     {
         r.Terminate();
     }
+    // Nothing is scheduled anymore
+    s_Timers.Clear();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -336,7 +329,7 @@ struct RoutineBuilder
         // Alright, at this point we can initialize the slot
         inst.Init(mEnv, mFunc, mInst, mInterval, static_cast< Routine::Iterator >(mIterations));
         // Now initialize the timer
-        Routine::s_Intervals[mSlot] = mInterval;
+        Routine::s_Timers.Arm(static_cast< TimerQueue::Slot >(mSlot), mInterval);
 #ifdef VCMP_ENABLE_OFFICIAL
         // Drop the temporary callback reference
         if (refs)
@@ -469,14 +462,8 @@ bool Routine::IsWithTag(StackStrF & tag)
     // Is the specified tag valid?
     if (tag.mPtr != nullptr)
     {
-        // Iterate routine list
-        for (const auto & r : s_Instances)
-        {
-            if (!r.mInst.IsNull() && r.mTag == tag.mPtr)
-            {
-                return true; // Yup, we're doing this
-            }
-        }
+        // Is there a routine with this tag?
+        return !s_Tags.Find(String(tag.mPtr, static_cast< size_t >(ClampMin(tag.mLen, 0)))).empty();
     }
     // Unable to find such routine
     return false;
@@ -488,14 +475,14 @@ bool Routine::TerminateWithTag(StackStrF & tag)
     // Is the specified tag valid?
     if (tag.mPtr != nullptr)
     {
-        // Iterate routine list
-        for (auto & r : s_Instances)
+        TagIndex::Slot slot = NOSLOT;
+        // Is there a routine with this tag?
+        if (s_Tags.First(String(tag.mPtr, static_cast< size_t >(ClampMin(tag.mLen, 0))), slot))
         {
-            if (!r.mInst.IsNull() && r.mTag == tag.mPtr)
-            {
-                r.Terminate(); // Yup, we're doing this
-                return true; // A routine was terminated
-            }
+            s_Instances[slot].Terminate(); // Yup, we're doing this
+            // Also disable the timer
+            s_Timers.Disarm(static_cast< TimerQueue::Slot >(slot));
+            return true; // A routine was terminated
         }
     }
     // Unable to find such routine
@@ -569,6 +556,7 @@ void Register_Routine(HSQUIRRELVM vm)
         .Func(_SC("Restart"), &Routine::Restart)
         .StaticFunc(_SC("Current"), &Routine::GetCurrent)
         .StaticFunc(_SC("UsedCount"), &Routine::GetUsed)
+        .StaticFunc(_SC("ScheduledCount"), &Routine::GetScheduled)
         .StaticFunc(_SC("AreSilenced"), &Routine::GetSilenced)
         .StaticFunc(_SC("SetSilenced"), &Routine::SetSilenced)
         .StaticFunc(_SC("ArePersistent"), &Routine::GetPersistency)
@@ -2,6 +2,11 @@
 
 // ------------------------------------------------------------------------------------------------
 #include "Core/Utility.hpp"
+#include "Core/TagIndex.hpp"
+#include "Core/TimerQueue.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <deque>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
@@ -50,6 +55,7 @@ private:
         bool        mYields{false}; // Whether this instance may yield a value when callback is invoked.
         uint8_t     mArgc{0}; // The number of arguments that the routine must forward.
         Argument    mArgv[14]{}; // The arguments that the routine must forward.
+        uint32_t    mSlot{0}; // The index of this instance in the pool.
 
         /* ----------------------------------------------------------------------------------------
          * Default constructor.
@@ -72,6 +78,7 @@ private:
             , mYields(false)
             , mArgc(0)
             , mArgv()
+            , mSlot(0)
         {
             /* ... */
         }
@@ -121,6 +128,8 @@ private:
             mExecuting = false;
             // This is now active
             mInactive = mFunc.IsNull();
+            // Make it discoverable by tag
+            s_Tags.Insert(mTag, mSlot);
         }
 
         /* ----------------------------------------------------------------------------------------
@@ -136,6 +145,7 @@ private:
             mIterations = 0;
             mInterval = 0;
             mInactive = true;
+            s_Tags.Remove(mTag, mSlot);
             mTag.clear();
         }
 
@@ -263,12 +273,19 @@ protected:
 
 private:
 
+    // --------------------------------------------------------------------------------------------
+    typedef std::deque< Instance > Instances; // Grows without moving existing instances.
+
+    // --------------------------------------------------------------------------------------------
+    static constexpr uint32_t NOSLOT = std::numeric_limits< uint32_t >::max(); // Inexistent slot.
+
     // --------------------------------------------------------------------------------------------
     static Time         s_Last; // Last time point.
     static Time         s_Prev; // Previous time point.
-    static Interval     s_Intervals[SQMOD_MAX_ROUTINES]; // List of intervals to be processed.
-    static Instance     s_Instances[SQMOD_MAX_ROUTINES]; // List of routines to be executed.
-    static SQInteger    s_Current; // Currently executed routine index (SQMOD_MAX_ROUTINES if none).
+    static TagIndex     s_Tags; // Slots of the active routines by tag.
+    static TimerQueue   s_Timers; // Schedule of the routines to be processed.
+    static Instances    s_Instances; // List of routines to be executed.
+    static SQInteger    s_Current; // Currently executed routine index (NOSLOT if none).
     static bool         s_Silenced; // Error reporting independent from global setting.
     static bool         s_Persistent; // Whether all routines should be persistent by default.
 
@@ -285,7 +302,7 @@ protected:
      * Default constructor.
     */
     Routine()
-        : m_Slot(SQMOD_MAX_ROUTINES)
+        : m_Slot(NOSLOT)
     {
         /* ... */
     }
@@ -300,20 +317,30 @@ protected:
     }
 
     /* --------------------------------------------------------------------------------------------
-     * Find an unoccupied routine slot.
+     * Find an unoccupied routine slot or create one if all are occupied.
     */
     static SQInteger FindUnused()
     {
-        for (const auto & r : s_Instances)
+        for (Instances::size_type i = 0; i < s_Instances.size(); ++i)
         {
+            const Instance & r = s_Instances[i];
             // Either not used or not currently being executing
             if (r.mInst.IsNull() && !(r.mExecuting))
             {
-                return (&r - s_Instances); // Return the index of this element
+                return static_cast< SQInteger >(i); // Return the index of this element
             }
         }
-        // No available slot
-        return -1;
+        // Can we have another slot?
+        if (s_Instances.size() >= NOSLOT)
+        {
+            return -1;
+        }
+        // Create a new slot
+        s_Instances.emplace_back();
+        // Let it know where it is
+        s_Instances.back().mSlot = static_cast< uint32_t >(s_Instances.size() - 1);
+        // Return the index of the new slot
+        return static_cast< SQInteger >(s_Instances.size() - 1);
     }
 
 public:
@@ -323,7 +350,7 @@ public:
     */
     ~Routine()
     {
-        if (m_Slot < SQMOD_MAX_ROUTINES)
+        if (m_Slot < s_Instances.size())
         {
             Terminate();
         }
@@ -349,6 +376,14 @@ public:
     */
     Routine & operator = (Routine && o) = delete;
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of routines waiting to be invoked.
+    */
+    static SQInteger GetScheduled()
+    {
+        return static_cast< SQInteger >(s_Timers.Armed());
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Retrieve the number of used routine slots.
     */
@@ -372,17 +407,11 @@ public:
     */
     static LightObj FindByTag(StackStrF & tag)
     {
-        // Is the specified tag valid?
-        if (tag.mPtr != nullptr && tag.mLen > 0)
+        TagIndex::Slot slot = NOSLOT;
+        // Is the specified tag valid and is there a routine with it?
+        if (tag.mPtr != nullptr && tag.mLen > 0 && s_Tags.First(String(tag.mPtr, static_cast< size_t >(tag.mLen)), slot))
         {
-            // Iterate routine list and look for it
-            for (const auto & r : s_Instances)
-            {
-                if (!r.mInst.IsNull() && r.mTag == tag.mPtr)
-                {
-                    return r.mInst; // Return this routine instance
-                }
-            }
+            return s_Instances[slot].mInst; // Return this routine instance
         }
         // Unable to find such routine
         return LightObj{};
@@ -398,25 +427,16 @@ public:
         {
             STHROWF("Invalid routine tag");
         }
-        // Iterate routine list and look for it
-        for (const auto & r : s_Instances)
+        TagIndex::Slot slot = NOSLOT;
+        // Look for a routine with this tag
+        if (s_Tags.First(String(tag.mPtr, static_cast< size_t >(tag.mLen)), slot))
         {
-            if (!r.mInst.IsNull() && r.mTag == tag.mPtr)
-            {
-                return r.mInst; // Return this routine instance
-            }
+            return s_Instances[slot].mInst; // Return this routine instance
         }
         // Unable to find such routine
         STHROWF("Unable to fetch a routine with tag ({}). No such routine", tag.mPtr);
         // Should not reach this point but if it did, we have to return something
-#ifdef __clang__
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Warray-bounds"
-#endif
-        return s_Instances[SQMOD_MAX_ROUTINES].mInst; // Intentional Buffer overflow!
-#ifdef __clang__
-    #pragma clang diagnostic pop
-#endif
+        return NullLightObj();
         SQ_UNREACHABLE
     }
 
@@ -462,7 +482,7 @@ protected:
     */
     void Validate() const
     {
-        if (m_Slot >= SQMOD_MAX_ROUTINES)
+        if (m_Slot >= s_Instances.size())
         {
             STHROWF("This instance does not reference a valid routine");
         }
@@ -473,7 +493,7 @@ protected:
     */
     SQMOD_NODISCARD Instance & GetValid() const
     {
-        if (m_Slot >= SQMOD_MAX_ROUTINES)
+        if (m_Slot >= s_Instances.size())
         {
             STHROWF("This instance does not reference a valid routine");
         }
@@ -488,7 +508,7 @@ public:
     */
     SQMOD_NODISCARD const String & ToString() const
     {
-        return (m_Slot >= SQMOD_MAX_ROUTINES) ? NullString() : s_Instances[m_Slot].mTag;
+        return (m_Slot >= s_Instances.size()) ? NullString() : s_Instances[m_Slot].mTag;
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -497,8 +517,8 @@ public:
     void Terminate()
     {
         GetValid().Terminate();
-        s_Intervals[m_Slot] = 0;
-        m_Slot = SQMOD_MAX_ROUTINES;
+        s_Timers.Disarm(m_Slot);
+        m_Slot = NOSLOT;
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -514,7 +534,11 @@ public:
     */
     void SetTag(StackStrF & tag)
     {
-        GetValid().mTag.assign(tag.mPtr, static_cast< size_t >(ClampMin(tag.mLen, 0)));
+        Instance & inst = GetValid();
+        // Remember the previous tag to update the index
+        const String prev(std::move(inst.mTag));
+        inst.mTag.assign(tag.mPtr, static_cast< size_t >(ClampMin(tag.mLen, 0)));
+        s_Tags.Update(prev, inst.mTag, m_Slot);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -801,7 +825,7 @@ public:
     */
     SQMOD_NODISCARD bool GetTerminated() const
     {
-        return (m_Slot == SQMOD_MAX_ROUTINES);
+        return (m_Slot == NOSLOT);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -809,12 +833,12 @@ public:
     */
     SQMOD_NODISCARD SQInteger GetElapsed() const
     {
-        if (m_Slot >= SQMOD_MAX_ROUTINES)
+        if (m_Slot >= s_Instances.size())
         {
             STHROWF("This instance does not reference a valid routine");
         }
         // We know it's valid so let's return it
-        return s_Instances[m_Slot].mInterval - s_Intervals[m_Slot];
+        return s_Instances[m_Slot].mInterval - static_cast< SQInteger >(s_Timers.Remaining(m_Slot));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -822,12 +846,12 @@ public:
     */
     SQMOD_NODISCARD SQInteger GetRemaining() const
     {
-        if (m_Slot >= SQMOD_MAX_ROUTINES)
+        if (m_Slot >= s_Instances.size())
         {
             STHROWF("This instance does not reference a valid routine");
         }
         // We know it's valid so let's return it
-        return s_Intervals[m_Slot];
+        return static_cast< SQInteger >(s_Timers.Remaining(m_Slot));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -880,7 +904,7 @@ public:
         // Activate the routine again
         inst.mInactive = inst.mFunc.IsNull();
         // Start the clock again
-        s_Intervals[m_Slot] = inst.mInterval;
+        s_Timers.Arm(m_Slot, inst.mInterval);
         // Allow chaining
         return *this;
     }
@@ -890,7 +914,7 @@ public:
     */
     static LightObj & GetCurrent()
     {
-        return (s_Current != SQMOD_MAX_ROUTINES) ? s_Instances[s_Current].mInst : NullLightObj();
+        return (s_Current != NOSLOT) ? s_Instances[s_Current].mInst : NullLightObj();
     }
 
     /* --------------------------------------------------------------------------------------------
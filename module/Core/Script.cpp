@@ -6,6 +6,9 @@
 #include <algorithm>
 #include <stdexcept>
 
+// ------------------------------------------------------------------------------------------------
+#include <xxhash.h>
+
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
@@ -31,6 +34,14 @@ public:
         }
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Open the file with the specified mode but without throwing on failure.
+    */
+    FileHandle(const SQChar * path, const char * mode)
+        : mFile(std::fopen(path, mode))
+    {
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Copy constructor. (disabled)
     */
@@ -72,6 +83,138 @@ public:
 };
 
 
+/* ------------------------------------------------------------------------------------------------
+ * Header that precedes the compiled closure in a bytecode cache file.
+*/
+struct ScriptCacheHeader
+{
+    uint32_t    mMagic; // Identifies the file as a bytecode cache entry.
+    uint32_t    mFormat; // Format of the cache entry and the compiler that produced it.
+    uint64_t    mKey; // Hash of the source code that was compiled.
+    uint64_t    mSize; // Size of the source code that was compiled.
+};
+
+// ------------------------------------------------------------------------------------------------
+static constexpr uint32_t SQMOD_SCRIPT_CACHE_MAGIC = 0x43514D53; // SMQC
+static constexpr uint32_t SQMOD_SCRIPT_CACHE_FORMAT = (SQUIRREL_VERSION_NUMBER << 16) |
+                                                        (sizeof(SQInteger) << 12) |
+                                                        (sizeof(SQFloat) << 8) |
+                                                        (sizeof(SQChar) << 4) | 1;
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger ScriptCacheRead(SQUserPointer up, SQUserPointer buf, SQInteger size)
+{
+    return static_cast< SQInteger >(std::fread(buf, 1, static_cast< size_t >(size), static_cast< std::FILE * >(up)));
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger ScriptCacheWrite(SQUserPointer up, SQUserPointer buf, SQInteger size)
+{
+    return static_cast< SQInteger >(std::fwrite(buf, 1, static_cast< size_t >(size), static_cast< std::FILE * >(up)));
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Read the raw contents of a script file. Returns false if the file is already compiled.
+*/
+static bool ScriptCacheSource(const String & path, String & data)
+{
+    // Attempt to open the specified file
+    FileHandle fp(path.c_str());
+    // Go to the end of the file
+    std::fseek(fp, 0, SEEK_END);
+    // Calculate buffer size from beginning to current position
+    const long length = std::ftell(fp);
+    // Go back to the beginning
+    std::fseek(fp, 0, SEEK_SET);
+    // Is there anything to read?
+    if (length <= 0)
+    {
+        return false;
+    }
+    // Allocate enough space to hold the file data
+    data.resize(static_cast< size_t >(length), 0);
+    // Read the file contents into allocated data
+    if (std::fread(&data[0], 1, data.size(), fp) != data.size())
+    {
+        STHROWF("Failed to read script contents ({})", path);
+    }
+    // Is this a compiled script?
+    return !(data.size() >= 2 && *reinterpret_cast< const uint16_t * >(data.data()) == SQ_BYTECODE_STREAM_TAG);
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Attempt to load a previously compiled closure from the cache and push it on the stack.
+*/
+static bool ScriptCacheLoad(HSQUIRRELVM vm, const String & file, uint64_t key, size_t size)
+{
+    // Attempt to open the cache entry
+    FileHandle fp(file.c_str(), "rb");
+    // Is there an entry for this source?
+    if (!fp.mFile)
+    {
+        return false;
+    }
+    // Read the entry header
+    ScriptCacheHeader hdr{};
+    // Does this entry belong to this exact source and compiler?
+    if (std::fread(&hdr, sizeof(hdr), 1, fp) != 1 || hdr.mMagic != SQMOD_SCRIPT_CACHE_MAGIC ||
+        hdr.mFormat != SQMOD_SCRIPT_CACHE_FORMAT || hdr.mKey != key || hdr.mSize != size)
+    {
+        return false;
+    }
+    // Remember the stack size in case the closure is damaged
+    const SQInteger top = sq_gettop(vm);
+    // Attempt to deserialize the closure
+    if (SQ_FAILED(sq_readclosure(vm, ScriptCacheRead, fp.mFile)))
+    {
+        // Discard the error and whatever was left on the stack
+        sq_reseterror(vm);
+        sq_settop(vm, top);
+        // The source will have to be compiled
+        return false;
+    }
+    // The closure is now on the stack
+    return true;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Store a compiled closure in the cache. Failures are ignored since the cache is optional.
+*/
+static void ScriptCacheStore(HSQUIRRELVM vm, HSQOBJECT & obj, const String & file, uint64_t key, size_t size)
+{
+    // Write to a temporary file first so that partial entries are never observed
+    const String temp = file + ".tmp";
+    // Whether the entry was written completely
+    bool ok = false;
+    {
+        // Attempt to create the temporary file
+        FileHandle fp(temp.c_str(), "wb");
+        // Could we create it?
+        if (!fp.mFile)
+        {
+            return;
+        }
+        // Prepare the entry header
+        const ScriptCacheHeader hdr{SQMOD_SCRIPT_CACHE_MAGIC, SQMOD_SCRIPT_CACHE_FORMAT, key, static_cast< uint64_t >(size)};
+        // Remember the stack size
+        const SQInteger top = sq_gettop(vm);
+        // Push the compiled closure on the stack
+        sq_pushobject(vm, obj);
+        // Write the header followed by the serialized closure
+        ok = std::fwrite(&hdr, sizeof(hdr), 1, fp) == 1 && SQ_SUCCEEDED(sq_writeclosure(vm, ScriptCacheWrite, fp.mFile));
+        // Discard any error and restore the stack
+        sq_reseterror(vm);
+        sq_settop(vm, top);
+        // Make sure everything reached the file before it's moved into place
+        ok = ok && std::fflush(fp) == 0;
+    }
+    // Move the entry into place or discard it
+    if (!ok || std::rename(temp.c_str(), file.c_str()) != 0)
+    {
+        std::remove(temp.c_str());
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void ScriptSrc::Process()
 {
@@ -147,6 +290,64 @@ void ScriptSrc::Process()
     mInfo = true;
 }
 
+// ------------------------------------------------------------------------------------------------
+void ScriptSrc::Compile(const String & cache)
+{
+    // Is the bytecode cache disabled?
+    if (cache.empty())
+    {
+        mExec.CompileFile(mPath);
+        // Nothing else to do
+        return;
+    }
+    // Source code that is about to be compiled
+    String data;
+    // Can we reuse the contents that were loaded for debugging?
+    if (!mData.empty())
+    {
+        data = mData;
+    }
+    // Read them now otherwise
+    else if (!ScriptCacheSource(mPath, data))
+    {
+        mExec.CompileFile(mPath);
+        // Empty and already compiled scripts are not cached
+        return;
+    }
+    // The source name is stored within the bytecode so it must be part of the key
+    const uint64_t seed = XXH64(mPath.data(), mPath.size(), SQMOD_SCRIPT_CACHE_FORMAT);
+    // Hash the source code to obtain the cache key
+    const uint64_t key = XXH64(data.data(), data.size(), seed);
+    // Generate the path of the cache entry
+    String file(cache);
+    // Is there a path separator at the end?
+    if (file.back() != '/' && file.back() != '\\')
+    {
+        file.push_back('/');
+    }
+    // Append the name of the cache entry
+    file.append(fmt::format("{:016x}.cnut", key));
+    // Grab the virtual machine
+    HSQUIRRELVM vm = SqVM();
+    // Is there a valid cache entry for this source?
+    if (ScriptCacheLoad(vm, file, key, data.size()))
+    {
+        HSQOBJECT obj;
+        // Grab the deserialized closure
+        sq_getstackobj(vm, -1, &obj);
+        // Take ownership of it
+        mExec = Script(obj, vm);
+        // Pop it from the stack
+        sq_pop(vm, 1);
+        // Nothing else to do
+        return;
+    }
+    // Compile the script from the source
+    mExec.CompileFile(mPath);
+    // Store the result for next time
+    ScriptCacheStore(vm, mExec.GetObj(), file, key, data.size());
+}
+
 // ------------------------------------------------------------------------------------------------
 ScriptSrc::ScriptSrc(const String & path, Function & cb, LightObj & ctx, bool delay, bool info) // NOLINT(modernize-pass-by-value)
     : mExec()
@@ -39,6 +39,12 @@ struct ScriptSrc
     */
     void Process();
 
+    /* --------------------------------------------------------------------------------------------
+     * Compile the script file. If a cache directory is specified then the compiled closure is
+     * looked up there by the hash of the source code and stored there after a fresh compilation.
+    */
+    void Compile(const String & cache);
+
     /* --------------------------------------------------------------------------------------------
      * Base constructor.
     */
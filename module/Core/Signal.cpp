@@ -10,6 +10,8 @@ SQMOD_DECL_TYPENAME(Typename, _SC("SqSignalBase"))
 // ------------------------------------------------------------------------------------------------
 Signal::SignalPool  Signal::s_Signals;
 Signal::FreeSignals Signal::s_FreeSignals;
+bool                Signal::s_Profiling = false;
+uint64_t            Signal::s_SlowSlot = 0;
 
 /* ------------------------------------------------------------------------------------------------
  * Class used to control the signal emitter.
@@ -570,6 +572,8 @@ Signal::Signal()
     , m_Scope(nullptr)
     , m_Name()
     , m_Data()
+    , m_Label(nullptr)
+    , m_Profile()
 {
     s_FreeSignals.push_back(this);
 }
@@ -582,6 +586,8 @@ Signal::Signal(String && name)
     , m_Scope(nullptr)
     , m_Name(std::forward< String >(name))
     , m_Data()
+    , m_Label(nullptr)
+    , m_Profile()
 {
     if (m_Name.empty())
     {
@@ -976,6 +982,8 @@ SQInteger Signal::Emit(HSQUIRRELVM vm, SQInteger top)
     Scope scope(m_Scope, m_Slots, m_Slots + m_Used);
     // Activate the current scope and create a guard to restore it
     const AutoAssign< Scope * > aa(m_Scope, scope.mParent, &scope);
+    // Record the cost of this emission, if necessary
+    const ProfileScope ps(*this);
     // Contains the last received result
     SQRESULT res = SQ_OK;
     // Process the slots from this scope
@@ -1002,8 +1010,15 @@ SQInteger Signal::Emit(HSQUIRRELVM vm, SQInteger top)
                 sq_push(vm, i);
             }
         }
+        // Copy what the profiler needs since the slots can change during the call
+        const SQHash hash = slot.mFuncHash;
+        const HSQOBJECT func = slot.mFuncRef;
+        // Start timing the call, if necessary
+        const uint64_t start = ProfileBegin();
         // Make the function call and store the result
         res = sq_call(vm, top, static_cast< SQBool >(false), static_cast< SQBool >(ErrorHandling::IsEnabled()));
+        // Record the cost of the call, if necessary
+        ProfileEnd(hash, func, start);
         // Pop the callback object from the stack
         sq_pop(vm, 1);
         // Validate the result
@@ -1061,6 +1076,8 @@ SQInteger Signal::Query(HSQUIRRELVM vm, SQInteger top)
     Scope scope(m_Scope, m_Slots, m_Slots + m_Used);
     // Activate the current scope and create a guard to restore it
     const AutoAssign< Scope * > aa(m_Scope, scope.mParent, &scope);
+    // Record the cost of this emission, if necessary
+    const ProfileScope ps(*this);
     // Process the slots from this scope
     while (scope.mItr != scope.mEnd)
     {
@@ -1085,8 +1102,15 @@ SQInteger Signal::Query(HSQUIRRELVM vm, SQInteger top)
                 sq_push(vm, i);
             }
         }
+        // Copy what the profiler needs since the slots can change during the call
+        const SQHash hash = slot.mFuncHash;
+        const HSQOBJECT func = slot.mFuncRef;
+        // Start timing the call, if necessary
+        const uint64_t start = ProfileBegin();
         // Make the function call and store the result
         res = sq_call(vm, top-2, static_cast< SQBool >(true), static_cast< SQBool >(ErrorHandling::IsEnabled()));
+        // Record the cost of the call, if necessary
+        ProfileEnd(hash, func, start);
         // Validate the result
         if (SQ_FAILED(res))
         {
@@ -1123,6 +1147,8 @@ SQInteger Signal::Consume(HSQUIRRELVM vm, SQInteger top)
     Scope scope(m_Scope, m_Slots, m_Slots + m_Used);
     // Activate the current scope and create a guard to restore it
     const AutoAssign< Scope * > aa(m_Scope, scope.mParent, &scope);
+    // Record the cost of this emission, if necessary
+    const ProfileScope ps(*this);
     // Contains the last received result
     SQRESULT res = SQ_OK;
     // Default to not consumed
@@ -1151,8 +1177,15 @@ SQInteger Signal::Consume(HSQUIRRELVM vm, SQInteger top)
                 sq_push(vm, i);
             }
         }
+        // Copy what the profiler needs since the slots can change during the call
+        const SQHash hash = slot.mFuncHash;
+        const HSQOBJECT func = slot.mFuncRef;
+        // Start timing the call, if necessary
+        const uint64_t start = ProfileBegin();
         // Make the function call and store the result
         res = sq_call(vm, top, static_cast< SQBool >(true), static_cast< SQBool >(ErrorHandling::IsEnabled()));
+        // Record the cost of the call, if necessary
+        ProfileEnd(hash, func, start);
         // Validate the result
         if (SQ_FAILED(res))
         {
@@ -1198,6 +1231,8 @@ SQInteger Signal::Approve(HSQUIRRELVM vm, SQInteger top)
     Scope scope(m_Scope, m_Slots, m_Slots + m_Used);
     // Activate the current scope and create a guard to restore it
     const AutoAssign< Scope * > aa(m_Scope, scope.mParent, &scope);
+    // Record the cost of this emission, if necessary
+    const ProfileScope ps(*this);
     // Contains the last received result
     SQRESULT res = SQ_OK;
     // Default to approved
@@ -1226,8 +1261,15 @@ SQInteger Signal::Approve(HSQUIRRELVM vm, SQInteger top)
                 sq_push(vm, i);
             }
         }
+        // Copy what the profiler needs since the slots can change during the call
+        const SQHash hash = slot.mFuncHash;
+        const HSQOBJECT func = slot.mFuncRef;
+        // Start timing the call, if necessary
+        const uint64_t start = ProfileBegin();
         // Make the function call and store the result
         res = sq_call(vm, top, static_cast< SQBool >(true), static_cast< SQBool >(ErrorHandling::IsEnabled()));
+        // Record the cost of the call, if necessary
+        ProfileEnd(hash, func, start);
         // Validate the result
         if (SQ_FAILED(res))
         {
@@ -1273,6 +1315,8 @@ SQInteger Signal::Request(HSQUIRRELVM vm, SQInteger top)
     Scope scope(m_Scope, m_Slots, m_Slots + m_Used);
     // Activate the current scope and create a guard to restore it
     const AutoAssign< Scope * > aa(m_Scope, scope.mParent, &scope);
+    // Record the cost of this emission, if necessary
+    const ProfileScope ps(*this);
     // Contains the last received result
     SQRESULT res = SQ_OK;
     // Process the slots from this scope
@@ -1299,8 +1343,15 @@ SQInteger Signal::Request(HSQUIRRELVM vm, SQInteger top)
                 sq_push(vm, i);
             }
         }
+        // Copy what the profiler needs since the slots can change during the call
+        const SQHash hash = slot.mFuncHash;
+        const HSQOBJECT func = slot.mFuncRef;
+        // Start timing the call, if necessary
+        const uint64_t start = ProfileBegin();
         // Make the function call and store the result
         res = sq_call(vm, top, static_cast< SQBool >(true), static_cast< SQBool >(ErrorHandling::IsEnabled()));
+        // Record the cost of the call, if necessary
+        ProfileEnd(hash, func, start);
         // Validate the result
         if (SQ_FAILED(res))
         {
@@ -1647,6 +1698,200 @@ const LightObj & Signal::Fetch(StackStrF & name)
     return slo;
 }
 
+// ------------------------------------------------------------------------------------------------
+Table Signal::Stats::ToTable() const
+{
+    Table tbl(SqVM(), 8);
+    // Populate the table with the recorded information
+    tbl.SetValue(_SC("Calls"), static_cast< SQInteger >(mCalls));
+    tbl.SetValue(_SC("Total"), static_cast< SQInteger >(mTotal));
+    tbl.SetValue(_SC("Max"), static_cast< SQInteger >(mMax));
+    tbl.SetValue(_SC("Average"), mCalls ? static_cast< SQInteger >(mTotal / mCalls) : SQInteger(0));
+    // Only slots have a name and location
+    if (!mSource.empty())
+    {
+        tbl.SetValue(_SC("Name"), mName);
+        tbl.SetValue(_SC("Source"), mSource);
+        tbl.SetValue(_SC("Line"), mLine);
+    }
+    // Trailing empty buckets are not included
+    SQInteger n = PROFILE_BUCKETS;
+    while (n > 0 && mHistogram[n - 1] == 0) --n;
+    // Create the histogram array
+    Array hist(SqVM(), n);
+    for (SQInteger i = 0; i < n; ++i)
+    {
+        hist.SetValue(i, static_cast< SQInteger >(mHistogram[i]));
+    }
+    tbl.SetValue(_SC("Histogram"), hist);
+    // Return the resulted table
+    return tbl;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Signal::ProfileEmission(uint64_t us)
+{
+    // Create the profile on first use
+    if (!m_Profile)
+    {
+        m_Profile = std::make_unique< Profile >();
+    }
+    // Record the emission
+    m_Profile->mSignal.Record(us);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Signal::ProfileSlot(SQHash hash, HSQOBJECT func, uint64_t us)
+{
+    // Create the profile on first use
+    if (!m_Profile)
+    {
+        m_Profile = std::make_unique< Profile >();
+    }
+    // Grab the statistics of this slot
+    Stats & st = m_Profile->mSlots[hash];
+    // Is this the first call to this slot?
+    if (st.mSource.empty())
+    {
+        HSQUIRRELVM vm = SqVM();
+        // Remember the current stack size
+        const StackGuard sg(vm);
+        // Push the callback object
+        sq_pushobject(vm, func);
+        // Retrieve the location of the function
+        const SQChar * src = nullptr;
+        if (SQ_SUCCEEDED(sq_getclosuresource(vm, -1, &src, &st.mLine)))
+        {
+            st.mSource.assign(src);
+        }
+        else
+        {
+            st.mSource.assign("unknown");
+        }
+        // Retrieve the name of the function
+        const SQChar * name = nullptr;
+        if (SQ_SUCCEEDED(sq_getclosurename(vm, -1)) && SQ_SUCCEEDED(sq_getstring(vm, -1, &name)))
+        {
+            st.mName.assign(name);
+        }
+        else
+        {
+            st.mName.assign("anonymous");
+        }
+    }
+    // Record the call
+    st.Record(us);
+    // Should this call be reported?
+    if (s_SlowSlot != 0 && us >= s_SlowSlot)
+    {
+        LogWrn("Slot %s (%s:%lld) of signal (%s) took %llu microseconds", st.mName.c_str(), st.mSource.c_str(),
+                static_cast< long long >(st.mLine), GetLabel(), static_cast< unsigned long long >(us));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+LightObj Signal::GetProfile() const
+{
+    // Was anything recorded?
+    if (!m_Profile)
+    {
+        return LightObj{};
+    }
+    // Start with the statistics of the signal itself
+    Table tbl = m_Profile->mSignal.ToTable();
+    // Create an array with the statistics of each slot
+    Array slots(SqVM(), static_cast< SQInteger >(m_Profile->mSlots.size()));
+    SQInteger i = 0;
+    for (const auto & e : m_Profile->mSlots)
+    {
+        slots.SetValue(i++, e.second.ToTable());
+    }
+    tbl.SetValue(_SC("Slots"), slots);
+    // Return the resulted table
+    return LightObj(tbl.GetObj());
+}
+
+// ------------------------------------------------------------------------------------------------
+void Signal::ResetProfiles()
+{
+    for (const auto & e : s_Signals)
+    {
+        e.second.first->ResetProfile();
+    }
+    for (const auto & s : s_FreeSignals)
+    {
+        s->ResetProfile();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Signal::DumpProfiles(StackStrF & path)
+{
+    // Attempt to open the specified file
+    std::unique_ptr< std::FILE, int(*)(std::FILE *) > file(std::fopen(path.mPtr, "w"), &std::fclose);
+    // Validate the file handle
+    if (!file)
+    {
+        STHROWF("Unable to open file: {}", path.mPtr);
+    }
+    // Collect all signals in a single list
+    std::vector< const Signal * > list;
+    list.reserve(s_Signals.size() + s_FreeSignals.size());
+    for (const auto & e : s_Signals)
+    {
+        list.push_back(e.second.first);
+    }
+    list.insert(list.end(), s_FreeSignals.begin(), s_FreeSignals.end());
+    // Ignore signals without recorded costs
+    list.erase(std::remove_if(list.begin(), list.end(), [](const Signal * s) { return !s->m_Profile; }), list.end());
+    // The most expensive signals go first
+    std::sort(list.begin(), list.end(), [](const Signal * a, const Signal * b) {
+        return a->m_Profile->mSignal.mTotal > b->m_Profile->mSignal.mTotal;
+    });
+    // Write each signal followed by its slots
+    for (const Signal * s : list)
+    {
+        fmt::print(file.get(), "{}\tcalls={}\ttotal={}us\tmax={}us\n", s->GetLabel(),
+                   s->m_Profile->mSignal.mCalls, s->m_Profile->mSignal.mTotal, s->m_Profile->mSignal.mMax);
+        // Write the slots of this signal
+        for (const auto & e : s->m_Profile->mSlots)
+        {
+            const Stats & st = e.second;
+            fmt::print(file.get(), "\t{} ({}:{})\tcalls={}\ttotal={}us\tmax={}us\n",
+                       st.mName, st.mSource, st.mLine, st.mCalls, st.mTotal, st.mMax);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Signal::SampleProfiles(std::vector< ProfileSample > & out)
+{
+    out.clear();
+    // Copy the costs of a single signal, if it has any
+    const auto sample = [&out](const Signal * s) {
+        if (!s->m_Profile)
+        {
+            return;
+        }
+        const Stats & st = s->m_Profile->mSignal;
+        out.emplace_back();
+        ProfileSample & ps = out.back();
+        ps.mName.assign(s->GetLabel());
+        ps.mCalls = st.mCalls;
+        ps.mTotal = st.mTotal;
+        ps.mMax = st.mMax;
+        std::copy(std::begin(st.mHistogram), std::end(st.mHistogram), std::begin(ps.mHistogram));
+    };
+    for (const auto & e : s_Signals)
+    {
+        sample(e.second.first);
+    }
+    for (const auto * s : s_FreeSignals)
+    {
+        sample(s);
+    }
+}
+
 /* ------------------------------------------------------------------------------------------------
  * Forward the call to terminate the signals.
 */
@@ -1666,6 +1911,8 @@ void InitSignalPair(SignalPair & sp, LightObj & et, const char * name)
     sp.second = LightObj(dg.Get());
     // Assign the signal instance itself
     sp.first = dg.Get();
+    // Identify the signal in profiling reports
+    sp.first->SetLabel(name);
     // This is now managed by the script
     dg.Release();
     // Should we bind this to a certain object?
@@ -1702,8 +1949,10 @@ void Register_Signal(HSQUIRRELVM vm)
         .Func(_SC("Name"), &Signal::ToString)
         .Prop(_SC("Slots"), &Signal::GetUsed)
         .Prop(_SC("Empty"), &Signal::IsEmpty)
+        .Prop(_SC("Profile"), &Signal::GetProfile)
         // Core Methods
         .Func(_SC("Clear"), &Signal::ClearSlots)
+        .Func(_SC("ResetProfile"), &Signal::ResetProfile)
         // Squirrel Functions
         .SquirrelFunc(_SC("Connect"), &Signal::SqConnect)
         .SquirrelFunc(_SC("ConnectOnce"), &Signal::SqConnectOnce)
@@ -1734,7 +1983,13 @@ void Register_Signal(HSQUIRRELVM vm)
     RootTable(vm)
         .FmtFunc(_SC("SqSignal"), &Signal::Fetch)
         .FmtFunc(_SC("SqCreateSignal"), &Signal::Create)
-        .FmtFunc(_SC("SqRemoveSignal"), &Signal::Remove);
+        .FmtFunc(_SC("SqRemoveSignal"), &Signal::Remove)
+        .Func(_SC("SqSignalProfiling"), &Signal::IsProfiling)
+        .Func(_SC("SqSetSignalProfiling"), &Signal::SetProfiling)
+        .Func(_SC("SqSlowSlotThreshold"), &Signal::GetSlowSlot)
+        .Func(_SC("SqSetSlowSlotThreshold"), &Signal::SetSlowSlot)
+        .Func(_SC("SqResetSignalProfiles"), &Signal::ResetProfiles)
+        .FmtFunc(_SC("SqDumpSignalProfiles"), &Signal::DumpProfiles);
 }
 
 } // Namespace:: SqMod
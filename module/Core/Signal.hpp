@@ -4,10 +4,12 @@
 #include "Core/Utility.hpp"
 
 // ------------------------------------------------------------------------------------------------
+#include <chrono>
 #include <vector>
 #include <utility>
 #include <algorithm>
 #include <functional>
+#include <unordered_map>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
@@ -357,6 +359,117 @@ protected:
         void Finish();
     };
 
+    // --------------------------------------------------------------------------------------------
+    enum { PROFILE_BUCKETS = 24 }; // Bucket N holds calls that took less than 2^N microseconds.
+
+    /* --------------------------------------------------------------------------------------------
+     * Cost of calls made to a signal or one of its slots. Only ever updated from the main thread.
+    */
+    struct Stats
+    {
+        uint64_t    mCalls{0}; // Number of recorded calls.
+        uint64_t    mTotal{0}; // Total time spent in calls (microseconds).
+        uint64_t    mMax{0}; // Longest call (microseconds).
+        uint32_t    mHistogram[PROFILE_BUCKETS]{}; // Distribution of call times.
+        String      mName{}; // Name of the slot function.
+        String      mSource{}; // Source where the slot function is defined.
+        SQInteger   mLine{0}; // Line where the slot function is defined.
+
+        /* ----------------------------------------------------------------------------------------
+         * Record the time spent in a call.
+        */
+        void Record(uint64_t us)
+        {
+            ++mCalls;
+            mTotal += us;
+            mMax = std::max(mMax, us);
+            // Find the bucket of this call
+            uint32_t b = 0;
+            while (b < PROFILE_BUCKETS - 1 && (us >> b) != 0) ++b;
+            ++mHistogram[b];
+        }
+
+        /* ----------------------------------------------------------------------------------------
+         * Create a script table with the recorded information.
+        */
+        SQMOD_NODISCARD Table ToTable() const;
+    };
+
+    /* --------------------------------------------------------------------------------------------
+     * Recorded emission costs of a signal.
+    */
+    struct Profile
+    {
+        Stats                               mSignal{}; // Cost of complete emissions.
+        std::unordered_map< SQHash, Stats > mSlots{}; // Cost of each slot, by function hash.
+    };
+
+    /* --------------------------------------------------------------------------------------------
+     * Records the cost of an emission when profiling is enabled.
+    */
+    struct ProfileScope
+    {
+        Signal &    mSignal; // The emitted signal.
+        uint64_t    mStart; // When the emission started.
+
+        /* ----------------------------------------------------------------------------------------
+         * Base constructor.
+        */
+        explicit ProfileScope(Signal & signal)
+            : mSignal(signal), mStart(ProfileBegin())
+        {
+        }
+
+        /* ----------------------------------------------------------------------------------------
+         * Destructor.
+        */
+        ~ProfileScope()
+        {
+            if (mStart != 0)
+            {
+                mSignal.ProfileEmission(ProfileClock() - mStart);
+            }
+        }
+    };
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the clock used for profiling (microseconds).
+    */
+    SQMOD_NODISCARD static uint64_t ProfileClock()
+    {
+        return static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::microseconds >(
+                                        std::chrono::steady_clock::now().time_since_epoch()).count()) + 1;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Start timing a call. Returns 0 if profiling is disabled.
+    */
+    SQMOD_NODISCARD static uint64_t ProfileBegin()
+    {
+        return s_Profiling ? ProfileClock() : 0;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Finish timing a call to the slot with the specified function.
+    */
+    void ProfileEnd(SQHash hash, HSQOBJECT func, uint64_t start)
+    {
+        if (start != 0)
+        {
+            ProfileSlot(hash, func, ProfileClock() - start);
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Record the cost of a complete emission.
+    */
+    void ProfileEmission(uint64_t us);
+
+    /* --------------------------------------------------------------------------------------------
+     * Record the cost of a call to the slot with the specified function and report it if it was too slow.
+    */
+    void ProfileSlot(SQHash hash, HSQOBJECT func, uint64_t us);
+
 private:
 
     // --------------------------------------------------------------------------------------------
@@ -369,6 +482,9 @@ private:
     String          m_Name; // The name that identifies this signal.
     LightObj        m_Data; // User data associated with this instance.
     // --------------------------------------------------------------------------------------------
+    const char *    m_Label; // Name of the event delivered by this signal, if any.
+    std::unique_ptr< Profile > m_Profile; // Recorded emission costs, if any.
+    // --------------------------------------------------------------------------------------------
     ValueType       m_SMB[SMB_SIZE]{}; // Small buffer optimization.
 
 public:
@@ -418,6 +534,35 @@ public:
         return (m_Used == 0);
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Specify the name of the event delivered by this signal. Must have static storage duration.
+    */
+    void SetLabel(const char * label)
+    {
+        m_Label = label;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve a name that can be used to identify this signal in reports.
+    */
+    SQMOD_NODISCARD const char * GetLabel() const
+    {
+        return m_Name.empty() ? (m_Label ? m_Label : "") : m_Name.c_str();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the recorded emission costs of this signal and its slots.
+    */
+    SQMOD_NODISCARD LightObj GetProfile() const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Forget the recorded emission costs of this signal.
+    */
+    void ResetProfile()
+    {
+        m_Profile.reset();
+    }
+
 protected:
 
     /* --------------------------------------------------------------------------------------------
@@ -666,6 +811,9 @@ protected:
     // --------------------------------------------------------------------------------------------
     static SignalPool   s_Signals; // List of all created signals.
     static FreeSignals  s_FreeSignals; // List of signals without a name.
+    // --------------------------------------------------------------------------------------------
+    static bool         s_Profiling; // Whether emission costs are recorded.
+    static uint64_t     s_SlowSlot; // Slot calls above this many microseconds are reported. (0 to disable)
     /* --------------------------------------------------------------------------------------------
      * Specialization for when there are no arguments given.
     */
@@ -718,6 +866,65 @@ public:
     */
     SQMOD_NODISCARD static const LightObj & Fetch(StackStrF & name);
 
+    /* --------------------------------------------------------------------------------------------
+     * See whether emission costs are recorded.
+    */
+    SQMOD_NODISCARD static bool IsProfiling()
+    {
+        return s_Profiling;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Toggle whether emission costs are recorded.
+    */
+    static void SetProfiling(bool toggle)
+    {
+        s_Profiling = toggle;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the duration (microseconds) above which slot calls are reported.
+    */
+    SQMOD_NODISCARD static SQInteger GetSlowSlot()
+    {
+        return static_cast< SQInteger >(s_SlowSlot);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the duration (microseconds) above which slot calls are reported. (0 to disable)
+    */
+    static void SetSlowSlot(SQInteger us)
+    {
+        s_SlowSlot = static_cast< uint64_t >(std::max< SQInteger >(us, 0));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Forget the recorded emission costs of all signals.
+    */
+    static void ResetProfiles();
+
+    /* --------------------------------------------------------------------------------------------
+     * Write the recorded emission costs of all signals to the specified file.
+    */
+    static void DumpProfiles(StackStrF & path);
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy of the recorded emission costs of a signal.
+    */
+    struct ProfileSample
+    {
+        String      mName{}; // Name of the signal.
+        uint64_t    mCalls{0}; // Number of recorded emissions.
+        uint64_t    mTotal{0}; // Total time spent in emissions (microseconds).
+        uint64_t    mMax{0}; // Longest emission (microseconds).
+        uint32_t    mHistogram[PROFILE_BUCKETS]{}; // Bucket N holds emissions below 2^N microseconds.
+    };
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy the recorded emission costs of all signals that have any.
+    */
+    static void SampleProfiles(std::vector< ProfileSample > & out);
+
     /* --------------------------------------------------------------------------------------------
      * Emit a signal from the module.
     */
@@ -729,6 +936,8 @@ public:
         Scope scope(m_Scope, m_Slots, m_Slots + m_Used);
         // Activate the current scope and create a guard to restore it
         const AutoAssign< Scope * > aa(m_Scope, scope.mParent, &scope);
+        // Record the cost of this emission, if necessary
+        const ProfileScope ps(*this);
         // Grab the default virtual machine
         HSQUIRRELVM vm = SqVM();
         // Process the slots from this scope
@@ -749,8 +958,15 @@ public:
             }
             // Push the given parameters on the stack
             PushParameters(args...);
+            // Copy what the profiler needs since the slots can change during the call
+            const SQHash hash = slot.mFuncHash;
+            const HSQOBJECT func = slot.mFuncRef;
+            // Start timing the call, if necessary
+            const uint64_t start = ProfileBegin();
             // Make the function call and store the result
             const SQRESULT res = sq_call(vm, 1 + sizeof...(Args), static_cast< SQBool >(false), static_cast< SQBool >(ErrorHandling::IsEnabled()));
+            // Record the cost of the call, if necessary
+            ProfileEnd(hash, func, start);
             // Pop the callback object from the stack
             sq_pop(vm, 1);
             // Validate the result
@@ -0,0 +1,188 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------------------
+#include "SqBase.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <set>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+// ------------------------------------------------------------------------------------------------
+namespace SqMod {
+
+/* ------------------------------------------------------------------------------------------------
+ * Maintained association between tags and the slots that currently use them.
+ * Exact lookups go through a hash table while prefix lookups walk a sorted list of tags.
+ * Slots associated with the same tag are kept in ascending order.
+*/
+class TagIndex
+{
+public:
+
+    // --------------------------------------------------------------------------------------------
+    typedef uint32_t                Slot; // Slot identifiers.
+    typedef std::vector< Slot >     Slots; // List of slot identifiers.
+
+private:
+
+    // --------------------------------------------------------------------------------------------
+    typedef std::unordered_map< String, Slots > Table; // Slots associated with each tag.
+    typedef std::set< String, std::less< > >   Sorted; // Tags in lexicographical order.
+
+    // --------------------------------------------------------------------------------------------
+    Table   m_Table; // Slots associated with each tag.
+    Sorted  m_Sorted; // Tags in lexicographical order.
+
+public:
+
+    /* --------------------------------------------------------------------------------------------
+     * Default constructor.
+    */
+    TagIndex()
+        : m_Table(), m_Sorted()
+    {
+        //...
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Associate a slot with the specified tag. Does nothing if already associated.
+    */
+    void Insert(const String & tag, Slot slot)
+    {
+        auto itr = m_Table.find(tag);
+        // Is this a new tag?
+        if (itr == m_Table.end())
+        {
+            itr = m_Table.emplace(tag, Slots{}).first;
+            m_Sorted.insert(tag);
+        }
+        Slots & slots = itr->second;
+        // Keep the slots sorted
+        auto pos = std::lower_bound(slots.begin(), slots.end(), slot);
+        if (pos == slots.end() || *pos != slot)
+        {
+            slots.insert(pos, slot);
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Dissociate a slot from the specified tag. Returns false if they were not associated.
+    */
+    bool Remove(const String & tag, Slot slot)
+    {
+        auto itr = m_Table.find(tag);
+        // Is this tag known?
+        if (itr == m_Table.end())
+        {
+            return false;
+        }
+        Slots & slots = itr->second;
+        // Is the slot associated with this tag?
+        auto pos = std::lower_bound(slots.begin(), slots.end(), slot);
+        if (pos == slots.end() || *pos != slot)
+        {
+            return false;
+        }
+        slots.erase(pos);
+        // Forget about tags that are not used anymore
+        if (slots.empty())
+        {
+            m_Sorted.erase(tag);
+            m_Table.erase(itr);
+        }
+        return true;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Move a slot to a different tag. Slots that are not indexed are left alone.
+    */
+    void Update(const String & from, const String & to, Slot slot)
+    {
+        if (Remove(from, slot))
+        {
+            Insert(to, slot);
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the slots associated with the specified tag, in ascending order.
+    */
+    SQMOD_NODISCARD const Slots & Find(const String & tag) const
+    {
+        static const Slots empty{};
+        // Look for the tag
+        auto itr = m_Table.find(tag);
+        // Return the associated slots, if any
+        return (itr == m_Table.end()) ? empty : itr->second;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the first slot associated with the specified tag. Returns false if none.
+    */
+    SQMOD_NODISCARD bool First(const String & tag, Slot & slot) const
+    {
+        const Slots & slots = Find(tag);
+        // Are there any slots?
+        if (slots.empty())
+        {
+            return false;
+        }
+        slot = slots.front();
+        return true;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Collect the slots associated with tags that begin with the specified string, in ascending order.
+    */
+    void Prefix(std::string_view prefix, Slots & out) const
+    {
+        out.clear();
+        // Tags that begin with the prefix are all stored after it
+        for (auto itr = m_Sorted.lower_bound(prefix); itr != m_Sorted.end(); ++itr)
+        {
+            // Did we move past the tags that begin with the prefix?
+            if (itr->compare(0, prefix.size(), prefix) != 0)
+            {
+                break;
+            }
+            const Slots & slots = m_Table.find(*itr)->second;
+            out.insert(out.end(), slots.begin(), slots.end());
+        }
+        // Slots from different tags are interleaved
+        std::sort(out.begin(), out.end());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Count the slots associated with tags that begin with the specified string.
+    */
+    SQMOD_NODISCARD size_t CountPrefix(std::string_view prefix) const
+    {
+        size_t n = 0;
+        // Tags that begin with the prefix are all stored after it
+        for (auto itr = m_Sorted.lower_bound(prefix); itr != m_Sorted.end(); ++itr)
+        {
+            // Did we move past the tags that begin with the prefix?
+            if (itr->compare(0, prefix.size(), prefix) != 0)
+            {
+                break;
+            }
+            n += m_Table.find(*itr)->second.size();
+        }
+        return n;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Forget all associations.
+    */
+    void Clear()
+    {
+        m_Table.clear();
+        m_Sorted.clear();
+    }
+};
+
+} // Namespace:: SqMod
@@ -17,8 +17,9 @@ SQMOD_DECL_TYPENAME(Typename, _SC("SqTask"))
 // ------------------------------------------------------------------------------------------------
 Tasks::Time         Tasks::s_Last = 0;
 Tasks::Time         Tasks::s_Prev = 0;
-Tasks::Interval     Tasks::s_Intervals[SQMOD_MAX_TASKS];
-Tasks::Task         Tasks::s_Tasks[SQMOD_MAX_TASKS];
+TagIndex            Tasks::s_Tags{};
+TimerQueue          Tasks::s_Timers{};
+Tasks::TaskList     Tasks::s_Tasks{};
 
 // ------------------------------------------------------------------------------------------------
 void Tasks::Task::Init(HSQOBJECT & func, HSQOBJECT & inst, Interval intrv, Iterator itr, int32_t id, int32_t type)
@@ -34,6 +35,8 @@ void Tasks::Task::Init(HSQOBJECT & func, HSQOBJECT & inst, Interval intrv, Itera
     // Initialize the entity information
     mEntity = ConvTo< int16_t >::From(id);
     mType = ConvTo< uint8_t >::From(type);
+    // Make it discoverable by tag
+    s_Tags.Insert(mTag, mSlot);
     // Grab the virtual machine once
     HSQUIRRELVM vm = SqVM();
     // Remember the current stack size
@@ -52,6 +55,7 @@ void Tasks::Task::Init(HSQOBJECT & func, HSQOBJECT & inst, Interval intrv, Itera
 void Tasks::Task::Release()
 {
     mHash = 0;
+    s_Tags.Remove(mTag, mSlot);
     mTag.clear();
     mFunc.Release();
     mInst.Release();
@@ -115,28 +119,18 @@ void Tasks::Process()
     s_Last = Chrono::GetCurrentSysTime();
     // Calculate the elapsed time
     const auto delta = int32_t((s_Last - s_Prev) / 1000L);
-    // Process all active tasks
-    for (Interval * itr = s_Intervals; itr != (s_Intervals + SQMOD_MAX_TASKS); ++itr)
-    {
-        // Is this task valid?
-        if (*itr)
-        {
-            // Decrease the elapsed time
-            (*itr) -= delta;
-            // Have we completed the routine interval?
-            if ((*itr) <= 0)
-            {
-                // Execute and reset the elapsed time
-                (*itr) = s_Tasks[itr - s_Intervals].Execute();
-            }
-        }
-    }
+    // Process the tasks that completed their interval
+    s_Timers.Advance(delta, [](TimerQueue::Slot slot) -> TimerQueue::Time {
+        // Execute and reset the elapsed time
+        return s_Tasks[slot].Execute();
+    });
 }
 
 // ------------------------------------------------------------------------------------------------
 void Tasks::Initialize()
 {
-    std::memset(s_Intervals, 0, sizeof(s_Intervals));
+    s_Timers.Clear();
+    s_Timers.Reserve(SQMOD_MAX_TASKS);
     // Transform all task instances to script objects
     for (auto & t : s_Tasks)
     {
@@ -168,6 +162,7 @@ void Tasks::Register(HSQUIRRELVM vm)
         .Func(_SC("GetArgument"), &Task::GetArgument)
         // Static functions
         .StaticFunc(_SC("Used"), &Tasks::GetUsed)
+        .StaticFunc(_SC("Scheduled"), &Tasks::GetScheduled)
     );
 }
 
@@ -180,6 +175,8 @@ void Tasks::Deinitialize()
         t.Terminate();
         t.mSelf.Release();
     }
+    // Nothing is scheduled anymore
+    s_Timers.Clear();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -201,15 +198,26 @@ LightObj & Tasks::FindEntity(int32_t id, int32_t type)
 // ------------------------------------------------------------------------------------------------
 SQInteger Tasks::FindUnused()
 {
-    for (const auto & t : s_Tasks)
+    for (TaskList::size_type i = 0; i < s_Tasks.size(); ++i)
     {
-        if (INVALID_ENTITY(t.mEntity))
+        if (INVALID_ENTITY(s_Tasks[i].mEntity))
         {
-            return (&t - s_Tasks); // Return the index of this element
+            return static_cast< SQInteger >(i); // Return the index of this element
         }
     }
-    // No available slot
-    return -1;
+    // Can we have another slot?
+    if (s_Tasks.size() >= std::numeric_limits< TimerQueue::Slot >::max())
+    {
+        return -1;
+    }
+    // Create a new slot
+    Task & t = s_Tasks.emplace_back();
+    // Let it know where it is
+    t.mSlot = static_cast< uint32_t >(s_Tasks.size() - 1);
+    // Transform the task instance to a script object (tasks always outlive the virtual machine)
+    t.mSelf = LightObj(&t);
+    // Return the index of the new slot
+    return static_cast< SQInteger >(s_Tasks.size() - 1);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -316,7 +324,7 @@ SQInteger Tasks::Create(int32_t id, int32_t type, HSQUIRRELVM vm)
     // Alright, at this point we can initialize the slot
     task.Init(func, inst, intrv, static_cast< Iterator >(itr), id, type);
     // Now initialize the timer
-    s_Intervals[slot] = intrv;
+    s_Timers.Arm(static_cast< TimerQueue::Slot >(slot), intrv);
     // Push the tag instance on the stack
     sq_pushobject(vm, task.mSelf);
     // Specify that this function returns a value
@@ -346,12 +354,14 @@ SQInteger Tasks::Find(int32_t id, int32_t type, SQInteger & pos, HSQUIRRELVM vm)
         {
             return tag.mRes; // Propagate the error!
         }
-        // Attempt to find the requested task
-        for (const auto & t : s_Tasks)
+        // Attempt to find the requested task among the ones with this tag
+        for (const TagIndex::Slot i : s_Tags.Find(String(tag.mPtr, static_cast< size_t >(ClampMin(tag.mLen, 0)))))
         {
-            if (t.mEntity == id && t.mType == type && t.mTag.compare(0, String::npos, tag.mPtr) == 0)
+            const Task & t = s_Tasks[i];
+            // Does this task match the criteria?
+            if (t.mEntity == id && t.mType == type)
             {
-                pos = static_cast< SQInteger >(&t - s_Tasks); // Store the index of this element
+                pos = static_cast< SQInteger >(i); // Store the index of this element
             }
         }
     }
@@ -374,11 +384,13 @@ SQInteger Tasks::Find(int32_t id, int32_t type, SQInteger & pos, HSQUIRRELVM vm)
         // Grab the hash of the callback object
         const SQHash chash = sq_gethash(vm, 2);
         // Attempt to find the requested task
-        for (const auto & t : s_Tasks)
+        for (TaskList::size_type i = 0; i < s_Tasks.size(); ++i)
         {
+            const Task & t = s_Tasks[i];
+            // Does this task match the criteria?
             if (t.mHash == chash && t.mEntity == id && t.mType == type && t.mInterval == intrv)
             {
-                pos = static_cast< SQInteger >(&t - s_Tasks); // Store the index of this element
+                pos = static_cast< SQInteger >(i); // Store the index of this element
             }
         }
     }
@@ -405,11 +417,13 @@ SQInteger Tasks::Find(int32_t id, int32_t type, SQInteger & pos, HSQUIRRELVM vm)
         // Cast iterations to the right type
         const Iterator itr = ConvTo< Iterator >::From(sqitr);
         // Attempt to find the requested task
-        for (const auto & t : s_Tasks)
+        for (TaskList::size_type i = 0; i < s_Tasks.size(); ++i)
         {
+            const Task & t = s_Tasks[i];
+            // Does this task match the criteria?
             if (t.mHash == chash && t.mEntity == id && t.mType == type && t.mInterval == intrv && t.mIterations == itr)
             {
-                pos = static_cast< SQInteger >(&t - s_Tasks); // Store the index of this element
+                pos = static_cast< SQInteger >(i); // Store the index of this element
             }
         }
     }
@@ -418,11 +432,13 @@ SQInteger Tasks::Find(int32_t id, int32_t type, SQInteger & pos, HSQUIRRELVM vm)
         // Grab the hash of the callback object
         const SQHash chash = sq_gethash(vm, 2);
         // Attempt to find the requested task
-        for (const auto & t : s_Tasks)
+        for (TaskList::size_type i = 0; i < s_Tasks.size(); ++i)
         {
+            const Task & t = s_Tasks[i];
+            // Does this task match the criteria?
             if (t.mHash == chash && t.mEntity == id && t.mType == type)
             {
-                pos = static_cast< SQInteger >(&t - s_Tasks); // Store the index of this element
+                pos = static_cast< SQInteger >(i); // Store the index of this element
             }
         }
     }
@@ -452,7 +468,7 @@ SQInteger Tasks::Remove(int32_t id, int32_t type, HSQUIRRELVM vm)
         // Release task resources
         s_Tasks[pos].Terminate();
         // Reset the timer
-        s_Intervals[pos] = 0;
+        s_Timers.Disarm(static_cast< TimerQueue::Slot >(pos));
         // A task was successfully removed
         sq_pushbool(vm, SQTrue);
     }
@@ -481,10 +497,12 @@ SQInteger Tasks::Exists(int32_t id, int32_t type, HSQUIRRELVM vm)
 // ------------------------------------------------------------------------------------------------
 const Tasks::Task & Tasks::FindByTag(int32_t id, int32_t type, StackStrF & tag)
 {
-    // Attempt to find the requested task
-    for (const auto & t : s_Tasks)
+    // Attempt to find the requested task among the ones with this tag
+    for (const TagIndex::Slot i : s_Tags.Find(String(tag.mPtr, static_cast< size_t >(ClampMin(tag.mLen, 0)))))
     {
-        if (t.mEntity == id && t.mType == type && t.mTag == tag.mPtr)
+        const Task & t = s_Tasks[i];
+        // Does this task match the criteria?
+        if (t.mEntity == id && t.mType == type)
         {
             return t; // Return this task instance
         }
@@ -498,13 +516,15 @@ const Tasks::Task & Tasks::FindByTag(int32_t id, int32_t type, StackStrF & tag)
 // ------------------------------------------------------------------------------------------------
 void Tasks::Cleanup(int32_t id, int32_t type)
 {
-    for (auto & t : s_Tasks)
+    for (TaskList::size_type i = 0; i < s_Tasks.size(); ++i)
     {
+        Task & t = s_Tasks[i];
+        // Does this task belong to the specified entity?
         if (t.mEntity == id && t.mType == type)
         {
             t.Terminate();
             // Also disable the timer
-            s_Intervals[&t - s_Tasks] = 0;
+            s_Timers.Disarm(static_cast< TimerQueue::Slot >(i));
         }
     }
 }
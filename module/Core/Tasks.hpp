@@ -2,6 +2,11 @@
 
 // ------------------------------------------------------------------------------------------------
 #include "Core/Utility.hpp"
+#include "Core/TagIndex.hpp"
+#include "Core/TimerQueue.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <deque>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
@@ -41,6 +46,7 @@ private:
         uint8_t     mType; // The type of the entity to which is belongs.
         uint8_t     mArgc; // The number of arguments that the task must forward.
         Argument    mArgv[8]; // The arguments that the task must forward.
+        uint32_t    mSlot; // The index of this task in the pool.
 
         /* ----------------------------------------------------------------------------------------
          * Default constructor.
@@ -58,6 +64,7 @@ private:
             , mType(0)
             , mArgc(0)
             , mArgv()
+            , mSlot(0)
         {
             /* ... */
         }
@@ -149,7 +156,10 @@ private:
         */
         void SetTag(StackStrF & tag)
         {
+            // Remember the previous tag to update the index
+            const String prev(std::move(mTag));
             mTag.assign(tag.mPtr, static_cast< size_t  >(ClampMin(tag.mLen, 0)));
+            s_Tags.Update(prev, mTag, mSlot);
         }
 
         /* ----------------------------------------------------------------------------------------
@@ -264,11 +274,15 @@ private:
         }
     };
 
+    // --------------------------------------------------------------------------------------------
+    typedef std::deque< Task > TaskList; // Grows without moving existing tasks.
+
     // --------------------------------------------------------------------------------------------
     static Time         s_Last; // Last time point.
     static Time         s_Prev; // Previous time point.
-    static Interval     s_Intervals[SQMOD_MAX_TASKS]; // List of intervals to be processed.
-    static Task         s_Tasks[SQMOD_MAX_TASKS]; // List of tasks to be executed.
+    static TagIndex     s_Tags; // Slots of the active tasks by tag.
+    static TimerQueue   s_Timers; // Schedule of the tasks to be processed.
+    static TaskList     s_Tasks; // List of tasks to be executed.
 
 public:
 
@@ -330,7 +344,7 @@ protected:
     static LightObj & FindEntity(int32_t id, int32_t type);
 
     /* --------------------------------------------------------------------------------------------
-     * Find an unoccupied task slot.
+     * Find an unoccupied task slot or create one if all are occupied.
     */
     static SQInteger FindUnused();
 
@@ -379,6 +393,14 @@ public:
         return n;
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of tasks waiting to be invoked.
+    */
+    SQMOD_NODISCARD static SQInteger GetScheduled()
+    {
+        return static_cast< SQInteger >(s_Timers.Armed());
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Cleanup all tasks associated with the specified entity.
     */
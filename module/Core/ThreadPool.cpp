@@ -21,11 +21,15 @@ ThreadPool::ThreadPool() noexcept
     : m_Running(false)
     , m_Mutex()
     , m_CV()
-    , m_Queue()
+    , m_Shared(0)
+    , m_Next(0)
+    , m_Workers()
+    , m_Lanes()
     , m_Finished()
     , m_Threads()
 {
     m_Threads.reserve(MAX_WORKER_THREADS + 1); // Reserve thread memory in advance
+    m_Workers.reserve(MAX_WORKER_THREADS + 1); // Reserve queue memory in advance
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -58,10 +62,15 @@ bool ThreadPool::Initialize(uint32_t count)
     }
     // Make sure the threads don't stop after creation
     m_Running = true;
+    // Create the queues before any thread can look at them
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        m_Workers.emplace_back(std::make_unique< Worker >());
+    }
     // Create the specified amount of worker threads
     for (uint32_t i = 0; i < count; ++i)
     {
-        m_Threads.emplace_back(&ThreadPool::WorkerProc, this);
+        m_Threads.emplace_back(&ThreadPool::WorkerProc, this, static_cast< size_t >(i));
     }
     // Thread pool initialized
     return m_Running;
@@ -79,12 +88,7 @@ void ThreadPool::Terminate(bool SQ_UNUSED_ARG(shutdown))
     m_Running = false;
     {
         std::lock_guard< std::mutex > lg(m_Mutex);
-        // Enqueue dummy items to wake the threads and allow them to stop
-        for (size_t n = 0; n < m_Threads.size(); ++n)
-        {
-            m_Queue.push(Item());
-        }
-        // Allow threads to process the dummy items and stop
+        // Wake the idle threads and allow them to stop
         m_CV.notify_all();
     }
     // Attempt to join the threads
@@ -97,6 +101,35 @@ void ThreadPool::Terminate(bool SQ_UNUSED_ARG(shutdown))
     }
     // Clear all thread instances
     m_Threads.clear();
+    // Abort the items that are still in the queues
+    const auto abort = [this](std::deque< Entry > & queue) {
+        for (auto & e : queue)
+        {
+            try {
+                e.mItem->OnAborted(e.mRetry); // It should mark itself as aborted somehow!
+            } catch (const std::exception & ex) {
+                LogErr("Exception occured in %s forced cancelation stage [%s] for [%s]", e.mItem->TypeName(), ex.what(), e.mItem->IdentifiableInfo());
+            }
+            // Return it, even if not completed
+            m_Finished.enqueue(std::move(e.mItem));
+        }
+    };
+    for (auto & w : m_Workers)
+    {
+        for (auto & q : w->mLanes)
+        {
+            abort(q);
+        }
+        abort(w->mPinned);
+    }
+    // Clear all worker queues
+    m_Workers.clear();
+    m_Shared = 0;
+    // Nothing is waiting in the lanes anymore
+    for (auto & l : m_Lanes)
+    {
+        l.mDepth = 0;
+    }
     // Retrieve each item individually and process it
     for (Item item; m_Finished.try_dequeue(item);)
     {
@@ -140,89 +173,265 @@ void ThreadPool::Process()
 }
 
 // ------------------------------------------------------------------------------------------------
-void ThreadPool::WorkerProc()
+void ThreadPool::Enqueue(Item && item)
 {
-    // Whether this item wants to try again
-    bool retry = false;
-    // Pointer to the dequeued item
-    Item item;
-    // Initialize third-party allocator for this thread
-    auto rpmallocinit = std::make_unique< RPMallocThreadInit >();
-    // Constantly process items from the queue
-    while (true)
+    // Only queue valid items
+    if (!item || !m_Running) return;
+    // Only queue if worker threads exist
+    if (m_Threads.empty())
+    {
+        ProcessInPlace(std::move(item));
+        // Nothing else to do
+        return;
+    }
+    Entry entry;
+    // Find out where the item belongs
+    entry.mLane = item->Lane();
+    entry.mAffinity = item->Affinity();
+    // Unknown lanes are treated as the lowest priority
+    if (entry.mLane < TPLANE_HIGH || entry.mLane >= TPLANE_COUNT)
+    {
+        entry.mLane = TPLANE_LOW;
+    }
+    // Take ownership of the item
+    entry.mItem = std::move(item);
+    // Count the item
+    ++m_Lanes[entry.mLane].mQueued;
+    // Push the item in the queue
+    Push(std::move(entry));
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::Push(Entry && entry)
+{
+    const size_t n = m_Workers.size();
+    const bool pinned = (entry.mAffinity != 0);
+    // Keep track of the lane since the entry is moved
+    const ThreadPoolLane lane = entry.mLane;
+    // Items with the same key always go to the same worker (key is mixed to spread pointers)
+    Worker & w = *m_Workers[pinned ? ((entry.mAffinity * UINT64_C(0x9E3779B97F4A7C15)) >> 32u) % n : m_Next++ % n];
+    // Remember when the item was queued
+    entry.mTime = Clock::now();
     {
-        // Do we have to stop?
-        if (!m_Running)
+        // Acquire a lock on the worker queues
+        std::lock_guard< std::mutex > lg(w.mMutex);
+        // The item is now waiting in the lane (before a worker can take it and decrease the depth)
+        ++m_Lanes[lane].mDepth;
+        // Pinned items (including the retried ones) wait behind the other items of that worker
+        if (pinned)
         {
-            // Is there an item that requested to try again?
-            if (item)
+            w.mPinned.push_back(std::move(entry));
+            ++w.mPinnedCount;
+        }
+        else
+        {
+            w.mLanes[lane].push_back(std::move(entry));
+            ++m_Shared;
+        }
+    }
+    // Make sure a worker that is about to sleep sees the item
+    {
+        std::lock_guard< std::mutex > lg(m_Mutex);
+    }
+    // Only the owner can take a pinned item but, any worker can take the others
+    if (pinned)
+    {
+        m_CV.notify_all();
+    }
+    else
+    {
+        m_CV.notify_one();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ThreadPool::Pop(size_t index, Entry & entry)
+{
+    const size_t n = m_Workers.size();
+    Worker & own = *m_Workers[index];
+    // Higher priority lanes are always emptied first
+    for (size_t lane = TPLANE_HIGH; lane < TPLANE_COUNT; ++lane)
+    {
+        bool found = false, stolen = false;
+        {
+            // Acquire a lock on the own queues
+            std::lock_guard< std::mutex > lg(own.mMutex);
+            // Pinned items are taken in order, when their lane comes
+            const bool pinned = !own.mPinned.empty() && own.mPinned.front().mLane == static_cast< ThreadPoolLane >(lane);
+            // Retried items let the other items of the same lane go first
+            if (pinned && (!own.mPinned.front().mRetry || own.mLanes[lane].empty()))
             {
-                try {
-                    item->OnAborted(true); // NOLINT(bugprone-use-after-move) There's an `if` condition above idiot!
-                } catch (const std::exception & e) {
-                    LogErr("Exception occured in %s cancelation stage [%s] for [%s]", item->TypeName(), e.what(), item->IdentifiableInfo());
-                }
+                entry = std::move(own.mPinned.front());
+                own.mPinned.pop_front();
+                --own.mPinnedCount;
+                found = true;
+            }
+            else if (!own.mLanes[lane].empty())
+            {
+                entry = std::move(own.mLanes[lane].front());
+                own.mLanes[lane].pop_front();
+                --m_Shared;
+                found = true;
             }
-            // Exit the loop
-            break;
         }
-        // Attempt to get an item from the queue
-        if (!retry)
+        // Attempt to steal from the other workers, starting with the next one
+        for (size_t k = 1; !found && k < n && m_Shared > 0; ++k)
         {
-            // Acquire a lock on the mutex
-            std::unique_lock< std::mutex > lock(m_Mutex);
-            // Wait until there are items in the queue
-            while (m_Queue.empty())
+            Worker & w = *m_Workers[(index + k) % n];
+            // Acquire a lock on the queues of that worker
+            std::lock_guard< std::mutex > lg(w.mMutex);
+            // Take the oldest item in this lane, if any
+            if (!w.mLanes[lane].empty())
             {
-                m_CV.wait(lock);
+                entry = std::move(w.mLanes[lane].front());
+                w.mLanes[lane].pop_front();
+                --m_Shared;
+                found = stolen = true;
             }
-            // Retrieve top item the queue
-            item = std::move(m_Queue.front());
-            // Remove it from the queue
-            m_Queue.pop();
         }
-        // Do we have to stop?
-        if (!m_Running)
+        // Did we find something in this lane?
+        if (found)
         {
-            // Is there an item to be processed?
-            if (item)
+            Lane & l = m_Lanes[lane];
+            // Measure how long the item waited
+            const auto wait = static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::microseconds >(Clock::now() - entry.mTime).count());
+            // Update lane statistics
+            --l.mDepth;
+            ++l.mProcessed;
+            l.mWaitTotal += wait;
+            if (stolen)
             {
-                try {
-                    item->OnAborted(false); // It should mark itself as aborted somehow!
-                } catch (const std::exception & e) {
-                    LogErr("Exception occured in %s forced cancelation stage [%s] for [%s]", item->TypeName(), e.what(), item->IdentifiableInfo());
-                }
+                ++l.mStolen;
             }
-            // Exit the loop
-            break;
+            // Update the longest wait
+            for (uint64_t max = l.mWaitMax; wait > max && !l.mWaitMax.compare_exchange_weak(max, wait););
+            // Item retrieved
+            return true;
         }
-        bool r;
+    }
+    // Nothing to process
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::ProcessInPlace(Item && item)
+{
+    bool r = false;
+    // Attempt preparation
+    try {
+        r = item->OnPrepare();
+    } catch (const std::exception & e) {
+        LogErr("Exception occured in %s preparation stage [%s] for [%s]", item->TypeName(), e.what(), item->IdentifiableInfo());
+    }
+    // Perform the task in-place
+    if (r)
+    {
+        try {
+            r = item->OnProcess();
+        } catch (const std::exception & e) {
+            r = false;
+            LogErr("Exception occured in %s processing stage [%s] for [%s]", item->TypeName(), e.what(), item->IdentifiableInfo());
+        }
+        if (r)
+        {
+            try {
+                item->OnAborted(true); // Not accepted in single thread
+            } catch (const std::exception & e) {
+                LogErr("Exception occured in %s cancelation stage [%s] for [%s]", item->TypeName(), e.what(), item->IdentifiableInfo());
+            }
+        }
+    }
+    // Task is completed in processing stage
+    m_Finished.enqueue(std::move(item));
+}
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::LaneInfo ThreadPool::GetLaneInfo(ThreadPoolLane lane) const
+{
+    LaneInfo info;
+    // Is this a valid lane?
+    if (lane >= TPLANE_HIGH && lane < TPLANE_COUNT)
+    {
+        const Lane & l = m_Lanes[lane];
+        // Take a snapshot of the counters
+        info.mDepth = l.mDepth;
+        info.mQueued = l.mQueued;
+        info.mProcessed = l.mProcessed;
+        info.mRetried = l.mRetried;
+        info.mStolen = l.mStolen;
+        info.mWaitTotal = l.mWaitTotal;
+        info.mWaitMax = l.mWaitMax;
+    }
+    // Return the snapshot
+    return info;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::ResetLaneInfo()
+{
+    for (auto & l : m_Lanes)
+    {
+        l.mQueued = 0;
+        l.mProcessed = 0;
+        l.mRetried = 0;
+        l.mStolen = 0;
+        l.mWaitTotal = 0;
+        l.mWaitMax = 0;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::WorkerProc(size_t index)
+{
+    // The queue of this worker
+    Worker & self = *m_Workers[index];
+    // The dequeued item
+    Entry entry;
+    // Initialize third-party allocator for this thread
+    auto rpmallocinit = std::make_unique< RPMallocThreadInit >();
+    // Constantly process items from the queues
+    while (m_Running)
+    {
+        // Attempt to get an item from the queues
+        if (!Pop(index, entry))
+        {
+            // Acquire a lock on the mutex
+            std::unique_lock< std::mutex > lock(m_Mutex);
+            // Wait until there are items this worker can take
+            m_CV.wait(lock, [this, &self] { return !m_Running || m_Shared > 0 || self.mPinnedCount > 0; });
+            // Try again
+            continue;
+        }
+        bool r = false, retry = false;
         // Attempt preparation
         try {
-            r = item->OnPrepare();
+            r = entry.mItem->OnPrepare();
         } catch (const std::exception & e) {
-            LogErr("Exception occured in %s preparation stage [%s] for [%s]", item->TypeName(), e.what(), item->IdentifiableInfo());
+            LogErr("Exception occured in %s preparation stage [%s] for [%s]", entry.mItem->TypeName(), e.what(), entry.mItem->IdentifiableInfo());
         }
         // Perform the task
         if (r)
         {
             try {
-                retry = item->OnProcess();
+                retry = entry.mItem->OnProcess();
             } catch (const std::exception & e) {
-                LogErr("Exception occured in %s processing stage [%s] for [%s]", item->TypeName(), e.what(), item->IdentifiableInfo());
+                LogErr("Exception occured in %s processing stage [%s] for [%s]", entry.mItem->TypeName(), e.what(), entry.mItem->IdentifiableInfo());
             }
         }
+        // Does the task want to be processed again?
+        if (retry)
+        {
+            ++m_Lanes[entry.mLane].mRetried;
+            // Let other items have a go before trying again
+            entry.mRetry = true;
+            Push(std::move(entry));
+        }
         // The task was performed
-        if (!retry)
+        else
         {
-            m_Finished.enqueue(std::move(item));
+            m_Finished.enqueue(std::move(entry.mItem));
         }
     }
-    // Did we take an item from the queue?
-    if (item)
-    {
-        m_Finished.enqueue(std::move(item)); // Return it, even if not completed
-    }
 }
 
 } // Namespace:: SqMod
@@ -7,8 +7,9 @@
 #include <concurrentqueue.h>
 
 // ------------------------------------------------------------------------------------------------
-#include <queue>
+#include <deque>
 #include <mutex>
+#include <chrono>
 #include <vector>
 #include <atomic>
 #include <thread>
@@ -20,6 +21,21 @@ namespace SqMod {
 // ------------------------------------------------------------------------------------------------
 static constexpr uint32_t MAX_WORKER_THREADS = 32; // Hard coded worker threads limit.
 
+/* ------------------------------------------------------------------------------------------------
+ * Priority lanes of the thread pool. Workers always look for work in higher priority lanes first.
+*/
+enum ThreadPoolLane
+{
+    // Latency sensitive work, such as database queries
+    TPLANE_HIGH = 0,
+    // Regular work, such as HTTP requests
+    TPLANE_NORMAL,
+    // Bulk work, such as file I/O
+    TPLANE_LOW,
+    // Number of lanes
+    TPLANE_COUNT
+};
+
 /* ------------------------------------------------------------------------------------------------
  * Item that can be given to the thread pool to process data in a separate thread.
 */
@@ -65,6 +81,17 @@ struct ThreadPoolItem
     */
     SQMOD_NODISCARD virtual const char * IdentifiableInfo() noexcept { return ""; }
 
+    /* --------------------------------------------------------------------------------------------
+     * Provide the priority lane in which this task should be queued.
+    */
+    SQMOD_NODISCARD virtual ThreadPoolLane Lane() noexcept { return TPLANE_NORMAL; }
+
+    /* --------------------------------------------------------------------------------------------
+     * Provide a key that tasks which must not run concurrently have in common. Tasks with the same
+     * key are always processed by the same worker, in the order they were queued. Zero means none.
+    */
+    SQMOD_NODISCARD virtual uintptr_t Affinity() noexcept { return 0; }
+
     /* --------------------------------------------------------------------------------------------
      * Invoked in worker thread by the thread pool after obtaining the task from the queue.
      * Must return true to indicate that the task can be performed. False indicates failure.
@@ -73,7 +100,9 @@ struct ThreadPoolItem
 
     /* --------------------------------------------------------------------------------------------
      * Called in worker by the thread pool to performed by the associated tasks.
-     * Will be called continuously while the returned value is true. While false means it finished.
+     * While the returned value is true the task is queued again, behind the work that is already
+     * waiting in its lane. Tasks with an affinity key are also queued behind the other tasks with
+     * the same key. While false means it finished.
     */
     SQMOD_NODISCARD virtual bool OnProcess() { return false; };
 
@@ -113,18 +142,76 @@ private:
 public:
     // --------------------------------------------------------------------------------------------
     using Item = std::unique_ptr< ThreadPoolItem >; // Owning pointer of an item.
+    using Clock = std::chrono::steady_clock; // Clock used to measure queue latency.
+
+    /* --------------------------------------------------------------------------------------------
+     * Snapshot of the statistics of a lane.
+    */
+    struct LaneInfo
+    {
+        size_t      mDepth{0}; // Items currently waiting in the lane.
+        uint64_t    mQueued{0}; // Items queued in the lane since startup.
+        uint64_t    mProcessed{0}; // Items taken out of the lane by workers.
+        uint64_t    mRetried{0}; // Items that asked to be processed again.
+        uint64_t    mStolen{0}; // Items taken from the queue of another worker.
+        uint64_t    mWaitTotal{0}; // Total time, in microseconds, items spent waiting in the lane.
+        uint64_t    mWaitMax{0}; // Longest time, in microseconds, an item spent waiting in the lane.
+    };
+
 private:
 
+    /* --------------------------------------------------------------------------------------------
+     * Queued item and the moment it was queued.
+    */
+    struct Entry
+    {
+        Item                mItem{}; // The queued item.
+        ThreadPoolLane      mLane{TPLANE_NORMAL}; // Lane in which the item was queued.
+        uintptr_t           mAffinity{0}; // Affinity key of the item, if any.
+        bool                mRetry{false}; // Whether the item was queued again after processing.
+        Clock::time_point   mTime{}; // When was the item queued.
+    };
+
+    /* --------------------------------------------------------------------------------------------
+     * Queues owned by a worker thread.
+    */
+    struct Worker
+    {
+        std::mutex          mMutex{}; // Guards the queues of this worker.
+        std::deque< Entry > mLanes[TPLANE_COUNT]{}; // Items that any worker may take.
+        std::deque< Entry > mPinned{}; // Items that only this worker may take, in order.
+        std::atomic_size_t  mPinnedCount{0}; // Number of items in the pinned queue.
+    };
+
+    /* --------------------------------------------------------------------------------------------
+     * Statistics of a lane.
+    */
+    struct Lane
+    {
+        std::atomic_size_t      mDepth{0};
+        std::atomic_uint64_t    mQueued{0};
+        std::atomic_uint64_t    mProcessed{0};
+        std::atomic_uint64_t    mRetried{0};
+        std::atomic_uint64_t    mStolen{0};
+        std::atomic_uint64_t    mWaitTotal{0};
+        std::atomic_uint64_t    mWaitMax{0};
+    };
+
     // --------------------------------------------------------------------------------------------
     using Pool = std::vector< std::thread >; // Worker container.
+    using Workers = std::vector< std::unique_ptr< Worker > >; // Worker queues.
     using Finished = moodycamel::ConcurrentQueue< Item >; // Finished items.
 
     // --------------------------------------------------------------------------------------------
     std::atomic_bool        m_Running; // Whether the threads are allowed to run.
     // --------------------------------------------------------------------------------------------
-    std::mutex              m_Mutex;
-    std::condition_variable m_CV;
-    std::queue< Item >      m_Queue;
+    std::mutex              m_Mutex; // Mutex used by idle workers to wait for items.
+    std::condition_variable m_CV; // Condition used to wake idle workers.
+    std::atomic_size_t      m_Shared; // Number of queued items that any worker may take.
+    std::atomic_size_t      m_Next; // Worker that receives the next item without affinity.
+    // --------------------------------------------------------------------------------------------
+    Workers                 m_Workers; // Queues of each worker thread.
+    Lane                    m_Lanes[TPLANE_COUNT]; // Statistics of each lane.
     // --------------------------------------------------------------------------------------------
     Finished                m_Finished; // Non-blocking concurrent queue of finished items.
     // --------------------------------------------------------------------------------------------
@@ -135,7 +222,22 @@ private:
     /* --------------------------------------------------------------------------------------------
      * Internal function used to process tasks.
     */
-    void WorkerProc();
+    void WorkerProc(size_t index);
+
+    /* --------------------------------------------------------------------------------------------
+     * Place an item in the queue of a worker and wake the workers that may take it.
+    */
+    void Push(Entry && entry);
+
+    /* --------------------------------------------------------------------------------------------
+     * Take the next item that the specified worker should process. Returns false if none.
+    */
+    bool Pop(size_t index, Entry & entry);
+
+    /* --------------------------------------------------------------------------------------------
+     * Process an item in-place, on the calling thread, when there are no worker threads.
+    */
+    void ProcessInPlace(Item && item);
 
 public:
 
@@ -201,51 +303,15 @@ public:
     /* --------------------------------------------------------------------------------------------
      * Queue an item to be processed. Will take ownership of the given pointer!
     */
-    void Enqueue(Item && item)
+    void Enqueue(Item && item);
+
+    /* --------------------------------------------------------------------------------------------
+     * Hand over an item that was processed outside of the thread pool. The item is completed in the
+     * main thread by Process(), together with the other finished items. Safe to call from any thread.
+    */
+    void Complete(Item && item)
     {
-        // Only queue valid items
-        if (!item || !m_Running) return;
-        // Only queue if worker threads exist
-        if (!m_Threads.empty())
-        {
-            // Acquire a lock on the mutex
-            std::unique_lock< std::mutex > lock(m_Mutex);
-            // Push the item in the queue
-            m_Queue.push(std::forward< Item >(item));
-            // Release the mutex before notifying
-            lock.unlock();
-            // Notify one thread that there's work
-            m_CV.notify_one(); 
-        }
-        else
-        {
-            bool r;
-            // Attempt preparation
-            try {
-                r = item->OnPrepare();
-            } catch (const std::exception & e) {
-                LogErr("Exception occured in %s preparation stage [%s] for [%s]", item->TypeName(), e.what(), item->IdentifiableInfo());
-            }
-            // Perform the task in-place
-            if (r)
-            {
-                try {
-                    r = item->OnProcess();
-                } catch (const std::exception & e) {
-                    LogErr("Exception occured in %s processing stage [%s] for [%s]", item->TypeName(), e.what(), item->IdentifiableInfo());
-                }
-                if (r)
-                {
-                    try {
-                        item->OnAborted(true); // Not accepted in single thread
-                    } catch (const std::exception & e) {
-                        LogErr("Exception occured in %s cancelation stage [%s] for [%s]", item->TypeName(), e.what(), item->IdentifiableInfo());
-                    }
-                }
-            }
-            // Task is completed in processing stage
-            m_Finished.enqueue(std::forward< Item >(item));
-        }
+        m_Finished.enqueue(std::move(item));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -255,6 +321,16 @@ public:
     {
         return m_Threads.size();
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve a snapshot of the statistics of a lane.
+    */
+    SQMOD_NODISCARD LaneInfo GetLaneInfo(ThreadPoolLane lane) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Reset the statistics of all lanes. The queue depth is not affected.
+    */
+    void ResetLaneInfo();
 };
 
 } // Namespace:: SqMod
@@ -0,0 +1,266 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------------------
+#include "SqBase.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+// ------------------------------------------------------------------------------------------------
+namespace SqMod {
+
+/* ------------------------------------------------------------------------------------------------
+ * Min-heap of expiration times used to schedule a set of slots identified by their index.
+ * Processing only touches the slots that expired instead of every slot that exists.
+ * Slots that are re-scheduled simply invalidate their previous heap entry, which is discarded
+ * lazily once it reaches the top of the heap.
+*/
+class TimerQueue
+{
+public:
+
+    // --------------------------------------------------------------------------------------------
+    typedef int64_t     Time; // Time values (milliseconds).
+    typedef uint32_t    Slot; // Slot identifiers.
+
+private:
+
+    /* --------------------------------------------------------------------------------------------
+     * Heap element which identifies a scheduled slot.
+    */
+    struct Entry
+    {
+        Time        mDue; // Time when the slot expires.
+        Slot        mSlot; // The slot that expires.
+        uint32_t    mStamp; // Stamp of the slot when this entry was created.
+    };
+
+    /* --------------------------------------------------------------------------------------------
+     * Heap ordering. Earliest expiration first and lower slots first when equal.
+    */
+    struct Later
+    {
+        bool operator () (const Entry & a, const Entry & b) const noexcept
+        {
+            return (a.mDue > b.mDue) || (a.mDue == b.mDue && a.mSlot > b.mSlot);
+        }
+    };
+
+    /* --------------------------------------------------------------------------------------------
+     * Scheduling information of a slot.
+    */
+    struct State
+    {
+        Time        mDue{0}; // Time when the slot expires.
+        uint32_t    mStamp{0}; // Incremented every time the slot is scheduled or canceled.
+        bool        mArmed{false}; // Whether the slot is currently scheduled.
+    };
+
+    // --------------------------------------------------------------------------------------------
+    std::vector< Entry >    m_Heap; // Scheduled slots.
+    std::vector< Entry >    m_Pending; // Slots scheduled while processing.
+    std::vector< State >    m_States; // Scheduling information of each slot.
+    // --------------------------------------------------------------------------------------------
+    Time                    m_Clock; // Time accumulated so far.
+    size_t                  m_Armed; // Number of currently scheduled slots.
+    bool                    m_Processing; // Whether expired slots are currently being processed.
+
+    /* --------------------------------------------------------------------------------------------
+     * Make sure the state of the specified slot exists and retrieve it.
+    */
+    State & Acquire(Slot slot)
+    {
+        if (slot >= m_States.size())
+        {
+            m_States.resize(static_cast< size_t >(slot) + 1);
+        }
+        return m_States[slot];
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Rebuild the heap from the scheduled slots if too many entries became invalid.
+    */
+    void Compact()
+    {
+        // Is it worth the trouble?
+        if (m_Heap.size() < 64 || m_Heap.size() < (m_Armed * 2))
+        {
+            return;
+        }
+        // Discard invalid entries
+        m_Heap.erase(std::remove_if(m_Heap.begin(), m_Heap.end(), [this](const Entry & e) -> bool {
+            return !IsValid(e);
+        }), m_Heap.end());
+        // Restore the heap property
+        std::make_heap(m_Heap.begin(), m_Heap.end(), Later{});
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Check whether a heap entry still represents the current schedule of its slot.
+    */
+    SQMOD_NODISCARD bool IsValid(const Entry & e) const
+    {
+        const State & s = m_States[e.mSlot];
+        return s.mArmed && s.mStamp == e.mStamp;
+    }
+
+public:
+
+    /* --------------------------------------------------------------------------------------------
+     * Default constructor.
+    */
+    TimerQueue()
+        : m_Heap(), m_Pending(), m_States(), m_Clock(0), m_Armed(0), m_Processing(false)
+    {
+        //...
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Reserve memory for the specified number of slots.
+    */
+    void Reserve(size_t n)
+    {
+        m_Heap.reserve(n);
+        m_States.reserve(n);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Schedule a slot to expire after the specified interval. A zero interval cancels the slot.
+    */
+    void Arm(Slot slot, Time interval)
+    {
+        // Zero means that the slot is not active
+        if (interval == 0)
+        {
+            Disarm(slot);
+            return;
+        }
+        State & s = Acquire(slot);
+        // Invalidate any previous heap entry
+        ++s.mStamp;
+        // Count newly scheduled slots
+        if (!s.mArmed)
+        {
+            s.mArmed = true;
+            ++m_Armed;
+        }
+        // Compute the expiration time
+        s.mDue = m_Clock + interval;
+        // Slots scheduled while processing must wait for the next pass
+        if (m_Processing)
+        {
+            m_Pending.push_back(Entry{s.mDue, slot, s.mStamp});
+        }
+        else
+        {
+            m_Heap.push_back(Entry{s.mDue, slot, s.mStamp});
+            std::push_heap(m_Heap.begin(), m_Heap.end(), Later{});
+            // Get rid of invalid entries, if too many
+            Compact();
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Cancel the schedule of a slot.
+    */
+    void Disarm(Slot slot)
+    {
+        // Does this slot exist and is it scheduled?
+        if (slot < m_States.size() && m_States[slot].mArmed)
+        {
+            State & s = m_States[slot];
+            // Invalidate the heap entry
+            ++s.mStamp;
+            s.mArmed = false;
+            --m_Armed;
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Check whether a slot is currently scheduled.
+    */
+    SQMOD_NODISCARD bool IsArmed(Slot slot) const
+    {
+        return slot < m_States.size() && m_States[slot].mArmed;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the time remaining until the slot expires. Zero if not scheduled.
+    */
+    SQMOD_NODISCARD Time Remaining(Slot slot) const
+    {
+        return IsArmed(slot) ? (m_States[slot].mDue - m_Clock) : 0;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of currently scheduled slots.
+    */
+    SQMOD_NODISCARD size_t Armed() const
+    {
+        return m_Armed;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Advance the clock and invoke the functor for every expired slot. The functor returns the
+     * interval after which the slot expires again or zero to stop. Each slot expires at most once.
+    */
+    template < typename F > void Advance(Time delta, F && f)
+    {
+        m_Clock += delta;
+        m_Processing = true;
+        // Process the slots that expired
+        while (!m_Heap.empty() && m_Heap.front().mDue <= m_Clock)
+        {
+            std::pop_heap(m_Heap.begin(), m_Heap.end(), Later{});
+            const Entry e = m_Heap.back();
+            m_Heap.pop_back();
+            // Was this slot re-scheduled or canceled in the meantime?
+            if (!IsValid(e))
+            {
+                continue;
+            }
+            // The slot is not scheduled while being processed
+            Disarm(e.mSlot);
+            // Invoke the functor and schedule the slot again if necessary
+            const Time next = f(e.mSlot);
+            // Was the slot scheduled from within the functor? (then leave it alone)
+            if (next != 0 && !m_States[e.mSlot].mArmed)
+            {
+                Arm(e.mSlot, next);
+            }
+        }
+        m_Processing = false;
+        // Move the slots that were scheduled during processing into the heap
+        for (const Entry & e : m_Pending)
+        {
+            if (IsValid(e))
+            {
+                m_Heap.push_back(e);
+                std::push_heap(m_Heap.begin(), m_Heap.end(), Later{});
+            }
+        }
+        m_Pending.clear();
+        // Get rid of invalid entries, if too many
+        Compact();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Cancel all slots.
+    */
+    void Clear()
+    {
+        m_Heap.clear();
+        m_Pending.clear();
+        // Invalidate every slot
+        for (State & s : m_States)
+        {
+            ++s.mStamp;
+            s.mArmed = false;
+        }
+        m_Armed = 0;
+    }
+};
+
+} // Namespace:: SqMod
@@ -48,6 +48,8 @@ const String & CBlip::GetTag() const
 // ------------------------------------------------------------------------------------------------
 void CBlip::SetTag(StackStrF & tag)
 {
+    // Remember the previous tag to update the index
+    const String prev(std::move(m_Tag));
     if (tag.mLen > 0)
     {
         m_Tag.assign(tag.mPtr, static_cast< size_t >(tag.mLen));
@@ -56,6 +58,8 @@ void CBlip::SetTag(StackStrF & tag)
     {
         m_Tag.clear();
     }
+    // Only active entities are indexed
+    Core::Get().GetEntityTags(ENT_BLIP).Update(prev, m_Tag, static_cast< TagIndex::Slot >(m_ID));
 }
 
 // ------------------------------------------------------------------------------------------------
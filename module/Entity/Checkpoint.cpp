@@ -51,6 +51,8 @@ const String & CCheckpoint::GetTag() const
 // ------------------------------------------------------------------------------------------------
 void CCheckpoint::SetTag(StackStrF & tag)
 {
+    // Remember the previous tag to update the index
+    const String prev(std::move(m_Tag));
     if (tag.mLen > 0)
     {
         m_Tag.assign(tag.mPtr, static_cast< size_t >(tag.mLen));
@@ -59,6 +61,8 @@ void CCheckpoint::SetTag(StackStrF & tag)
     {
         m_Tag.clear();
     }
+    // Only active entities are indexed
+    Core::Get().GetEntityTags(ENT_CHECKPOINT).Update(prev, m_Tag, static_cast< TagIndex::Slot >(m_ID));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -57,6 +57,8 @@ const String & CObject::GetTag() const
 // ------------------------------------------------------------------------------------------------
 void CObject::SetTag(StackStrF & tag)
 {
+    // Remember the previous tag to update the index
+    const String prev(std::move(m_Tag));
     if (tag.mLen > 0)
     {
         m_Tag.assign(tag.mPtr, static_cast< size_t >(tag.mLen));
@@ -65,6 +67,8 @@ void CObject::SetTag(StackStrF & tag)
     {
         m_Tag.clear();
     }
+    // Only active entities are indexed
+    Core::Get().GetEntityTags(ENT_OBJECT).Update(prev, m_Tag, static_cast< TagIndex::Slot >(m_ID));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -50,6 +50,8 @@ const String & CPickup::GetTag() const
 // ------------------------------------------------------------------------------------------------
 void CPickup::SetTag(StackStrF & tag)
 {
+    // Remember the previous tag to update the index
+    const String prev(std::move(m_Tag));
     if (tag.mLen > 0)
     {
         m_Tag.assign(tag.mPtr, static_cast< size_t >(tag.mLen));
@@ -58,6 +60,8 @@ void CPickup::SetTag(StackStrF & tag)
     {
         m_Tag.clear();
     }
+    // Only active entities are indexed
+    Core::Get().GetEntityTags(ENT_PICKUP).Update(prev, m_Tag, static_cast< TagIndex::Slot >(m_ID));
 }
 
 // ------------------------------------------------------------------------------------------------
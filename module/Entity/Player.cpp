@@ -74,6 +74,8 @@ const String & CPlayer::GetTag() const
 // ------------------------------------------------------------------------------------------------
 void CPlayer::SetTag(StackStrF & tag)
 {
+    // Remember the previous tag to update the index
+    const String prev(std::move(m_Tag));
     if (tag.mLen > 0)
     {
         m_Tag.assign(tag.mPtr, static_cast< size_t >(tag.mLen));
@@ -82,6 +84,8 @@ void CPlayer::SetTag(StackStrF & tag)
     {
         m_Tag.clear();
     }
+    // Only active entities are indexed
+    Core::Get().GetEntityTags(ENT_PLAYER).Update(prev, m_Tag, static_cast< TagIndex::Slot >(m_ID));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -233,6 +237,8 @@ void CPlayer::Kill() const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Perform the requested operation
     _Func->KillPlayer(m_ID);
 }
@@ -785,6 +791,13 @@ float CPlayer::GetHealth() const
 {
     // Validate the managed identifier
     Validate();
+    // Retrieve the associated tracking instance
+    const PlayerInst & inst = Core::Get().GetPlayer(m_ID);
+    // Can we use the value captured during the last update?
+    if (Core::Get().IsStateFresh(inst.mStateTime))
+    {
+        return inst.mStateHealth;
+    }
     // Return the requested information
     return _Func->GetPlayerHealth(m_ID);
 }
@@ -794,6 +807,8 @@ void CPlayer::SetHealth(float amount) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Perform the requested operation
     _Func->SetPlayerHealth(m_ID, amount);
 }
@@ -803,6 +818,13 @@ float CPlayer::GetArmor() const
 {
     // Validate the managed identifier
     Validate();
+    // Retrieve the associated tracking instance
+    const PlayerInst & inst = Core::Get().GetPlayer(m_ID);
+    // Can we use the value captured during the last update?
+    if (Core::Get().IsStateFresh(inst.mStateTime))
+    {
+        return inst.mStateArmour;
+    }
     // Return the requested information
     return _Func->GetPlayerArmour(m_ID);
 }
@@ -812,6 +834,8 @@ void CPlayer::SetArmor(float amount) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Perform the requested operation
     _Func->SetPlayerArmour(m_ID, amount);
 }
@@ -849,6 +873,13 @@ Vector3 CPlayer::GetPosition() const
 {
     // Validate the managed identifier
     Validate();
+    // Retrieve the associated tracking instance
+    const PlayerInst & inst = Core::Get().GetPlayer(m_ID);
+    // Can we use the value captured during the last update?
+    if (Core::Get().IsStateFresh(inst.mStateTime))
+    {
+        return inst.mStatePosition;
+    }
     // Create a default vector instance
     Vector3 vec;
     // Query the server for the values
@@ -862,6 +893,8 @@ void CPlayer::SetPosition(const Vector3 & pos) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Perform the requested operation
     _Func->SetPlayerPosition(m_ID, pos.x, pos.y, pos.z);
 }
@@ -871,6 +904,8 @@ void CPlayer::SetPositionEx(float x, float y, float z) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Perform the requested operation
     _Func->SetPlayerPosition(m_ID, x, y, z);
 }
@@ -929,6 +964,13 @@ float CPlayer::GetHeading() const
 {
     // Validate the managed identifier
     Validate();
+    // Retrieve the associated tracking instance
+    const PlayerInst & inst = Core::Get().GetPlayer(m_ID);
+    // Can we use the value captured during the last update?
+    if (Core::Get().IsStateFresh(inst.mStateTime))
+    {
+        return inst.mStateHeading;
+    }
     // Return the requested information
     return _Func->GetPlayerHeading(m_ID);
 }
@@ -938,6 +980,8 @@ void CPlayer::SetHeading(float angle) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Perform the requested operation
     _Func->SetPlayerHeading(m_ID, angle);
 }
@@ -1157,6 +1201,13 @@ int32_t CPlayer::GetWeapon() const
 {
     // Validate the managed identifier
     Validate();
+    // Retrieve the associated tracking instance
+    const PlayerInst & inst = Core::Get().GetPlayer(m_ID);
+    // Can we use the value captured during the last update?
+    if (Core::Get().IsStateFresh(inst.mStateTime))
+    {
+        return inst.mStateWeapon;
+    }
     // Return the requested information
     return _Func->GetPlayerWeapon(m_ID);
 }
@@ -1166,6 +1217,8 @@ void CPlayer::SetWeapon(int32_t wep) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Perform the requested operation
     if (_Func->SetPlayerWeapon(m_ID, wep, mDefaultAmmo) == vcmpErrorArgumentOutOfBounds)
     {
@@ -1178,6 +1231,8 @@ void CPlayer::SetWeaponEx(int32_t wep, int32_t ammo) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Perform the requested operation
     if (_Func->SetPlayerWeapon(m_ID, wep, ammo) == vcmpErrorArgumentOutOfBounds)
     {
@@ -1190,6 +1245,8 @@ void CPlayer::GiveWeapon(int32_t wep, int32_t ammo) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Perform the requested operation
     if (_Func->GivePlayerWeapon(m_ID, wep, ammo) == vcmpErrorArgumentOutOfBounds)
     {
@@ -1220,6 +1277,8 @@ void CPlayer::SetWeaponSlot(int32_t slot) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Perform the requested operation
     if (_Func->SetPlayerWeaponSlot(m_ID, slot) == vcmpErrorArgumentOutOfBounds)
     {
@@ -1260,6 +1319,8 @@ void CPlayer::RemoveWeapon(int32_t wep) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Perform the requested operation
     _Func->RemovePlayerWeapon(m_ID, wep);
 }
@@ -1269,6 +1330,8 @@ void CPlayer::StripWeapons() const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Perform the requested operation
     _Func->RemoveAllWeapons(m_ID);
 }
@@ -1807,6 +1870,15 @@ const Vector3 & CPlayer::GetLastPosition() const
     return Core::Get().GetPlayer(m_ID).mLastPosition;
 }
 
+// ------------------------------------------------------------------------------------------------
+uint32_t CPlayer::GetLastChanges() const
+{
+    // Validate the managed identifier
+    Validate();
+    // Return the requested information
+    return Core::Get().GetPlayer(m_ID).mChanged;
+}
+
 // ------------------------------------------------------------------------------------------------
 SQFloat CPlayer::GetDistance() const
 {
@@ -2005,6 +2077,13 @@ float CPlayer::GetPositionX() const
 {
     // Validate the managed identifier
     Validate();
+    // Retrieve the associated tracking instance
+    const PlayerInst & inst = Core::Get().GetPlayer(m_ID);
+    // Can we use the value captured during the last update?
+    if (Core::Get().IsStateFresh(inst.mStateTime))
+    {
+        return inst.mStatePosition.x;
+    }
     // Reserve a temporary float to retrieve the requested component
     float x = 0.0f, dummy;
     // Query the server for the requested component value
@@ -2018,6 +2097,13 @@ float CPlayer::GetPositionY() const
 {
     // Validate the managed identifier
     Validate();
+    // Retrieve the associated tracking instance
+    const PlayerInst & inst = Core::Get().GetPlayer(m_ID);
+    // Can we use the value captured during the last update?
+    if (Core::Get().IsStateFresh(inst.mStateTime))
+    {
+        return inst.mStatePosition.y;
+    }
     // Reserve a temporary float to retrieve the requested component
     float y = 0.0f, dummy;
     // Query the server for the requested component value
@@ -2031,6 +2117,13 @@ float CPlayer::GetPositionZ() const
 {
     // Validate the managed identifier
     Validate();
+    // Retrieve the associated tracking instance
+    const PlayerInst & inst = Core::Get().GetPlayer(m_ID);
+    // Can we use the value captured during the last update?
+    if (Core::Get().IsStateFresh(inst.mStateTime))
+    {
+        return inst.mStatePosition.z;
+    }
     // Reserve a temporary float to retrieve the requested component
     float z = 0.0f, dummy;
     // Query the server for the requested component value
@@ -2044,6 +2137,8 @@ void CPlayer::SetPositionX(float x) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Reserve some temporary floats to retrieve the missing components
     float y, z, dummy;
     // Retrieve the current values for unchanged components
@@ -2057,6 +2152,8 @@ void CPlayer::SetPositionY(float y) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Reserve some temporary floats to retrieve the missing components
     float x, z, dummy;
     // Retrieve the current values for unchanged components
@@ -2070,6 +2167,8 @@ void CPlayer::SetPositionZ(float z) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetPlayer(m_ID).mStateTime = 0;
     // Reserve some temporary floats to retrieve the missing components
     float x, y, dummy;
     // Retrieve the current values for unchanged components
@@ -2878,6 +2977,7 @@ void Register_CPlayer(HSQUIRRELVM vm)
         .Prop(_SC("LastArmour"), &CPlayer::GetLastArmour)
         .Prop(_SC("LastHeading"), &CPlayer::GetLastHeading)
         .Prop(_SC("LastPosition"), &CPlayer::GetLastPosition)
+        .Prop(_SC("LastChanges"), &CPlayer::GetLastChanges)
         .Prop(_SC("Distance"), &CPlayer::GetDistance, &CPlayer::SetDistance)
         .Prop(_SC("TrackDistance"), &CPlayer::GetTrackDistance, &CPlayer::SetTrackDistance)
         .Prop(_SC("BufferCursor"), &CPlayer::GetBufferCursor, &CPlayer::SetBufferCursor)
@@ -927,6 +927,11 @@ public:
     */
     SQMOD_NODISCARD const Vector3 & GetLastPosition() const;
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the last known values that changed during the last update (SqEntityState flags).
+    */
+    SQMOD_NODISCARD uint32_t GetLastChanges() const;
+
     /* --------------------------------------------------------------------------------------------
      * Retrieve the distance traveled by the managed player entity while tracking was enabled.
     */
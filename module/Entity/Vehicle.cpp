@@ -53,6 +53,8 @@ const String & CVehicle::GetTag() const
 // ------------------------------------------------------------------------------------------------
 void CVehicle::SetTag(StackStrF & tag)
 {
+    // Remember the previous tag to update the index
+    const String prev(std::move(m_Tag));
     if (tag.mLen > 0)
     {
         m_Tag.assign(tag.mPtr, static_cast< size_t >(tag.mLen));
@@ -61,6 +63,8 @@ void CVehicle::SetTag(StackStrF & tag)
     {
         m_Tag.clear();
     }
+    // Only active entities are indexed
+    Core::Get().GetEntityTags(ENT_VEHICLE).Update(prev, m_Tag, static_cast< TagIndex::Slot >(m_ID));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -303,6 +307,10 @@ void CVehicle::Respawn() const
 {
     // Validate the managed identifier
     Validate();
+    // Retrieve the associated tracking instance
+    VehicleInst & inst = Core::Get().GetVehicle(m_ID);
+    // The captured state is about to become outdated
+    inst.mHealthTime = inst.mPositionTime = inst.mRotationTime = 0;
     // Perform the requested operation
     _Func->RespawnVehicle(m_ID);
 }
@@ -340,6 +348,8 @@ void CVehicle::Explode() const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mHealthTime = 0;
     // Perform the requested operation
     _Func->ExplodeVehicle(m_ID);
 }
@@ -380,6 +390,13 @@ Vector3 CVehicle::GetPosition() const
 {
     // Validate the managed identifier
     Validate();
+    // Retrieve the associated tracking instance
+    const VehicleInst & inst = Core::Get().GetVehicle(m_ID);
+    // Can we use the value captured during the last update?
+    if (Core::Get().IsStateFresh(inst.mPositionTime))
+    {
+        return inst.mStatePosition;
+    }
     // Create a default vector instance
     Vector3 vec;
     // Query the server for the values
@@ -393,6 +410,8 @@ void CVehicle::SetPosition(const Vector3 & pos) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mPositionTime = 0;
     // Perform the requested operation
     _Func->SetVehiclePosition(m_ID, pos.x, pos.y, pos.z, static_cast< uint8_t >(false));
 }
@@ -402,6 +421,8 @@ void CVehicle::SetPositionB(const Vector3 & pos, bool empty) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mPositionTime = 0;
     // Perform the requested operation
     _Func->SetVehiclePosition(m_ID, pos.x, pos.y, pos.z, static_cast< uint8_t >(empty));
 }
@@ -411,6 +432,8 @@ void CVehicle::SetPositionEx(float x, float y, float z) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mPositionTime = 0;
     // Perform the requested operation
     _Func->SetVehiclePosition(m_ID, x, y, z, static_cast< uint8_t >(false));
 }
@@ -420,6 +443,8 @@ void CVehicle::SetPositionExB(float x, float y, float z, bool empty) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mPositionTime = 0;
     // Perform the requested operation
     _Func->SetVehiclePosition(m_ID, x, y, z, static_cast< uint8_t >(empty));
 }
@@ -429,6 +454,13 @@ Quaternion CVehicle::GetRotation() const
 {
     // Validate the managed identifier
     Validate();
+    // Retrieve the associated tracking instance
+    const VehicleInst & inst = Core::Get().GetVehicle(m_ID);
+    // Can we use the value captured during the last update?
+    if (Core::Get().IsStateFresh(inst.mRotationTime))
+    {
+        return inst.mStateRotation;
+    }
     // Create a default quaternion instance
     Quaternion q;
     // Query the server for the values
@@ -442,6 +474,8 @@ void CVehicle::SetRotation(const Quaternion & rot) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mRotationTime = 0;
     // Perform the requested operation
     _Func->SetVehicleRotation(m_ID, rot.x, rot.y, rot.z, rot.w);
 }
@@ -451,6 +485,8 @@ void CVehicle::SetRotationEx(float x, float y, float z, float w) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mRotationTime = 0;
     // Perform the requested operation
     _Func->SetVehicleRotation(m_ID, x, y, z, w);
 }
@@ -473,6 +509,8 @@ void CVehicle::SetRotationEuler(const Vector3 & rot) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mRotationTime = 0;
     // Perform the requested operation
     _Func->SetVehicleRotationEuler(m_ID, rot.x, rot.y, rot.z);
 }
@@ -482,6 +520,8 @@ void CVehicle::SetRotationEulerEx(float x, float y, float z) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mRotationTime = 0;
     // Perform the requested operation
     _Func->SetVehicleRotationEuler(m_ID, x, y, z);
 }
@@ -810,6 +850,13 @@ float CVehicle::GetHealth() const
 {
     // Validate the managed identifier
     Validate();
+    // Retrieve the associated tracking instance
+    const VehicleInst & inst = Core::Get().GetVehicle(m_ID);
+    // Can we use the value captured during the last update?
+    if (Core::Get().IsStateFresh(inst.mHealthTime))
+    {
+        return inst.mStateHealth;
+    }
     // Return the requested information
     return _Func->GetVehicleHealth(m_ID);
 }
@@ -819,6 +866,8 @@ void CVehicle::SetHealth(float amount) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mHealthTime = 0;
     // Perform the requested operation
     _Func->SetVehicleHealth(m_ID, amount);
 }
@@ -828,6 +877,8 @@ void CVehicle::Fix() const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mHealthTime = 0;
     // Perform the requested operation
     _Func->SetVehicleHealth(m_ID, 1000);
     _Func->SetVehicleDamageData(m_ID, 0);
@@ -1400,6 +1451,15 @@ const Quaternion & CVehicle::GetLastRotation() const
     return Core::Get().GetVehicle(m_ID).mLastRotation;
 }
 
+// ------------------------------------------------------------------------------------------------
+uint32_t CVehicle::GetLastChanges() const
+{
+    // Validate the managed identifier
+    Validate();
+    // Return the requested information
+    return Core::Get().GetVehicle(m_ID).mChanged;
+}
+
 // ------------------------------------------------------------------------------------------------
 SQFloat CVehicle::GetDistance() const
 {
@@ -1487,6 +1547,8 @@ void CVehicle::SetPositionX(float x) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mPositionTime = 0;
     // Reserve some temporary floats to retrieve the missing components
     float y, z, dummy;
     // Retrieve the current values for unchanged components
@@ -1500,6 +1562,8 @@ void CVehicle::SetPositionY(float y) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mPositionTime = 0;
     // Reserve some temporary floats to retrieve the missing components
     float x, z, dummy;
     // Retrieve the current values for unchanged components
@@ -1513,6 +1577,8 @@ void CVehicle::SetPositionZ(float z) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mPositionTime = 0;
     // Reserve some temporary floats to retrieve the missing components
     float x, y, dummy;
     // Retrieve the current values for unchanged components
@@ -1578,6 +1644,8 @@ void CVehicle::SetRotationX(float x) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mRotationTime = 0;
     // Reserve some temporary floats to retrieve the missing components
     float y, z, w, dummy;
     // Retrieve the current values for unchanged components
@@ -1591,6 +1659,8 @@ void CVehicle::SetRotationY(float y) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mRotationTime = 0;
     // Reserve some temporary floats to retrieve the missing components
     float x, z, w, dummy;
     // Retrieve the current values for unchanged components
@@ -1604,6 +1674,8 @@ void CVehicle::SetRotationZ(float z) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mRotationTime = 0;
     // Reserve some temporary floats to retrieve the missing components
     float x, y, w, dummy;
     // Retrieve the current values for unchanged components
@@ -1617,6 +1689,8 @@ void CVehicle::SetRotationW(float w) const
 {
     // Validate the managed identifier
     Validate();
+    // The captured state is about to become outdated
+    Core::Get().GetVehicle(m_ID).mRotationTime = 0;
     // Reserve some temporary floats to retrieve the missing components
     float x, y, z, dummy;
     // Retrieve the current values for unchanged components
@@ -2131,6 +2205,7 @@ void Register_CVehicle(HSQUIRRELVM vm)
         .Prop(_SC("LastHealth"), &CVehicle::GetLastHealth)
         .Prop(_SC("LastPosition"), &CVehicle::GetLastPosition)
         .Prop(_SC("LastRotation"), &CVehicle::GetLastRotation)
+        .Prop(_SC("LastChanges"), &CVehicle::GetLastChanges)
         .Prop(_SC("Distance"), &CVehicle::GetDistance, &CVehicle::SetDistance)
         .Prop(_SC("TrackDistance"), &CVehicle::GetTrackDistance, &CVehicle::SetTrackDistance)
         .Prop(_SC("PosX"), &CVehicle::GetPositionX, &CVehicle::SetPositionX)
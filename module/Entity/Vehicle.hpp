@@ -703,6 +703,11 @@ public:
     */
     SQMOD_NODISCARD const Quaternion & GetLastRotation() const;
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the last known values that changed until the last update (SqEntityState flags).
+    */
+    SQMOD_NODISCARD uint32_t GetLastChanges() const;
+
     /* --------------------------------------------------------------------------------------------
      * Retrieve the distance traveled by the managed vehicle entity while tracking was enabled.
     */
@@ -1,9 +1,13 @@
 // ------------------------------------------------------------------------------------------------
 #include "Library/CURL.hpp"
+#include "Core/Promise.hpp"
 
 // ------------------------------------------------------------------------------------------------
 #include <sqratConst.h>
 
+// ------------------------------------------------------------------------------------------------
+#include <unordered_map>
+
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
@@ -41,7 +45,8 @@ struct CpBaseAction : public ThreadPoolItem
     CpSession *     mInstance{nullptr}; // Associated session.
     Function        mCallback{}; // Function to call when completed.
     LightObj        mObject{}; // Prevent the session from being destroyed.
-    cpr::Response   mResponse{};
+    PromiseRef      mPromise{}; // Promise to settle instead of invoking the callback.
+    CURLcode        mResult{CURLE_OK}; // Result of the transfer.
 
     /* --------------------------------------------------------------------------------------------
      * Base constructor.
@@ -50,7 +55,6 @@ struct CpBaseAction : public ThreadPoolItem
         : mInstance(session)
         , mCallback(std::move(cb))
         , mObject(std::move(obj))
-        , mResponse()
     {
     }
 
@@ -59,6 +63,11 @@ struct CpBaseAction : public ThreadPoolItem
     */
     ~CpBaseAction() override = default;
 
+    /* --------------------------------------------------------------------------------------------
+     * Configure the session handle for this request. Invoked in main thread before submitting.
+    */
+    virtual void Prepare() = 0;
+
     /* --------------------------------------------------------------------------------------------
      * Invoked in main thread by the thread pool after the task was completed.
      * If it returns true then it will be put back into the queue to be processed again.
@@ -66,23 +75,392 @@ struct CpBaseAction : public ThreadPoolItem
     */
     SQMOD_NODISCARD bool OnCompleted(bool SQ_UNUSED_ARG(stop)) override
     {
+        // Collect the response from the session handle
+        cpr::Response response = mInstance->Complete(mResult);
+        // Unlock the session
+        mInstance->mPending = nullptr;
+        // Is there a promise?
+        if (mPromise)
+        {
+            mPromise->Resolve(LightObj(SqTypeIdentity< CpResponse >{}, SqVM(), std::move(response)));
+        }
         // Is there a callback?
-        if (!mCallback.IsNull())
+        else if (!mCallback.IsNull())
         {
-            mCallback(mObject, CpResponse(std::move(mResponse))); // Invoke it
+            mCallback(mObject, CpResponse(std::move(response))); // Invoke it
         }
-        // Unlock the session
-        mInstance->mPending = nullptr;
         // Don't re-queue
         return false;
     }
 
     /* --------------------------------------------------------------------------------------------
-     * Task process callback.
+     * Task process callback. Only used when the transfer engine is not available.
     */
-    SQMOD_NODISCARD bool OnProcess() override { return false; }
+    SQMOD_NODISCARD bool OnProcess() override
+    {
+        mResult = curl_easy_perform(mInstance->GetCurlHolder()->handle);
+        return false; // We do this once
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Called in worker by the thread pool to let the task know that it will be aborted.
+    */
+    void OnAborted(bool SQ_UNUSED_ARG(retry)) override
+    {
+        mResult = CURLE_ABORTED_BY_CALLBACK;
+    }
 };
 
+/* ------------------------------------------------------------------------------------------------
+ * Transfer engine that drives the asynchronous requests of all sessions from a single thread,
+ * through a curl multi handle. Transfers share the DNS and connection cache of the multi handle so,
+ * requests to the same host reuse idle connections instead of opening new ones. Finished actions
+ * are handed to the thread pool, which completes them in the main thread like any other task.
+*/
+class CpMulti
+{
+private:
+
+    // --------------------------------------------------------------------------------------------
+    using Action = std::unique_ptr< CpBaseAction >; // Owning pointer of an action.
+
+    // --------------------------------------------------------------------------------------------
+    static CpMulti s_Inst; // Engine instance.
+
+    // --------------------------------------------------------------------------------------------
+    CURLM *                                 m_Multi{nullptr}; // The multi handle.
+    std::thread                             m_Thread{}; // Thread that drives the transfers.
+    std::atomic_bool                        m_Running{false}; // Whether the thread is allowed to run.
+    // --------------------------------------------------------------------------------------------
+    std::atomic_bool                        m_Dirty{false}; // Whether the limits must be applied again.
+    std::atomic_long                        m_MaxHost{0}; // Connection limit per host. Zero is unlimited.
+    std::atomic_long                        m_MaxTotal{0}; // Connection limit in total. Zero is unlimited.
+    std::atomic_size_t                      m_Active{0}; // Number of transfers in progress.
+    // --------------------------------------------------------------------------------------------
+    std::mutex                              m_Mutex{}; // Guards the incoming actions.
+    std::vector< Action >                   m_Incoming{}; // Actions waiting to be started.
+    std::unordered_map< CURL *, Action >    m_Transfers{}; // Actions in progress. Engine thread only.
+
+    /* --------------------------------------------------------------------------------------------
+     * Default constructor.
+    */
+    CpMulti() = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Destructor.
+    */
+    ~CpMulti()
+    {
+        // The engine should have been terminated already
+        if (m_Thread.joinable())
+        {
+            m_Running = false;
+            curl_multi_wakeup(m_Multi);
+            m_Thread.join();
+        }
+        // Script resources cannot be released anymore at this point
+        for (auto & t : m_Transfers)
+        {
+            [[maybe_unused]] auto * _ = t.second.release();
+        }
+        for (auto & a : m_Incoming)
+        {
+            [[maybe_unused]] auto * _ = a.release();
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Create the multi handle and start the engine thread, if not already started.
+    */
+    bool Start()
+    {
+        // Already started?
+        if (m_Running)
+        {
+            return true;
+        }
+        // Create the multi handle
+        m_Multi = curl_multi_init();
+        // Was the handle created?
+        if (m_Multi == nullptr)
+        {
+            LogErr("Unable to create the HTTP transfer engine. Falling back to the thread pool.");
+            // Can't start
+            return false;
+        }
+        // Make sure the limits are applied before the first transfer
+        m_Dirty = true;
+        // Make sure the thread doesn't stop after creation
+        m_Running = true;
+        // Create the engine thread
+        m_Thread = std::thread(&CpMulti::Run, this);
+        // Engine started
+        return true;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Apply the connection limits to the multi handle. Engine thread only.
+    */
+    void ApplyLimits()
+    {
+        curl_multi_setopt(m_Multi, CURLMOPT_MAX_HOST_CONNECTIONS, m_MaxHost.load());
+        curl_multi_setopt(m_Multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, m_MaxTotal.load());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Start the actions that were submitted since the last iteration. Engine thread only.
+    */
+    void Accept(std::vector< Action > & incoming)
+    {
+        // Take the submitted actions
+        {
+            std::lock_guard< std::mutex > lg(m_Mutex);
+            incoming.swap(m_Incoming);
+        }
+        // Add them to the multi handle
+        for (auto & a : incoming)
+        {
+            CURL * handle = a->mInstance->GetCurlHolder()->handle;
+            // Requests beyond the connection limits are kept pending by the multi handle
+            if (curl_multi_add_handle(m_Multi, handle) == CURLM_OK)
+            {
+                m_Transfers.emplace(handle, std::move(a));
+                ++m_Active;
+            }
+            else
+            {
+                a->mResult = CURLE_FAILED_INIT;
+                // Complete it right away
+                ThreadPool::Get().Complete(std::move(a));
+            }
+        }
+        // Keep the memory for the next iteration
+        incoming.clear();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Hand the finished transfers to the thread pool. Engine thread only.
+    */
+    void Collect()
+    {
+        int left = 0;
+        // Look at the messages from the multi handle
+        for (CURLMsg * msg = curl_multi_info_read(m_Multi, &left); msg != nullptr; msg = curl_multi_info_read(m_Multi, &left))
+        {
+            // Only finished transfers are of interest
+            if (msg->msg != CURLMSG_DONE)
+            {
+                continue;
+            }
+            // The message is invalidated once the handle is removed
+            CURL * handle = msg->easy_handle;
+            const CURLcode result = msg->data.result;
+            // The connection goes back to the cache of the multi handle
+            curl_multi_remove_handle(m_Multi, handle);
+            // Find the associated action
+            auto itr = m_Transfers.find(handle);
+            // Should not happen but, just in case
+            if (itr == m_Transfers.end())
+            {
+                continue;
+            }
+            itr->second->mResult = result;
+            // Let the main thread complete the action
+            ThreadPool::Get().Complete(std::move(itr->second));
+            // Forget about it
+            m_Transfers.erase(itr);
+            --m_Active;
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Engine thread procedure.
+    */
+    void Run()
+    {
+        // Initialize third-party allocator for this thread
+        auto rpmallocinit = std::make_unique< RPMallocThreadInit >();
+        // Actions submitted since the last iteration
+        std::vector< Action > incoming;
+        // Drive the transfers until told to stop
+        while (m_Running)
+        {
+            // Were the limits changed?
+            if (m_Dirty.exchange(false))
+            {
+                ApplyLimits();
+            }
+            // Start the submitted actions
+            Accept(incoming);
+            // Move the transfers forward
+            int running = 0;
+            curl_multi_perform(m_Multi, &running);
+            // Complete the ones that finished
+            Collect();
+            // Sleep until there is network activity, a timeout or a new action
+            curl_multi_poll(m_Multi, nullptr, 0, 1000, nullptr);
+        }
+    }
+
+public:
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy constructor. (disabled)
+    */
+    CpMulti(const CpMulti & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move constructor. (disabled)
+    */
+    CpMulti(CpMulti && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy assignment operator. (disabled)
+    */
+    CpMulti & operator = (const CpMulti & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move assignment operator. (disabled)
+    */
+    CpMulti & operator = (CpMulti && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the engine instance.
+    */
+    static CpMulti & Get()
+    {
+        return s_Inst;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Lock the session of the specified action and start the request. Will take ownership!
+    */
+    void Submit(CpBaseAction * action)
+    {
+        // Take ownership before any exception can be thrown
+        Action item{action};
+        // Configure the session handle while we still own it
+        item->Prepare();
+        // Lock the session
+        item->mInstance->mPending = action;
+        // Can the engine be used?
+        if (!Start())
+        {
+            ThreadPool::Get().Enqueue(item.release());
+            // Nothing else to do
+            return;
+        }
+        // Queue the action
+        {
+            std::lock_guard< std::mutex > lg(m_Mutex);
+            m_Incoming.push_back(std::move(item));
+        }
+        // Let the engine thread know about it
+        curl_multi_wakeup(m_Multi);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Stop the engine thread and abort the requests in progress.
+    */
+    void Terminate()
+    {
+        // Was the engine started?
+        if (!m_Running)
+        {
+            return;
+        }
+        // Tell the thread to stop
+        m_Running = false;
+        curl_multi_wakeup(m_Multi);
+        // Will block until the current iteration is finished
+        m_Thread.join();
+        // Gather the actions that did not finish
+        std::vector< Action > aborted;
+        aborted.swap(m_Incoming);
+        for (auto & t : m_Transfers)
+        {
+            curl_multi_remove_handle(m_Multi, t.first);
+            aborted.push_back(std::move(t.second));
+        }
+        m_Transfers.clear();
+        m_Active = 0;
+        // Release the multi handle and the connections it keeps alive
+        curl_multi_cleanup(m_Multi);
+        m_Multi = nullptr;
+        // Allow the actions to finish themselves
+        for (auto & a : aborted)
+        {
+            a->mResult = CURLE_ABORTED_BY_CALLBACK;
+            try {
+                [[maybe_unused]] auto _ = a->OnCompleted(true);
+            } catch (const std::exception & e) {
+                LogErr("Exception occured in %s forced cancelation stage [%s] for [%s]", a->TypeName(), e.what(), a->IdentifiableInfo());
+            }
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the maximum number of connections to a single host.
+    */
+    SQMOD_NODISCARD SQInteger GetMaxHostConnections() const
+    {
+        return static_cast< SQInteger >(m_MaxHost.load());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the maximum number of connections to a single host. Zero means no limit.
+    */
+    void SetMaxHostConnections(SQInteger n)
+    {
+        m_MaxHost = static_cast< long >(std::max(n, SQInteger(0)));
+        // Apply it with the next iteration
+        m_Dirty = true;
+        if (m_Running)
+        {
+            curl_multi_wakeup(m_Multi);
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the maximum number of connections in total.
+    */
+    SQMOD_NODISCARD SQInteger GetMaxConnections() const
+    {
+        return static_cast< SQInteger >(m_MaxTotal.load());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the maximum number of connections in total. Zero means no limit.
+    */
+    void SetMaxConnections(SQInteger n)
+    {
+        m_MaxTotal = static_cast< long >(std::max(n, SQInteger(0)));
+        // Apply it with the next iteration
+        m_Dirty = true;
+        if (m_Running)
+        {
+            curl_multi_wakeup(m_Multi);
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of transfers in progress.
+    */
+    SQMOD_NODISCARD SQInteger GetActiveTransfers() const
+    {
+        return static_cast< SQInteger >(m_Active.load());
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+CpMulti CpMulti::s_Inst;
+
+// ------------------------------------------------------------------------------------------------
+void TerminateCURL()
+{
+    CpMulti::Get().Terminate();
+}
+
 /* ------------------------------------------------------------------------------------------------
  * Delete action implementation.
 */
@@ -98,12 +476,11 @@ struct CpDeleteAction : public CpBaseAction
     }
 
     /* --------------------------------------------------------------------------------------------
-     * Task process callback.
+     * Configure the session handle for this request.
     */
-    SQMOD_NODISCARD bool OnProcess() override
+    void Prepare() override
     {
-        mResponse = mInstance->Delete();
-        return false; // We do this once
+        mInstance->PrepareDelete();
     }
 };
 
@@ -111,10 +488,8 @@ struct CpDeleteAction : public CpBaseAction
 void CpSession::DoDelete_(Function & cb)
 {
     LockCheck();
-    // Create the task and lock session
-    mPending = new CpDeleteAction(this, cb, LightObj(1, SqVM()));
-    // Queue the task to be processed
-    ThreadPool::Get().Enqueue(mPending);
+    // Create the task and hand it to the transfer engine
+    CpMulti::Get().Submit(new CpDeleteAction(this, cb, LightObj(1, SqVM())));
 }
 
 /* ------------------------------------------------------------------------------------------------
@@ -132,12 +507,11 @@ struct CpGetAction : public CpBaseAction
     }
 
     /* --------------------------------------------------------------------------------------------
-     * Task process callback.
+     * Configure the session handle for this request.
     */
-    SQMOD_NODISCARD bool OnProcess() override
+    void Prepare() override
     {
-        mResponse = mInstance->Get();
-        return false; // We do this once
+        mInstance->PrepareGet();
     }
 };
 
@@ -145,10 +519,8 @@ struct CpGetAction : public CpBaseAction
 void CpSession::DoGet_(Function & cb)
 {
     LockCheck();
-    // Create the task and lock session
-    mPending = new CpGetAction(this, cb, LightObj(1, SqVM()));
-    // Queue the task to be processed
-    ThreadPool::Get().Enqueue(mPending);
+    // Create the task and hand it to the transfer engine
+    CpMulti::Get().Submit(new CpGetAction(this, cb, LightObj(1, SqVM())));
 }
 
 /* ------------------------------------------------------------------------------------------------
@@ -166,12 +538,11 @@ struct CpHeadAction : public CpBaseAction
     }
 
     /* --------------------------------------------------------------------------------------------
-     * Task process callback.
+     * Configure the session handle for this request.
     */
-    SQMOD_NODISCARD bool OnProcess() override
+    void Prepare() override
     {
-        mResponse = mInstance->Head();
-        return false; // We do this once
+        mInstance->PrepareHead();
     }
 };
 
@@ -179,10 +550,8 @@ struct CpHeadAction : public CpBaseAction
 void CpSession::DoHead_(Function & cb)
 {
     LockCheck();
-    // Create the task and lock session
-    mPending = new CpHeadAction(this, cb, LightObj(1, SqVM()));
-    // Queue the task to be processed
-    ThreadPool::Get().Enqueue(mPending);
+    // Create the task and hand it to the transfer engine
+    CpMulti::Get().Submit(new CpHeadAction(this, cb, LightObj(1, SqVM())));
 }
 
 /* ------------------------------------------------------------------------------------------------
@@ -200,12 +569,11 @@ struct CpOptionsAction : public CpBaseAction
     }
 
     /* --------------------------------------------------------------------------------------------
-     * Task process callback.
+     * Configure the session handle for this request.
     */
-    SQMOD_NODISCARD bool OnProcess() override
+    void Prepare() override
     {
-        mResponse = mInstance->Options();
-        return false; // We do this once
+        mInstance->PrepareOptions();
     }
 };
 
@@ -213,10 +581,8 @@ struct CpOptionsAction : public CpBaseAction
 void CpSession::DoOptions_(Function & cb)
 {
     LockCheck();
-    // Create the task and lock session
-    mPending = new CpOptionsAction(this, cb, LightObj(1, SqVM()));
-    // Queue the task to be processed
-    ThreadPool::Get().Enqueue(mPending);
+    // Create the task and hand it to the transfer engine
+    CpMulti::Get().Submit(new CpOptionsAction(this, cb, LightObj(1, SqVM())));
 }
 
 /* ------------------------------------------------------------------------------------------------
@@ -234,12 +600,11 @@ struct CpPatchAction : public CpBaseAction
     }
 
     /* --------------------------------------------------------------------------------------------
-     * Task process callback.
+     * Configure the session handle for this request.
     */
-    SQMOD_NODISCARD bool OnProcess() override
+    void Prepare() override
     {
-        mResponse = mInstance->Patch();
-        return false; // We do this once
+        mInstance->PreparePatch();
     }
 };
 
@@ -247,10 +612,8 @@ struct CpPatchAction : public CpBaseAction
 void CpSession::DoPatch_(Function & cb)
 {
     LockCheck();
-    // Create the task and lock session
-    mPending = new CpPatchAction(this, cb, LightObj(1, SqVM()));
-    // Queue the task to be processed
-    ThreadPool::Get().Enqueue(mPending);
+    // Create the task and hand it to the transfer engine
+    CpMulti::Get().Submit(new CpPatchAction(this, cb, LightObj(1, SqVM())));
 }
 
 /* ------------------------------------------------------------------------------------------------
@@ -268,12 +631,11 @@ struct CpPostAction : public CpBaseAction
     }
 
     /* --------------------------------------------------------------------------------------------
-     * Task process callback.
+     * Configure the session handle for this request.
     */
-    SQMOD_NODISCARD bool OnProcess() override
+    void Prepare() override
     {
-        mResponse = mInstance->Post();
-        return false; // We do this once
+        mInstance->PreparePost();
     }
 };
 
@@ -281,10 +643,8 @@ struct CpPostAction : public CpBaseAction
 void CpSession::DoPost_(Function & cb)
 {
     LockCheck();
-    // Create the task and lock session
-    mPending = new CpPostAction(this, cb, LightObj(1, SqVM()));
-    // Queue the task to be processed
-    ThreadPool::Get().Enqueue(mPending);
+    // Create the task and hand it to the transfer engine
+    CpMulti::Get().Submit(new CpPostAction(this, cb, LightObj(1, SqVM())));
 }
 
 /* ------------------------------------------------------------------------------------------------
@@ -302,12 +662,11 @@ struct CpPutAction : public CpBaseAction
     }
 
     /* --------------------------------------------------------------------------------------------
-     * Task process callback.
+     * Configure the session handle for this request.
     */
-    SQMOD_NODISCARD bool OnProcess() override
+    void Prepare() override
     {
-        mResponse = mInstance->Put();
-        return false; // We do this once
+        mInstance->PreparePut();
     }
 };
 
@@ -315,10 +674,25 @@ struct CpPutAction : public CpBaseAction
 void CpSession::DoPut_(Function & cb)
 {
     LockCheck();
-    // Create the task and lock session
-    mPending = new CpPutAction(this, cb, LightObj(1, SqVM()));
-    // Queue the task to be processed
-    ThreadPool::Get().Enqueue(mPending);
+    // Create the task and hand it to the transfer engine
+    CpMulti::Get().Submit(new CpPutAction(this, cb, LightObj(1, SqVM())));
+}
+
+// ------------------------------------------------------------------------------------------------
+template < class T > LightObj CpSession::DoPromise_()
+{
+    LockCheck();
+    Function cb{};
+    PromiseRef promise{};
+    // Create the promise returned to the script
+    LightObj obj = Promise::Create(promise);
+    // Create the task
+    auto * action = new T(this, cb, LightObj(1, SqVM()));
+    action->mPromise = std::move(promise);
+    // Hand it to the transfer engine
+    CpMulti::Get().Submit(action);
+    // Return the promise
+    return obj;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -438,6 +812,36 @@ static const EnumElements g_EnumList[] = {
     {_SC("SqCprPostRedirectFlags"),     g_PostRedirectFlags}
 };
 
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqGetMaxHostConnections()
+{
+    return CpMulti::Get().GetMaxHostConnections();
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqSetMaxHostConnections(SQInteger n)
+{
+    CpMulti::Get().SetMaxHostConnections(n);
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqGetMaxConnections()
+{
+    return CpMulti::Get().GetMaxConnections();
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqSetMaxConnections(SQInteger n)
+{
+    CpMulti::Get().SetMaxConnections(n);
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqGetActiveTransfers()
+{
+    return CpMulti::Get().GetActiveTransfers();
+}
+
 // ================================================================================================
 void Register_CURL(HSQUIRRELVM vm)
 {
@@ -701,8 +1105,22 @@ void Register_CURL(HSQUIRRELVM vm)
         .Func(_SC("AsyncPatch"), &CpSession::DoPatch_)
         .Func(_SC("AsyncPost"), &CpSession::DoPost_)
         .Func(_SC("AsyncPut"), &CpSession::DoPut_)
+        .Func(_SC("PromiseDelete"), &CpSession::DoPromise_< CpDeleteAction >)
+        .Func(_SC("PromiseGet"), &CpSession::DoPromise_< CpGetAction >)
+        .Func(_SC("PromiseHead"), &CpSession::DoPromise_< CpHeadAction >)
+        .Func(_SC("PromiseOptions"), &CpSession::DoPromise_< CpOptionsAction >)
+        .Func(_SC("PromisePatch"), &CpSession::DoPromise_< CpPatchAction >)
+        .Func(_SC("PromisePost"), &CpSession::DoPromise_< CpPostAction >)
+        .Func(_SC("PromisePut"), &CpSession::DoPromise_< CpPutAction >)
     );
 
+    // --------------------------------------------------------------------------------------------
+    cpns.Func(_SC("GetMaxHostConnections"), &SqGetMaxHostConnections);
+    cpns.Func(_SC("SetMaxHostConnections"), &SqSetMaxHostConnections);
+    cpns.Func(_SC("GetMaxConnections"), &SqGetMaxConnections);
+    cpns.Func(_SC("SetMaxConnections"), &SqSetMaxConnections);
+    cpns.Func(_SC("ActiveTransfers"), &SqGetActiveTransfers);
+
     RootTable(vm).Bind(_SC("SqCPR"), cpns);
 
     // --------------------------------------------------------------------------------------------
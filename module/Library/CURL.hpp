@@ -2218,6 +2218,11 @@ struct CpSession : public cpr::Session
      * Put async request.
     */
     void DoPut_(Function & cb);
+
+    /* --------------------------------------------------------------------------------------------
+     * Async request that settles the returned promise with the response.
+    */
+    template < class T > SQMOD_NODISCARD LightObj DoPromise_();
 };
 
 } // Namespace:: SqMod
@@ -29,7 +29,7 @@ SQMOD_DECL_TYPENAME(Typename, _SC("SqBuffer"))
 SQInteger SqBuffer::WriteRawString(StackStrF & val) const
 {
     // Validate the managed buffer reference
-    Validate();
+    ValidateWritable();
     // Is the given string value even valid?
     if (!val.mLen)
     {
@@ -47,7 +47,7 @@ SQInteger SqBuffer::WriteRawString(StackStrF & val) const
 SQInteger SqBuffer::WriteClientString(StackStrF & val) const
 {
     // Validate the managed buffer reference
-    Validate();
+    ValidateWritable();
     // Is the given string value even valid?
     if (!val.mLen)
     {
@@ -71,61 +71,61 @@ SQInteger SqBuffer::WriteClientString(StackStrF & val) const
 // ------------------------------------------------------------------------------------------------
 void SqBuffer::WriteAABB(const AABB & val) const
 {
-    Valid().Push< AABB >(val);
+    Writable().Push< AABB >(val);
 }
 
 // ------------------------------------------------------------------------------------------------
 void SqBuffer::WriteCircle(const Circle & val) const
 {
-    Valid().Push< Circle >(val);
+    Writable().Push< Circle >(val);
 }
 
 // ------------------------------------------------------------------------------------------------
 void SqBuffer::WriteColor3(const Color3 & val) const
 {
-    Valid().Push< Color3 >(val);
+    Writable().Push< Color3 >(val);
 }
 
 // ------------------------------------------------------------------------------------------------
 void SqBuffer::WriteColor4(const Color4 & val) const
 {
-    Valid().Push< Color4 >(val);
+    Writable().Push< Color4 >(val);
 }
 
 // ------------------------------------------------------------------------------------------------
 void SqBuffer::WriteQuaternion(const Quaternion & val) const
 {
-    Valid().Push< Quaternion >(val);
+    Writable().Push< Quaternion >(val);
 }
 
 // ------------------------------------------------------------------------------------------------
 void SqBuffer::WriteSphere(const Sphere &val) const
 {
-    Valid().Push< Sphere >(val);
+    Writable().Push< Sphere >(val);
 }
 
 // ------------------------------------------------------------------------------------------------
 void SqBuffer::WriteVector2(const Vector2 & val) const
 {
-    Valid().Push< Vector2 >(val);
+    Writable().Push< Vector2 >(val);
 }
 
 // ------------------------------------------------------------------------------------------------
 void SqBuffer::WriteVector2i(const Vector2i & val) const
 {
-    Valid().Push< Vector2i >(val);
+    Writable().Push< Vector2i >(val);
 }
 
 // ------------------------------------------------------------------------------------------------
 void SqBuffer::WriteVector3(const Vector3 & val) const
 {
-    Valid().Push< Vector3 >(val);
+    Writable().Push< Vector3 >(val);
 }
 
 // ------------------------------------------------------------------------------------------------
 void SqBuffer::WriteVector4(const Vector4 & val) const
 {
-    Valid().Push< Vector4 >(val);
+    Writable().Push< Vector4 >(val);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -439,6 +439,33 @@ LightObj SqBuffer::GetBase64(SQInteger n) const
     return LightObj{out.str()};
 }
 
+// ------------------------------------------------------------------------------------------------
+LightObj SqBuffer::Clone() const
+{
+    // Validate the managed buffer reference
+    Validate();
+    // Is there any memory to copy?
+    if (!(*m_Buffer))
+    {
+        return LightObj(SqTypeIdentity< SqBuffer >{}, SqVM());
+    }
+    // Copy the memory and the cursor position into a new buffer
+    return LightObj(SqTypeIdentity< SqBuffer >{}, SqVM(),
+                    Buffer(m_Buffer->Data(), m_Buffer->Capacity(), m_Buffer->Position()));
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqBufferPoolBytes()
+{
+    return static_cast< SQInteger >(Buffer::PoolBytes());
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqBufferTrimPool()
+{
+    Buffer::TrimPool();
+}
+
 // ================================================================================================
 void Register_Buffer(HSQUIRRELVM vm)
 {
@@ -462,7 +489,9 @@ void Register_Buffer(HSQUIRRELVM vm)
         .Prop(_SC("Capacity"), &SqBuffer::GetCapacity, &SqBuffer::Adjust)
         .Prop(_SC("Position"), &SqBuffer::GetPosition, &SqBuffer::Move)
         .Prop(_SC("Remaining"), &SqBuffer::GetRemaining)
+        .Prop(_SC("ReadOnly"), &SqBuffer::IsReadOnly)
         // Member Methods
+        .Func(_SC("Clone"), &SqBuffer::Clone)
         .Func(_SC("Get"), &SqBuffer::Get)
         .Func(_SC("Set"), &SqBuffer::Set)
         .Func(_SC("Move"), &SqBuffer::Move)
@@ -528,6 +557,9 @@ void Register_Buffer(HSQUIRRELVM vm)
         .Func(_SC("Base32"), &SqBuffer::GetBase32)
         .Func(_SC("Base64"), &SqBuffer::GetBase64)
         .SquirrelMethod< SqBuffer, &SqBuffer::GetJSON >(_SC("GetJSON"))
+        // Static Functions
+        .StaticFunc(_SC("PoolBytes"), &SqBufferPoolBytes)
+        .StaticFunc(_SC("TrimPool"), &SqBufferTrimPool)
     );
 }
 
@@ -20,6 +20,7 @@ private:
 
     // --------------------------------------------------------------------------------------------
     SRef m_Buffer; // The managed memory buffer.
+    bool m_ReadOnly{false}; // Whether the buffer is a read-only view over memory it doesn't own.
 
 public:
 
@@ -193,6 +194,83 @@ public:
         return *m_Buffer;
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Validate the managed memory buffer reference and make sure it can be modified.
+    */
+    void ValidateWritable() const
+    {
+        Validate();
+        // Is this a view over memory that we don't own?
+        if (m_ReadOnly)
+        {
+            STHROWF("Cannot modify a read-only memory buffer (use Clone() to obtain a copy)");
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Validate the managed memory buffer reference and make sure it can be modified.
+    */
+    SQMOD_NODISCARD Buffer & Writable() const
+    {
+        ValidateWritable();
+        // Return the buffer
+        return *m_Buffer;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Validate the managed memory buffer reference and make sure the cursor can reach a position.
+    */
+    SQMOD_NODISCARD Buffer & Reachable(SzType pos) const
+    {
+        Validate();
+        // Read-only views cannot grow
+        if (m_ReadOnly && pos > m_Buffer->Capacity())
+        {
+            STHROWF("Position ({}) is beyond the read-only memory buffer ({})", pos, m_Buffer->Capacity());
+        }
+        // Return the buffer
+        return *m_Buffer;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * See whether this is a read-only view over memory that the buffer doesn't own.
+    */
+    SQMOD_NODISCARD bool IsReadOnly() const
+    {
+        return m_ReadOnly;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Turn this instance into a read-only view over the specified memory.
+     * The memory must outlive the view or Detach() must be called before it goes away.
+    */
+    void View(ConstPtr data, SzType size)
+    {
+        // Forget about the previous view, if any
+        Detach();
+        // Point the buffer to the specified memory, with the cursor at the beginning
+        *m_Buffer = Buffer(const_cast< Pointer >(data), size, Buffer::OwnIt{});
+        // Prevent modifications
+        m_ReadOnly = true;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Forget about the memory of a read-only view without releasing it. The buffer remains read-only.
+    */
+    void Detach() const
+    {
+        // Is this a view over memory that we don't own?
+        if (m_ReadOnly && m_Buffer)
+        {
+            static_cast< void >(m_Buffer->Steal());
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Create a writable copy of the buffer, including the cursor position.
+    */
+    SQMOD_NODISCARD LightObj Clone() const;
+
     /* --------------------------------------------------------------------------------------------
      * Limit the specified amount at to the range of the cursor and the end of the buffer.
     */
@@ -224,7 +302,7 @@ public:
     */
     void Set(SQInteger n, SQInteger v) const
     {
-        Valid().At(ConvTo< SzType >::From(n)) = ConvTo< Value >::From(v);
+        Writable().At(ConvTo< SzType >::From(n)) = ConvTo< Value >::From(v);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -240,7 +318,7 @@ public:
     */
     void SetFront(SQInteger v) const
     {
-        Valid().Front() = ConvTo< Value >::From(v);
+        Writable().Front() = ConvTo< Value >::From(v);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -256,7 +334,7 @@ public:
     */
     void SetNext(SQInteger v) const
     {
-        Valid().Next() = ConvTo< Value >::From(v);
+        Writable().Next() = ConvTo< Value >::From(v);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -272,7 +350,7 @@ public:
     */
     void SetBack(SQInteger v) const
     {
-        Valid().Back() = ConvTo< Value >::From(v);
+        Writable().Back() = ConvTo< Value >::From(v);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -288,7 +366,7 @@ public:
     */
     void SetPrev(SQInteger v) const
     {
-        Valid().Prev() = ConvTo< Value >::From(v);
+        Writable().Prev() = ConvTo< Value >::From(v);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -296,7 +374,7 @@ public:
     */
     SqBuffer & Advance(SQInteger n)
     {
-        Valid().Advance(ConvTo< SzType >::From(n));
+        Reachable(m_Buffer ? m_Buffer->Position() + ConvTo< SzType >::From(n) : 0).Advance(ConvTo< SzType >::From(n));
         // Allow chaining
         return *this;
     }
@@ -316,7 +394,7 @@ public:
     */
     SqBuffer & Move(SQInteger n)
     {
-        Valid().Move(ConvTo< SzType >::From(n));
+        Reachable(ConvTo< SzType >::From(n)).Move(ConvTo< SzType >::From(n));
         // Allow chaining
         return *this;
     }
@@ -326,7 +404,7 @@ public:
     */
     SqBuffer & Push(SQInteger v)
     {
-        Valid().Push(ConvTo< Value >::From(v));
+        Writable().Push(ConvTo< Value >::From(v));
         // Allow chaining
         return *this;
     }
@@ -344,7 +422,7 @@ public:
     */
     void SetCursor(SQInteger v) const
     {
-        Valid().Cursor() = ConvTo< Value >::From(v);
+        Writable().Cursor() = ConvTo< Value >::From(v);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -360,7 +438,7 @@ public:
     */
     void SetBefore(SQInteger v) const
     {
-        Valid().Before() = ConvTo< Value >::From(v);
+        Writable().Before() = ConvTo< Value >::From(v);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -376,7 +454,7 @@ public:
     */
     void SetAfter(SQInteger v) const
     {
-        Valid().After() = ConvTo< Value >::From(v);
+        Writable().After() = ConvTo< Value >::From(v);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -424,7 +502,7 @@ public:
     */
     SqBuffer & Grow(SQInteger n)
     {
-        Valid().Grow(ConvTo< SzType >::From(n) * sizeof(Value));
+        Writable().Grow(ConvTo< SzType >::From(n) * sizeof(Value));
         // Allow chaining
         return *this;
     }
@@ -435,7 +513,7 @@ public:
     SqBuffer & Adjust(SQInteger n)
     {
         // Validate the managed buffer reference
-        Validate();
+        ValidateWritable();
         // Attempt to perform the requested operation
         try
         {
@@ -457,7 +535,7 @@ public:
     */
     void WriteInt8(SQInteger val) const
     {
-        Valid().Push< int8_t >(static_cast< int8_t >(val));
+        Writable().Push< int8_t >(static_cast< int8_t >(val));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -465,7 +543,7 @@ public:
     */
     void WriteUint8(SQInteger val) const
     {
-        Valid().Push< uint8_t >(static_cast< uint8_t >(val));
+        Writable().Push< uint8_t >(static_cast< uint8_t >(val));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -473,7 +551,7 @@ public:
     */
     void WriteInt16(SQInteger val) const
     {
-        Valid().Push< int16_t >(static_cast< int16_t >(val));
+        Writable().Push< int16_t >(static_cast< int16_t >(val));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -481,7 +559,7 @@ public:
     */
     void WriteUint16(SQInteger val) const
     {
-        Valid().Push< uint16_t >(static_cast< uint16_t >(val));
+        Writable().Push< uint16_t >(static_cast< uint16_t >(val));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -489,7 +567,7 @@ public:
     */
     void WriteInt32(SQInteger val) const
     {
-        Valid().Push< int32_t >(static_cast< int32_t >(val));
+        Writable().Push< int32_t >(static_cast< int32_t >(val));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -497,7 +575,7 @@ public:
     */
     void WriteUint32(SQInteger val) const
     {
-        Valid().Push< uint32_t >(static_cast< uint32_t >(val));
+        Writable().Push< uint32_t >(static_cast< uint32_t >(val));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -505,7 +583,7 @@ public:
     */
     void WriteInt64(SQInteger val) const
     {
-        Valid().Push< int64_t >(static_cast< int64_t >(val));
+        Writable().Push< int64_t >(static_cast< int64_t >(val));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -513,7 +591,7 @@ public:
     */
     void WriteUint64(SQInteger val) const
     {
-        Valid().Push< uint64_t >(static_cast< uint64_t >(val));
+        Writable().Push< uint64_t >(static_cast< uint64_t >(val));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -521,7 +599,7 @@ public:
     */
     void WriteFloat32(SQFloat val) const
     {
-        Valid().Push< float >(ConvTo< float >::From(val));
+        Writable().Push< float >(ConvTo< float >::From(val));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -529,7 +607,7 @@ public:
     */
     void WriteFloat64(SQFloat val) const
     {
-        Valid().Push< double >(ConvTo< double >::From(val));
+        Writable().Push< double >(ConvTo< double >::From(val));
     }
 
     /* --------------------------------------------------------------------------------------------
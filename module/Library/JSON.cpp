@@ -7,6 +7,7 @@
 
 // ------------------------------------------------------------------------------------------------
 #include <cstdio>
+#include <vector>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
@@ -119,6 +120,45 @@ static SQInteger SqFromJson_Push(HSQUIRRELVM vm, const sajson::value & node) noe
     return r;
 }
 
+/* ------------------------------------------------------------------------------------------------
+ * Memory reused by every parse. The AST of a document never needs more words than the document has bytes.
+*/
+static struct
+{
+    std::vector< size_t >   mWords; // Storage for the parsed AST.
+    std::vector< char >     mText; // Mutable copy of the parsed document.
+} g_JSONArena;
+
+// ------------------------------------------------------------------------------------------------
+static constexpr size_t JSON_ARENA_LIMIT = 1024 * 1024; // Documents above this size don't keep their memory.
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqFromJSON_Parse(HSQUIRRELVM vm, const char * data, size_t size)
+{
+    // Make sure the arena can hold the document and its AST
+    if (g_JSONArena.mWords.size() < size + 1)
+    {
+        g_JSONArena.mWords.resize(size + 1);
+    }
+    // The document is modified in place while parsing
+    g_JSONArena.mText.assign(data, data + size);
+    // Attempt to parse the specified JSON string
+    const sajson::document & document = sajson::parse(
+        sajson::bounded_allocation(g_JSONArena.mWords.data(), g_JSONArena.mWords.size()),
+        sajson::mutable_string_view(size, g_JSONArena.mText.data()));
+    // Process the nodes that were parsed from the string
+    const SQInteger r = document.is_valid() ? SqFromJson_Push(vm, document.get_root()) :
+                                              sq_throwerror(vm, document.get_error_message_as_cstring());
+    // Don't hold on to the memory of unusually large documents
+    if (size > JSON_ARENA_LIMIT)
+    {
+        std::vector< size_t >().swap(g_JSONArena.mWords);
+        std::vector< char >().swap(g_JSONArena.mText);
+    }
+    // We either have a value to return or we propagate some error
+    return SQ_SUCCEEDED(r) ? 1 : r;
+}
+
 // ------------------------------------------------------------------------------------------------
 static SQInteger SqFromJSON(HSQUIRRELVM vm) noexcept
 {
@@ -136,33 +176,15 @@ static SQInteger SqFromJSON(HSQUIRRELVM vm) noexcept
     {
         return s.mRes; // Propagate the error
     }
-    // Attempt to parse the specified JSON string
-    const sajson::document & document = sajson::parse(sajson::dynamic_allocation(), sajson::string(s.mPtr, static_cast<size_t>(s.mLen)));
-    // See if there was an error
-    if (!document.is_valid())
-    {
-        return sq_throwerror(vm, document.get_error_message_as_cstring());
-    }
-    // Process the nodes that were parsed from the string
-    SQInteger r = SqFromJson_Push(vm, document.get_root());
-    // We either have a value to return or we propagate some error
-    return SQ_SUCCEEDED(r) ? 1 : r;
+    // Parse the specified JSON string
+    return SqFromJSON_Parse(vm, s.mPtr, static_cast< size_t >(s.mLen));
 }
 
 // ------------------------------------------------------------------------------------------------
 SQInteger SqFromNativeJSON(HSQUIRRELVM vm, const char * data, size_t size)
 {
-    // Attempt to parse the specified JSON string
-    const sajson::document & document = sajson::parse(sajson::dynamic_allocation(), sajson::string(data, size));
-    // See if there was an error
-    if (!document.is_valid())
-    {
-        return sq_throwerror(vm, document.get_error_message_as_cstring());
-    }
-    // Process the nodes that were parsed from the string
-    SQInteger r = SqFromJson_Push(vm, document.get_root());
-    // We either have a value to return or we propagate some error
-    return SQ_SUCCEEDED(r) ? 1 : r;
+    // Parse the specified JSON string
+    return SqFromJSON_Parse(vm, data, size);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -193,6 +215,8 @@ CtxJSON & CtxJSON::CloseArray()
     mOutput.push_back(',');
     // Go back one level
     Retreat();
+    // Stream what was written so far, if necessary
+    Stream();
     // Allow chaining
     return *this;
 }
@@ -242,6 +266,8 @@ CtxJSON & CtxJSON::CloseObject()
     mOutput.push_back(',');
     // Go back one level
     Retreat();
+    // Stream what was written so far, if necessary
+    Stream();
     // Allow chaining
     return *this;
 }
@@ -310,6 +336,8 @@ SQRESULT CtxJSON::SerializeParams(HSQUIRRELVM vm)
     // Clear the output buffer if necessary
     mOutput.clear();
     mDepth = 0;
+    mStreamed = 0;
+    mStreamFailed = false;
     // Fetch the number of objects on the stack
     const auto top = sq_gettop(vm);
     // If there's more than one argument then they all get wrapped inside an array
@@ -337,12 +365,28 @@ SQRESULT CtxJSON::SerializeParams(HSQUIRRELVM vm)
         CloseArray();
     }
     // Remove trailing separator, if any
-    if (mOutput.back() == ',')
+    if (!mOutput.empty() && mOutput.back() == ',')
     {
         mOutput.pop_back();
     }
-    // Push the output string on the stack
-    sq_pushstring(vm, mOutput.c_str(), static_cast< SQInteger >(mOutput.size()));
+    // Is the output streamed somewhere?
+    if (IsStreaming())
+    {
+        // Stream the remaining output
+        Flush(mOutput.size());
+        // Did any of the writes fail?
+        if (mStreamFailed)
+        {
+            return sq_throwerror(vm, _SC("Unable to stream the JSON output"));
+        }
+        // Push the amount of streamed output on the stack
+        sq_pushinteger(vm, static_cast< SQInteger >(mStreamed));
+    }
+    else
+    {
+        // Push the output string on the stack
+        sq_pushstring(vm, mOutput.c_str(), static_cast< SQInteger >(mOutput.size()));
+    }
     // Specify that we have a value on the stack
     return 1;
 }
@@ -436,6 +480,8 @@ SQRESULT CtxJSON::SerializeAt(HSQUIRRELVM vm, SQInteger idx) // NOLINT(misc-no-r
         case OT_OUTER:
             return sq_throwerrorf(vm, _SC("Type (%s) is not serializable"), SqTypeName(sq_gettype(vm, 2)));
     }
+    // Stream what was written so far, if necessary
+    Stream();
     // Serialization was successful
     return SQ_OK;
 }
@@ -685,8 +731,11 @@ void CtxJSON::PushString(const SQChar * str)
     mOutput.append(str);
     mOutput.push_back('"');
     mOutput.push_back(',');
-    // Allow the hook to know
-    mString.assign(str);
+    // Allow the hook to know, if any
+    if (mKeyHook)
+    {
+        mString.assign(str);
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -696,34 +745,127 @@ void CtxJSON::PushString(const SQChar * str, size_t length)
     mOutput.append(str, length);
     mOutput.push_back('"');
     mOutput.push_back(',');
-    // Allow the hook to know
-    mString.assign(str, length);
+    // Allow the hook to know, if any
+    if (mKeyHook)
+    {
+        mString.assign(str, length);
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
-static SQInteger SqToJSON(HSQUIRRELVM vm) noexcept
+CtxJSON & CtxJSON::StreamToBuffer(SqBuffer & buffer)
+{
+    // The buffer must be allowed to grow
+    buffer.ValidateWritable();
+    // Stop any previous stream
+    StopStream();
+    // Stream into the specified buffer
+    mBuffer = buffer.GetRef();
+    // Allow chaining
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+CtxJSON & CtxJSON::StreamToFile(StackStrF & path)
+{
+    // Validate the specified path
+    if (path.mLen <= 0)
+    {
+        STHROWF("Invalid file path");
+    }
+    // Attempt to open the specified file
+    std::FILE * file = std::fopen(path.mPtr, "wb");
+    // Validate the file handle
+    if (!file)
+    {
+        STHROWF("Unable to open file: {}", path.mPtr);
+    }
+    // Stop any previous stream
+    StopStream();
+    // Stream into the specified file
+    mFile.reset(file, &std::fclose);
+    // Allow chaining
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+CtxJSON & CtxJSON::StopStream()
+{
+    // Write the file contents, if any
+    if (mFile)
+    {
+        std::fflush(mFile.get());
+    }
+    // Forget about the streams
+    mBuffer.Reset();
+    mFile.reset();
+    // Allow chaining
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+void CtxJSON::Flush(size_t n) noexcept
+{
+    // Is there anything to stream?
+    if (n == 0 || mStreamFailed)
+    {
+        return;
+    }
+    // Write to the buffer, if any
+    else if (mBuffer)
+    {
+        try
+        {
+            mBuffer->Append(mOutput.data(), static_cast< Buffer::SzType >(n));
+        }
+        catch (...)
+        {
+            mStreamFailed = true;
+        }
+    }
+    // Write to the file, if any
+    else if (mFile && std::fwrite(mOutput.data(), 1, n, mFile.get()) != n)
+    {
+        mStreamFailed = true;
+    }
+    // Remove the streamed output
+    mOutput.erase(0, n);
+    // Keep track of how much was streamed
+    mStreamed += n;
+}
+
+// ------------------------------------------------------------------------------------------------
+static size_t g_JSONOutputHint = 0; // Size of the last generated output. Used to reserve memory upfront.
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqToJSON_Serialize(HSQUIRRELVM vm, bool ooa) noexcept
 {
     // Make sure the instance is cleaned up even in the case of exceptions
-    DeleteGuard< CtxJSON > sq_dg(new CtxJSON());
+    DeleteGuard< CtxJSON > sq_dg(new CtxJSON(ooa));
     // Remember the instance, so we don't have to cast the script object back
     auto ctx = sq_dg.Get();
+    // Outputs are usually similar in size
+    ctx->mOutput.reserve(g_JSONOutputHint);
     // Turn it into a script object because it may be passed as a parameter to `_tojson` meta-methods
     LightObj obj(sq_dg, vm);
     // Proceed with the serialization
-    return ctx->SerializeParams(vm);
+    const SQRESULT r = ctx->SerializeParams(vm);
+    // Remember the size of the output for next time
+    g_JSONOutputHint = ctx->mOutput.size();
+    // Propagate the result
+    return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqToJSON(HSQUIRRELVM vm) noexcept
+{
+    return SqToJSON_Serialize(vm, true);
 }
 
 // ------------------------------------------------------------------------------------------------
 static SQInteger SqToCompactJSON(HSQUIRRELVM vm) noexcept
 {
-    // Make sure the instance is cleaned up even in the case of exceptions
-    DeleteGuard< CtxJSON > sq_dg(new CtxJSON(false));
-    // Remember the instance, so we don't have to cast the script object back
-    auto ctx = sq_dg.Get();
-    // Turn it into a script object because it may be passed as a parameter to `_tojson` meta-methods
-    LightObj obj(sq_dg, vm);
-    // Proceed with the serialization
-    return ctx->SerializeParams(vm);
+    return SqToJSON_Serialize(vm, false);
 }
 
 // ================================================================================================
@@ -744,6 +886,10 @@ void Register_JSON(HSQUIRRELVM vm)
         // Properties
         .Prop(_SC("Output"), &CtxJSON::GetOutput)
         .Prop(_SC("Depth"), &CtxJSON::GetDepth)
+        .Prop(_SC("Capacity"), &CtxJSON::GetCapacity)
+        .Prop(_SC("ChunkSize"), &CtxJSON::GetChunkSize, &CtxJSON::SetChunkSize)
+        .Prop(_SC("Streamed"), &CtxJSON::GetStreamed)
+        .Prop(_SC("Streaming"), &CtxJSON::IsStreaming)
         .Prop(_SC("OOA"), &CtxJSON::GetObjectOverArray, &CtxJSON::SetObjectOverArray)
         .Prop(_SC("ObjectOverArray"), &CtxJSON::GetObjectOverArray, &CtxJSON::SetObjectOverArray)
         // Member Methods
@@ -758,6 +904,10 @@ void Register_JSON(HSQUIRRELVM vm)
         .FmtFunc(_SC("PushKey"), &CtxJSON::PushKey)
         .Func(_SC("SetOOA"), &CtxJSON::SetObjectOverArray)
         .Func(_SC("SetObjectOverArray"), &CtxJSON::SetObjectOverArray)
+        .Func(_SC("Reserve"), &CtxJSON::Reserve)
+        .Func(_SC("StreamToBuffer"), &CtxJSON::StreamToBuffer)
+        .FmtFunc(_SC("StreamToFile"), &CtxJSON::StreamToFile)
+        .Func(_SC("StopStream"), &CtxJSON::StopStream)
     );
 }
 
@@ -5,6 +5,8 @@
 #include "Library/IO/Buffer.hpp"
 
 // ------------------------------------------------------------------------------------------------
+#include <memory>
+#include <cstdio>
 #include <functional>
 
 // ------------------------------------------------------------------------------------------------
@@ -51,6 +53,31 @@ struct CtxJSON
     */
     std::function< void(CtxJSON&) > mKeyHook{};
 
+    /* --------------------------------------------------------------------------------------------
+     * Buffer where the output is streamed to, if any.
+    */
+    SharedPtr< Buffer > mBuffer{};
+
+    /* --------------------------------------------------------------------------------------------
+     * File where the output is streamed to, if any.
+    */
+    std::shared_ptr< std::FILE > mFile{};
+
+    /* --------------------------------------------------------------------------------------------
+     * How much output to accumulate before it is streamed.
+    */
+    size_t mChunkSize{4096};
+
+    /* --------------------------------------------------------------------------------------------
+     * How much output was streamed since the last serialization.
+    */
+    size_t mStreamed{0};
+
+    /* --------------------------------------------------------------------------------------------
+     * Whether streaming failed since the last serialization.
+    */
+    bool mStreamFailed{false};
+
     /* --------------------------------------------------------------------------------------------
      * Default constructor.
     */
@@ -118,6 +145,88 @@ struct CtxJSON
         return mOutput;
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the capacity of the output string.
+    */
+    SQMOD_NODISCARD SQInteger GetCapacity() const noexcept
+    {
+        return static_cast< SQInteger >(mOutput.capacity());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Make sure the output string can hold the specified amount of characters without growing.
+    */
+    CtxJSON & Reserve(SQInteger n)
+    {
+        mOutput.reserve(ClampL< SQInteger, size_t >(n));
+        // Allow chaining
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve how much output to accumulate before it is streamed.
+    */
+    SQMOD_NODISCARD SQInteger GetChunkSize() const noexcept
+    {
+        return static_cast< SQInteger >(mChunkSize);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify how much output to accumulate before it is streamed.
+    */
+    void SetChunkSize(SQInteger n)
+    {
+        // Keep the trailing characters that may still be modified
+        mChunkSize = static_cast< size_t >(std::max< SQInteger >(n, 16));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve how much output was streamed since the last serialization.
+    */
+    SQMOD_NODISCARD SQInteger GetStreamed() const noexcept
+    {
+        return static_cast< SQInteger >(mStreamed);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * See whether the output is streamed somewhere.
+    */
+    SQMOD_NODISCARD bool IsStreaming() const noexcept
+    {
+        return mBuffer || mFile;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Stream the output into the specified buffer, starting at its current cursor.
+    */
+    CtxJSON & StreamToBuffer(SqBuffer & buffer);
+
+    /* --------------------------------------------------------------------------------------------
+     * Stream the output into the file at the specified path. The file is truncated.
+    */
+    CtxJSON & StreamToFile(StackStrF & path);
+
+    /* --------------------------------------------------------------------------------------------
+     * Stop streaming the output and close the associated file, if any.
+    */
+    CtxJSON & StopStream();
+
+    /* --------------------------------------------------------------------------------------------
+     * Stream the output if enough of it was accumulated. Keeps the characters that may still change.
+    */
+    void Stream()
+    {
+        if (mOutput.size() >= mChunkSize && IsStreaming())
+        {
+            Flush(mOutput.size() - 2);
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Stream the specified amount of characters from the beginning of the output.
+    */
+    void Flush(size_t n) noexcept;
+
     /* --------------------------------------------------------------------------------------------
      * Retrieve the current depth.
     */
@@ -3,6 +3,7 @@
 
 // ------------------------------------------------------------------------------------------------
 #include <sqratConst.h>
+#include <mysql/errmsg.h>
 
 // ------------------------------------------------------------------------------------------------
 #include <cstdio>
@@ -3175,6 +3176,485 @@ void MySQLStatement::SetNull(uint32_t idx) const
     m_Handle->mBinds[idx].SetInput(MYSQL_TYPE_NULL, &(m_Handle->mMyBinds[idx]));
 }
 
+// ------------------------------------------------------------------------------------------------
+void MySQLRows::Assign(MYSQL_RES * res)
+{
+    // Obtain the number of columns
+    const unsigned int n = mysql_num_fields(res);
+    // Obtain the column information
+    MYSQL_FIELD * fields = mysql_fetch_fields(res);
+    // Copy the column information
+    mColumns.reserve(n);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        mColumns.push_back(Column{String(fields[i].name, fields[i].name_length), fields[i].type});
+    }
+    // Reserve space for all values upfront
+    mCells.reserve(static_cast< size_t >(mysql_num_rows(res)) * n);
+    // Copy the values of each row
+    for (MYSQL_ROW row = mysql_fetch_row(res); row != nullptr; row = mysql_fetch_row(res))
+    {
+        // Obtain the length of each value in this row
+        const unsigned long * lengths = mysql_fetch_lengths(res);
+        // Copy each value in this row
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            // Is this value null?
+            if (row[i] == nullptr)
+            {
+                mCells.push_back(Cell{0, NULL_CELL});
+                // Nothing to copy
+                continue;
+            }
+            // Remember where this value begins
+            mCells.push_back(Cell{static_cast< uint32_t >(mData.size()), static_cast< uint32_t >(lengths[i])});
+            // Copy the value and the null terminator
+            mData.insert(mData.end(), row[i], row[i] + lengths[i]);
+            mData.push_back('\0');
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger MySQLRows::GetColumnIndex(StackStrF & name) const
+{
+    // Look for a column with the specified name
+    for (size_t i = 0; i < mColumns.size(); ++i)
+    {
+        if (mColumns[i].mName.size() == static_cast< size_t >(name.mLen) &&
+            mColumns[i].mName.compare(0, String::npos, name.mPtr, static_cast< size_t >(name.mLen)) == 0)
+        {
+            return static_cast< SQInteger >(i);
+        }
+    }
+    // No such column
+    return -1;
+}
+
+// ------------------------------------------------------------------------------------------------
+Array MySQLRows::GetColumns() const
+{
+    Array arr(SqVM(), static_cast< SQInteger >(mColumns.size()));
+    // Populate the array with the column names
+    for (size_t i = 0; i < mColumns.size(); ++i)
+    {
+        arr.SetValue(static_cast< SQInteger >(i), mColumns[i].mName);
+    }
+    // Return the resulted array
+    return arr;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MySQLRows::PushValue(HSQUIRRELVM vm, size_t row, size_t col) const
+{
+    // Grab the cell
+    const Cell & c = mCells[row * mColumns.size() + col];
+    // Is this value null?
+    if (c.mLength == NULL_CELL)
+    {
+        sq_pushnull(vm);
+        // Nothing else to do
+        return;
+    }
+    // Grab the value
+    const SQChar * value = mData.data() + c.mOffset;
+    // Grab the column type
+    const enum_field_types type = mColumns[col].mType;
+    // Identify the best matching script type
+    switch (type)
+    {
+        case MYSQL_TYPE_TINY:
+        case MYSQL_TYPE_SHORT:
+        case MYSQL_TYPE_LONG:
+        case MYSQL_TYPE_INT24:
+        case MYSQL_TYPE_LONGLONG:
+        case MYSQL_TYPE_YEAR:
+            sq_pushinteger(vm, static_cast< SQInteger >(DbConvTo< int64_t >::From(value, c.mLength, type)));
+        break;
+        case MYSQL_TYPE_FLOAT:
+        case MYSQL_TYPE_DOUBLE:
+            sq_pushfloat(vm, static_cast< SQFloat >(DbConvTo< double >::From(value, c.mLength, type)));
+        break;
+        default:
+            sq_pushstring(vm, value, static_cast< SQInteger >(c.mLength));
+        break;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+LightObj MySQLRows::GetValue(SQInteger row, SQInteger col) const
+{
+    // Validate the location
+    [[maybe_unused]] const Cell & c = At(row, col);
+    // Push the value on the stack
+    PushValue(SqVM(), static_cast< size_t >(row), static_cast< size_t >(col));
+    // Obtain it from the stack
+    LightObj o(-1, SqVM());
+    // Remove it from the stack
+    sq_poptop(SqVM());
+    // Return the value
+    return o;
+}
+
+// ------------------------------------------------------------------------------------------------
+LightObj MySQLRows::GetString(SQInteger row, SQInteger col) const
+{
+    // Grab the cell
+    const Cell & c = At(row, col);
+    // Is this value null?
+    if (c.mLength == NULL_CELL)
+    {
+        return LightObj{};
+    }
+    // Return the value as is
+    return LightObj(mData.data() + c.mOffset, static_cast< SQInteger >(c.mLength));
+}
+
+// ------------------------------------------------------------------------------------------------
+Table MySQLRows::GetRow(SQInteger row) const
+{
+    // Validate the row index
+    [[maybe_unused]] const Cell & c = At(row, 0);
+    // Create the table
+    Table tbl(SqVM(), static_cast< SQInteger >(mColumns.size()));
+    // Populate the table with the row values
+    for (size_t i = 0; i < mColumns.size(); ++i)
+    {
+        // Push the table, key and value on the stack
+        sq_pushobject(SqVM(), tbl.GetObj());
+        sq_pushstring(SqVM(), mColumns[i].mName.c_str(), static_cast< SQInteger >(mColumns[i].mName.size()));
+        PushValue(SqVM(), static_cast< size_t >(row), i);
+        // Insert the value and remove the table from the stack
+        sq_newslot(SqVM(), -3, SQFalse);
+        sq_poptop(SqVM());
+    }
+    // Return the resulted table
+    return tbl;
+}
+
+// ------------------------------------------------------------------------------------------------
+Array MySQLRows::GetRows() const
+{
+    // Obtain the number of rows
+    const SQInteger n = RowCount();
+    // Create the array
+    Array arr(SqVM(), n);
+    // Populate the array with the rows
+    for (SQInteger i = 0; i < n; ++i)
+    {
+        arr.SetValue(i, GetRow(i));
+    }
+    // Return the resulted array
+    return arr;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Query that is executed in a worker thread with one of the pool connections.
+*/
+struct MySQLPoolTask : public ThreadPoolItem
+{
+    // --------------------------------------------------------------------------------------------
+    MySQLPoolRef    mPool{}; // The pool that owns the connection.
+    MySQLConnRef    mConn{}; // The connection used to execute the query.
+    // --------------------------------------------------------------------------------------------
+    String          mQuery{}; // The query string that will be executed.
+    Function        mResolved{}; // Callback to invoke when the query succeeded.
+    Function        mRejected{}; // Callback to invoke when the query failed.
+    bool            mWantRows{false}; // Whether the returned rows should be retrieved.
+    // --------------------------------------------------------------------------------------------
+    MySQLRows       mRows{}; // Rows returned by the query, if any.
+    uint32_t        mErrNo{0}; // Error code, if any.
+    String          mErrStr{}; // Error message, if any.
+
+    /* --------------------------------------------------------------------------------------------
+     * Provide a name to what type of task this is. Mainly for debugging purposes.
+    */
+    SQMOD_NODISCARD const char * TypeName() noexcept override { return "mysql pool query"; }
+
+    /* --------------------------------------------------------------------------------------------
+     * Provide unique information that may help identify the task. Mainly for debugging purposes.
+    */
+    SQMOD_NODISCARD const char * IdentifiableInfo() noexcept override { return mQuery.c_str(); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Database queries are processed before other tasks.
+    */
+    SQMOD_NODISCARD ThreadPoolLane Lane() noexcept override { return TPLANE_HIGH; }
+
+    /* --------------------------------------------------------------------------------------------
+     * Invoked in worker thread by the thread pool after obtaining the task from the queue.
+    */
+    SQMOD_NODISCARD bool OnPrepare() override
+    {
+        // Every thread that uses the client library must be initialized
+        if (mysql_thread_init() != 0)
+        {
+            mErrNo = CR_UNKNOWN_ERROR;
+            mErrStr.assign("Unable to initialize the MySQL client library for this thread");
+            // Skip processing
+            return false;
+        }
+        // Proceed with the query
+        return true;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Called in worker by the thread pool to perform the query.
+    */
+    SQMOD_NODISCARD bool OnProcess() override
+    {
+        try
+        {
+            // Connect on first use or after the connection was lost
+            if (!mConn->mPtr)
+            {
+                mConn->Create(mPool->mAccount);
+            }
+            // Attempt to execute the query
+            if (mysql_real_query(mConn->mPtr, mQuery.data(), static_cast< unsigned long >(mQuery.size())) != 0)
+            {
+                Fail();
+                // Nothing else to do
+                return false;
+            }
+            // Process every result produced by the query
+            for (int32_t status = 0; status == 0; status = mysql_next_result(mConn->mPtr))
+            {
+                // Attempt to retrieve a buffered result set
+                MYSQL_RES * res = mysql_store_result(mConn->mPtr);
+                // Did the query return rows?
+                if (res != nullptr)
+                {
+                    // Keep the first result set, if requested
+                    if (mWantRows && mRows.mColumns.empty())
+                    {
+                        mRows.Assign(res);
+                    }
+                    // Release the result set
+                    mysql_free_result(res);
+                }
+                // Non SELECT queries should have a field count of 0
+                else if (mysql_field_count(mConn->mPtr) == 0)
+                {
+                    mRows.mAffected += mysql_affected_rows(mConn->mPtr);
+                    mRows.mInsertId = mysql_insert_id(mConn->mPtr);
+                }
+                // Failed to retrieve the result set
+                else
+                {
+                    Fail();
+                    // Nothing else to do
+                    return false;
+                }
+            }
+            // Was there an error with any of the following results?
+            if (mysql_errno(mConn->mPtr) != 0)
+            {
+                Fail();
+            }
+        }
+        catch (const std::exception & e)
+        {
+            mErrNo = mConn->mErrNo ? mConn->mErrNo : CR_UNKNOWN_ERROR;
+            mErrStr.assign(e.what());
+            // Make sure a new connection is attempted next time
+            mConn->Disconnect();
+        }
+        // Don't retry
+        return false;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Invoked in main thread by the thread pool after the task was completed.
+    */
+    SQMOD_NODISCARD bool OnCompleted(bool stop) override
+    {
+        // Give the connection back to the pool and start the next query, if any
+        mPool->Release(std::move(mConn), stop);
+        // Let the script know about the outcome
+        Finish();
+        // Don't re-queue
+        return false;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Called by the thread pool to let the task know that it will be aborted before it was processed.
+     * Most likely due to a shutdown of the thread pool.
+    */
+    void OnAborted(bool SQ_UNUSED_ARG(retry)) override
+    {
+        mErrNo = CR_UNKNOWN_ERROR;
+        mErrStr.assign("Query was aborted before it could be executed");
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Invoke the callback that matches the outcome of the query.
+    */
+    void Finish()
+    {
+        // Did the query succeed?
+        if (mErrNo == 0)
+        {
+            if (!mResolved.IsNull())
+            {
+                // Are the rows requested?
+                if (mWantRows)
+                {
+                    mResolved(LightObj(SqTypeIdentity< MySQLRows >{}, SqVM(), std::move(mRows)));
+                }
+                else
+                {
+                    mResolved(static_cast< SQInteger >(mRows.mAffected), static_cast< SQInteger >(mRows.mInsertId));
+                }
+            }
+        }
+        else if (!mRejected.IsNull())
+        {
+            mRejected(static_cast< SQInteger >(mErrNo), mErrStr, mQuery);
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Save the current error of the connection.
+    */
+    void Fail()
+    {
+        mErrNo = mysql_errno(mConn->mPtr);
+        mErrStr.assign(mysql_error(mConn->mPtr));
+        // Client errors usually mean the connection is no longer usable
+        if (mErrNo >= CR_MIN_ERROR && mErrNo <= CR_MAX_ERROR)
+        {
+            mConn->Disconnect();
+        }
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+MySQLPoolHnd::MySQLPoolHnd(const MySQLAccount & acc, uint32_t size)
+    : mAccount(acc), mIdle(), mBacklog(), mSize(size), mBusy(0)
+{
+    // Connections will be created on demand
+    mIdle.reserve(size);
+}
+
+// ------------------------------------------------------------------------------------------------
+void MySQLPoolHnd::Submit(Task && task)
+{
+    // Are all connections in use?
+    if (mBusy >= mSize)
+    {
+        mBacklog.push(std::move(task));
+        // Wait for a connection to become available
+        return;
+    }
+    auto * t = static_cast< MySQLPoolTask * >(task.get());
+    // Reuse an idle connection or create a new one
+    if (mIdle.empty())
+    {
+        t->mConn = MySQLConnRef(new MySQLConnHnd());
+    }
+    else
+    {
+        t->mConn = std::move(mIdle.back());
+        mIdle.pop_back();
+    }
+    // The connection is now in use
+    ++mBusy;
+    // Hand the query to a worker
+    ThreadPool::Get().Enqueue(std::move(task));
+}
+
+// ------------------------------------------------------------------------------------------------
+void MySQLPoolHnd::Release(MySQLConnRef && conn, bool stop)
+{
+    // The connection is no longer in use
+    --mBusy;
+    mIdle.push_back(std::move(conn));
+    // Is the thread pool shutting down?
+    if (stop)
+    {
+        std::queue< Task > backlog;
+        // Take the queries that will never get a connection (they also hold a reference to this pool)
+        backlog.swap(mBacklog);
+        // Reject them one by one
+        for (; !backlog.empty(); backlog.pop())
+        {
+            auto * t = static_cast< MySQLPoolTask * >(backlog.front().get());
+            // Mark it as aborted and let the script know
+            t->OnAborted(false);
+            t->Finish();
+        }
+    }
+    // Start the next query, if any
+    else if (!mBacklog.empty())
+    {
+        Task task = std::move(mBacklog.front());
+        mBacklog.pop();
+        // Hand it to the pool
+        Submit(std::move(task));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+MySQLPool::MySQLPool(const MySQLAccount & acc, SQInteger size)
+    : m_Handle()
+{
+    // Validate the number of connections
+    if (size <= 0 || size > static_cast< SQInteger >(MAX_WORKER_THREADS))
+    {
+        STHROWF("Invalid number of connections ({}). Must be between 1 and {}", size, MAX_WORKER_THREADS);
+    }
+    // The client library must be initialized before any worker thread can use it
+    if (mysql_library_init(0, nullptr, nullptr) != 0)
+    {
+        STHROWF("Unable to initialize the MySQL client library");
+    }
+    // Create the pool handle
+    m_Handle = MySQLPoolRef(new MySQLPoolHnd(acc, static_cast< uint32_t >(size)));
+}
+
+// ------------------------------------------------------------------------------------------------
+void MySQLPool::Submit(const SQChar * query, Function & resolved, Function & rejected, bool rows)
+{
+    // Make sure the specified query is valid
+    if (!query || *query == '\0')
+    {
+        STHROWF("Invalid or empty MySQL query");
+    }
+    // Queries would never complete without worker threads
+    else if (ThreadPool::Get().GetThreadCount() == 0)
+    {
+        STHROWF("Asynchronous MySQL queries require worker threads");
+    }
+    auto * item = new MySQLPoolTask();
+    // Take ownership before any exception can be thrown
+    MySQLPoolHnd::Task task{static_cast< ThreadPoolItem * >(item)};
+    // Populate task information
+    item->mPool = m_Handle;
+    item->mQuery.assign(query);
+    item->mResolved = std::move(resolved);
+    item->mRejected = std::move(rejected);
+    item->mWantRows = rows;
+    // Submit the task
+    m_Handle->Submit(std::move(task));
+}
+
+// ------------------------------------------------------------------------------------------------
+MySQLPool & MySQLPool::Execute(const SQChar * query, Function & resolved, Function & rejected)
+{
+    Submit(query, resolved, rejected, false);
+    // Allow chaining
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+MySQLPool & MySQLPool::Query(const SQChar * query, Function & resolved, Function & rejected)
+{
+    Submit(query, resolved, rejected, true);
+    // Allow chaining
+    return *this;
+}
+
 // ================================================================================================
 void Register_MySQL(HSQUIRRELVM vm)
 {
@@ -3393,6 +3873,39 @@ void Register_MySQL(HSQUIRRELVM vm)
         .Func(_SC("SetNull"), &MySQLStatement::SetNull)
     );
 
+    sqlns.Bind(_SC("Rows")
+        , Class< MySQLRows, NoCopy< MySQLRows > >(sqlns.GetVM(), _SC("SqMySQLRows"))
+        // Constructors
+        .Ctor()
+        // Properties
+        .Prop(_SC("RowCount"), &MySQLRows::RowCount)
+        .Prop(_SC("ColumnCount"), &MySQLRows::ColumnCount)
+        .Prop(_SC("Affected"), &MySQLRows::GetAffected)
+        .Prop(_SC("InsertId"), &MySQLRows::GetInsertId)
+        .Prop(_SC("Columns"), &MySQLRows::GetColumns)
+        .Prop(_SC("Rows"), &MySQLRows::GetRows)
+        // Member Methods
+        .Func(_SC("ColumnName"), &MySQLRows::GetColumnName)
+        .FmtFunc(_SC("ColumnIndex"), &MySQLRows::GetColumnIndex)
+        .Func(_SC("IsNull"), &MySQLRows::IsNull)
+        .Func(_SC("Get"), &MySQLRows::GetValue)
+        .Func(_SC("GetString"), &MySQLRows::GetString)
+        .Func(_SC("GetRow"), &MySQLRows::GetRow)
+    );
+
+    sqlns.Bind(_SC("Pool")
+        , Class< MySQLPool >(sqlns.GetVM(), _SC("SqMySQLPool"))
+        // Constructors
+        .Ctor< const MySQLAccount &, SQInteger >()
+        // Properties
+        .Prop(_SC("Size"), &MySQLPool::GetSize)
+        .Prop(_SC("Busy"), &MySQLPool::GetBusy)
+        .Prop(_SC("Backlog"), &MySQLPool::GetBacklog)
+        // Member Methods
+        .Func(_SC("Execute"), &MySQLPool::Execute)
+        .Func(_SC("Query"), &MySQLPool::Query)
+    );
+
     RootTable(vm).Bind(_SC("MySQL"), sqlns);
 }
 
@@ -3,6 +3,9 @@
 // ------------------------------------------------------------------------------------------------
 #include "Core/Utility.hpp"
 
+// ------------------------------------------------------------------------------------------------
+#include "Core/ThreadPool.hpp"
+
 // ------------------------------------------------------------------------------------------------
 #include "Library/IO/Buffer.hpp"
 #include "Library/Chrono.hpp"
@@ -16,6 +19,7 @@
 #include "Poco/Data/SessionImpl.h"
 
 // ------------------------------------------------------------------------------------------------
+#include <queue>
 #include <cstdbool>
 #include <unordered_map>
 
@@ -2724,4 +2728,318 @@ struct MySQLTransaction
     MySQLTransaction & operator = (MySQLTransaction && o) = default;
 };
 
+/* ------------------------------------------------------------------------------------------------
+ * Compact copy of a result set that was retrieved in a worker thread.
+*/
+class MySQLRows
+{
+public:
+
+    /* --------------------------------------------------------------------------------------------
+     * Information about a column in the result set.
+    */
+    struct Column
+    {
+        String              mName; // Name of the column.
+        enum_field_types    mType; // Type of the column.
+    };
+
+    /* --------------------------------------------------------------------------------------------
+     * Location of a value within the data buffer.
+    */
+    struct Cell
+    {
+        uint32_t    mOffset; // Where the value begins in the data buffer.
+        uint32_t    mLength; // Length of the value. NULL_CELL if the value is null.
+    };
+
+    // --------------------------------------------------------------------------------------------
+    static constexpr uint32_t NULL_CELL = UINT32_MAX; // Length used to identify null values.
+
+    // --------------------------------------------------------------------------------------------
+    std::vector< Column >   mColumns; // Columns of the result set.
+    std::vector< Cell >     mCells; // Values of every row, one after the other.
+    std::vector< char >     mData; // Null terminated contents of all values.
+
+    // --------------------------------------------------------------------------------------------
+    uint64_t    mAffected; // Number of rows affected by the query.
+    uint64_t    mInsertId; // Identifier generated for an AUTO_INCREMENT column, if any.
+
+    /* --------------------------------------------------------------------------------------------
+     * Default constructor.
+    */
+    MySQLRows()
+        : mColumns(), mCells(), mData(), mAffected(0), mInsertId(0)
+    {
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy constructor. (disabled)
+    */
+    MySQLRows(const MySQLRows & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move constructor.
+    */
+    MySQLRows(MySQLRows && o) = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy assignment operator. (disabled)
+    */
+    MySQLRows & operator = (const MySQLRows & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move assignment operator.
+    */
+    MySQLRows & operator = (MySQLRows && o) = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy the contents of a result set. Safe to be used from a worker thread.
+    */
+    void Assign(MYSQL_RES * res);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of rows.
+    */
+    SQMOD_NODISCARD SQInteger RowCount() const
+    {
+        return mColumns.empty() ? 0 : static_cast< SQInteger >(mCells.size() / mColumns.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of columns.
+    */
+    SQMOD_NODISCARD SQInteger ColumnCount() const
+    {
+        return static_cast< SQInteger >(mColumns.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of rows affected by the query.
+    */
+    SQMOD_NODISCARD SQInteger GetAffected() const
+    {
+        return static_cast< SQInteger >(mAffected);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the identifier generated for an AUTO_INCREMENT column, if any.
+    */
+    SQMOD_NODISCARD SQInteger GetInsertId() const
+    {
+        return static_cast< SQInteger >(mInsertId);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the name of a column.
+    */
+    SQMOD_NODISCARD const String & GetColumnName(SQInteger col) const
+    {
+        return mColumns[ValidColumn(col)].mName;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the index of a column by name. Returns -1 if there's no such column.
+    */
+    SQMOD_NODISCARD SQInteger GetColumnIndex(StackStrF & name) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the names of all columns.
+    */
+    SQMOD_NODISCARD Array GetColumns() const;
+
+    /* --------------------------------------------------------------------------------------------
+     * See if a value is null.
+    */
+    SQMOD_NODISCARD bool IsNull(SQInteger row, SQInteger col) const
+    {
+        return At(row, col).mLength == NULL_CELL;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve a value converted to the script type that best matches the column type.
+    */
+    SQMOD_NODISCARD LightObj GetValue(SQInteger row, SQInteger col) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve a value as a string.
+    */
+    SQMOD_NODISCARD LightObj GetString(SQInteger row, SQInteger col) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve a row as a table with column names as keys.
+    */
+    SQMOD_NODISCARD Table GetRow(SQInteger row) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve all rows as an array of tables.
+    */
+    SQMOD_NODISCARD Array GetRows() const;
+
+protected:
+
+    /* --------------------------------------------------------------------------------------------
+     * Validate a column index and return it.
+    */
+    SQMOD_NODISCARD size_t ValidColumn(SQInteger col) const
+    {
+        if (col < 0 || static_cast< size_t >(col) >= mColumns.size())
+        {
+            STHROWF("Column index ({}) is out of range ({})", col, mColumns.size());
+        }
+        return static_cast< size_t >(col);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the cell at the specified location.
+    */
+    SQMOD_NODISCARD const Cell & At(SQInteger row, SQInteger col) const
+    {
+        if (row < 0 || row >= RowCount())
+        {
+            STHROWF("Row index ({}) is out of range ({})", row, RowCount());
+        }
+        return mCells[static_cast< size_t >(row) * mColumns.size() + ValidColumn(col)];
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Push a value on the stack converted to the script type that best matches the column type.
+    */
+    void PushValue(HSQUIRRELVM vm, size_t row, size_t col) const;
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * The structure that holds the data associated with a pool of connections.
+*/
+struct MySQLPoolHnd
+{
+    // --------------------------------------------------------------------------------------------
+    typedef std::unique_ptr< ThreadPoolItem > Task; // Owning pointer to a queued query.
+
+    // --------------------------------------------------------------------------------------------
+    MySQLAccount                mAccount; // Account used to create the connections.
+    std::vector< MySQLConnRef > mIdle; // Connections that are not currently used by a query.
+    std::queue< Task >          mBacklog; // Queries waiting for a connection to become available.
+    uint32_t                    mSize; // Maximum number of connections.
+    uint32_t                    mBusy; // Number of connections currently used by a query.
+
+    /* --------------------------------------------------------------------------------------------
+     * Base constructor.
+    */
+    MySQLPoolHnd(const MySQLAccount & acc, uint32_t size);
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy constructor. (disabled)
+    */
+    MySQLPoolHnd(const MySQLPoolHnd & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move constructor. (disabled)
+    */
+    MySQLPoolHnd(MySQLPoolHnd && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy assignment operator. (disabled)
+    */
+    MySQLPoolHnd & operator = (const MySQLPoolHnd & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move assignment operator. (disabled)
+    */
+    MySQLPoolHnd & operator = (MySQLPoolHnd && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Hand the query to a worker if a connection is available or put it in the backlog otherwise.
+    */
+    void Submit(Task && task);
+
+    /* --------------------------------------------------------------------------------------------
+     * Take back a connection after a query completed and start the next query in the backlog.
+     * If the thread pool is shutting down then the queries in the backlog are rejected instead.
+    */
+    void Release(MySQLConnRef && conn, bool stop);
+};
+
+// ------------------------------------------------------------------------------------------------
+typedef SharedPtr< MySQLPoolHnd > MySQLPoolRef;
+
+/* ------------------------------------------------------------------------------------------------
+ * Executes queries asynchronously on the thread pool with a limited number of connections.
+*/
+class MySQLPool
+{
+private:
+
+    // --------------------------------------------------------------------------------------------
+    MySQLPoolRef m_Handle; // Reference to the actual pool.
+
+public:
+
+    /* --------------------------------------------------------------------------------------------
+     * Base constructor.
+    */
+    MySQLPool(const MySQLAccount & acc, SQInteger size);
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy constructor.
+    */
+    MySQLPool(const MySQLPool & o) = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move constructor.
+    */
+    MySQLPool(MySQLPool && o) = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy assignment operator.
+    */
+    MySQLPool & operator = (const MySQLPool & o) = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move assignment operator.
+    */
+    MySQLPool & operator = (MySQLPool && o) = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the maximum number of connections.
+    */
+    SQMOD_NODISCARD SQInteger GetSize() const
+    {
+        return static_cast< SQInteger >(m_Handle->mSize);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of connections currently used by a query.
+    */
+    SQMOD_NODISCARD SQInteger GetBusy() const
+    {
+        return static_cast< SQInteger >(m_Handle->mBusy);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of queries waiting for a connection.
+    */
+    SQMOD_NODISCARD SQInteger GetBacklog() const
+    {
+        return static_cast< SQInteger >(m_Handle->mBacklog.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Execute a query and receive the number of affected rows and the last insert identifier.
+    */
+    MySQLPool & Execute(const SQChar * query, Function & resolved, Function & rejected);
+
+    /* --------------------------------------------------------------------------------------------
+     * Execute a query and receive the returned rows.
+    */
+    MySQLPool & Query(const SQChar * query, Function & resolved, Function & rejected);
+
+protected:
+
+    /* --------------------------------------------------------------------------------------------
+     * Create the task and hand it to the pool.
+    */
+    void Submit(const SQChar * query, Function & resolved, Function & rejected, bool rows);
+};
+
 } // Namespace:: SqMod
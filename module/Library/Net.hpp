@@ -31,10 +31,15 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
         char * mData{nullptr};
 
         /* ----------------------------------------------------------------------------------------
-         * Frame data capacity.
+         * Frame data size.
         */
         uint32_t mSize{0};
 
+        /* ----------------------------------------------------------------------------------------
+         * Frame data capacity.
+        */
+        uint32_t mCapacity{0};
+
         /* ----------------------------------------------------------------------------------------
          * Frame flags.
         */
@@ -49,13 +54,13 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
          * Explicit constructor.
         */
         Frame(char * data, size_t size, int flags)
-            : mData(nullptr), mSize(static_cast< uint32_t >(size)), mFlags(flags)
+            : mData(nullptr), mSize(static_cast< uint32_t >(size)), mCapacity(mSize), mFlags(flags)
         {
             // Do we need to allocate a buffer?
             if (mSize != 0)
             {
-                // Allocate the memory buffer.
-                mData = new char[mSize];
+                // Obtain the memory buffer from the buffer pool of this thread
+                mData = Buffer::Acquire(mCapacity);
                 // Copy the data into the buffer we own
                 std::memcpy(mData, data, mSize);
             }
@@ -76,7 +81,11 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
         */
         ~Frame()
         {
-            delete[] mData;
+            // Give the memory back to the buffer pool
+            if (mData != nullptr)
+            {
+                Buffer::Recycle(mData, mCapacity);
+            }
         }
 
         /* ----------------------------------------------------------------------------------------
@@ -96,6 +105,7 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
         {
             mData = nullptr;
             mSize = 0;
+            mCapacity = 0;
         }
     };
 
@@ -723,7 +733,7 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
             if (mQueue.try_dequeue(frame) && !mOnData.IsNull())
             {
                 // Obtain a buffer from the frame
-                Buffer b(frame->mData, frame->mSize, frame->mSize, Buffer::OwnIt{});
+                Buffer b(frame->mData, frame->mCapacity, frame->mSize, Buffer::OwnIt{});
                 // Backup the frame size before forgetting about it
                 const SQInteger size = static_cast< SQInteger >(frame->mSize);
                 // Take ownership of the memory
@@ -611,6 +611,9 @@ SQLiteConnHnd::SQLiteConnHnd()
     , mFlags(0)
     , mName()
     , mVFS()
+    , mStmtCache()
+    , mStmtIndex()
+    , mStmtLimit(64)
     , mSession()
     , mMemory(false)
     , mTrace(false)
@@ -645,6 +648,8 @@ SQLiteConnHnd::~SQLiteConnHnd()
     {
         // Flush remaining queries in the queue and ignore the result
         Flush(static_cast<uint32_t>(mQueue.size()), NullObject(), NullFunction());
+        // Cached statements would prevent the database from closing
+        TrimStmtCache(0);
         // NOTE: Should we call sqlite3_interrupt(...) before closing?
         // Attempt to close the database
         // If this connection is a pooled session then let it clean itself up
@@ -785,6 +790,94 @@ int32_t SQLiteConnHnd::Flush(uint32_t num, Object & env, Function & func)
     return -1;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool SQLiteConnHnd::AcquireStmt(SQLiteStmtHnd & stmt, size_t hash)
+{
+    // Look for statements prepared from a query string with the same hash
+    auto range = mStmtIndex.equal_range(hash);
+    // Find the one with the exact same query string
+    for (auto itr = range.first; itr != range.second; ++itr)
+    {
+        // Grab the cached statement
+        CachedStmt & cs = *(itr->second);
+        // Is this the same query? (hashes can collide)
+        if (cs.mQuery != stmt.mQuery)
+        {
+            continue;
+        }
+        // Hand over the statement resources
+        stmt.mPtr = cs.mPtr;
+        stmt.mColumns = cs.mColumns;
+        stmt.mParameters = cs.mParameters;
+        stmt.mIndexes = std::move(cs.mIndexes);
+        stmt.mStatus = SQLITE_OK;
+        // The statement is no longer available to others
+        mStmtCache.erase(itr->second);
+        mStmtIndex.erase(itr);
+        // Found one
+        return true;
+    }
+    // Nothing to reuse
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool SQLiteConnHnd::RecycleStmt(SQLiteStmtHnd & stmt)
+{
+    // Is the cache enabled and is there anything to recycle?
+    if (!mStmtLimit || !mPtr || !stmt.mPtr || stmt.mQuery.empty())
+    {
+        return false;
+    }
+    // Bring the statement back to its initial state (the result only reflects the last step)
+    sqlite3_reset(stmt.mPtr);
+    // Make sure no values are carried over to the next user
+    if (sqlite3_clear_bindings(stmt.mPtr) != SQLITE_OK)
+    {
+        return false;
+    }
+    // Compute the lookup key
+    const size_t hash = std::hash< String >{}(stmt.mQuery);
+    // Insert the statement as the most recently used one
+    mStmtCache.push_front(CachedStmt{std::move(stmt.mQuery), hash, stmt.mPtr,
+                                        stmt.mColumns, stmt.mParameters, std::move(stmt.mIndexes)});
+    // Make it available for lookup
+    mStmtIndex.emplace(hash, mStmtCache.begin());
+    // The statement no longer owns the resource
+    stmt.mPtr = nullptr;
+    // Evict the least recently used statements that no longer fit
+    TrimStmtCache(mStmtLimit);
+    // Statement was recycled
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SQLiteConnHnd::TrimStmtCache(size_t num)
+{
+    while (mStmtCache.size() > num)
+    {
+        // Grab the least recently used statement
+        auto itr = std::prev(mStmtCache.end());
+        // Remove it from the index
+        auto range = mStmtIndex.equal_range(itr->mHash);
+        for (auto idx = range.first; idx != range.second; ++idx)
+        {
+            if (idx->second == itr)
+            {
+                mStmtIndex.erase(idx);
+                break;
+            }
+        }
+        // Attempt to finalize the statement
+        if ((sqlite3_finalize(itr->mPtr)) != SQLITE_OK)
+        {
+            LogErr("Unable to finalize SQLite statement [%s]", ErrMsg());
+        }
+        // Forget about it
+        mStmtCache.erase(itr);
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 SQLiteStmtHnd::SQLiteStmtHnd(SQLiteConnRef conn)
     : mPtr(nullptr)
@@ -803,8 +896,8 @@ SQLiteStmtHnd::SQLiteStmtHnd(SQLiteConnRef conn)
 // ------------------------------------------------------------------------------------------------
 SQLiteStmtHnd::~SQLiteStmtHnd()
 {
-    // Is there anything to finalize?
-    if (mPtr != nullptr)
+    // Is there anything to finalize? Can it be reused instead?
+    if (mPtr != nullptr && !(mConnection && mConnection->RecycleStmt(*this)))
     {
         // Attempt to finalize the statement
         if ((sqlite3_finalize(mPtr)) != SQLITE_OK)
@@ -833,7 +926,12 @@ void SQLiteStmtHnd::Create(const SQChar * query, SQInteger length)
         STHROWF("Unable to prepare statement. Invalid or empty query string");
     }
     // Save the query string
-    mQuery.assign(query, static_cast< size_t >(length));
+    mQuery.assign(query, length < 0 ? std::strlen(query) : static_cast< size_t >(length));
+    // Is there a statement with the same query string that can be reused?
+    if (mConnection->mStmtLimit && mConnection->AcquireStmt(*this, std::hash< String >{}(mQuery)))
+    {
+        return; // Already prepared, reset and cleared
+    }
     // Attempt to prepare a statement with the specified query string
     if ((mStatus = sqlite3_prepare_v2(mConnection->mPtr, mQuery.c_str(), ConvTo< int32_t >::From(mQuery.size()),
                                             &mPtr, nullptr)) != SQLITE_OK)
@@ -877,7 +975,7 @@ int32_t SQLiteStmtHnd::GetColumnIndex(const SQChar * name, SQInteger length)
             // Save it to guarantee the same lifetime as this instance
             else
             {
-                mIndexes[name] = i;
+                mIndexes.emplace(column_name, i);
             }
         }
     }
@@ -3015,6 +3113,8 @@ void Register_SQLite(HSQUIRRELVM vm)
         .Prop(_SC("Trace"), &SQLiteConnection::GetTracing, &SQLiteConnection::SetTracing)
         .Prop(_SC("Profile"), &SQLiteConnection::GetProfiling, &SQLiteConnection::SetProfiling)
         .Prop(_SC("QueueSize"), &SQLiteConnection::QueueSize)
+        .Prop(_SC("StatementCacheLimit"), &SQLiteConnection::GetStatementCacheLimit, &SQLiteConnection::SetStatementCacheLimit)
+        .Prop(_SC("StatementCacheSize"), &SQLiteConnection::GetStatementCacheSize)
         // Member Methods
         .Func(_SC("Release"), &SQLiteConnection::Release)
         .FmtFunc(_SC("Exec"), &SQLiteConnection::Exec)
@@ -3028,6 +3128,7 @@ void Register_SQLite(HSQUIRRELVM vm)
         .Func(_SC("CompactQueue"), &SQLiteConnection::CompactQueue)
         .Func(_SC("ClearQueue"), &SQLiteConnection::ClearQueue)
         .Func(_SC("PopQueue"), &SQLiteConnection::PopQueue)
+        .Func(_SC("ClearStatementCache"), &SQLiteConnection::ClearStatementCache)
         // Member Overloads
         .Overload< void (SQLiteConnection::*)(StackStrF &) >(_SC("Open"), &SQLiteConnection::Open)
         .Overload< void (SQLiteConnection::*)(StackStrF &, int32_t) >(_SC("Open"), &SQLiteConnection::Open)
@@ -18,7 +18,8 @@
 // ------------------------------------------------------------------------------------------------
 #include <utility>
 #include <vector>
-#include <map>
+#include <list>
+#include <unordered_map>
 
 // ------------------------------------------------------------------------------------------------
 #ifdef SQMOD_POCO_HAS_SQLITE
@@ -167,6 +168,26 @@ public:
     // --------------------------------------------------------------------------------------------
     typedef std::vector< String > QueryList; // Container used to queue queries.
 
+    // --------------------------------------------------------------------------------------------
+    typedef std::unordered_map< String, int > Indexes; // Container used to identify column indexes.
+
+    /* --------------------------------------------------------------------------------------------
+     * A prepared statement that is not currently in use and can be handed out again.
+    */
+    struct CachedStmt
+    {
+        String          mQuery; // The query string used to prepare the statement.
+        size_t          mHash; // Hash of the query string.
+        sqlite3_stmt *  mPtr; // The statement handle resource.
+        int32_t         mColumns; // The amount of columns available in the statement.
+        int32_t         mParameters; // The amount of parameters available in the statement.
+        Indexes         mIndexes; // Column names and their index, if they were requested.
+    };
+
+    // --------------------------------------------------------------------------------------------
+    typedef std::list< CachedStmt > StmtList; // Cached statements. Most recently used first.
+    typedef std::unordered_multimap< size_t, StmtList::iterator > StmtIndex; // Lookup by query hash.
+
 public:
 
     // --------------------------------------------------------------------------------------------
@@ -183,6 +204,11 @@ public:
     String      mName; // The specified name to be used as the database file.
     String      mVFS; // The specified virtual file system.
 
+    // --------------------------------------------------------------------------------------------
+    StmtList    mStmtCache; // Prepared statements that can be reused.
+    StmtIndex   mStmtIndex; // Cached statements indexed by the hash of their query string.
+    uint32_t    mStmtLimit; // Maximum number of statements to keep in the cache.
+
     // --------------------------------------------------------------------------------------------
     Poco::AutoPtr< Poco::Data::SessionImpl > mSession; // POCO session when this connection comes from a pool.
 
@@ -241,6 +267,21 @@ public:
     */
     int32_t Flush(uint32_t num, Object & env, Function & func);
 
+    /* --------------------------------------------------------------------------------------------
+     * Hand over a cached statement prepared with the same query string, if any.
+    */
+    bool AcquireStmt(SQLiteStmtHnd & stmt, size_t hash);
+
+    /* --------------------------------------------------------------------------------------------
+     * Take back a statement that is no longer used so it can be handed out again.
+    */
+    bool RecycleStmt(SQLiteStmtHnd & stmt);
+
+    /* --------------------------------------------------------------------------------------------
+     * Finalize cached statements until no more than the specified amount remain.
+    */
+    void TrimStmtCache(size_t num);
+
     /* --------------------------------------------------------------------------------------------
      * Retrieve the message of the last received error code.
     */
@@ -307,7 +348,7 @@ public:
     typedef const Type &    SQ_UNUSED_TYPEDEF(ConstRef); // Constant reference to the managed type.
 
     // --------------------------------------------------------------------------------------------
-    typedef std::map< String, int > Indexes; // Container used to identify column indexes.
+    typedef SQLiteConnHnd::Indexes Indexes; // Container used to identify column indexes.
 
 public:
 
@@ -850,6 +891,42 @@ public:
         return ConvTo< uint32_t >::From(SQMOD_GET_VALID(*this)->mQueue.size());
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the maximum number of prepared statements kept for reuse.
+    */
+    SQMOD_NODISCARD uint32_t GetStatementCacheLimit() const
+    {
+        return SQMOD_GET_VALID(*this)->mStmtLimit;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the maximum number of prepared statements kept for reuse. Zero disables the cache.
+    */
+    void SetStatementCacheLimit(uint32_t num)
+    {
+        const SQLiteConnRef & h = SQMOD_GET_VALID(*this);
+        // Apply the new limit
+        h->mStmtLimit = num;
+        // Finalize the statements that no longer fit
+        h->TrimStmtCache(num);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of prepared statements currently waiting to be reused.
+    */
+    SQMOD_NODISCARD uint32_t GetStatementCacheSize() const
+    {
+        return ConvTo< uint32_t >::From(SQMOD_GET_VALID(*this)->mStmtCache.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Finalize all prepared statements currently waiting to be reused.
+    */
+    void ClearStatementCache()
+    {
+        SQMOD_GET_VALID(*this)->TrimStmtCache(0);
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Reserve space upfront for the specified amount of queries in the query queue.
     */
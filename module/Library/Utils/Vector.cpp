@@ -1,6 +1,20 @@
 // ------------------------------------------------------------------------------------------------
 #include "Library/Utils/Vector.hpp"
 
+// ------------------------------------------------------------------------------------------------
+#if defined(__x86_64__) || defined(_M_X64)
+    #define SQMOD_VECTOR_SIMD 1
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        // MSVC accepts AVX2 intrinsics in any function
+        #define SQMOD_TARGET_AVX2
+    #else
+        // Only the functions that are selected at runtime may use AVX2 instructions
+        #define SQMOD_TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#endif
+
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
@@ -11,14 +25,488 @@ SQMOD_DECL_TYPENAME(SqVectorFloat, _SC("SqVectorFloat"))
 SQMOD_DECL_TYPENAME(SqVectorByte, _SC("SqVectorByte"))
 SQMOD_DECL_TYPENAME(SqVectorBool, _SC("SqVectorBool"))
 
+#ifdef SQMOD_VECTOR_SIMD
+
+/* ------------------------------------------------------------------------------------------------
+ * Ask the processor whether AVX2 instructions are supported and enabled by the operating system.
+*/
+static bool DetectAVX2() noexcept
+{
+#ifdef _MSC_VER
+    int r[4];
+    __cpuid(r, 0);
+    // Is the extended features leaf available?
+    if (r[0] < 7)
+    {
+        return false;
+    }
+    __cpuid(r, 1);
+    // Does the operating system preserve the AVX registers?
+    if ((r[2] & (1 << 27)) == 0 || (r[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+    {
+        return false;
+    }
+    __cpuidex(r, 7, 0);
+    // Finally, look for AVX2
+    return (r[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+static const bool g_HasAVX2 = DetectAVX2();
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static SQInteger SumAVX2(const SQInteger * p, size_t n) noexcept
+{
+    __m256i a0 = _mm256_setzero_si256(), a1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        a0 = _mm256_add_epi64(a0, _mm256_loadu_si256(reinterpret_cast< const __m256i * >(p + i)));
+        a1 = _mm256_add_epi64(a1, _mm256_loadu_si256(reinterpret_cast< const __m256i * >(p + i + 4)));
+    }
+    alignas(32) int64_t t[4];
+    _mm256_store_si256(reinterpret_cast< __m256i * >(t), _mm256_add_epi64(a0, a1));
+    // Wrap around on overflow, like the vector lanes did
+    auto s = static_cast< uint64_t >(t[0]) + static_cast< uint64_t >(t[1]) + static_cast< uint64_t >(t[2]) + static_cast< uint64_t >(t[3]);
+    for (; i < n; ++i) s += static_cast< uint64_t >(p[i]);
+    return static_cast< SQInteger >(s);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static SQInteger MinAVX2(const SQInteger * p, size_t n) noexcept
+{
+    __m256i m = _mm256_set1_epi64x(p[0]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast< const __m256i * >(p + i));
+        m = _mm256_blendv_epi8(m, v, _mm256_cmpgt_epi64(m, v));
+    }
+    alignas(32) int64_t t[4];
+    _mm256_store_si256(reinterpret_cast< __m256i * >(t), m);
+    int64_t r = std::min(std::min(t[0], t[1]), std::min(t[2], t[3]));
+    for (; i < n; ++i) r = std::min(r, static_cast< int64_t >(p[i]));
+    return static_cast< SQInteger >(r);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static SQInteger MaxAVX2(const SQInteger * p, size_t n) noexcept
+{
+    __m256i m = _mm256_set1_epi64x(p[0]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast< const __m256i * >(p + i));
+        m = _mm256_blendv_epi8(m, v, _mm256_cmpgt_epi64(v, m));
+    }
+    alignas(32) int64_t t[4];
+    _mm256_store_si256(reinterpret_cast< __m256i * >(t), m);
+    int64_t r = std::max(std::max(t[0], t[1]), std::max(t[2], t[3]));
+    for (; i < n; ++i) r = std::max(r, static_cast< int64_t >(p[i]));
+    return static_cast< SQInteger >(r);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static void OffsetAVX2(SQInteger * p, size_t n, SQInteger v) noexcept
+{
+    const __m256i o = _mm256_set1_epi64x(v);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        auto * x = reinterpret_cast< __m256i * >(p + i);
+        _mm256_storeu_si256(x, _mm256_add_epi64(_mm256_loadu_si256(x), o));
+    }
+    for (; i < n; ++i) p[i] = static_cast< SQInteger >(static_cast< uint64_t >(p[i]) + static_cast< uint64_t >(v));
+}
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static void ClampAVX2(SQInteger * p, size_t n, SQInteger lo, SQInteger hi) noexcept
+{
+    const __m256i l = _mm256_set1_epi64x(lo), h = _mm256_set1_epi64x(hi);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        auto * x = reinterpret_cast< __m256i * >(p + i);
+        __m256i v = _mm256_loadu_si256(x);
+        v = _mm256_blendv_epi8(v, l, _mm256_cmpgt_epi64(l, v));
+        v = _mm256_blendv_epi8(v, h, _mm256_cmpgt_epi64(v, h));
+        _mm256_storeu_si256(x, v);
+    }
+    for (; i < n; ++i) p[i] = std::min(std::max(p[i], lo), hi);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static void AddAVX2(SQInteger * a, const SQInteger * b, size_t n) noexcept
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        auto * x = reinterpret_cast< __m256i * >(a + i);
+        _mm256_storeu_si256(x, _mm256_add_epi64(_mm256_loadu_si256(x), _mm256_loadu_si256(reinterpret_cast< const __m256i * >(b + i))));
+    }
+    for (; i < n; ++i) a[i] = static_cast< SQInteger >(static_cast< uint64_t >(a[i]) + static_cast< uint64_t >(b[i]));
+}
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static SQFloat SumAVX2(const SQFloat * p, size_t n) noexcept
+{
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        a0 = _mm256_add_pd(a0, _mm256_loadu_pd(p + i));
+        a1 = _mm256_add_pd(a1, _mm256_loadu_pd(p + i + 4));
+    }
+    alignas(32) double t[4];
+    _mm256_store_pd(t, _mm256_add_pd(a0, a1));
+    SQFloat s = (t[0] + t[1]) + (t[2] + t[3]);
+    for (; i < n; ++i) s += p[i];
+    return s;
+}
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static SQFloat MinAVX2(const SQFloat * p, size_t n) noexcept
+{
+    __m256d m = _mm256_set1_pd(p[0]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) m = _mm256_min_pd(m, _mm256_loadu_pd(p + i));
+    alignas(32) double t[4];
+    _mm256_store_pd(t, m);
+    SQFloat r = std::min(std::min(t[0], t[1]), std::min(t[2], t[3]));
+    for (; i < n; ++i) r = std::min(r, p[i]);
+    return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static SQFloat MaxAVX2(const SQFloat * p, size_t n) noexcept
+{
+    __m256d m = _mm256_set1_pd(p[0]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) m = _mm256_max_pd(m, _mm256_loadu_pd(p + i));
+    alignas(32) double t[4];
+    _mm256_store_pd(t, m);
+    SQFloat r = std::max(std::max(t[0], t[1]), std::max(t[2], t[3]));
+    for (; i < n; ++i) r = std::max(r, p[i]);
+    return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static SQFloat DotAVX2(const SQFloat * a, const SQFloat * b, size_t n) noexcept
+{
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        a0 = _mm256_add_pd(a0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        a1 = _mm256_add_pd(a1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+    }
+    alignas(32) double t[4];
+    _mm256_store_pd(t, _mm256_add_pd(a0, a1));
+    SQFloat s = (t[0] + t[1]) + (t[2] + t[3]);
+    for (; i < n; ++i) s += a[i] * b[i];
+    return s;
+}
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static void ScaleAVX2(SQFloat * p, size_t n, SQFloat f) noexcept
+{
+    const __m256d x = _mm256_set1_pd(f);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(p + i, _mm256_mul_pd(_mm256_loadu_pd(p + i), x));
+    for (; i < n; ++i) p[i] *= f;
+}
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static void OffsetAVX2(SQFloat * p, size_t n, SQFloat v) noexcept
+{
+    const __m256d x = _mm256_set1_pd(v);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(p + i, _mm256_add_pd(_mm256_loadu_pd(p + i), x));
+    for (; i < n; ++i) p[i] += v;
+}
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static void ClampAVX2(SQFloat * p, size_t n, SQFloat lo, SQFloat hi) noexcept
+{
+    const __m256d l = _mm256_set1_pd(lo), h = _mm256_set1_pd(hi);
+    size_t i = 0;
+    // The element goes second so that NaN is passed through, like the scalar loop does
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(p + i, _mm256_min_pd(h, _mm256_max_pd(l, _mm256_loadu_pd(p + i))));
+    for (; i < n; ++i) p[i] = std::min(std::max(p[i], lo), hi);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static void AddAVX2(SQFloat * a, const SQFloat * b, size_t n) noexcept
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(a + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    for (; i < n; ++i) a[i] += b[i];
+}
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_TARGET_AVX2 static void MulAVX2(SQFloat * a, const SQFloat * b, size_t n) noexcept
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(a + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    for (; i < n; ++i) a[i] *= b[i];
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQFloat SumSSE2(const SQFloat * p, size_t n) noexcept
+{
+    __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        a0 = _mm_add_pd(a0, _mm_loadu_pd(p + i));
+        a1 = _mm_add_pd(a1, _mm_loadu_pd(p + i + 2));
+    }
+    alignas(16) double t[2];
+    _mm_store_pd(t, _mm_add_pd(a0, a1));
+    SQFloat s = t[0] + t[1];
+    for (; i < n; ++i) s += p[i];
+    return s;
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQFloat MinSSE2(const SQFloat * p, size_t n) noexcept
+{
+    __m128d m = _mm_set1_pd(p[0]);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) m = _mm_min_pd(m, _mm_loadu_pd(p + i));
+    alignas(16) double t[2];
+    _mm_store_pd(t, m);
+    SQFloat r = std::min(t[0], t[1]);
+    for (; i < n; ++i) r = std::min(r, p[i]);
+    return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQFloat MaxSSE2(const SQFloat * p, size_t n) noexcept
+{
+    __m128d m = _mm_set1_pd(p[0]);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) m = _mm_max_pd(m, _mm_loadu_pd(p + i));
+    alignas(16) double t[2];
+    _mm_store_pd(t, m);
+    SQFloat r = std::max(t[0], t[1]);
+    for (; i < n; ++i) r = std::max(r, p[i]);
+    return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQFloat DotSSE2(const SQFloat * a, const SQFloat * b, size_t n) noexcept
+{
+    __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        a0 = _mm_add_pd(a0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        a1 = _mm_add_pd(a1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+    }
+    alignas(16) double t[2];
+    _mm_store_pd(t, _mm_add_pd(a0, a1));
+    SQFloat s = t[0] + t[1];
+    for (; i < n; ++i) s += a[i] * b[i];
+    return s;
+}
+
+#endif // SQMOD_VECTOR_SIMD
+
+// ------------------------------------------------------------------------------------------------
+#ifdef SQMOD_VECTOR_SIMD
+    // Use the AVX2 version of a kernel when the processor supports it
+    #define SQMOD_VECTOR_AVX2(fn, ...) if (g_HasAVX2) { return fn(__VA_ARGS__); }
+#else
+    #define SQMOD_VECTOR_AVX2(fn, ...)
+#endif
+
+// ------------------------------------------------------------------------------------------------
+bool SqVectorMath::HasAVX2() noexcept
+{
+#ifdef SQMOD_VECTOR_SIMD
+    return g_HasAVX2;
+#else
+    return false;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger SqVectorMath::Sum(const SQInteger * p, size_t n) noexcept
+{
+    SQMOD_VECTOR_AVX2(SumAVX2, p, n)
+    // Wrap around on overflow instead of invoking undefined behavior
+    uint64_t s = 0;
+    for (size_t i = 0; i < n; ++i) s += static_cast< uint64_t >(p[i]);
+    return static_cast< SQInteger >(s);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQFloat SqVectorMath::Sum(const SQFloat * p, size_t n) noexcept
+{
+    SQMOD_VECTOR_AVX2(SumAVX2, p, n)
+#ifdef SQMOD_VECTOR_SIMD
+    return SumSSE2(p, n);
+#else
+    return std::accumulate(p, p + n, SQFloat{0});
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger SqVectorMath::Min(const SQInteger * p, size_t n) noexcept
+{
+    SQMOD_VECTOR_AVX2(MinAVX2, p, n)
+    return *std::min_element(p, p + n);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQFloat SqVectorMath::Min(const SQFloat * p, size_t n) noexcept
+{
+    SQMOD_VECTOR_AVX2(MinAVX2, p, n)
+#ifdef SQMOD_VECTOR_SIMD
+    return MinSSE2(p, n);
+#else
+    return *std::min_element(p, p + n);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger SqVectorMath::Max(const SQInteger * p, size_t n) noexcept
+{
+    SQMOD_VECTOR_AVX2(MaxAVX2, p, n)
+    return *std::max_element(p, p + n);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQFloat SqVectorMath::Max(const SQFloat * p, size_t n) noexcept
+{
+    SQMOD_VECTOR_AVX2(MaxAVX2, p, n)
+#ifdef SQMOD_VECTOR_SIMD
+    return MaxSSE2(p, n);
+#else
+    return *std::max_element(p, p + n);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger SqVectorMath::Dot(const SQInteger * a, const SQInteger * b, size_t n) noexcept
+{
+    // There are no 64-bit integer multiplications before AVX-512 so, leave this to the compiler
+    uint64_t s = 0;
+    for (size_t i = 0; i < n; ++i) s += static_cast< uint64_t >(a[i]) * static_cast< uint64_t >(b[i]);
+    return static_cast< SQInteger >(s);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQFloat SqVectorMath::Dot(const SQFloat * a, const SQFloat * b, size_t n) noexcept
+{
+    SQMOD_VECTOR_AVX2(DotAVX2, a, b, n)
+#ifdef SQMOD_VECTOR_SIMD
+    return DotSSE2(a, b, n);
+#else
+    return std::inner_product(a, a + n, b, SQFloat{0});
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void SqVectorMath::Scale(SQInteger * p, size_t n, SQInteger f) noexcept
+{
+    // There are no 64-bit integer multiplications before AVX-512 so, leave this to the compiler
+    for (size_t i = 0; i < n; ++i) p[i] = static_cast< SQInteger >(static_cast< uint64_t >(p[i]) * static_cast< uint64_t >(f));
+}
+
+// ------------------------------------------------------------------------------------------------
+void SqVectorMath::Scale(SQFloat * p, size_t n, SQFloat f) noexcept
+{
+    SQMOD_VECTOR_AVX2(ScaleAVX2, p, n, f)
+    // Element-wise loops are vectorized by the compiler with the baseline instruction set
+    for (size_t i = 0; i < n; ++i) p[i] *= f;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SqVectorMath::Offset(SQInteger * p, size_t n, SQInteger v) noexcept
+{
+    SQMOD_VECTOR_AVX2(OffsetAVX2, p, n, v)
+    for (size_t i = 0; i < n; ++i) p[i] = static_cast< SQInteger >(static_cast< uint64_t >(p[i]) + static_cast< uint64_t >(v));
+}
+
+// ------------------------------------------------------------------------------------------------
+void SqVectorMath::Offset(SQFloat * p, size_t n, SQFloat v) noexcept
+{
+    SQMOD_VECTOR_AVX2(OffsetAVX2, p, n, v)
+    for (size_t i = 0; i < n; ++i) p[i] += v;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SqVectorMath::Clamp(SQInteger * p, size_t n, SQInteger lo, SQInteger hi) noexcept
+{
+    SQMOD_VECTOR_AVX2(ClampAVX2, p, n, lo, hi)
+    for (size_t i = 0; i < n; ++i) p[i] = std::min(std::max(p[i], lo), hi);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SqVectorMath::Clamp(SQFloat * p, size_t n, SQFloat lo, SQFloat hi) noexcept
+{
+    SQMOD_VECTOR_AVX2(ClampAVX2, p, n, lo, hi)
+    for (size_t i = 0; i < n; ++i) p[i] = std::min(std::max(p[i], lo), hi);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SqVectorMath::Add(SQInteger * a, const SQInteger * b, size_t n) noexcept
+{
+    SQMOD_VECTOR_AVX2(AddAVX2, a, b, n)
+    for (size_t i = 0; i < n; ++i) a[i] = static_cast< SQInteger >(static_cast< uint64_t >(a[i]) + static_cast< uint64_t >(b[i]));
+}
+
+// ------------------------------------------------------------------------------------------------
+void SqVectorMath::Add(SQFloat * a, const SQFloat * b, size_t n) noexcept
+{
+    SQMOD_VECTOR_AVX2(AddAVX2, a, b, n)
+    for (size_t i = 0; i < n; ++i) a[i] += b[i];
+}
+
+// ------------------------------------------------------------------------------------------------
+void SqVectorMath::Mul(SQInteger * a, const SQInteger * b, size_t n) noexcept
+{
+    // There are no 64-bit integer multiplications before AVX-512 so, leave this to the compiler
+    for (size_t i = 0; i < n; ++i) a[i] = static_cast< SQInteger >(static_cast< uint64_t >(a[i]) * static_cast< uint64_t >(b[i]));
+}
+
+// ------------------------------------------------------------------------------------------------
+void SqVectorMath::Mul(SQFloat * a, const SQFloat * b, size_t n) noexcept
+{
+    SQMOD_VECTOR_AVX2(MulAVX2, a, b, n)
+    for (size_t i = 0; i < n; ++i) a[i] *= b[i];
+}
+
+// ------------------------------------------------------------------------------------------------
+void SqVectorMath::PrefixSum(SQInteger * p, size_t n) noexcept
+{
+    uint64_t s = 0;
+    // Each sum depends on the previous one so, there is nothing to vectorize here
+    for (size_t i = 0; i < n; ++i) p[i] = static_cast< SQInteger >(s += static_cast< uint64_t >(p[i]));
+}
+
+// ------------------------------------------------------------------------------------------------
+void SqVectorMath::PrefixSum(SQFloat * p, size_t n) noexcept
+{
+    SQFloat s = 0;
+    for (size_t i = 0; i < n; ++i) p[i] = (s += p[i]);
+}
+
 // ------------------------------------------------------------------------------------------------
 template < class T, class U >
 static void Register_Vector(HSQUIRRELVM vm, Table & ns, const SQChar * name)
 {
 	using Container = SqVector< T >;
     // --------------------------------------------------------------------------------------------
-    ns.Bind(name,
-        Class< Container, NoCopy< Container > >(vm, U::Str)
+    Class< Container, NoCopy< Container > > cls(vm, U::Str);
+    // --------------------------------------------------------------------------------------------
+    cls
         // Constructors
         .Ctor()
         .template Ctor< SQInteger >()
@@ -65,8 +553,29 @@ static void Register_Vector(HSQUIRRELVM vm, Table & ns, const SQChar * name)
         .Func(_SC("GenerateFrom"), &Container::GenerateFrom)
         .Func(_SC("GenerateBetween"), &Container::GenerateBetween)
         .Func(_SC("Sort"), &Container::Sort)
-        .Func(_SC("Shuffle"), &Container::Shuffle)
-    );
+        .Func(_SC("Shuffle"), &Container::Shuffle);
+    // Bulk operations are only available to numeric containers
+    if constexpr (std::is_same< T, SQInteger >::value || std::is_same< T, SQFloat >::value)
+    {
+        cls
+            // Properties
+            .Prop(_SC("Sum"), &Container::Sum)
+            .Prop(_SC("Min"), &Container::Min)
+            .Prop(_SC("Max"), &Container::Max)
+            .Prop(_SC("Mean"), &Container::Mean)
+            // Member Methods
+            .Func(_SC("Dot"), &Container::Dot)
+            .Func(_SC("Scale"), &Container::Scale)
+            .Func(_SC("Offset"), &Container::Offset)
+            .Func(_SC("Clamp"), &Container::Clamp)
+            .Func(_SC("AddVec"), &Container::AddVec)
+            .Func(_SC("MulVec"), &Container::MulVec)
+            .Func(_SC("Histogram"), &Container::Histogram)
+            .Func(_SC("TopK"), &Container::TopK)
+            .Func(_SC("PrefixSum"), &Container::PrefixSum);
+    }
+    // --------------------------------------------------------------------------------------------
+    ns.Bind(name, cls);
 }
 
 // ================================================================================================
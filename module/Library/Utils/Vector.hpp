@@ -11,6 +11,7 @@
 #include <random>
 #include <iterator>
 #include <algorithm>
+#include <functional>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
@@ -77,6 +78,78 @@ template < > struct SqVectorOpt< String >
     }
 };
 
+/* ------------------------------------------------------------------------------------------------
+ * Bulk operations on contiguous numeric values. Uses AVX2 when the processor supports it, SSE2 on
+ * other x86-64 processors and plain loops everywhere else.
+*/
+struct SqVectorMath
+{
+    /* --------------------------------------------------------------------------------------------
+     * See whether the processor supports AVX2 instructions.
+    */
+    static bool HasAVX2() noexcept;
+
+    /* --------------------------------------------------------------------------------------------
+     * Add up the specified values.
+    */
+    static SQInteger Sum(const SQInteger * p, size_t n) noexcept;
+    static SQFloat Sum(const SQFloat * p, size_t n) noexcept;
+
+    /* --------------------------------------------------------------------------------------------
+     * Find the smallest of the specified values. At least one value is required.
+    */
+    static SQInteger Min(const SQInteger * p, size_t n) noexcept;
+    static SQFloat Min(const SQFloat * p, size_t n) noexcept;
+
+    /* --------------------------------------------------------------------------------------------
+     * Find the largest of the specified values. At least one value is required.
+    */
+    static SQInteger Max(const SQInteger * p, size_t n) noexcept;
+    static SQFloat Max(const SQFloat * p, size_t n) noexcept;
+
+    /* --------------------------------------------------------------------------------------------
+     * Add up the products of the values at the same position.
+    */
+    static SQInteger Dot(const SQInteger * a, const SQInteger * b, size_t n) noexcept;
+    static SQFloat Dot(const SQFloat * a, const SQFloat * b, size_t n) noexcept;
+
+    /* --------------------------------------------------------------------------------------------
+     * Multiply the specified values by a factor.
+    */
+    static void Scale(SQInteger * p, size_t n, SQInteger f) noexcept;
+    static void Scale(SQFloat * p, size_t n, SQFloat f) noexcept;
+
+    /* --------------------------------------------------------------------------------------------
+     * Add an amount to the specified values.
+    */
+    static void Offset(SQInteger * p, size_t n, SQInteger v) noexcept;
+    static void Offset(SQFloat * p, size_t n, SQFloat v) noexcept;
+
+    /* --------------------------------------------------------------------------------------------
+     * Limit the specified values to a range. NaN values are left as they are.
+    */
+    static void Clamp(SQInteger * p, size_t n, SQInteger lo, SQInteger hi) noexcept;
+    static void Clamp(SQFloat * p, size_t n, SQFloat lo, SQFloat hi) noexcept;
+
+    /* --------------------------------------------------------------------------------------------
+     * Add the values from the second range to the values at the same position in the first range.
+    */
+    static void Add(SQInteger * a, const SQInteger * b, size_t n) noexcept;
+    static void Add(SQFloat * a, const SQFloat * b, size_t n) noexcept;
+
+    /* --------------------------------------------------------------------------------------------
+     * Multiply the values from the first range by the values at the same position in the second.
+    */
+    static void Mul(SQInteger * a, const SQInteger * b, size_t n) noexcept;
+    static void Mul(SQFloat * a, const SQFloat * b, size_t n) noexcept;
+
+    /* --------------------------------------------------------------------------------------------
+     * Replace every value with the sum of itself and the values before it.
+    */
+    static void PrefixSum(SQInteger * p, size_t n) noexcept;
+    static void PrefixSum(SQFloat * p, size_t n) noexcept;
+};
+
 /* ------------------------------------------------------------------------------------------------
  * Wrapper around a std::vector of values. Space efficient array.
 */
@@ -707,6 +780,172 @@ template < class T > struct SqVector
         std::shuffle(mC->begin(), mC->end(), g);
         return *this;
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Make sure another container has as many elements as this one and return it.
+    */
+    Container & ValidSame(SqVector & o) const
+    {
+        Validate();
+        o.Validate();
+        if (o.mC->size() != mC->size())
+        {
+            STHROWF("Vector containers differ in size ({} != {})", mC->size(), o.mC->size());
+        }
+        return *o.mC;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Add up the elements from the container. (numeric containers only)
+    */
+    SQMOD_NODISCARD T Sum() const
+    {
+        return SqVectorMath::Sum(Valid().data(), mC->size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the smallest element from the container. (numeric containers only)
+    */
+    SQMOD_NODISCARD T Min() const
+    {
+        return SqVectorMath::Min(ValidPop().data(), mC->size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the largest element from the container. (numeric containers only)
+    */
+    SQMOD_NODISCARD T Max() const
+    {
+        return SqVectorMath::Max(ValidPop().data(), mC->size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the arithmetic mean of the elements from the container. (numeric containers only)
+    */
+    SQMOD_NODISCARD SQFloat Mean() const
+    {
+        return static_cast< SQFloat >(SqVectorMath::Sum(ValidPop().data(), mC->size())) / static_cast< SQFloat >(mC->size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the dot product with another container of the same size. (numeric containers only)
+    */
+    SQMOD_NODISCARD T Dot(SqVector & o) const
+    {
+        return SqVectorMath::Dot(mC->data(), ValidSame(o).data(), mC->size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Multiply every element from the container by a factor. (numeric containers only)
+    */
+    SqVector & Scale(T f)
+    {
+        SqVectorMath::Scale(Valid().data(), mC->size(), f);
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Add an amount to every element from the container. (numeric containers only)
+    */
+    SqVector & Offset(T v)
+    {
+        SqVectorMath::Offset(Valid().data(), mC->size(), v);
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Limit every element from the container to a range. (numeric containers only)
+    */
+    SqVector & Clamp(T lo, T hi)
+    {
+        if (hi < lo)
+        {
+            STHROWF("Invalid clamp range ({} > {})", lo, hi);
+        }
+        SqVectorMath::Clamp(Valid().data(), mC->size(), lo, hi);
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Add the elements of another container of the same size, element-wise. (numeric containers only)
+    */
+    SqVector & AddVec(SqVector & o)
+    {
+        SqVectorMath::Add(mC->data(), ValidSame(o).data(), mC->size());
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Multiply by the elements of another container of the same size, element-wise. (numeric containers only)
+    */
+    SqVector & MulVec(SqVector & o)
+    {
+        SqVectorMath::Mul(mC->data(), ValidSame(o).data(), mC->size());
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Count the elements that fall in each of the equally sized bins between two values. Elements
+     * outside the range and NaN are ignored. The upper bound belongs to the last bin. (numeric containers only)
+    */
+    SQMOD_NODISCARD LightObj Histogram(T lo, T hi, SQInteger bins) const
+    {
+        Validate();
+        if (bins <= 0)
+        {
+            STHROWF("Invalid number of bins ({})", bins);
+        }
+        else if (!(lo < hi))
+        {
+            STHROWF("Invalid histogram range ({} >= {})", lo, hi);
+        }
+        // The bins would have no width if the range cannot be represented
+        else if (!std::isfinite(static_cast< SQFloat >(hi) - static_cast< SQFloat >(lo)))
+        {
+            STHROWF("Histogram range is too large ({} to {})", lo, hi);
+        }
+        std::vector< SQInteger > counts(static_cast< size_t >(bins), 0);
+        // Compute the bin widths once, in floating point for both containers
+        const auto flo = static_cast< SQFloat >(lo);
+        const SQFloat ratio = static_cast< SQFloat >(bins) / (static_cast< SQFloat >(hi) - flo);
+        const auto last = static_cast< size_t >(bins - 1);
+        for (const T & v : *mC)
+        {
+            // Ignore values outside the range (written so that NaN is ignored as well)
+            if (!(lo <= v && v <= hi))
+            {
+                continue;
+            }
+            // Rounding may push values near the upper bound past the last bin
+            ++counts[std::min(static_cast< size_t >((static_cast< SQFloat >(v) - flo) * ratio), last)];
+        }
+        // Return the counts in a new container
+        return LightObj(SqTypeIdentity< SqVector< SQInteger > >{}, SqVM(), Poco::makeShared< std::vector< SQInteger > >(std::move(counts)));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the largest elements from the container, in descending order. (numeric containers only)
+    */
+    SQMOD_NODISCARD LightObj TopK(SQInteger k) const
+    {
+        Validate();
+        // Cannot retrieve more elements than there are
+        Container top(std::min(ClampL< SQInteger, size_t >(k), mC->size()));
+        // Only the first few elements need to be sorted
+        std::partial_sort_copy(mC->begin(), mC->end(), top.begin(), top.end(), std::greater< T >());
+        // Return the elements in a new container
+        return LightObj(SqTypeIdentity< SqVector >{}, SqVM(), Poco::makeShared< Container >(std::move(top)));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Replace every element from the container with the sum of itself and the elements before it.
+     * (numeric containers only)
+    */
+    SqVector & PrefixSum()
+    {
+        SqVectorMath::PrefixSum(Valid().data(), mC->size());
+        return *this;
+    }
 };
 
 } // Namespace:: SqMod
@@ -119,6 +119,186 @@ void ZSkt::Flush(HSQUIRRELVM vm)
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+ZReactor & ZReactor::Get()
+{
+    static ZReactor r;
+    return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ZReactor::Start()
+{
+    // Already running?
+    if (mThread.joinable())
+    {
+        return;
+    }
+    // Create a dedicated context for the wake-up sockets
+    mContext = zmq_ctx_new();
+    // Create the wake-up sockets
+    mWakeIn = mContext ? zmq_socket(mContext, ZMQ_PAIR) : nullptr;
+    mWakeOut = mContext ? zmq_socket(mContext, ZMQ_PAIR) : nullptr;
+    // Connect them together
+    if (!mWakeIn || !mWakeOut || zmq_bind(mWakeIn, "inproc://sqmod-zmq-reactor") != 0 ||
+                                    zmq_connect(mWakeOut, "inproc://sqmod-zmq-reactor") != 0)
+    {
+        // Save the error before it gets overwritten
+        const int e = zmq_errno();
+        // Release whatever was created
+        Stop();
+        // Without these there's no way to interrupt the poll
+        STHROWF("Unable to initialize socket reactor: {}", zmq_strerror(e));
+    }
+    // Nothing was signaled yet
+    mSignaled = false;
+    // Allow the processing thread to run
+    mRun = true;
+    // Create the processing thread
+    mThread = std::thread(&ZReactor::Proc, this);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ZReactor::Stop()
+{
+    // Is the processing thread running?
+    if (mThread.joinable())
+    {
+        {
+            // Park the reactor
+            Lock guard;
+            // Stop the loop
+            mRun = false;
+        }
+        // Wait for the thread
+        mThread.join();
+    }
+    // Acquire exclusive access to the wake-up writer
+    std::lock_guard< std::mutex > guard(mWakeMtx);
+    // Close the wake-up sockets
+    if (mWakeOut)
+    {
+        zmq_close(mWakeOut);
+        mWakeOut = nullptr;
+    }
+    if (mWakeIn)
+    {
+        zmq_close(mWakeIn);
+        mWakeIn = nullptr;
+    }
+    // Release their context
+    if (mContext)
+    {
+        zmq_ctx_term(mContext);
+        mContext = nullptr;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ZReactor::Wake()
+{
+    // Is there a wake-up message on its way already?
+    if (mSignaled.exchange(true))
+    {
+        return;
+    }
+    // Acquire exclusive access to the wake-up writer
+    std::lock_guard< std::mutex > guard(mWakeMtx);
+    // Send an empty message to interrupt the poll
+    if (mWakeOut)
+    {
+        zmq_send(mWakeOut, nullptr, 0, ZMQ_DONTWAIT);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ZReactor::Attach(ZSkt * skt)
+{
+    // Make sure there's someone to process the socket
+    Start();
+    // Park the reactor
+    Lock guard;
+    // Start polling the socket
+    mSockets.push_back(skt);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ZReactor::Detach(ZSkt * skt)
+{
+    mSockets.erase(std::remove(mSockets.begin(), mSockets.end(), skt), mSockets.end());
+}
+
+// ------------------------------------------------------------------------------------------------
+void ZReactor::Proc()
+{
+    // Acquire exclusive access to the sockets
+    std::unique_lock< std::mutex > lock(mMtx);
+    // Whether the last poll failed (to avoid flooding the log)
+    bool failing = false;
+    // Enter processing loop
+    while (mRun)
+    {
+        // Yield to anyone that needs exclusive access
+        mCond.wait(lock, [this] { return mWaiting.load() == 0; });
+        // Were we asked to stop in the meantime?
+        if (!mRun)
+        {
+            break;
+        }
+        // Rebuild the poll items since sockets may have been added or removed
+        mItems.clear();
+        // Always listen for wake-up messages
+        mItems.push_back(zmq_pollitem_t{mWakeIn, 0, ZMQ_POLLIN, 0});
+        // Listen for incoming messages and, if there's something to send, for room to send it
+        for (ZSkt * skt : mSockets)
+        {
+            mItems.push_back(zmq_pollitem_t{skt->mPtr, 0, static_cast< short >(ZMQ_POLLIN | (skt->Outgoing() ? ZMQ_POLLOUT : 0)), 0});
+        }
+        // Wait for something to happen
+        if (zmq_poll(mItems.data(), static_cast< int >(mItems.size()), -1) < 0)
+        {
+            const int e = zmq_errno();
+            // Interrupted by a signal?
+            if (e == EINTR)
+            {
+                continue;
+            }
+            // Report the error once, until polling works again
+            else if (!failing)
+            {
+                LogErr("Unable to poll sockets: %s", zmq_strerror(e));
+                failing = true;
+            }
+            // Don't spin on a persistent error but keep yielding to anyone that needs the sockets
+            mCond.wait_for(lock, std::chrono::milliseconds(100));
+            continue;
+        }
+        failing = false;
+        // Were we woken up?
+        if (mItems[0].revents & ZMQ_POLLIN)
+        {
+            // Discard the wake-up messages
+            while (zmq_recv(mWakeIn, nullptr, 0, ZMQ_DONTWAIT) >= 0) { }
+            // Anyone waking us from now on must send another message. Clearing this only after the
+            // messages were discarded guarantees that a message is pending whenever it is set.
+            // Wake-ups that were skipped in the meantime are covered by the next poll item rebuild
+            mSignaled = false;
+        }
+        // Process the sockets
+        for (size_t i = 0; i < mSockets.size(); ++i)
+        {
+            ZSkt * skt = mSockets[i];
+            // Anything to receive? Don't let a busy socket starve the others
+            if (mItems[i + 1].revents & ZMQ_POLLIN)
+            {
+                for (int n = 0; n < 256 && skt->Recv(); ++n) { }
+            }
+            // Send whatever the socket can accept
+            while (skt->Send()) { }
+        }
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 LightObj ZContext::Socket(int type) const
 {
@@ -129,7 +309,7 @@ LightObj ZSocket::GetOpt(int opt)
 {
     int r = 0;
     // Acquire exclusive access to the socket
-    std::lock_guard< std::mutex > guard(Valid().mMtx);
+    ZReactor::Lock guard;
     // Identify option
     switch (opt)
     {
@@ -279,7 +459,7 @@ void ZSocket::SetOpt(int opt, LightObj & value)
 {
     int r = 0;
     // Acquire exclusive access to the socket
-    std::lock_guard< std::mutex > guard(Valid().mMtx);
+    ZReactor::Lock guard;
     // Identify option
     switch (opt)
     {
@@ -454,6 +634,8 @@ void ZmqTerminate()
         // Flush pending messages
         inst->Flush(SqVM());
     }
+    // Stop the reactor as well
+    ZReactor::Get().Stop();
 }
 
 // ================================================================================================
@@ -490,6 +672,9 @@ void Register_ZMQ(HSQUIRRELVM vm)
         // Properties
         .Prop(_SC("IsNull"), &ZSocket::IsNull)
         .Prop(_SC("StringMessages"), &ZSocket::GetStringMessages, &ZSocket::SetStringMessages)
+        .Prop(_SC("QueuedBytes"), &ZSocket::GetQueuedBytes)
+        .Prop(_SC("SentBytes"), &ZSocket::GetSentBytes)
+        .Prop(_SC("ReceivedBytes"), &ZSocket::GetReceivedBytes)
         // Member Methods
         .CbFunc(_SC("OnData"), &ZSocket::OnData)
         .FmtFunc(_SC("Bind"), &ZSocket::Bind)
@@ -6,10 +6,12 @@
 
 // ------------------------------------------------------------------------------------------------
 #include <mutex>
+#include <atomic>
 #include <thread>
 #include <vector>
 #include <memory>
 #include <chrono>
+#include <condition_variable>
 #include <utility>
 #include <algorithm>
 
@@ -23,6 +25,7 @@ namespace SqMod {
 // ------------------------------------------------------------------------------------------------
 struct ZCtx;
 struct ZSkt;
+struct ZReactor;
 struct ZContext;
 struct ZSocket;
 
@@ -239,6 +242,202 @@ struct ZMsg
         mList.emplace_back(static_cast< Buffer::ConstPtr >(zmq_msg_data(&msg)),
                             static_cast< Buffer::SzType >(zmq_msg_size(&msg)));
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of bytes in the message (all parts).
+    */
+    SQMOD_NODISCARD uint64_t Bytes() const
+    {
+        // Is this a single message?
+        if (!mMulti)
+        {
+            return mBuff.Position();
+        }
+        // Accumulate the size of all parts
+        uint64_t n = 0;
+        for (const auto & b : mList)
+        {
+            n += b.Position();
+        }
+        // Return the total
+        return n;
+    }
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Shared processing thread that multiplexes all sockets with a single poll.
+*/
+struct ZReactor
+{
+    /* --------------------------------------------------------------------------------------------
+     * Exclusive access to the sockets while the reactor is parked. Helper type.
+    */
+    struct Lock
+    {
+        /* ----------------------------------------------------------------------------------------
+         * Default constructor. Interrupts the poll and waits for the reactor to yield.
+        */
+        Lock()
+            : mReactor(ZReactor::Get())
+        {
+            // Let the reactor know someone is waiting
+            ++mReactor.mWaiting;
+            // Interrupt the poll, if any
+            mReactor.Wake();
+            // Acquire exclusive access to the sockets
+            mReactor.mMtx.lock();
+        }
+
+        /* ----------------------------------------------------------------------------------------
+         * Copy constructor (disabled).
+        */
+        Lock(const Lock &) = delete;
+
+        /* ----------------------------------------------------------------------------------------
+         * Destructor. Allows the reactor to resume.
+        */
+        ~Lock()
+        {
+            // No longer waiting (must happen before the mutex is released)
+            --mReactor.mWaiting;
+            // Release exclusive access to the sockets
+            mReactor.mMtx.unlock();
+            // Let the reactor know it may resume
+            mReactor.mCond.notify_all();
+        }
+
+        /* ----------------------------------------------------------------------------------------
+         * Assignment operator (disabled).
+        */
+        Lock & operator = (const Lock &) = delete;
+
+        // ----------------------------------------------------------------------------------------
+        ZReactor & mReactor; // The reactor that was parked.
+    };
+
+    /* --------------------------------------------------------------------------------------------
+     * Processing thread.
+    */
+    std::thread mThread;
+
+    /* --------------------------------------------------------------------------------------------
+     * Synchronization mutex. Held by the processing thread while it uses the sockets.
+    */
+    std::mutex mMtx;
+
+    /* --------------------------------------------------------------------------------------------
+     * Used to resume the processing thread after someone else had exclusive access.
+    */
+    std::condition_variable mCond;
+
+    /* --------------------------------------------------------------------------------------------
+     * Number of threads waiting for exclusive access.
+    */
+    std::atomic< int > mWaiting;
+
+    /* --------------------------------------------------------------------------------------------
+     * Whether a wake-up message is already on its way to the processing thread.
+    */
+    std::atomic< bool > mSignaled;
+
+    /* --------------------------------------------------------------------------------------------
+     * Whether the processing thread should keep running.
+    */
+    bool mRun;
+
+    /* --------------------------------------------------------------------------------------------
+     * Context of the wake-up sockets.
+    */
+    void * mContext;
+
+    /* --------------------------------------------------------------------------------------------
+     * Wake-up socket polled by the processing thread.
+    */
+    void * mWakeIn;
+
+    /* --------------------------------------------------------------------------------------------
+     * Wake-up socket written by anyone that needs the processing thread to wake up.
+    */
+    void * mWakeOut;
+
+    /* --------------------------------------------------------------------------------------------
+     * Synchronization mutex for the wake-up writer socket.
+    */
+    std::mutex mWakeMtx;
+
+    /* --------------------------------------------------------------------------------------------
+     * Sockets managed by this reactor.
+    */
+    std::vector< ZSkt * > mSockets;
+
+    /* --------------------------------------------------------------------------------------------
+     * Poll items. Rebuilt before every poll.
+    */
+    std::vector< zmq_pollitem_t > mItems;
+
+    /* --------------------------------------------------------------------------------------------
+     * Default constructor.
+    */
+    ZReactor()
+        : mThread(), mMtx(), mCond(), mWaiting(0), mSignaled(false), mRun(false)
+        , mContext(nullptr), mWakeIn(nullptr), mWakeOut(nullptr), mWakeMtx(), mSockets(), mItems()
+    {
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy constructor (disabled).
+    */
+    ZReactor(const ZReactor &) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Destructor.
+    */
+    ~ZReactor()
+    {
+        Stop();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Assignment operator (disabled).
+    */
+    ZReactor & operator = (const ZReactor &) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the reactor shared by all sockets.
+    */
+    static ZReactor & Get();
+
+    /* --------------------------------------------------------------------------------------------
+     * Create the wake-up sockets and start the processing thread, if not already running.
+    */
+    void Start();
+
+    /* --------------------------------------------------------------------------------------------
+     * Stop the processing thread and release the wake-up sockets.
+    */
+    void Stop();
+
+    /* --------------------------------------------------------------------------------------------
+     * Interrupt the poll so that queued messages are sent or exclusive access is granted.
+    */
+    void Wake();
+
+    /* --------------------------------------------------------------------------------------------
+     * Start managing the specified socket.
+    */
+    void Attach(ZSkt * skt);
+
+    /* --------------------------------------------------------------------------------------------
+     * Stop managing the specified socket. Must be called with exclusive access.
+    */
+    void Detach(ZSkt * skt);
+
+protected:
+
+    /* --------------------------------------------------------------------------------------------
+     * Internal processing thread.
+    */
+    void Proc();
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -266,11 +465,6 @@ struct ZSkt : SqChainedInstances< ZSkt >
     */
     void * mPtr;
 
-    /* --------------------------------------------------------------------------------------------
-     * Socket status.
-    */
-    bool mRun;
-
     /* --------------------------------------------------------------------------------------------
      * Messages should be delivered as string instead of binary data.
     */
@@ -281,11 +475,6 @@ struct ZSkt : SqChainedInstances< ZSkt >
     */
     int mType;
 
-    /* --------------------------------------------------------------------------------------------
-     * Synchronization mutex.
-    */
-    std::mutex mMtx;
-
     /* --------------------------------------------------------------------------------------------
      * Messages received from the socket.
     */
@@ -297,14 +486,29 @@ struct ZSkt : SqChainedInstances< ZSkt >
     Queue mInputQueue;
 
     /* --------------------------------------------------------------------------------------------
-     * Message received callback.
+     * Message that the socket could not accept yet. Only used by the reactor.
     */
-    Function mOnData;
+    Item mPending;
 
     /* --------------------------------------------------------------------------------------------
-     * Processing thread.
+     * Number of bytes waiting to be sent.
     */
-    std::thread mThread;
+    std::atomic< uint64_t > mQueuedBytes;
+
+    /* --------------------------------------------------------------------------------------------
+     * Number of bytes sent through the socket.
+    */
+    std::atomic< uint64_t > mSentBytes;
+
+    /* --------------------------------------------------------------------------------------------
+     * Number of bytes received from the socket.
+    */
+    std::atomic< uint64_t > mReceivedBytes;
+
+    /* --------------------------------------------------------------------------------------------
+     * Message received callback.
+    */
+    Function mOnData;
 
     /* --------------------------------------------------------------------------------------------
      * Socket context.
@@ -316,42 +520,37 @@ struct ZSkt : SqChainedInstances< ZSkt >
     */
     ZSkt(const ZCtx::Ptr & ctx, int type)
         : SqChainedInstances< ZSkt >()
-        , mPtr(nullptr), mRun(true), mStringMessages(true), mType(type), mMtx()
-        , mOutputQueue(4096), mInputQueue(4096)
-        , mOnData(), mThread(), mContext(ctx)
+        , mPtr(nullptr), mStringMessages(true), mType(type)
+        , mOutputQueue(4096), mInputQueue(4096), mPending()
+        , mQueuedBytes(0), mSentBytes(0), mReceivedBytes(0)
+        , mOnData(), mContext(ctx)
     {
         // Validate the context
         if (!ctx)
         {
             STHROWF("Invalid context");
         }
-        // Create the processing thread
-        mThread = std::thread(&ZSkt::Proc, this);
-        // Remember this instance
-        ChainInstance();
-        // Wait for the socket to be created before we attempt to use it
-        for (int n = 0; n < 100; ++n)
+        // Create the socket
+        mPtr = zmq_socket(*mContext, mType);
+        // Validate the socket
+        if (!mPtr)
         {
-            using namespace std::chrono_literals;
-            // Acquire exclusive access to the socket
-            mMtx.lock();
-            // Was the socket created?
-            if (mPtr)
-            {
-                // Release exclusive access to the socket
-                mMtx.unlock();
-                // Socket created
-                break;
-            }
-            else
-            {
-                // Release exclusive access to the socket
-                mMtx.unlock();
-                // Wait for the socket to be created
-                std::this_thread::sleep_for(10ms);
-            }
+            STHROWF("Unable to initialize socket: {}", zmq_strerror(errno));
+        }
+        // Let the reactor take care of it
+        try
+        {
+            ZReactor::Get().Attach(this);
+        }
+        catch (...)
+        {
+            // Don't leak the socket
+            zmq_close(mPtr);
+            // Let the caller know
+            throw;
         }
-        // If it wasn't created by this point then something isn't right
+        // Remember this instance
+        ChainInstance();
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -398,62 +597,6 @@ struct ZSkt : SqChainedInstances< ZSkt >
     */
     operator void * () const noexcept { return mPtr; } // NOLINT(google-explicit-constructor)
 
-    /* --------------------------------------------------------------------------------------------
-     * Internal processing thread.
-     * NOTE: Messages are being sent in whatever order we can.
-     *       Don't expect them be in the order you sent or receive them.
-     *       That's the cost of simplicity. And something I can live with under the circumstances.
-    */
-    void Proc()
-    {
-        // Acquire exclusive access to the socket
-        mMtx.lock();
-        // Create the socket in this thread
-        mPtr = zmq_socket(*mContext, mType);
-        // Validate the socket
-        if (!mPtr)
-        {
-            LogErr("Unable to initialize socket: %s", zmq_strerror(errno));
-            // Stop the thread
-            return;
-        }
-        // Release exclusive access to the socket
-        mMtx.unlock();
-        // Enter processing loop
-        while (mRun)
-        {
-            using namespace std::chrono_literals;
-            // Acquire exclusive access to the socket
-            mMtx.lock();
-            // Perform tasks until there's none left
-            if (!Recv() && !Send())
-            {
-                // Release exclusive access to the socket
-                mMtx.unlock();
-                // Don't exhaust resources pointlessly
-                std::this_thread::sleep_for(50ms);
-            }
-            else
-            {
-                // Release exclusive access to the socket
-                mMtx.unlock();
-            }
-        }
-        // Acquire exclusive access to the socket
-        mMtx.lock();
-        // Close the socket
-        int r = zmq_close(mPtr);
-        // Forget about it
-        mPtr = nullptr;
-        // Release exclusive access to the socket
-        mMtx.unlock();
-        // Validate result
-        if (r != 0)
-        {
-            LogErr("Unable to close socket: [%d] {%s}", r, zmq_strerror(errno));
-        }
-    }
-
     /* --------------------------------------------------------------------------------------------
      * Flush messages from the queue to the script.
     */
@@ -464,21 +607,22 @@ struct ZSkt : SqChainedInstances< ZSkt >
     */
     void Close()
     {
-        // Is the processing thread running?
-        if (mThread.joinable())
-        {
-            // Acquire exclusive access
-            mMtx.lock();
-            // Stop the loop
-            mRun = false;
-            // Yield exclusive access
-            mMtx.unlock();
-            // Wait for the thread
-            mThread.join();
-        }
-        else
+        // Is there a socket to close?
+        if (mPtr)
         {
-            mRun = false; // Just in case
+            // Park the reactor
+            ZReactor::Lock guard;
+            // Stop polling the socket
+            ZReactor::Get().Detach(this);
+            // Close the socket
+            int r = zmq_close(mPtr);
+            // Forget about it
+            mPtr = nullptr;
+            // Validate result
+            if (r != 0)
+            {
+                LogErr("Unable to close socket: [%d] {%s}", r, zmq_strerror(errno));
+            }
         }
         // Forget about the context
         mContext.reset();
@@ -489,7 +633,7 @@ struct ZSkt : SqChainedInstances< ZSkt >
     */
     void Send(const Buffer & data)
     {
-        mInputQueue.enqueue(std::make_unique< ZMsg >(data));
+        Push(std::make_unique< ZMsg >(data));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -497,7 +641,7 @@ struct ZSkt : SqChainedInstances< ZSkt >
     */
     void Send(Buffer && data)
     {
-        mInputQueue.enqueue(std::make_unique< ZMsg >(std::move(data)));
+        Push(std::make_unique< ZMsg >(std::move(data)));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -505,7 +649,7 @@ struct ZSkt : SqChainedInstances< ZSkt >
     */
     void Send(const ZMsg::List & list)
     {
-        mInputQueue.enqueue(std::make_unique< ZMsg >(list));
+        Push(std::make_unique< ZMsg >(list));
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -513,11 +657,35 @@ struct ZSkt : SqChainedInstances< ZSkt >
     */
     void Send(ZMsg::List && list)
     {
-        mInputQueue.enqueue(std::make_unique< ZMsg >(std::move(list)));
+        Push(std::make_unique< ZMsg >(std::move(list)));
     }
 
 protected:
 
+    // --------------------------------------------------------------------------------------------
+    friend struct ZReactor;
+
+    /* --------------------------------------------------------------------------------------------
+     * Queue a message and let the reactor know there is something to send.
+    */
+    void Push(Item && item)
+    {
+        // Account for the queued data
+        mQueuedBytes += item->Bytes();
+        // Queue the message
+        mInputQueue.enqueue(std::move(item));
+        // Have it sent as soon as possible
+        ZReactor::Get().Wake();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * See if there are messages waiting to be sent.
+    */
+    SQMOD_NODISCARD bool Outgoing() const
+    {
+        return mPending || mInputQueue.size_approx() > 0;
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Receive one message from the socket.
     */
@@ -549,6 +717,8 @@ protected:
         // Did we have a message?
         if (r >= 0)
         {
+            // Account for the received data
+            mReceivedBytes += static_cast< uint64_t >(r);
             // Put it in the queue
             mOutputQueue.enqueue(std::move(item));
             // We received a message
@@ -588,7 +758,7 @@ protected:
                 // Abort everything
                 return false;
             }
-            // Ask for another message, if any (blocking operation!)
+            // Ask for another message, if any (multi-part messages arrive whole so this won't block)
             r = zmq_msg_recv(&msg, mPtr, 0);
             // Do we actually have a message?
             if (r >= 0)
@@ -604,6 +774,9 @@ protected:
         // Did we actually have any valid messages?
         if (!(item->mList.empty()))
         {
+            // Account for the received data
+            mReceivedBytes += item->Bytes();
+            // Put it in the queue
             mOutputQueue.enqueue(std::move(item));
             // Messages were present in the list
             return true;
@@ -613,64 +786,83 @@ protected:
     }
 
     /* --------------------------------------------------------------------------------------------
-     * Send one queued message to the socket.
+     * Send one queued message to the socket. Returns false if nothing could be sent.
     */
     bool Send()
     {
-        // Need someone to receive the message
-        Item data;
-        // Try to get a message from the queue
-        if (mInputQueue.try_dequeue(data))
+        // Retry the message that was not accepted last time or get one from the queue
+        if (!mPending && !mInputQueue.try_dequeue(mPending))
         {
-            if (data->mMulti)
-            {
-                SendMore(data->mList);
-            }
-            else
-            {
-                SendOne(data->mBuff);
-            }
-            // One item was found in the queue
-            return true;
+            return false; // No item in the queue
         }
-        else
+        // Attempt to send the message
+        if (!(mPending->mMulti ? SendMore(mPending->mList) : SendOne(mPending->mBuff)))
         {
-            return false; // No item in the queue
+            return false; // Try again once the socket is writable
         }
+        // The message is no longer queued
+        mQueuedBytes -= mPending->Bytes();
+        // Release it
+        mPending.reset();
+        // One item was processed
+        return true;
     }
 
     /* --------------------------------------------------------------------------------------------
-     * Send a single message to the socket.
+     * Send a single message to the socket. Returns false if the socket can't accept it right now.
     */
-    void SendOne(Buffer & buff) const
+    bool SendOne(Buffer & buff)
     {
         // Attempt to send the message
         int r = zmq_send(mPtr, buff.Data(), buff.Position(), ZMQ_DONTWAIT);
+        // Should we try again later?
+        if (r < 0 && zmq_errno() == EAGAIN)
+        {
+            return false;
+        }
         // Could we send what the message had?
-        if (r >= 0 && static_cast< Buffer::SzType >(r) != buff.Position())
+        else if (r < 0 || static_cast< Buffer::SzType >(r) != buff.Position())
         {
             LogErr("Unable to send data to socket: [%d], {%s}", r, zmq_strerror(errno));
-            // NOTE: Should we put the buffer back into the queue?
         }
+        else
+        {
+            // Account for the sent data
+            mSentBytes += static_cast< uint64_t >(r);
+        }
+        // We're done with this message
+        return true;
     }
 
     /* --------------------------------------------------------------------------------------------
-     * Send a multi-part message to the socket.
+     * Send a multi-part message to the socket. Returns false if the socket can't accept it right now.
     */
-    void SendMore(ZMsg::List & list) const
+    bool SendMore(ZMsg::List & list)
     {
         // Send all message parts
         for (size_t i = 0, n = list.size(); i < n; ++i)
         {
             // Attempt to send the message
-            int r = zmq_send(mPtr, list[i].Data(), list[i].Position(), (i + 1) == n ? ZMQ_DONTWAIT : ZMQ_SNDMORE);
+            int r = zmq_send(mPtr, list[i].Data(), list[i].Position(), (i + 1) == n ? ZMQ_DONTWAIT : (ZMQ_DONTWAIT | ZMQ_SNDMORE));
+            // Multi-part messages are atomic so only the first part can be refused
+            if (r < 0 && i == 0 && zmq_errno() == EAGAIN)
+            {
+                return false;
+            }
             // Could we send what the message had?
-            if (r >= 0 && static_cast< Buffer::SzType >(r) != list[i].Position())
+            else if (r < 0 || static_cast< Buffer::SzType >(r) != list[i].Position())
             {
                 LogErr("Unable to send multi-part data to socket: [%d], %s", r, zmq_strerror(errno));
                 // NOTE: Should we abort the whole thing? But we probably already sent some.
             }
+            else
+            {
+                // Account for the sent data
+                mSentBytes += static_cast< uint64_t >(r);
+            }
         }
+        // We're done with this message
+        return true;
     }
 };
 
@@ -919,6 +1111,30 @@ struct ZSocket
         return Valid().mStringMessages;
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of bytes waiting to be sent through the socket.
+    */
+    SQMOD_NODISCARD SQInteger GetQueuedBytes() const
+    {
+        return static_cast< SQInteger >(Valid().mQueuedBytes.load());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of bytes sent through the socket.
+    */
+    SQMOD_NODISCARD SQInteger GetSentBytes() const
+    {
+        return static_cast< SQInteger >(Valid().mSentBytes.load());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of bytes received from the socket.
+    */
+    SQMOD_NODISCARD SQInteger GetReceivedBytes() const
+    {
+        return static_cast< SQInteger >(Valid().mReceivedBytes.load());
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Instruct the socket to always deliver messages as strings instead of binary data.
     */
@@ -943,7 +1159,7 @@ struct ZSocket
     ZSocket & Bind(StackStrF & ep)
     {
         // Acquire exclusive access to the socket
-        std::lock_guard< std::mutex > guard(Valid().mMtx);
+        ZReactor::Lock guard;
         // Attempt to bind the socket
         int r = zmq_bind(Valid(), ep.mPtr);
         // Validate result
@@ -961,7 +1177,7 @@ struct ZSocket
     ZSocket & Connect(StackStrF & ep)
     {
         // Acquire exclusive access to the socket
-        std::lock_guard< std::mutex > guard(Valid().mMtx);
+        ZReactor::Lock guard;
         // Attempt to connect the socket
         int r = zmq_connect(Valid(), ep.mPtr);
         // Validate result
@@ -979,7 +1195,7 @@ struct ZSocket
     ZSocket & Disconnect(StackStrF & ep)
     {
         // Acquire exclusive access to the socket
-        std::lock_guard< std::mutex > guard(Valid().mMtx);
+        ZReactor::Lock guard;
         // Attempt to connect the socket
         int r = zmq_disconnect(Valid(), ep.mPtr);
         // Validate result
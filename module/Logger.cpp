@@ -9,6 +9,7 @@
 #include <cstring>
 #include <cstdarg>
 #include <memory>
+#include <chrono>
 
 // ------------------------------------------------------------------------------------------------
 #include <sqratUtil.h>
@@ -158,40 +159,66 @@ static inline const char * GetColoredLevelTagDim(uint8_t level)
 #endif // SQMOD_OS_WINDOWS
 
 /* ------------------------------------------------------------------------------------------------
- * Output a logging message to the console window.
+ * Output a logging message to the console window. The time-stamp is omitted if null.
 */
-static inline void OutputConsoleMessage(const Logger::MsgPtr & msg)
+static inline void OutputConsoleMessage(uint8_t lvl, bool sub, const char * tms, const char * str)
 {
 #ifdef SQMOD_OS_WINDOWS
     HANDLE hstdout = GetStdHandle(STD_OUTPUT_HANDLE);
     CONSOLE_SCREEN_BUFFER_INFO csb_state;
     GetConsoleScreenBufferInfo(hstdout, &csb_state);
-    SetConsoleTextAttribute(hstdout, GetLevelColor(msg->mLvl));
-    if (Logger::Get().ConsoleHasTime())
+    SetConsoleTextAttribute(hstdout, GetLevelColor(lvl));
+    if (tms)
     {
-        std::printf("%s %s ", GetLevelTag(msg->mLvl), msg->mBuf);
+        std::printf("%s %s ", GetLevelTag(lvl), tms);
     }
     else
     {
-        std::printf("%s ", GetLevelTag(msg->mLvl));
+        std::printf("%s ", GetLevelTag(lvl));
     }
-    SetConsoleTextAttribute(hstdout, msg->mSub ? LC_NORMAL : LC_WHITE);
-    std::printf("%s\n", msg->mStr.c_str());
+    SetConsoleTextAttribute(hstdout, sub ? LC_NORMAL : LC_WHITE);
+    std::printf("%s\n", str);
     SetConsoleTextAttribute(hstdout, csb_state.wAttributes);
 #else
-    if (Logger::Get().ConsoleHasTime())
+    if (tms)
     {
-        std::printf("%s %s %s\033[0m\n",
-                    msg->mSub ? GetColoredLevelTagDim(msg->mLvl) : GetColoredLevelTag(msg->mLvl), msg->mBuf, msg->mStr.c_str());
+        std::printf("%s %s %s\033[0m\n", sub ? GetColoredLevelTagDim(lvl) : GetColoredLevelTag(lvl), tms, str);
     }
     else
     {
-        std::printf("%s %s\033[0m\n",
-                    msg->mSub ? GetColoredLevelTagDim(msg->mLvl) : GetColoredLevelTag(msg->mLvl), msg->mStr.c_str());
+        std::printf("%s %s\033[0m\n", sub ? GetColoredLevelTagDim(lvl) : GetColoredLevelTag(lvl), str);
     }
 #endif // SQMOD_OS_WINDOWS
 }
 
+/* ------------------------------------------------------------------------------------------------
+ * Output a logging message to the console window.
+*/
+static inline void OutputConsoleMessage(const Logger::MsgPtr & msg)
+{
+    OutputConsoleMessage(msg->mLvl, msg->mSub, Logger::Get().ConsoleHasTime() ? msg->mBuf : nullptr, msg->mStr.c_str());
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Append a logging message to the output of a log file.
+*/
+static inline void AppendFileMessage(String & out, uint8_t lvl, const char * tms, const char * str, size_t len)
+{
+    // Write the level tag
+    out.append(GetLevelTag(lvl));
+    out.push_back(' ');
+    // Should we include the time-stamp?
+    if (tms)
+    {
+        out.append(tms);
+        out.push_back(' ');
+    }
+    // Write the message
+    out.append(str, len);
+    // Append a new line
+    out.push_back('\n');
+}
+
 // ------------------------------------------------------------------------------------------------
 Logger Logger::s_Inst;
 
@@ -287,6 +314,27 @@ Logger::Logger() noexcept
     , m_File(nullptr)
     , m_Filename()
     , m_LogCb{}
+    , m_CbLevels(0)
+    , m_Ring()
+    , m_RingMask(0)
+    , m_RingHead(0)
+    , m_RingTail(0)
+    , m_RingDone(0)
+    , m_Writer()
+    , m_WriterMutex()
+    , m_WriterCond()
+    , m_FileMutex()
+    , m_Batch()
+    , m_Async(false)
+    , m_Running(false)
+    , m_Sleeping(false)
+    , m_Producers(0)
+    , m_Overflow(LOGO_COUNT)
+    , m_Dropped(0)
+    , m_Unreported(0)
+    , m_TailMutex()
+    , m_Tail()
+    , m_TailSize(0)
 {
     /* ... */
 }
@@ -294,12 +342,19 @@ Logger::Logger() noexcept
 // ------------------------------------------------------------------------------------------------
 Logger::~Logger()
 {
+    // Stop the writer thread, if any
+    DisableAsync();
+    // Close the file, if any
     Close();
 }
 
 // ------------------------------------------------------------------------------------------------
 void Logger::Close()
 {
+    // Make sure pending messages end up in this file
+    Flush();
+    // Don't close the file while the writer thread uses it
+    std::lock_guard< std::mutex > guard(m_FileMutex);
     // Is there a file handle to close?
     if (m_File)
     {
@@ -337,6 +392,8 @@ void Logger::SetLogFilename(const char * filename)
     {
         return; // We're done here!
     }
+    // Don't assign the file while the writer thread uses it
+    std::lock_guard< std::mutex > guard(m_FileMutex);
     // Attempt to open the file for writing
     m_File = std::fopen(m_Filename.c_str(), "w");
     // See if the file could be opened
@@ -360,6 +417,15 @@ void Logger::BindCb(uint8_t level, Function & func)
     Function & cb = m_LogCb[idx];
     // Assign the specified environment and function
     cb = std::move(func);
+    // Remember which levels have a callback
+    if (cb.IsNull())
+    {
+        m_CbLevels.fetch_and(static_cast< uint8_t >(~level));
+    }
+    else
+    {
+        m_CbLevels.fetch_or(level);
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -378,6 +444,8 @@ void Logger::Terminate()
 {
     // Process whatever is in the queue
     ProcessQueue();
+    // Write whatever is in the buffer and stop the writer thread
+    DisableAsync();
     // Close the stream, if any
     Close();
 }
@@ -389,6 +457,8 @@ void Logger::Release()
     {
         f.Release();
     }
+    // No level has a callback anymore
+    m_CbLevels.store(0);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -408,10 +478,10 @@ void Logger::ProcessQueue()
 }
 
 // ------------------------------------------------------------------------------------------------
-SQBool Logger::ProcessCb()
+SQBool Logger::ProcessCb(const Message & msg)
 {
     // Get the index of this log level
-    const uint8_t idx = GetLevelIdx(m_Message->mLvl);
+    const uint8_t idx = GetLevelIdx(msg.mLvl);
     // Is the log level valid and is there a callback associated?
     if (idx > 6 || m_LogCb[idx].IsNull())
     {
@@ -427,9 +497,9 @@ SQBool Logger::ProcessCb()
     sq_pushobject(vm, fn.GetFunc());
     sq_pushobject(vm, fn.GetEnv());
     // Push the log message
-    sq_pushstring(vm, m_Message->mStr.c_str(), static_cast< SQInteger >(m_Message->mStr.size()));
+    sq_pushstring(vm, msg.mStr.c_str(), static_cast< SQInteger >(msg.mLen));
     // Specify whether this is a sub message
-    sq_pushbool(vm, static_cast< SQBool >(m_Message->mSub));
+    sq_pushbool(vm, static_cast< SQBool >(msg.mSub));
     // Make the function call and store the result
     SQRESULT res = sq_call(vm, 3, static_cast< SQBool >(true),
                            static_cast< SQBool >(ErrorHandling::IsEnabled()));
@@ -470,8 +540,16 @@ void Logger::PushMessage(MsgPtr & msg)
         msg->Finish();
         // Time-stamp the message
         msg->Stamp();
-        // Queue it for later
-        m_Queue.enqueue(std::move(msg));
+        // Can it skip the main thread? (callbacks can only be invoked from there)
+        if (IsAsync() && (m_CbLevels.load(std::memory_order_relaxed) & msg->mLvl) == 0)
+        {
+            Enqueue(*msg);
+        }
+        else
+        {
+            // Queue it for later
+            m_Queue.enqueue(std::move(msg));
+        }
     }
 }
 // ------------------------------------------------------------------------------------------------
@@ -523,7 +601,7 @@ void Logger::ProcessMessage()
         // Lock the logger to prevent a cyclic dependency
         m_CyclicLock = true;
         // Attempt to process the script callback first
-        const bool greedy = static_cast< bool >(ProcessCb());
+        const bool greedy = static_cast< bool >(ProcessCb(*m_Message));
         // Unlock the logger after the callback was invoked
         m_CyclicLock = false;
         // Is the callback for this level greedy?
@@ -532,6 +610,12 @@ void Logger::ProcessMessage()
             return;
         }
     }
+    // Should the writer thread deal with the output?
+    if (IsAsync())
+    {
+        Enqueue(*m_Message);
+        return;
+    }
     // Are we allowed to send this message level to console?
     if (m_ConsoleLevels & m_Message->mLvl)
     {
@@ -553,7 +637,397 @@ void Logger::ProcessMessage()
         std::fputs(m_Message->mStr.data(), m_File);
         // Append a new line
         std::fputc('\n', m_File);
+        // Make sure fatal messages are not lost
+        if (m_Message->mLvl == LOGL_FTL)
+        {
+            std::fflush(m_File);
+        }
+    }
+    // Keep it among the recent messages
+    Remember(m_Message->mLvl, m_Message->mStr.data(), m_Message->mLen);
+}
+
+// ------------------------------------------------------------------------------------------------
+Logger::Message & Logger::Scratch(uint8_t level, bool sub)
+{
+    // Each thread reuses the memory of its own builder
+    static thread_local Message s_Message;
+    // Reset the builder without releasing the memory
+    s_Message.mLvl = level;
+    s_Message.mSub = sub;
+    s_Message.mLen = 0;
+    s_Message.mTms = false;
+    // Return the builder
+    return s_Message;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Logger::PushAsync(Message & msg)
+{
+    // Finish the message
+    msg.Finish();
+    // Does the script want to see messages of this level?
+    if (m_CbLevels.load(std::memory_order_relaxed) & msg.mLvl)
+    {
+        // The callback could send messages of its own and reuse this builder
+        MsgPtr message(new Message(msg.mLvl, msg.mSub));
+        // Copy the message
+        message->Append(msg.mStr.data(), msg.mLen);
+        // Take the regular route which knows how to deal with callbacks
+        return PushMessage(message);
+    }
+    // Time-stamp the message, if necessary
+    if (m_ConsoleTime || m_LogFileTime)
+    {
+        msg.Stamp();
+    }
+    // Leave the output to the writer thread
+    Enqueue(msg);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Logger::Enqueue(const Message & msg)
+{
+    const bool console = (m_ConsoleLevels & msg.mLvl) != 0;
+    const bool file = (m_LogFileLevels & msg.mLvl) != 0;
+    // Is there anywhere to write this message?
+    if (!console && !file)
+    {
+        return true;
+    }
+    // Let DisableAsync() know that a message is being published
+    m_Producers.fetch_add(1, std::memory_order_seq_cst);
+    size_t pos = m_RingHead.load(std::memory_order_relaxed);
+    Slot * slot;
+    // Claim a slot
+    for (;;)
+    {
+        slot = &m_Ring[pos & m_RingMask];
+        // The sequence tells whether the writer is done with this slot
+        const size_t seq = slot->mSeq.load(std::memory_order_acquire);
+        const auto diff = static_cast< intptr_t >(seq) - static_cast< intptr_t >(pos);
+        // Is the slot available?
+        if (diff == 0)
+        {
+            // Attempt to claim it before other producers
+            if (m_RingHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        // Is the buffer full?
+        else if (diff < 0)
+        {
+            const uint8_t policy = m_Overflow.load(std::memory_order_relaxed);
+            // Should we wait for the writer to make room? (only if there's a writer to wait for)
+            if (policy == LOGO_BLOCK && m_Running.load(std::memory_order_relaxed))
+            {
+                WakeWriter();
+                std::this_thread::yield();
+                // Try again
+                pos = m_RingHead.load(std::memory_order_relaxed);
+                continue;
+            }
+            // Discard the message
+            m_Dropped.fetch_add(1, std::memory_order_relaxed);
+            // Should it be reported later?
+            if (policy == LOGO_COUNT)
+            {
+                m_Unreported.fetch_add(1, std::memory_order_relaxed);
+            }
+            m_Producers.fetch_sub(1, std::memory_order_seq_cst);
+            return false;
+        }
+        // Another producer claimed it first
+        else
+        {
+            pos = m_RingHead.load(std::memory_order_relaxed);
+        }
+    }
+    // Copy the message into the slot (reuses the memory of previous messages)
+    slot->mStr.assign(msg.mStr.data(), msg.mLen);
+    slot->mLvl = msg.mLvl;
+    slot->mSub = msg.mSub;
+    slot->mConsole = console;
+    slot->mFile = file;
+    slot->mConsoleTime = m_ConsoleTime;
+    slot->mFileTime = m_LogFileTime;
+    std::memcpy(slot->mBuf, msg.mBuf, sizeof(slot->mBuf));
+    // Hand the slot over to the writer
+    slot->mSeq.store(pos + 1, std::memory_order_release);
+    // The message is published
+    m_Producers.fetch_sub(1, std::memory_order_seq_cst);
+    // Did the writer stop while the message was published? (it might not have seen the message)
+    if (!m_Running.load(std::memory_order_seq_cst))
+    {
+        Drain();
+        return true;
+    }
+    // Make sure the writer doesn't sleep through this message
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // Is the writer waiting for messages?
+    if (m_Sleeping.load(std::memory_order_relaxed))
+    {
+        WakeWriter();
+    }
+    // Fatal messages must reach their destination before anything else happens
+    if (msg.mLvl == LOGL_FTL)
+    {
+        Flush();
+    }
+    // The message was buffered
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Logger::WakeWriter()
+{
+    {
+        // Acquire the lock so the notification can't be missed
+        std::lock_guard< std::mutex > guard(m_WriterMutex);
+    }
+    m_WriterCond.notify_one();
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t Logger::Drain()
+{
+    // Number of messages written
+    size_t n = 0;
+    // Don't let the file be closed while writing
+    std::lock_guard< std::mutex > guard(m_FileMutex);
+    // Write every message that is ready
+    for (;;)
+    {
+        Slot & slot = m_Ring[m_RingTail & m_RingMask];
+        // Was a message published in this slot?
+        if (slot.mSeq.load(std::memory_order_acquire) != m_RingTail + 1)
+        {
+            break;
+        }
+        // Are we allowed to send this message to console?
+        if (slot.mConsole)
+        {
+            OutputConsoleMessage(slot.mLvl, slot.mSub, slot.mConsoleTime ? slot.mBuf : nullptr, slot.mStr.c_str());
+        }
+        // Are we allowed to write it to a file?
+        if (slot.mFile && m_File)
+        {
+            AppendFileMessage(m_Batch, slot.mLvl, slot.mFileTime ? slot.mBuf : nullptr, slot.mStr.data(), slot.mStr.size());
+        }
+        // Keep it among the recent messages
+        Remember(slot.mLvl, slot.mStr.data(), slot.mStr.size());
+        // Give the slot back to the producers
+        slot.mSeq.store(m_RingTail + m_RingMask + 1, std::memory_order_release);
+        ++m_RingTail;
+        ++n;
+        // Don't let the batch grow without limits during a storm
+        if (m_Batch.size() >= 65536)
+        {
+            std::fwrite(m_Batch.data(), 1, m_Batch.size(), m_File);
+            m_Batch.clear();
+        }
+    }
+    const size_t lost = m_Unreported.exchange(0, std::memory_order_relaxed);
+    // Were any messages discarded in the meantime?
+    if (lost)
+    {
+        char buffer[128];
+        // Generate the notice
+        const int len = std::snprintf(buffer, sizeof(buffer), "%zu log messages were discarded because the buffer was full", lost);
+        // Output it like any other warning
+        if (m_ConsoleLevels & LOGL_WRN)
+        {
+            OutputConsoleMessage(LOGL_WRN, true, nullptr, buffer);
+        }
+        if (m_File && (m_LogFileLevels & LOGL_WRN))
+        {
+            AppendFileMessage(m_Batch, LOGL_WRN, nullptr, buffer, static_cast< size_t >(len));
+        }
+    }
+    // Write the gathered file output at once
+    if (m_File && !m_Batch.empty())
+    {
+        std::fwrite(m_Batch.data(), 1, m_Batch.size(), m_File);
+        m_Batch.clear();
+    }
+    // Push the output to its destination
+    if (n || lost)
+    {
+        std::fflush(stdout);
+        // Is there a file?
+        if (m_File)
+        {
+            std::fflush(m_File);
+        }
     }
+    // Let others know how far we got
+    m_RingDone.store(m_RingTail, std::memory_order_release);
+    // Return the number of written messages
+    return n;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Logger::WriterLoop()
+{
+    while (m_Running.load(std::memory_order_acquire))
+    {
+        // Was there anything to write?
+        if (Drain() != 0)
+        {
+            continue;
+        }
+        std::unique_lock< std::mutex > lock(m_WriterMutex);
+        // Let producers know that they have to wake us up
+        m_Sleeping.store(true, std::memory_order_seq_cst);
+        // Was anything published in the meantime?
+        if (m_Ring[m_RingTail & m_RingMask].mSeq.load(std::memory_order_seq_cst) != m_RingTail + 1 &&
+            m_Running.load(std::memory_order_relaxed))
+        {
+            m_WriterCond.wait_for(lock, std::chrono::milliseconds(100));
+        }
+        m_Sleeping.store(false, std::memory_order_relaxed);
+    }
+    // Write whatever is left
+    Drain();
+}
+
+// ------------------------------------------------------------------------------------------------
+void Logger::EnableAsync(size_t slots)
+{
+    // Is the writer already running?
+    if (m_Running.load())
+    {
+        return;
+    }
+    // Allocate the buffer the first time
+    if (!m_Ring)
+    {
+        size_t n = 64;
+        // Round the number of slots to a power of two
+        while (n < slots && n < (1u << 20u))
+        {
+            n <<= 1u;
+        }
+        m_Ring.reset(new Slot[n]);
+        m_RingMask = n - 1;
+        // Prepare each slot so that it can be claimed and written without allocating
+        for (size_t i = 0; i < n; ++i)
+        {
+            m_Ring[i].mSeq.store(i, std::memory_order_relaxed);
+            m_Ring[i].mStr.reserve(256);
+        }
+        m_RingHead.store(0);
+        m_RingTail = 0;
+        m_RingDone.store(0);
+    }
+    // Start the writer thread
+    m_Running.store(true);
+    m_Writer = std::thread(&Logger::WriterLoop, this);
+    // Messages can go through the buffer now
+    m_Async.store(true);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Logger::DisableAsync()
+{
+    // Is the writer even running?
+    if (!m_Running.load())
+    {
+        return;
+    }
+    // Messages are written by the sender from now on
+    m_Async.store(false);
+    // Tell the writer thread to stop after it writes whatever is left
+    m_Running.store(false);
+    WakeWriter();
+    // Wait for it to finish
+    m_Writer.join();
+    // Wait for the producers that were already publishing a message
+    while (m_Producers.load(std::memory_order_seq_cst) != 0)
+    {
+        std::this_thread::yield();
+    }
+    // Write anything that was published while it was stopping. Producers that start publishing
+    // from now on see that the writer stopped and write their own message
+    Drain();
+}
+
+// ------------------------------------------------------------------------------------------------
+void Logger::Flush()
+{
+    // Is there a writer thread?
+    if (!m_Running.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    // Wait for everything claimed until now
+    const size_t target = m_RingHead.load(std::memory_order_acquire);
+    // Wait for the writer to get there
+    while (m_RingDone.load(std::memory_order_acquire) < target && m_Running.load(std::memory_order_relaxed))
+    {
+        // Is the writer waiting for messages?
+        if (m_Sleeping.load(std::memory_order_relaxed))
+        {
+            WakeWriter();
+        }
+        std::this_thread::yield();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Logger::SetOverflow(uint8_t policy)
+{
+    // Is this a known policy?
+    if (policy > LOGO_COUNT)
+    {
+        STHROWF("Unknown log overflow policy: {}", int(policy));
+    }
+    m_Overflow.store(policy, std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Logger::Remember(uint8_t level, const char * str, size_t len)
+{
+    const size_t max = m_TailSize.load(std::memory_order_relaxed);
+    // Are recent messages kept?
+    if (max == 0)
+    {
+        return;
+    }
+    // Messages are remembered from the main thread and the writer thread
+    std::lock_guard< std::mutex > guard(m_TailMutex);
+    // Reuse the memory of the oldest message, if there are enough
+    String line;
+    if (m_Tail.size() >= max)
+    {
+        line = std::move(m_Tail.front());
+        m_Tail.pop_front();
+    }
+    // Generate the line
+    line.assign(GetLevelTag(level)).append(1, ' ').append(str, len);
+    // Remember it
+    m_Tail.push_back(std::move(line));
+}
+
+// ------------------------------------------------------------------------------------------------
+void Logger::SetTailSize(size_t count)
+{
+    std::lock_guard< std::mutex > guard(m_TailMutex);
+    // Forget the messages above the new limit
+    while (m_Tail.size() > count)
+    {
+        m_Tail.pop_front();
+    }
+    m_TailSize.store(count, std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Logger::GetTail(std::vector< String > & out)
+{
+    std::lock_guard< std::mutex > guard(m_TailMutex);
+    // Copy the messages in the order they were sent
+    out.assign(m_Tail.begin(), m_Tail.end());
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -562,6 +1036,15 @@ void Logger::Send(uint8_t level, bool sub, const char * msg)
     // Is this level even allowed?
     if ((m_ConsoleLevels & level) || (m_LogFileLevels & level))
     {
+        // Can we skip the allocation?
+        if (IsAsync())
+        {
+            Message & message = Scratch(level, sub);
+            // Generate the log message
+            message.Append(msg);
+            // Leave it to the writer thread
+            return PushAsync(message);
+        }
         // Create a new message builder
         MsgPtr message(new Message(level, sub));
         // Generate the log message
@@ -577,6 +1060,15 @@ void Logger::Send(uint8_t level, bool sub, const char * msg, size_t len)
     // Is this level even allowed?
     if ((m_ConsoleLevels & level) || (m_LogFileLevels & level))
     {
+        // Can we skip the allocation?
+        if (IsAsync())
+        {
+            Message & message = Scratch(level, sub);
+            // Generate the log message
+            message.Append(msg, len);
+            // Leave it to the writer thread
+            return PushAsync(message);
+        }
         // Create a new message builder
         MsgPtr message(new Message(level, sub));
         // Generate the log message
@@ -592,6 +1084,15 @@ void Logger::SendFv(uint8_t level, bool sub, const char * fmt, va_list args)
     // Is this level even allowed?
     if ((m_ConsoleLevels & level) || (m_LogFileLevels & level))
     {
+        // Can we skip the allocation?
+        if (IsAsync())
+        {
+            Message & message = Scratch(level, sub);
+            // Generate the log message
+            message.AppendFv(fmt, args);
+            // Leave it to the writer thread
+            return PushAsync(message);
+        }
         // Create a new message builder
         MsgPtr message(new Message(level, sub));
         // Generate the log message
@@ -609,6 +1110,17 @@ void Logger::WriteF(uint8_t level, bool sub, const char * fmt, ...)
         // Initialize the variable argument list
         va_list args;
         va_start(args, fmt);
+        // Can we skip the allocation?
+        if (IsAsync())
+        {
+            Message & message = Scratch(level, sub);
+            // Generate the log message
+            message.AppendFv(fmt, args);
+            // Finalize the variable argument list
+            va_end(args);
+            // Leave it to the writer thread
+            return PushAsync(message);
+        }
         // Create a new message builder
         MsgPtr message(new Message(level, sub));
         // Generate the log message
@@ -1109,6 +1621,48 @@ static void SqLogSetStringTruncate(SQInteger nc)
     Logger::Get().SetStringTruncate(ConvTo< uint32_t >::From(nc));
 }
 
+// ------------------------------------------------------------------------------------------------
+static void SqLogEnableAsync(SQInteger slots)
+{
+    Logger::Get().EnableAsync(ConvTo< size_t >::From(slots));
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqLogDisableAsync()
+{
+    Logger::Get().DisableAsync();
+}
+
+// ------------------------------------------------------------------------------------------------
+static bool SqLogIsAsync()
+{
+    return Logger::Get().IsAsync();
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqLogFlush()
+{
+    Logger::Get().Flush();
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqLogSetOverflow(SQInteger policy)
+{
+    Logger::Get().SetOverflow(ConvTo< uint8_t >::From(policy));
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqLogGetOverflow()
+{
+    return static_cast< SQInteger >(Logger::Get().GetOverflow());
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqLogGetDropped()
+{
+    return static_cast< SQInteger >(Logger::Get().GetDropped());
+}
+
 // ================================================================================================
 void Register_Log(HSQUIRRELVM vm)
 {
@@ -1155,6 +1709,13 @@ void Register_Log(HSQUIRRELVM vm)
         .Func(_SC("SetLogFilename"), &SqLogSetLogFilename)
         .Func(_SC("GetStringTruncate"), &SqLogGetStringTruncate)
         .Func(_SC("SetStringTruncate"), &SqLogSetStringTruncate)
+        .Func(_SC("EnableAsync"), &SqLogEnableAsync)
+        .Func(_SC("DisableAsync"), &SqLogDisableAsync)
+        .Func(_SC("IsAsync"), &SqLogIsAsync)
+        .Func(_SC("Flush"), &SqLogFlush)
+        .Func(_SC("SetOverflow"), &SqLogSetOverflow)
+        .Func(_SC("GetOverflow"), &SqLogGetOverflow)
+        .Func(_SC("GetDropped"), &SqLogGetDropped)
     );
 }
 
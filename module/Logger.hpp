@@ -8,7 +8,13 @@
 #include <string>
 
 // ------------------------------------------------------------------------------------------------
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <vector>
 #include <thread>
+#include <memory>
+#include <condition_variable>
 
 // ------------------------------------------------------------------------------------------------
 #include <sqratFunction.h>
@@ -33,6 +39,16 @@ enum LogLvl
     LOGL_ANY = 0xFFu
 };
 
+/* ------------------------------------------------------------------------------------------------
+ * Supported policies when the asynchronous message buffer is full.
+*/
+enum LogOverflow
+{
+    LOGO_DROP = 0, // Discard the message.
+    LOGO_BLOCK, // Wait for the writer thread to make room.
+    LOGO_COUNT // Discard the message and report how many were discarded once there's room.
+};
+
 /* ------------------------------------------------------------------------------------------------
  * Class responsible for logging output.
 */
@@ -118,6 +134,23 @@ protected:
         uint32_t AppendFv(const SQChar * str, va_list vl);
     };
 
+    /* --------------------------------------------------------------------------------------------
+     * Pre-allocated message slot of the asynchronous buffer.
+    */
+    struct Slot
+    {
+        // ----------------------------------------------------------------------------------------
+        std::atomic< size_t >   mSeq{0}; // Sequence number which tells who owns the slot.
+        String                  mStr{}; // Message string. Keeps its capacity between messages.
+        uint8_t                 mLvl{LOGL_NIL}; // Message level.
+        bool                    mSub{false}; // Message hierarchy.
+        bool                    mConsole{false}; // Whether the message goes to console.
+        bool                    mFile{false}; // Whether the message goes to the log file.
+        bool                    mConsoleTime{false}; // Whether console output is time-stamped.
+        bool                    mFileTime{false}; // Whether log file output is time-stamped.
+        char                    mBuf[Message::TMS_LEN]{'\0'}; // Message time-stamp.
+    };
+
 public:
 
     /* --------------------------------------------------------------------------------------------
@@ -172,6 +205,35 @@ private:
 
     // --------------------------------------------------------------------------------------------
     Function        m_LogCb[7]; //Callback to receive debug information instead of console.
+    std::atomic< uint8_t > m_CbLevels; // Levels which have a callback associated.
+
+    // --------------------------------------------------------------------------------------------
+    std::unique_ptr< Slot[] >   m_Ring; // Bounded multi-producer/single-consumer message buffer.
+    size_t                      m_RingMask; // Number of slots minus one. (always a power of two)
+    std::atomic< size_t >       m_RingHead; // Next position to be claimed by producers.
+    size_t                      m_RingTail; // Next position to be written. (writer thread only)
+    std::atomic< size_t >       m_RingDone; // Number of messages written so far.
+
+    // --------------------------------------------------------------------------------------------
+    std::thread                 m_Writer; // Thread which writes the messages from the buffer.
+    std::mutex                  m_WriterMutex; // Used to put the writer to sleep when idle.
+    std::condition_variable     m_WriterCond; // Used to wake the writer up.
+    std::mutex                  m_FileMutex; // Prevents the file from being closed while written.
+    String                      m_Batch; // File output gathered by the writer before a single write.
+    std::atomic< bool >         m_Async; // Whether messages go through the asynchronous buffer.
+    std::atomic< bool >         m_Running; // Whether the writer thread should keep running.
+    std::atomic< bool >         m_Sleeping; // Whether the writer thread waits for messages.
+    std::atomic< size_t >       m_Producers; // Number of threads currently publishing a message.
+
+    // --------------------------------------------------------------------------------------------
+    std::atomic< uint8_t >      m_Overflow; // What to do when the buffer is full.
+    std::atomic< size_t >       m_Dropped; // Messages discarded because the buffer was full.
+    std::atomic< size_t >       m_Unreported; // Discarded messages that were not reported yet.
+
+    // --------------------------------------------------------------------------------------------
+    std::mutex                  m_TailMutex; // Guards the recent messages.
+    std::deque< String >        m_Tail; // Most recent messages that reached their destination.
+    std::atomic< size_t >       m_TailSize; // Number of recent messages to remember. (0 to disable)
 
 protected:
 
@@ -190,6 +252,41 @@ protected:
     */
     void ProcessMessage();
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the message builder of the calling thread to be reused by the asynchronous mode.
+    */
+    static Message & Scratch(uint8_t level, bool sub);
+
+    /* --------------------------------------------------------------------------------------------
+     * Push a message generated in the builder of the calling thread in asynchronous mode.
+    */
+    void PushAsync(Message & msg);
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy a finished message into the asynchronous buffer. Returns false if it was discarded.
+    */
+    bool Enqueue(const Message & msg);
+
+    /* --------------------------------------------------------------------------------------------
+     * Wake the writer thread if it waits for messages.
+    */
+    void WakeWriter();
+
+    /* --------------------------------------------------------------------------------------------
+     * Write the messages that are available in the buffer. Returns the number of messages written.
+    */
+    size_t Drain();
+
+    /* --------------------------------------------------------------------------------------------
+     * Writer thread entry point.
+    */
+    void WriterLoop();
+
+    /* --------------------------------------------------------------------------------------------
+     * Remember a message that reached its destination, if recent messages are kept.
+    */
+    void Remember(uint8_t level, const char * str, size_t len);
+
 public:
 
     /* --------------------------------------------------------------------------------------------
@@ -245,6 +342,69 @@ public:
     */
     void ProcessQueue();
 
+    /* --------------------------------------------------------------------------------------------
+     * Move console and file output to a dedicated writer thread. The number of slots is rounded
+     * to a power of two and only has effect the first time since the buffer is kept afterwards.
+    */
+    void EnableAsync(size_t slots);
+
+    /* --------------------------------------------------------------------------------------------
+     * Write the remaining messages and go back to writing them from the calling thread.
+    */
+    void DisableAsync();
+
+    /* --------------------------------------------------------------------------------------------
+     * See whether messages are written from a dedicated thread.
+    */
+    SQMOD_NODISCARD bool IsAsync() const
+    {
+        return m_Async.load(std::memory_order_relaxed);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Wait until the messages sent so far were written.
+    */
+    void Flush();
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify what happens to messages when the asynchronous buffer is full.
+    */
+    void SetOverflow(uint8_t policy);
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the number of recent messages to remember. (0 to disable)
+    */
+    void SetTailSize(size_t count);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of recent messages to remember.
+    */
+    SQMOD_NODISCARD size_t GetTailSize() const
+    {
+        return m_TailSize.load(std::memory_order_relaxed);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy the recent messages, oldest first. Safe to call from any thread.
+    */
+    void GetTail(std::vector< String > & out);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve what happens to messages when the asynchronous buffer is full.
+    */
+    SQMOD_NODISCARD uint8_t GetOverflow() const
+    {
+        return m_Overflow.load(std::memory_order_relaxed);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of messages discarded because the asynchronous buffer was full.
+    */
+    SQMOD_NODISCARD size_t GetDropped() const
+    {
+        return m_Dropped.load(std::memory_order_relaxed);
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Enable or disable console message time stamping.
     */
@@ -444,7 +604,7 @@ private:
     /* --------------------------------------------------------------------------------------------
      * Forward the log message to a callback.
     */
-    SQBool ProcessCb();
+    SQBool ProcessCb(const Message & msg);
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -1,6 +1,7 @@
 // ------------------------------------------------------------------------------------------------
 #include "Logger.hpp"
 #include "Core.hpp"
+#include "Core/Metrics.hpp"
 
 // ------------------------------------------------------------------------------------------------
 #include <cstdio>
@@ -27,7 +28,10 @@ extern void InitializePocoDataConnectors();
 extern void ProcessRoutines();
 extern void ProcessTasks();
 extern void ProcessThreads();
+extern void ProcessPromises();
 extern void ProcessNet();
+extern void ProcessLoot();
+extern void ProcessMetrics();
 #ifdef SQMOD_DISCORD
     extern void ProcessDiscord();
 #endif
@@ -155,6 +159,8 @@ static void OnServerShutdown()
         // Deallocate and release everything obtained at startup
         Core::Get().Terminate(true);
         curl_global_cleanup();
+        // Write pending log messages and stop the writer thread
+        Logger::Get().Terminate();
         SQMOD_SV_EV_TRACEBACK("[TRACE>] OnServerShutdown")
     }
     SQMOD_CATCH_EVENT_EXCEPTION(OnServerShutdown)
@@ -165,6 +171,9 @@ static void OnServerShutdown()
 // ------------------------------------------------------------------------------------------------
 static void OnServerFrame(float elapsed_time)
 {
+    // Measure the time spent by the plug-in in this frame
+    const MetricScope frame_ms(Metrics::Get().FrameTimes());
+    Metrics::Get().RecordTick(elapsed_time);
     // Attempt to forward the event
     try
     {
@@ -178,14 +187,20 @@ static void OnServerFrame(float elapsed_time)
     ProcessTasks();
     // Process threads
     ProcessThreads();
+    // Resume coroutines waiting for settled promises
+    ProcessPromises();
     // Process network
     ProcessNet();
+    // Process loot managers
+    ProcessLoot();
     // Process Discord
 #ifdef SQMOD_DISCORD
     ProcessDiscord();
 #endif
     // Process log messages from other threads
     Logger::Get().ProcessQueue();
+    // Publish metrics, if enabled
+    ProcessMetrics();
     // See if a reload was requested
     SQMOD_RELOAD_CHECK(g_Reload)
 }
@@ -193,6 +208,7 @@ static void OnServerFrame(float elapsed_time)
 // ------------------------------------------------------------------------------------------------
 static uint8_t OnPluginCommand(uint32_t command_identifier, const char * message)
 {
+    SQMOD_EVENT_METRIC(OnPluginCommand)
     // Mark the initialization as successful by default
     const CoreState cs(SQMOD_SUCCESS);
     // Attempt to forward the event
@@ -213,6 +229,7 @@ static uint8_t OnPluginCommand(uint32_t command_identifier, const char * message
 static uint8_t OnIncomingConnection(char * player_name, size_t name_buffer_size,
                                     const char * user_password, const char * ip_address)
 {
+    SQMOD_EVENT_METRIC(OnIncomingConnection)
     // Mark the initialization as successful by default
     const CoreState cs(SQMOD_SUCCESS);
     // Attempt to forward the event
@@ -232,6 +249,7 @@ static uint8_t OnIncomingConnection(char * player_name, size_t name_buffer_size,
 // ------------------------------------------------------------------------------------------------
 static void OnClientScriptData(int32_t player_id, const uint8_t * data, size_t size)
 {
+    SQMOD_EVENT_METRIC(OnClientScriptData)
     // Attempt to forward the event
     try
     {
@@ -247,6 +265,7 @@ static void OnClientScriptData(int32_t player_id, const uint8_t * data, size_t s
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerConnect(int32_t player_id)
 {
+    SQMOD_EVENT_METRIC(OnPlayerConnect)
     // Attempt to forward the event
     try
     {
@@ -262,6 +281,7 @@ static void OnPlayerConnect(int32_t player_id)
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerDisconnect(int32_t player_id, vcmpDisconnectReason reason)
 {
+    SQMOD_EVENT_METRIC(OnPlayerDisconnect)
     // Attempt to forward the event
     try
     {
@@ -285,6 +305,7 @@ static void OnPlayerDisconnect(int32_t player_id, vcmpDisconnectReason reason)
 // ------------------------------------------------------------------------------------------------
 static uint8_t OnPlayerRequestClass(int32_t player_id, int32_t offset)
 {
+    SQMOD_EVENT_METRIC(OnPlayerRequestClass)
     // Mark the initialization as successful by default
     const CoreState cs(SQMOD_SUCCESS);
     // Attempt to forward the event
@@ -304,6 +325,7 @@ static uint8_t OnPlayerRequestClass(int32_t player_id, int32_t offset)
 // ------------------------------------------------------------------------------------------------
 static uint8_t OnPlayerRequestSpawn(int32_t player_id)
 {
+    SQMOD_EVENT_METRIC(OnPlayerRequestSpawn)
     // Mark the initialization as successful by default
     const CoreState cs(SQMOD_SUCCESS);
     // Attempt to forward the event
@@ -323,6 +345,7 @@ static uint8_t OnPlayerRequestSpawn(int32_t player_id)
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerSpawn(int32_t player_id)
 {
+    SQMOD_EVENT_METRIC(OnPlayerSpawn)
     // Attempt to forward the event
     try
     {
@@ -338,6 +361,7 @@ static void OnPlayerSpawn(int32_t player_id)
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerDeath(int32_t player_id, int32_t killer_id, int32_t reason, vcmpBodyPart body_part)
 {
+    SQMOD_EVENT_METRIC(OnPlayerDeath)
     // Attempt to forward the event
     try
     {
@@ -362,6 +386,7 @@ static void OnPlayerDeath(int32_t player_id, int32_t killer_id, int32_t reason,
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerUpdate(int32_t player_id, vcmpPlayerUpdate update_type)
 {
+    SQMOD_EVENT_METRIC(OnPlayerUpdate)
     // Attempt to forward the event
     try
     {
@@ -377,6 +402,7 @@ static void OnPlayerUpdate(int32_t player_id, vcmpPlayerUpdate update_type)
 // ------------------------------------------------------------------------------------------------
 static uint8_t OnPlayerRequestEnterVehicle(int32_t player_id, int32_t vehicle_id, int32_t slot_index)
 {
+    SQMOD_EVENT_METRIC(OnPlayerRequestEnterVehicle)
     // Mark the initialization as successful by default
     const CoreState cs(SQMOD_SUCCESS);
     // Attempt to forward the event
@@ -396,6 +422,7 @@ static uint8_t OnPlayerRequestEnterVehicle(int32_t player_id, int32_t vehicle_id
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerEnterVehicle(int32_t player_id, int32_t vehicle_id, int32_t slot_index)
 {
+    SQMOD_EVENT_METRIC(OnPlayerEnterVehicle)
     // Attempt to forward the event
     try
     {
@@ -411,6 +438,7 @@ static void OnPlayerEnterVehicle(int32_t player_id, int32_t vehicle_id, int32_t
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerExitVehicle(int32_t player_id, int32_t vehicle_id)
 {
+    SQMOD_EVENT_METRIC(OnPlayerExitVehicle)
     // Attempt to forward the event
     try
     {
@@ -426,6 +454,7 @@ static void OnPlayerExitVehicle(int32_t player_id, int32_t vehicle_id)
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerNameChange(int32_t player_id, const char * old_name, const char * new_name)
 {
+    SQMOD_EVENT_METRIC(OnPlayerNameChange)
     // Attempt to forward the event
     try
     {
@@ -441,6 +470,7 @@ static void OnPlayerNameChange(int32_t player_id, const char * old_name, const c
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerStateChange(int32_t player_id, vcmpPlayerState old_state, vcmpPlayerState new_state)
 {
+    SQMOD_EVENT_METRIC(OnPlayerStateChange)
     // Look for changes
     if (old_state == new_state)
     {
@@ -493,6 +523,7 @@ static void OnPlayerStateChange(int32_t player_id, vcmpPlayerState old_state, vc
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerActionChange(int32_t player_id, int32_t old_action, int32_t new_action)
 {
+    SQMOD_EVENT_METRIC(OnPlayerActionChange)
     // Look for changes
     if (old_action == new_action)
     {
@@ -557,6 +588,7 @@ static void OnPlayerActionChange(int32_t player_id, int32_t old_action, int32_t
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerOnFireChange(int32_t player_id, uint8_t is_on_fire)
 {
+    SQMOD_EVENT_METRIC(OnPlayerOnFireChange)
     // Attempt to forward the event
     try
     {
@@ -572,6 +604,7 @@ static void OnPlayerOnFireChange(int32_t player_id, uint8_t is_on_fire)
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerCrouchChange(int32_t player_id, uint8_t is_crouching)
 {
+    SQMOD_EVENT_METRIC(OnPlayerCrouchChange)
     // Attempt to forward the event
     try
     {
@@ -587,6 +620,7 @@ static void OnPlayerCrouchChange(int32_t player_id, uint8_t is_crouching)
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerGameKeysChange(int32_t player_id, uint32_t old_keys, uint32_t new_keys)
 {
+    SQMOD_EVENT_METRIC(OnPlayerGameKeysChange)
     // Attempt to forward the event
     try
     {
@@ -602,6 +636,7 @@ static void OnPlayerGameKeysChange(int32_t player_id, uint32_t old_keys, uint32_
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerBeginTyping(int32_t player_id)
 {
+    SQMOD_EVENT_METRIC(OnPlayerBeginTyping)
     // Attempt to forward the event
     try
     {
@@ -617,6 +652,7 @@ static void OnPlayerBeginTyping(int32_t player_id)
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerEndTyping(int32_t player_id)
 {
+    SQMOD_EVENT_METRIC(OnPlayerEndTyping)
     // Attempt to forward the event
     try
     {
@@ -632,6 +668,7 @@ static void OnPlayerEndTyping(int32_t player_id)
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerAwayChange(int32_t player_id, uint8_t is_away)
 {
+    SQMOD_EVENT_METRIC(OnPlayerAwayChange)
     // Attempt to forward the event
     try
     {
@@ -647,6 +684,7 @@ static void OnPlayerAwayChange(int32_t player_id, uint8_t is_away)
 // ------------------------------------------------------------------------------------------------
 static uint8_t OnPlayerMessage(int32_t player_id, const char * message)
 {
+    SQMOD_EVENT_METRIC(OnPlayerMessage)
     // Mark the initialization as successful by default
     const CoreState cs(SQMOD_SUCCESS);
     // Attempt to forward the event
@@ -666,6 +704,7 @@ static uint8_t OnPlayerMessage(int32_t player_id, const char * message)
 // ------------------------------------------------------------------------------------------------
 static uint8_t OnPlayerCommand(int32_t player_id, const char * message)
 {
+    SQMOD_EVENT_METRIC(OnPlayerCommand)
     // Mark the initialization as successful by default
     const CoreState cs(SQMOD_SUCCESS);
     // Attempt to forward the event
@@ -685,6 +724,7 @@ static uint8_t OnPlayerCommand(int32_t player_id, const char * message)
 // ------------------------------------------------------------------------------------------------
 static uint8_t OnPlayerPrivateMessage(int32_t player_id, int32_t target_player_id, const char * message)
 {
+    SQMOD_EVENT_METRIC(OnPlayerPrivateMessage)
     // Mark the initialization as successful by default
     const CoreState cs(SQMOD_SUCCESS);
     // Attempt to forward the event
@@ -704,6 +744,7 @@ static uint8_t OnPlayerPrivateMessage(int32_t player_id, int32_t target_player_i
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerKeyBindDown(int32_t player_id, int32_t bind_id)
 {
+    SQMOD_EVENT_METRIC(OnPlayerKeyBindDown)
     // Attempt to forward the event
     try
     {
@@ -719,6 +760,7 @@ static void OnPlayerKeyBindDown(int32_t player_id, int32_t bind_id)
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerKeyBindUp(int32_t player_id, int32_t bind_id)
 {
+    SQMOD_EVENT_METRIC(OnPlayerKeyBindUp)
     // Attempt to forward the event
     try
     {
@@ -734,6 +776,7 @@ static void OnPlayerKeyBindUp(int32_t player_id, int32_t bind_id)
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerSpectate(int32_t player_id, int32_t target_player_id)
 {
+    SQMOD_EVENT_METRIC(OnPlayerSpectate)
     // Attempt to forward the event
     try
     {
@@ -756,6 +799,7 @@ static void OnPlayerSpectate(int32_t player_id, int32_t target_player_id)
 // ------------------------------------------------------------------------------------------------
 static void OnPlayerCrashReport(int32_t player_id, const char * report)
 {
+    SQMOD_EVENT_METRIC(OnPlayerCrashReport)
     // Attempt to forward the event
     try
     {
@@ -770,6 +814,7 @@ static void OnPlayerCrashReport(int32_t player_id, const char * report)
 
 static void OnPlayerModuleList(int32_t player_id, const char * list)
 {
+    SQMOD_EVENT_METRIC(OnPlayerModuleList)
     // Attempt to forward the event
     try
     {
@@ -785,6 +830,7 @@ static void OnPlayerModuleList(int32_t player_id, const char * list)
 // ------------------------------------------------------------------------------------------------
 static void OnVehicleUpdate(int32_t vehicle_id, vcmpVehicleUpdate update_type)
 {
+    SQMOD_EVENT_METRIC(OnVehicleUpdate)
     // Attempt to forward the event
     try
     {
@@ -800,6 +846,7 @@ static void OnVehicleUpdate(int32_t vehicle_id, vcmpVehicleUpdate update_type)
 // ------------------------------------------------------------------------------------------------
 static void OnVehicleExplode(int32_t vehicle_id)
 {
+    SQMOD_EVENT_METRIC(OnVehicleExplode)
     // Attempt to forward the event
     try
     {
@@ -815,6 +862,7 @@ static void OnVehicleExplode(int32_t vehicle_id)
 // ------------------------------------------------------------------------------------------------
 static void OnVehicleRespawn(int32_t vehicle_id)
 {
+    SQMOD_EVENT_METRIC(OnVehicleRespawn)
     // Attempt to forward the event
     try
     {
@@ -830,6 +878,7 @@ static void OnVehicleRespawn(int32_t vehicle_id)
 // ------------------------------------------------------------------------------------------------
 static void OnObjectShot(int32_t object_id, int32_t player_id, int32_t weapon_id)
 {
+    SQMOD_EVENT_METRIC(OnObjectShot)
     // Attempt to forward the event
     try
     {
@@ -845,6 +894,7 @@ static void OnObjectShot(int32_t object_id, int32_t player_id, int32_t weapon_id
 // ------------------------------------------------------------------------------------------------
 static void OnObjectTouched(int32_t object_id, int32_t player_id)
 {
+    SQMOD_EVENT_METRIC(OnObjectTouched)
     // Attempt to forward the event
     try
     {
@@ -860,6 +910,7 @@ static void OnObjectTouched(int32_t object_id, int32_t player_id)
 // ------------------------------------------------------------------------------------------------
 static uint8_t OnPickupPickAttempt(int32_t pickup_id, int32_t player_id)
 {
+    SQMOD_EVENT_METRIC(OnPickupPickAttempt)
     // Mark the initialization as successful by default
     const CoreState cs(SQMOD_SUCCESS);
     // Attempt to forward the event
@@ -879,6 +930,7 @@ static uint8_t OnPickupPickAttempt(int32_t pickup_id, int32_t player_id)
 // ------------------------------------------------------------------------------------------------
 static void OnPickupPicked(int32_t pickup_id, int32_t player_id)
 {
+    SQMOD_EVENT_METRIC(OnPickupPicked)
     // Attempt to forward the event
     try
     {
@@ -894,6 +946,7 @@ static void OnPickupPicked(int32_t pickup_id, int32_t player_id)
 // ------------------------------------------------------------------------------------------------
 static void OnPickupRespawn(int32_t pickup_id)
 {
+    SQMOD_EVENT_METRIC(OnPickupRespawn)
     // Attempt to forward the event
     try
     {
@@ -909,6 +962,7 @@ static void OnPickupRespawn(int32_t pickup_id)
 // ------------------------------------------------------------------------------------------------
 static void OnCheckpointEntered(int32_t checkpoint_id, int32_t player_id)
 {
+    SQMOD_EVENT_METRIC(OnCheckpointEntered)
     // Attempt to forward the event
     try
     {
@@ -924,6 +978,7 @@ static void OnCheckpointEntered(int32_t checkpoint_id, int32_t player_id)
 // ------------------------------------------------------------------------------------------------
 static void OnCheckpointExited(int32_t checkpoint_id, int32_t player_id)
 {
+    SQMOD_EVENT_METRIC(OnCheckpointExited)
     // Attempt to forward the event
     try
     {
@@ -939,6 +994,7 @@ static void OnCheckpointExited(int32_t checkpoint_id, int32_t player_id)
 // ------------------------------------------------------------------------------------------------
 static void OnEntityPoolChange(vcmpEntityPool entity_type, int32_t entity_id, uint8_t is_deleted)
 {
+    SQMOD_EVENT_METRIC(OnEntityPoolChange)
     // Attempt to forward the event
     try
     {
@@ -955,6 +1011,7 @@ static void OnEntityPoolChange(vcmpEntityPool entity_type, int32_t entity_id, ui
 #if SQMOD_SDK_LEAST(2, 1)
 static void OnEntityStreamingChange(int32_t player_id, int32_t entity_id, vcmpEntityPool entity_type, uint8_t is_deleted)
 {
+    SQMOD_EVENT_METRIC(OnEntityStreamingChange)
     // Attempt to forward the event
     try
     {
@@ -563,6 +563,36 @@ void FirstMatches(Iterator first, Iterator last,
     }
 }
 
+/* ------------------------------------------------------------------------------------------------
+ * Collect all elements at the specified positions within the range.
+*/
+template < typename Iterator, typename Inspector, typename Collector >
+void EachSlot(Iterator first, const TagIndex::Slots & slots, Inspector inspect, Collector collect)
+{
+    for (const TagIndex::Slot slot : slots)
+    {
+        if (inspect(*(first + slot)))
+        {
+            collect(*(first + slot));
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Collect all elements at the specified positions within the range while the collector returns true.
+*/
+template < typename Iterator, typename Inspector, typename Collector >
+void EachSlotWhile(Iterator first, const TagIndex::Slots & slots, Inspector inspect, Collector collect)
+{
+    for (const TagIndex::Slot slot : slots)
+    {
+        if (inspect(*(first + slot)) && !collect(*(first + slot)))
+        {
+            break;
+        }
+    }
+}
+
 /* ------------------------------------------------------------------------------------------------
  * Used to work with entity instances in a template fashion.
 */
@@ -607,6 +637,14 @@ template <> struct InstSpec< CBlip >
     {
         return Core::Get().GetNullBlip();
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Index of the active entities by tag.
+    */
+    static inline const TagIndex & Tags()
+    {
+        return Core::Get().GetEntityTags(ENT_BLIP);
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -648,6 +686,14 @@ template <> struct InstSpec< CCheckpoint >
     {
         return Core::Get().GetNullCheckpoint();
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Index of the active entities by tag.
+    */
+    static inline const TagIndex & Tags()
+    {
+        return Core::Get().GetEntityTags(ENT_CHECKPOINT);
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -689,6 +735,14 @@ template <> struct InstSpec< CKeyBind >
     {
         return Core::Get().GetNullKeyBind();
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Index of the active entities by tag.
+    */
+    static inline const TagIndex & Tags()
+    {
+        return Core::Get().GetEntityTags(ENT_KEYBIND);
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -730,6 +784,14 @@ template <> struct InstSpec< CObject >
     {
         return Core::Get().GetNullObject();
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Index of the active entities by tag.
+    */
+    static inline const TagIndex & Tags()
+    {
+        return Core::Get().GetEntityTags(ENT_OBJECT);
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -771,6 +833,14 @@ template <> struct InstSpec< CPickup >
     {
         return Core::Get().GetNullPickup();
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Index of the active entities by tag.
+    */
+    static inline const TagIndex & Tags()
+    {
+        return Core::Get().GetEntityTags(ENT_PICKUP);
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -812,6 +882,14 @@ template <> struct InstSpec< CPlayer >
     {
         return Core::Get().GetNullPlayer();
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Index of the active entities by tag.
+    */
+    static inline const TagIndex & Tags()
+    {
+        return Core::Get().GetEntityTags(ENT_PLAYER);
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -853,6 +931,14 @@ template <> struct InstSpec< CVehicle >
     {
         return Core::Get().GetNullVehicle();
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Index of the active entities by tag.
+    */
+    static inline const TagIndex & Tags()
+    {
+        return Core::Get().GetEntityTags(ENT_VEHICLE);
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -1229,8 +1315,16 @@ public:
         const StackGuard sg;
         // Allocate an empty array on the stack
         sq_newarray(SqVM(), 0);
+        // Can we use the tag index?
+        if (cs && !neg)
+        {
+            EachSlot(Inst::CBegin(), Inst::Tags().Find(tag), ValidInst(), AppendElem());
+        }
         // Process each entity in the pool
-        EachEquals(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(), AppendElem(), tag, !neg, cs);
+        else
+        {
+            EachEquals(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(), AppendElem(), tag, !neg, cs);
+        }
         // Return the array at the top of the stack
         return Var< Array >(SqVM(), -1).value;
     }
@@ -1245,8 +1339,18 @@ public:
         const StackGuard sg;
         // Allocate an empty array on the stack
         sq_newarray(SqVM(), 0);
+        // Can we use the tag index?
+        if (cs && !neg)
+        {
+            TagIndex::Slots slots;
+            Inst::Tags().Prefix(tag, slots);
+            EachSlot(Inst::CBegin(), slots, ValidInst(), AppendElem());
+        }
         // Process each entity in the pool
-        EachBegins(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(), AppendElem(), tag, strlen(tag), !neg, cs);
+        else
+        {
+            EachBegins(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(), AppendElem(), tag, strlen(tag), !neg, cs);
+        }
         // Return the array at the top of the stack
         return Var< Array >(SqVM(), -1).value;
     }
@@ -1307,9 +1411,22 @@ public:
         SQMOD_VALID_TAG_STR(tag)
         // Create a new element receiver
         RecvElem recv;
+        // Can we use the tag index?
+        if (cs && !neg)
+        {
+            TagIndex::Slot slot;
+            // Is there an entity with this tag?
+            if (Inst::Tags().First(tag, slot))
+            {
+                recv(*(Inst::CBegin() + slot));
+            }
+        }
         // Process each entity in the pool
-        FirstEquals(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(),
-                        std::reference_wrapper< RecvElem >(recv), tag, !neg, cs);
+        else
+        {
+            FirstEquals(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(),
+                            std::reference_wrapper< RecvElem >(recv), tag, !neg, cs);
+        }
         // Return the received element, if any
         return recv.mObj;
     }
@@ -1322,9 +1439,23 @@ public:
         SQMOD_VALID_TAG_STR(tag)
         // Create a new element receiver
         RecvElem recv;
+        // Can we use the tag index?
+        if (cs && !neg)
+        {
+            TagIndex::Slots slots;
+            Inst::Tags().Prefix(tag, slots);
+            // Is there an entity with this tag?
+            if (!slots.empty())
+            {
+                recv(*(Inst::CBegin() + slots.front()));
+            }
+        }
         // Process each entity in the pool
-        FirstBegins(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(),
-                        std::reference_wrapper< RecvElem >(recv), tag, strlen(tag), !neg, cs);
+        else
+        {
+            FirstBegins(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(),
+                            std::reference_wrapper< RecvElem >(recv), tag, strlen(tag), !neg, cs);
+        }
         // Return the received element, if any
         return recv.mObj;
     }
@@ -1410,9 +1541,18 @@ public:
         SQMOD_VALID_TAG_STR(tag)
         // Create a new element forwarder
         ForwardElem fwd(func);
+        // Can we use the tag index? (copy the slots since callbacks may change tags)
+        if (cs && !neg)
+        {
+            EachSlotWhile(Inst::CBegin(), TagIndex::Slots(Inst::Tags().Find(tag)), ValidInst(),
+                            std::reference_wrapper< ForwardElem >(fwd));
+        }
         // Process each entity in the pool
-        EachEqualsWhile(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(),
-                        std::reference_wrapper< ForwardElem >(fwd), tag, !neg, cs);
+        else
+        {
+            EachEqualsWhile(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(),
+                            std::reference_wrapper< ForwardElem >(fwd), tag, !neg, cs);
+        }
         // Return the forward count
         return fwd.mCount;
     }
@@ -1425,9 +1565,18 @@ public:
         SQMOD_VALID_TAG_STR(tag)
         // Create a new element forwarder
         ForwardElemData fwd(data, func);
+        // Can we use the tag index? (copy the slots since callbacks may change tags)
+        if (cs && !neg)
+        {
+            EachSlotWhile(Inst::CBegin(), TagIndex::Slots(Inst::Tags().Find(tag)), ValidInst(),
+                            std::reference_wrapper< ForwardElemData >(fwd));
+        }
         // Process each entity in the pool
-        EachEqualsWhile(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(),
-                        std::reference_wrapper< ForwardElemData >(fwd), tag, !neg, cs);
+        else
+        {
+            EachEqualsWhile(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(),
+                            std::reference_wrapper< ForwardElemData >(fwd), tag, !neg, cs);
+        }
         // Return the forward count
         return fwd.mCount;
     }
@@ -1440,9 +1589,19 @@ public:
         SQMOD_VALID_TAG_STR(tag)
         // Create a new element forwarder
         ForwardElem fwd(func);
+        // Can we use the tag index?
+        if (cs && !neg)
+        {
+            TagIndex::Slots slots;
+            Inst::Tags().Prefix(tag, slots);
+            EachSlotWhile(Inst::CBegin(), slots, ValidInst(), std::reference_wrapper< ForwardElem >(fwd));
+        }
         // Process each entity in the pool
-        EachBeginsWhile(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(),
-                        std::reference_wrapper< ForwardElem >(fwd), tag, strlen(tag), !neg, cs);
+        else
+        {
+            EachBeginsWhile(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(),
+                            std::reference_wrapper< ForwardElem >(fwd), tag, strlen(tag), !neg, cs);
+        }
         // Return the forward count
         return fwd.mCount;
     }
@@ -1455,9 +1614,19 @@ public:
         SQMOD_VALID_TAG_STR(tag)
         // Create a new element forwarder
         ForwardElemData fwd(data, func);
+        // Can we use the tag index?
+        if (cs && !neg)
+        {
+            TagIndex::Slots slots;
+            Inst::Tags().Prefix(tag, slots);
+            EachSlotWhile(Inst::CBegin(), slots, ValidInst(), std::reference_wrapper< ForwardElemData >(fwd));
+        }
         // Process each entity in the pool
-        EachBeginsWhile(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(),
-                        std::reference_wrapper< ForwardElemData >(fwd), tag, strlen(tag), !neg, cs);
+        else
+        {
+            EachBeginsWhile(Inst::CBegin(), Inst::CEnd(), ValidInst(), InstTag(),
+                            std::reference_wrapper< ForwardElemData >(fwd), tag, strlen(tag), !neg, cs);
+        }
         // Return the forward count
         return fwd.mCount;
     }
@@ -1572,6 +1741,11 @@ public:
     static inline uint32_t CountWhereTagEquals(bool neg, bool cs, const SQChar * tag)
     {
         SQMOD_VALID_TAG_STR(tag)
+        // Can we use the tag index?
+        if (cs && !neg)
+        {
+            return static_cast< uint32_t >(Inst::Tags().Find(tag).size());
+        }
         // Create a new element counter
         CountElem cnt;
         // Process each entity in the pool
@@ -1587,6 +1761,11 @@ public:
     static inline uint32_t CountWhereTagBegins(bool neg, bool cs, const SQChar * tag)
     {
         SQMOD_VALID_TAG_STR(tag)
+        // Can we use the tag index?
+        if (cs && !neg)
+        {
+            return static_cast< uint32_t >(Inst::Tags().CountPrefix(tag));
+        }
         // Create a new element counter
         CountElem cnt;
         // Process each entity in the pool
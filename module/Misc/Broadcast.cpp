@@ -1,6 +1,7 @@
 // ------------------------------------------------------------------------------------------------
 #include "Core.hpp"
 #include "Base/Color3.hpp"
+#include "Base/Color4.hpp"
 #include "Entity/Player.hpp"
 
 // ------------------------------------------------------------------------------------------------
@@ -21,6 +22,55 @@ static inline bool SqCanBeInteger(HSQUIRRELVM vm, int32_t idx)
     }
 }
 
+/* ------------------------------------------------------------------------------------------------
+ * Retrieve the native instance at the specified stack index if its type tag matches exactly.
+*/
+template < class T > static inline T * SqGetTaggedInstance(HSQUIRRELVM vm, int32_t idx, SQUserPointer tag)
+{
+    // Does the type tag match?
+    if (tag == nullptr || tag != StaticClassTypeTag< T >::Get())
+    {
+        return nullptr;
+    }
+    std::pair< T *, SharedPtr< std::unordered_map< T *, HSQOBJECT > > > * inst = nullptr;
+    // The type is known so the user pointer can be retrieved directly
+    sq_getinstanceup(vm, idx, reinterpret_cast< SQUserPointer * >(&inst), nullptr);
+    // Was the instance constructed?
+    return inst ? inst->first : nullptr;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Slow path for color instances that do not have a native type tag. (script classes which extend them)
+*/
+static SQRESULT SqGrabInheritedColor(HSQUIRRELVM vm, int32_t idx, uint32_t & color)
+{
+    // Whether it failed to retrieve a Color3 value
+    bool failed = false;
+    // Attempt to extract a Color3 value
+    try
+    {
+        color = (Var< Color3 >(vm, idx).value.GetRGBA() | 0xFFu);
+    }
+    catch (...)
+    {
+        failed = true;
+    }
+    // Did we failed to retrieve a Color3 instance?
+    if (failed)
+    {
+        // Attempt to extract a Color4 value
+        try
+        {
+            color = Var< Color4 >(vm, idx).value.GetRGBA();
+        }
+        catch (const std::exception & e)
+        {
+            return sq_throwerror(vm, e.what());
+        }
+    }
+    return SQ_OK;
+}
+
 // ------------------------------------------------------------------------------------------------
 SQRESULT SqGrabPlayerMessageColor(HSQUIRRELVM vm, int32_t idx, uint32_t & color, int32_t & msg_idx)
 {
@@ -28,28 +78,27 @@ SQRESULT SqGrabPlayerMessageColor(HSQUIRRELVM vm, int32_t idx, uint32_t & color,
     // Is the color argument a Color3/Color4 instance?
     if (sq_gettype(vm, idx) == OT_INSTANCE)
     {
-        // Whether it failed to retrieve a Color3 value
-        bool failed = false;
-        // Attempt to extract a Color3 value
-        try
+        SQUserPointer tag = nullptr;
+        // Identify the type of instance from its tag instead of trying each type
+        sq_gettypetag(vm, idx, &tag);
+        // Is this a Color3 instance?
+        if (const Color3 * c3 = SqGetTaggedInstance< Color3 >(vm, idx, tag))
         {
-            color = (Var< Color3 >(vm, idx).value.GetRGBA() | 0xFFu);
+            color = (c3->GetRGBA() | 0xFFu);
         }
-        catch (...)
+        // Is this a Color4 instance?
+        else if (const Color4 * c4 = SqGetTaggedInstance< Color4 >(vm, idx, tag))
         {
-            failed = true;
+            color = c4->GetRGBA();
         }
-        // Did we failed to retrieve a Color3 instance?
-        if (failed)
+        // Possibly a script class that extends one of them
+        else
         {
-            // Attempt to extract a Color4 value
-            try
-            {
-                color = Var< Color4 >(vm, idx).value.GetRGBA();
-            }
-            catch (const std::exception & e)
+            const SQRESULT res = SqGrabInheritedColor(vm, idx, color);
+            // Did we fail to retrieve a color?
+            if (SQ_FAILED(res))
             {
-                return sq_throwerror(vm, e.what());
+                return res; // Propagate the error!
             }
         }
         // The message starts right after the color
@@ -298,7 +347,7 @@ static SQInteger SqBroadcastMsg(HSQUIRRELVM vm)
         }
     }
 
-    // Push the count count on the stack
+    // Push the count on the stack
     sq_pushinteger(vm, count);
     // Specify that this function returned a value
     return 1;
@@ -386,7 +435,7 @@ static SQInteger SqBroadcastMsgP(HSQUIRRELVM vm)
         }
     }
 
-    // Push the count count on the stack
+    // Push the count on the stack
     sq_pushinteger(vm, count);
     // Specify that this function returned a value
     return 1;
@@ -491,7 +540,7 @@ static SQInteger SqBroadcastMsgEx(HSQUIRRELVM vm)
         }
     }
 
-    // Push the count count on the stack
+    // Push the count on the stack
     sq_pushinteger(vm, count);
     // Specify that this function returned a value
     return 1;
@@ -547,7 +596,7 @@ static SQInteger SqBroadcastMessage(HSQUIRRELVM vm)
         }
     }
 
-    // Push the count count on the stack
+    // Push the count on the stack
     sq_pushinteger(vm, count);
     // Specify that this function returned a value
     return 1;
@@ -608,7 +657,7 @@ static SQInteger SqBroadcastAnnounce(HSQUIRRELVM vm)
         }
     }
 
-    // Push the count count on the stack
+    // Push the count on the stack
     sq_pushinteger(vm, count);
     // Specify that this function returned a value
     return 1;
@@ -685,7 +734,286 @@ static SQInteger SqBroadcastAnnounceEx(HSQUIRRELVM vm)
         }
     }
 
-    // Push the count count on the stack
+    // Push the count on the stack
+    sq_pushinteger(vm, count);
+    // Specify that this function returned a value
+    return 1;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Retrieve the player identified by the broadcast target at the specified stack index.
+ * The player is left null if the target refers to a player that is not connected.
+*/
+static SQRESULT SqGrabTargetPlayer(HSQUIRRELVM vm, SQInteger idx, CPlayer * & player)
+{
+    // Don't keep the player from a previous target
+    player = nullptr;
+    // The identifier of the targeted player
+    int32_t id = -1;
+    // Identify the type of target
+    switch (sq_gettype(vm, idx))
+    {
+        case OT_INTEGER:
+        {
+            SQInteger v = -1;
+            // Retrieve the player identifier
+            sq_getinteger(vm, idx, &v);
+            // Clamp it to the range of identifiers
+            id = ConvTo< int32_t >::From(v);
+        } break;
+        case OT_INSTANCE:
+        {
+            SQUserPointer tag = nullptr;
+            // Identify the type of instance from its tag
+            sq_gettypetag(vm, idx, &tag);
+            // Retrieve the player instance
+            const CPlayer * inst = SqGetTaggedInstance< CPlayer >(vm, idx, tag);
+            // Is this a player instance?
+            if (inst == nullptr)
+            {
+                return sq_throwerror(vm, "Broadcast target is not a player instance");
+            }
+            id = inst->GetID();
+        } break;
+        // Null targets are simply ignored
+        case OT_NULL: break;
+        default: return sq_throwerrorf(vm, "Invalid broadcast target type: %s", SqTypeName(sq_gettype(vm, idx)));
+    }
+    // Is this identifier within range?
+    if (VALID_ENTITYEX(id, SQMOD_PLAYER_POOL))
+    {
+        const PlayerInst & inst = Core::Get().GetPlayer(id);
+        // Is this player connected?
+        player = VALID_ENTITY(inst.mID) ? inst.mInst : nullptr;
+    }
+    // At this point we've identified the player
+    return SQ_OK;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Invoke the functor for every connected player from a broadcast target. The target can be a
+ * player instance, a player identifier or an array of those which was filtered beforehand.
+*/
+template < class F > static SQRESULT SqForeachTarget(HSQUIRRELVM vm, SQInteger idx, F f)
+{
+    CPlayer * player = nullptr;
+    // Is this a single target?
+    if (sq_gettype(vm, idx) != OT_ARRAY)
+    {
+        const SQRESULT res = SqGrabTargetPlayer(vm, idx, player);
+        // Anything to send to?
+        return (SQ_FAILED(res) || player == nullptr) ? res : f(*player);
+    }
+    const SQInteger size = sq_getsize(vm, idx);
+    // Process each target from the array
+    for (SQInteger i = 0; i < size; ++i)
+    {
+        sq_pushinteger(vm, i);
+        // Retrieve the target at this index
+        if (SQ_FAILED(sq_get(vm, idx)))
+        {
+            return sq_throwerrorf(vm, "Unable to retrieve broadcast target %lld", static_cast< long long >(i));
+        }
+        SQRESULT res = SqGrabTargetPlayer(vm, -1, player);
+        // The target is not needed anymore
+        sq_poptop(vm);
+        // Anything to send to?
+        if (SQ_SUCCEEDED(res) && player != nullptr)
+        {
+            res = f(*player);
+        }
+        // Did we fail to send?
+        if (SQ_FAILED(res))
+        {
+            return res; // Propagate the error!
+        }
+    }
+    // At this point we've processed all targets
+    return SQ_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqBroadcastMsgTo(HSQUIRRELVM vm)
+{
+    const auto top = static_cast< int32_t >(sq_gettop(vm));
+    // Were the targets specified?
+    if (top <= 1)
+    {
+        return sq_throwerror(vm, "Missing message targets");
+    }
+    // Was the message color specified?
+    else if (top <= 2)
+    {
+        return sq_throwerror(vm, "Missing message color");
+    }
+    // Was the message value specified?
+    else if (top <= 3)
+    {
+        return sq_throwerror(vm, "Missing message value");
+    }
+
+    // The index where the message should start
+    int32_t msg_idx = 3;
+    // The message color
+    uint32_t color = 0;
+    // Attempt to identify and extract the color
+    SQRESULT res = SqGrabPlayerMessageColor(vm, 3, color, msg_idx);
+    // Did we fail to identify a color?
+    if (SQ_FAILED(res))
+    {
+        return res; // Propagate the error!
+    }
+
+    // Attempt to generate the string value (only once for all targets)
+    StackStrF val(vm, msg_idx);
+    // Have we failed to retrieve the string?
+    if (SQ_FAILED(val.Proc(true)))
+    {
+        return val.mRes; // Propagate the error!
+    }
+
+    // The number of players that the message was sent to
+    uint32_t count = 0;
+    // Send the message to each target
+    res = SqForeachTarget(vm, 2, [&](CPlayer & player) -> SQRESULT {
+        // Send the resulted message string
+        const vcmpError result = _Func->SendClientMessage(player.GetID(), color,
+                                                    "%s%s%s",
+                                                    player.mMessagePrefix.c_str(),
+                                                    val.mPtr,
+                                                    player.mMessagePostfix.c_str());
+        // Check the result
+        if (result == vcmpErrorTooLargeInput)
+        {
+            return sq_throwerrorf(vm, "Client message too big [%s]", player.GetTag().c_str());
+        }
+        // Add this player to the count
+        ++count;
+        // Move to the next target
+        return SQ_OK;
+    });
+    // Did we fail to send the message?
+    if (SQ_FAILED(res))
+    {
+        return res; // Propagate the error!
+    }
+
+    // Push the count on the stack
+    sq_pushinteger(vm, count);
+    // Specify that this function returned a value
+    return 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqBroadcastMessageTo(HSQUIRRELVM vm)
+{
+    const auto top = static_cast< int32_t >(sq_gettop(vm));
+    // Were the targets specified?
+    if (top <= 1)
+    {
+        return sq_throwerror(vm, "Missing message targets");
+    }
+    // Was the message value specified?
+    else if (top <= 2)
+    {
+        return sq_throwerror(vm, "Missing message value");
+    }
+
+    // Attempt to generate the string value (only once for all targets)
+    StackStrF val(vm, 3);
+    // Have we failed to retrieve the string?
+    if (SQ_FAILED(val.Proc(true)))
+    {
+        return val.mRes; // Propagate the error!
+    }
+
+    // The number of players that the message was sent to
+    uint32_t count = 0;
+    // Send the message to each target
+    const SQRESULT res = SqForeachTarget(vm, 2, [&](CPlayer & player) -> SQRESULT {
+        // Send the resulted message string
+        const vcmpError result = _Func->SendClientMessage(player.GetID(), player.mMessageColor,
+                                                            "%s%s%s",
+                                                            player.mMessagePrefix.c_str(),
+                                                            val.mPtr,
+                                                            player.mMessagePostfix.c_str());
+        // Check the result
+        if (result == vcmpErrorTooLargeInput)
+        {
+            return sq_throwerrorf(vm, "Client message too big [%s]", player.GetTag().c_str());
+        }
+        // Add this player to the count
+        ++count;
+        // Move to the next target
+        return SQ_OK;
+    });
+    // Did we fail to send the message?
+    if (SQ_FAILED(res))
+    {
+        return res; // Propagate the error!
+    }
+
+    // Push the count on the stack
+    sq_pushinteger(vm, count);
+    // Specify that this function returned a value
+    return 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqBroadcastAnnounceTo(HSQUIRRELVM vm)
+{
+    const auto top = static_cast< int32_t >(sq_gettop(vm));
+    // Were the targets specified?
+    if (top <= 1)
+    {
+        return sq_throwerror(vm, "Missing announcement targets");
+    }
+    // Was the announcement value specified?
+    else if (top <= 2)
+    {
+        return sq_throwerror(vm, "Missing announcement value");
+    }
+
+    // Attempt to generate the string value (only once for all targets)
+    StackStrF val(vm, 3);
+    // Have we failed to retrieve the string?
+    if (SQ_FAILED(val.Proc(true)))
+    {
+        return val.mRes; // Propagate the error!
+    }
+
+    // The number of players that the announcement was sent to
+    uint32_t count = 0;
+    // Send the announcement to each target
+    const SQRESULT res = SqForeachTarget(vm, 2, [&](CPlayer & player) -> SQRESULT {
+        // Send the resulted announcement string
+        const vcmpError result = _Func->SendGameMessage(player.GetID(), player.mAnnounceStyle,
+                                                        "%s%s%s",
+                                                        player.mAnnouncePrefix.c_str(),
+                                                        val.mPtr,
+                                                        player.mAnnouncePostfix.c_str());
+        // Validate the result
+        if (result == vcmpErrorArgumentOutOfBounds)
+        {
+            return sq_throwerrorf(vm, "Invalid announcement style %d [%s]",
+                                            player.mAnnounceStyle, player.GetTag().c_str());
+        }
+        else if (result == vcmpErrorTooLargeInput)
+        {
+            return sq_throwerrorf(vm, "Game message too big [%s]", player.GetTag().c_str());
+        }
+        // Add this player to the count
+        ++count;
+        // Move to the next target
+        return SQ_OK;
+    });
+    // Did we fail to send the announcement?
+    if (SQ_FAILED(res))
+    {
+        return res; // Propagate the error!
+    }
+
+    // Push the count on the stack
     sq_pushinteger(vm, count);
     // Specify that this function returned a value
     return 1;
@@ -704,7 +1032,11 @@ void Register_Broadcast(HSQUIRRELVM vm)
     .SquirrelFunc(_SC("Announce"), &SqBroadcastAnnounce)
     .SquirrelFunc(_SC("AnnounceEx"), &SqBroadcastAnnounceEx)
     .SquirrelFunc(_SC("Text"), &SqBroadcastAnnounce)
-    .SquirrelFunc(_SC("TextEx"), &SqBroadcastAnnounceEx);
+    .SquirrelFunc(_SC("TextEx"), &SqBroadcastAnnounceEx)
+    .SquirrelFunc(_SC("MsgTo"), &SqBroadcastMsgTo)
+    .SquirrelFunc(_SC("MessageTo"), &SqBroadcastMessageTo)
+    .SquirrelFunc(_SC("AnnounceTo"), &SqBroadcastAnnounceTo)
+    .SquirrelFunc(_SC("TextTo"), &SqBroadcastAnnounceTo);
 
     RootTable(vm).Bind(_SC("SqBroadcast"), bns);
 }
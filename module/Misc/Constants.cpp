@@ -1,5 +1,7 @@
 // ------------------------------------------------------------------------------------------------
 #include "Core/Common.hpp"
+#include "Core/TimerQueue.hpp"
+#include "Logger.hpp"
 
 // ------------------------------------------------------------------------------------------------
 #include <sqratConst.h>
@@ -51,8 +53,8 @@ static const EnumElement g_SqMod[] = {
     {_SC("Infinity"),       INFINITY},
     {_SC("Inf"),            INFINITY},
     {_SC("Nan"),            NAN},
-    {_SC("MaxTasks"),       SQMOD_MAX_TASKS},
-    {_SC("MaxRoutines"),    SQMOD_MAX_ROUTINES},
+    {_SC("MaxTasks"),       std::numeric_limits< TimerQueue::Slot >::max()},
+    {_SC("MaxRoutines"),    std::numeric_limits< TimerQueue::Slot >::max()},
     {_SC("MaxBlips"),       SQMOD_BLIP_POOL},
     {_SC("MaxCheckpoints"), SQMOD_CHECKPOINT_POOL},
     {_SC("MaxKeybinds"),    SQMOD_KEYBIND_POOL},
@@ -287,6 +289,27 @@ static const EnumElement g_VehicleUpdateEnum[] = {
     {_SC("Max"),            vcmpVehicleUpdateRotation}
 };
 
+// ------------------------------------------------------------------------------------------------
+static const EnumElement g_EntityStateEnum[] = {
+    {_SC("None"),           ESC_NONE},
+    {_SC("Heading"),        ESC_HEADING},
+    {_SC("Position"),       ESC_POSITION},
+    {_SC("Health"),         ESC_HEALTH},
+    {_SC("Armor"),          ESC_ARMOUR},
+    {_SC("Armour"),         ESC_ARMOUR},
+    {_SC("Weapon"),         ESC_WEAPON},
+    {_SC("Rotation"),       ESC_ROTATION},
+    {_SC("Color"),          ESC_COLOR},
+    {_SC("Colour"),         ESC_COLOR}
+};
+
+// ------------------------------------------------------------------------------------------------
+static const EnumElement g_LogOverflowEnum[] = {
+    {_SC("Drop"),           LOGO_DROP},
+    {_SC("Block"),          LOGO_BLOCK},
+    {_SC("Count"),          LOGO_COUNT}
+};
+
 // ------------------------------------------------------------------------------------------------
 static const EnumElement g_PlayerVehicleEnum[] = {
     {_SC("Unknown"),        SQMOD_UNKNOWN},
@@ -1244,6 +1267,8 @@ static const EnumElements g_EnumList[] = {
     {_SC("SqEntityPool"),               g_EntityPoolEnum},
     {_SC("SqPlayerUpdate"),             g_PlayerUpdateEnum},
     {_SC("SqVehicleUpdate"),            g_VehicleUpdateEnum},
+    {_SC("SqEntityState"),              g_EntityStateEnum},
+    {_SC("SqLogOverflow"),              g_LogOverflowEnum},
     {_SC("SqPlayerVehicle"),            g_PlayerVehicleEnum},
     {_SC("SqVehicleSync"),              g_VehicleSyncEnum},
     {_SC("SqPartReason"),               g_PartReasonEnum},
@@ -542,6 +542,7 @@ struct SQLiteAsyncExec : public ThreadPoolItem
     LightObj        mQueryObj{}; // Strong reference to the query string object.
     // --------------------------------------------------------------------------------------------
     LightObj        mCtx{}; // User specified context object, if any.
+    PromiseRef      mPromise{}; // Promise to settle when completed, if any.
     // --------------------------------------------------------------------------------------------
     String          mError{}; // Error message, if any.
 
@@ -565,6 +566,19 @@ struct SQLiteAsyncExec : public ThreadPoolItem
     */
     SQMOD_NODISCARD const char * IdentifiableInfo() noexcept override { return mQueryStr; }
 
+    /* --------------------------------------------------------------------------------------------
+     * Database queries are processed before other tasks.
+    */
+    SQMOD_NODISCARD ThreadPoolLane Lane() noexcept override { return TPLANE_HIGH; }
+
+    /* --------------------------------------------------------------------------------------------
+     * Tasks on the same database handle must not run concurrently.
+    */
+    SQMOD_NODISCARD uintptr_t Affinity() noexcept override
+    {
+        return mConnection ? reinterpret_cast< uintptr_t >(mConnection->mPtr) : 0;
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Invoked in worker thread by the thread pool after obtaining the task from the queue.
      * Must return true to indicate that the task can be performed. False indicates failure.
@@ -619,6 +633,18 @@ struct SQLiteAsyncExec : public ThreadPoolItem
             LightObj c{SqTypeIdentity< SQLiteConnection >{}, SqVM(), mConnection};
             mRejected.Execute(c, mCtx, mResult, mError, mQueryObj);
         }
+        // Is there a promise to settle?
+        if (mPromise)
+        {
+            if (mResult == SQLITE_OK)
+            {
+                mPromise->Resolve(LightObj(SqInPlace{}, SqVM(), static_cast< SQInteger >(mChanges)));
+            }
+            else
+            {
+                mPromise->Reject(LightObj(SqInPlace{}, SqVM(), mError.empty() ? String(sqlite3_errstr(mResult)) : mError));
+            }
+        }
         // Finished
         return false;
     }
@@ -673,6 +699,19 @@ struct SQLiteAsyncStmtBase : public ThreadPoolItem
     */
     SQMOD_NODISCARD const char * IdentifiableInfo() noexcept override { return mQueryStr; }
 
+    /* --------------------------------------------------------------------------------------------
+     * Database queries are processed before other tasks.
+    */
+    SQMOD_NODISCARD ThreadPoolLane Lane() noexcept override { return TPLANE_HIGH; }
+
+    /* --------------------------------------------------------------------------------------------
+     * Tasks on the same database handle must not run concurrently.
+    */
+    SQMOD_NODISCARD uintptr_t Affinity() noexcept override
+    {
+        return mConnection ? reinterpret_cast< uintptr_t >(mConnection->mPtr) : 0;
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Invoked in worker thread by the thread pool after obtaining the task from the queue.
      * Must return true to indicate that the task can be performed. False indicates failure.
@@ -954,6 +993,27 @@ SqDataAsyncBuilder::SqDataAsyncBuilder(Poco::Data::SessionImpl * session, StackS
 {
 }
 
+// ------------------------------------------------------------------------------------------------
+LightObj SqDataAsyncBuilder::Promise_(LightObj & ctx)
+{
+    // Statements interact with the script at every step
+    if (mStmt)
+    {
+        STHROWF("Promises are only supported for plain query execution.");
+    }
+    // Only SQLite sessions settle the promise at the moment
+    else if (!mSession.isNull() && mSession->connectorName() != "sqlite")
+    {
+        STHROWF("Promises are only supported for SQLite sessions.");
+    }
+    // Create the promise returned to the script
+    LightObj obj = SqMod::Promise::Create(mPromise);
+    // Submit the task
+    Submit_(ctx);
+    // Return the promise
+    return obj;
+}
+
 // ------------------------------------------------------------------------------------------------
 void SqDataAsyncBuilder::Submit_(LightObj & ctx)
 {
@@ -1013,6 +1073,7 @@ void SqDataAsyncBuilder::Submit_(LightObj & ctx)
             item->mQueryStr = mQueryStr;
             item->mQueryObj = std::move(mQueryObj);
             item->mCtx = std::move(ctx);
+            item->mPromise = std::move(mPromise);
             // Submit the task
             ThreadPool::Get().Enqueue(std::move(task));
         }
@@ -1322,6 +1383,8 @@ void Register_POCO_Data(HSQUIRRELVM vm, Table &)
         // Overloaded methods
         .Overload(_SC("Submit"), &SqDataAsyncBuilder::Submit)
         .Overload(_SC("Submit"), &SqDataAsyncBuilder::Submit_)
+        .Overload(_SC("Promise"), &SqDataAsyncBuilder::Promise)
+        .Overload(_SC("Promise"), &SqDataAsyncBuilder::Promise_)
     );
     // --------------------------------------------------------------------------------------------
     ns.Bind(_SC("SessionPool"),
@@ -1,6 +1,7 @@
 #pragma once
 
 // ------------------------------------------------------------------------------------------------
+#include "Core/Promise.hpp"
 #include "Library/IO/Buffer.hpp"
 #include "Library/Utils/String.hpp"
 #include "Library/Utils/Vector.hpp"
@@ -2107,6 +2108,7 @@ struct SqDataAsyncBuilder
     Function        mResolved{}; // Callback to invoke when the task was completed.
     Function        mRejected{}; // Callback to invoke when the task was aborted.
     Function        mPrepared{}; // Callback to invoke when the task was must be prepared.
+    PromiseRef      mPromise{}; // Promise to settle when the task was completed.
     // --------------------------------------------------------------------------------------------
     const SQChar *  mQueryStr{nullptr}; // The query string that will be executed.
     LightObj        mQueryObj{}; // Strong reference to the query string object.
@@ -2155,6 +2157,18 @@ struct SqDataAsyncBuilder
     */
     void Submit_(LightObj & ctx);
 
+    /* --------------------------------------------------------------------------------------------
+     * Create the task and submit it to the worker pool. The returned promise is settled with the
+     * number of affected rows or with the error message.
+    */
+    SQMOD_NODISCARD LightObj Promise() { return Promise_(NullLightObj()); }
+
+    /* --------------------------------------------------------------------------------------------
+     * Create the task and submit it to the worker pool. The returned promise is settled with the
+     * number of affected rows or with the error message.
+    */
+    SQMOD_NODISCARD LightObj Promise_(LightObj & ctx);
+
     /* --------------------------------------------------------------------------------------------
      * Set the callback to be executed if the query was resolved.
     */
@@ -64,6 +64,7 @@ extern void Register_Command(HSQUIRRELVM vm);
 extern void Register_Inventory(HSQUIRRELVM vm);
 extern void Register_Loot(HSQUIRRELVM vm);
 extern void Register_Privilege(HSQUIRRELVM vm);
+extern void Register_Promise(HSQUIRRELVM vm);
 extern void Register_Routine(HSQUIRRELVM vm);
 extern void Register_Tasks(HSQUIRRELVM vm);
 
@@ -133,6 +134,7 @@ bool RegisterAPI(HSQUIRRELVM vm)
     Register_Inventory(vm);
     Register_Loot(vm);
     Register_Privilege(vm);
+    Register_Promise(vm);
     Register_Routine(vm);
     Register_Tasks(vm);
 
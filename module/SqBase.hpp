@@ -376,7 +376,23 @@ enum EntityFlags
     ENF_OWNED       = (1u << 1u),
     ENF_LOCKED      = (1u << 2u),
     ENF_AREA_TRACK  = (1u << 3u),
-    ENF_DIST_TRACK  = (1u << 4u)
+    ENF_DIST_TRACK  = (1u << 4u),
+    ENF_AREA_DIRTY  = (1u << 5u)
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Entity state fields. Used to report which of them changed during an update.
+*/
+enum EntityStateChange
+{
+    ESC_NONE        = (0),
+    ESC_HEADING     = (1u << 0u),
+    ESC_POSITION    = (1u << 1u),
+    ESC_HEALTH      = (1u << 2u),
+    ESC_ARMOUR      = (1u << 3u),
+    ESC_WEAPON      = (1u << 4u),
+    ESC_ROTATION    = (1u << 5u),
+    ESC_COLOR       = (1u << 6u)
 };
 
 /* ------------------------------------------------------------------------------------------------